@@ -29,6 +29,7 @@
 
 #include "application-pages.h"
 #include "main-window.h"
+#include "autosave.h"
 
 PingPage::PingPage(QWidget *parent, DragWidget *dw) : QWidget(parent)
 {
@@ -128,6 +129,8 @@ void PingPage::Add()
   {
     // Application form seems to be valid
     this->m_dw->m_mw->GetGenerator()->AddApplication("Ping", this->m_leftNode, this->m_rightNode, startTime, endTime);
+    this->m_dw->m_mw->GetAutosave()->Sync();
+    this->m_dw->UpdateToolTips();
     QMessageBox::about(this, "Ping", "Ping successfull installed.");
 
     // close the application window
@@ -262,6 +265,8 @@ void UdpEchoPage::Add()
   {
     // Application form seems to be valid
     this->m_dw->m_mw->GetGenerator()->AddApplication("UdpEcho", this->m_leftNode, this->m_rightNode, startTime, endTime, port);
+    this->m_dw->m_mw->GetAutosave()->Sync();
+    this->m_dw->UpdateToolTips();
     QMessageBox::about(this, "Udp Echo", "Udp Echo successfull installed.");
 
     // close the application window
@@ -396,6 +401,8 @@ void TcpPage::Add()
   {
     // Application form seems to be valid
     this->m_dw->m_mw->GetGenerator()->AddApplication("TcpLargeTransfer", this->m_leftNode, this->m_rightNode, startTime, endTime, port);
+    this->m_dw->m_mw->GetAutosave()->Sync();
+    this->m_dw->UpdateToolTips();
     QMessageBox::about(this, "Tcp Large Transfer", "Tcp large transfer successfull installed.");
 
     // close the application window
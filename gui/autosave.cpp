@@ -0,0 +1,367 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file autosave.cpp
+ * \brief Journal autosave of the edits.
+ */
+
+#include <cstdio>
+#include <stdexcept>
+
+#include <QtWidgets>
+
+#include "autosave.h"
+#include "drag-widget.h"
+#include "drag-object.h"
+#include "main-window.h"
+#include "gui-utils.h"
+#include "utils.h"
+
+const size_t Autosave::COMPACT_RECORDS = 10000;
+
+Autosave::Autosave(const std::string &directory, DragWidget *dw)
+{
+  this->m_directory = directory;
+  this->m_dw = dw;
+  this->m_generation = QDateTime::currentMSecsSinceEpoch();
+  this->m_nodes = 0;
+  this->m_links = 0;
+  this->m_applications = 0;
+  this->m_enabled = true;
+}
+
+Autosave::~Autosave()
+{
+  this->m_journal.Close();
+}
+
+bool Autosave::HasSession() const
+{
+  std::vector<std::vector<std::string> > records = Journal::Read(this->GetJournalName());
+  return records.size() > 1 || this->GetSnapshotName() != "";
+}
+
+std::string Autosave::GetSnapshotName() const
+{
+  std::vector<std::vector<std::string> > records = Journal::Read(this->GetJournalName());
+  if(records.size() == 0 || records.at(0).size() < 2 || records.at(0).at(0) != "snapshot" || records.at(0).at(1) == "")
+  {
+    return "";
+  }
+  return this->m_directory + "/" + records.at(0).at(1);
+}
+
+std::string Autosave::GetJournalName() const
+{
+  return this->m_directory + "/autosave.journal";
+}
+
+void Autosave::Start()
+{
+  if(!this->m_enabled)
+  {
+    return;
+  }
+  Generator *gen = this->GetGenerator();
+  std::string previous = this->GetSnapshotName();
+
+  try
+  {
+    // the previous snapshot stays valid until the journal names the new one.
+    std::string snapshot = "";
+    if(gen->GetNNodes() > 0 || gen->GetNNetworkHardwares() > 0 || this->m_dw->GetDrawLines().size() > 0)
+    {
+      snapshot = "autosave-" + QString::number(this->m_generation++).toStdString() + ".ngp";
+      guiUtils::saveProject(this->m_directory + "/" + snapshot, gen, this->m_dw);
+    }
+
+    std::vector<std::string> record;
+    record.push_back("snapshot");
+    record.push_back(snapshot);
+    this->m_journal.Open(this->GetJournalName());
+    this->m_journal.Reset(record);
+    this->m_snapshot = snapshot;
+  }
+  catch(const std::exception &e)
+  {
+    this->Fail(e.what());
+    return;
+  }
+
+  if(previous != "" && previous != this->m_directory + "/" + this->m_snapshot)
+  {
+    remove(previous.c_str());
+  }
+  this->m_nodes = gen->GetNNodes();
+  this->m_links = gen->GetNNetworkHardwares();
+  this->m_applications = gen->GetNApplications();
+  if(gen->GetScheduler() != "" || gen->GetParameterized())
+  {
+    this->Settings();
+  }
+}
+
+void Autosave::Sync()
+{
+  Generator *gen = this->GetGenerator();
+
+  ProjectFile::Node node;
+  for(size_t i = this->m_nodes; i < gen->GetNNodes(); i++)
+  {
+    if(guiUtils::nodeRecord(gen, this->m_dw, i, node))
+    {
+      std::vector<std::string> record;
+      record.push_back("node");
+      record.push_back(node.type);
+      record.push_back(node.name);
+      record.push_back(node.nsc);
+      record.push_back(utils::integerToString(node.number));
+      record.push_back(utils::integerToString(node.x));
+      record.push_back(utils::integerToString(node.y));
+      this->Append(record);
+    }
+  }
+  this->m_nodes = gen->GetNNodes();
+
+  for(size_t i = this->m_links; i < gen->GetNNetworkHardwares(); i++)
+  {
+    ProjectFile::Link link = guiUtils::linkRecord(gen, this->m_dw, i);
+    std::vector<std::string> record;
+    record.push_back("link");
+    record.push_back(link.hidden ? "1" : "0");
+    record.push_back(link.type);
+    record.push_back(link.name);
+    record.push_back(link.dataRate);
+    record.push_back(link.delay);
+    record.push_back(link.trace ? "1" : "0");
+    record.push_back(link.promisc ? "1" : "0");
+    record.push_back(link.special);
+    record.insert(record.end(), link.members.begin(), link.members.end());
+    this->Append(record);
+  }
+  this->m_links = gen->GetNNetworkHardwares();
+
+  for(size_t i = this->m_applications; i < gen->GetNApplications(); i++)
+  {
+    ProjectFile::Application application = guiUtils::applicationRecord(gen, i);
+    std::vector<std::string> record;
+    record.push_back("application");
+    record.push_back(application.type);
+    record.push_back(application.name);
+    record.push_back(application.sender);
+    record.push_back(application.receiver);
+    record.push_back(application.startTime);
+    record.push_back(application.endTime);
+    record.push_back(utils::integerToString(application.port));
+    record.push_back(utils::integerToString(application.packetSize));
+    record.push_back(utils::integerToString(application.maxPacketCount));
+    record.push_back(application.packetIntervalTime);
+    this->Append(record);
+  }
+  this->m_applications = gen->GetNApplications();
+}
+
+void Autosave::Install(const std::string &link, const std::string &node)
+{
+  std::vector<std::string> record;
+  record.push_back("install");
+  record.push_back(link);
+  record.push_back(node);
+  this->Append(record);
+}
+
+void Autosave::Uninstall(const std::string &link, const std::string &node)
+{
+  std::vector<std::string> record;
+  record.push_back("uninstall");
+  record.push_back(link);
+  record.push_back(node);
+  this->Append(record);
+}
+
+void Autosave::Line(const DragLines &line)
+{
+  std::vector<std::string> record;
+  record.push_back("line");
+  record.push_back(line.GetFirst());
+  record.push_back(line.GetSecond());
+  record.push_back(line.GetNetworkHardwareType());
+  this->Append(record);
+}
+
+void Autosave::Unline(const DragLines &line)
+{
+  std::vector<std::string> record;
+  record.push_back("unline");
+  record.push_back(line.GetFirst());
+  record.push_back(line.GetSecond());
+  record.push_back(line.GetNetworkHardwareType());
+  this->Append(record);
+}
+
+void Autosave::Remove(const std::set<std::string> &names)
+{
+  std::vector<std::string> record;
+  record.push_back("remove");
+  record.insert(record.end(), names.begin(), names.end());
+  this->Append(record);
+
+  // the generator lists were filtered, the next added objects are at their end.
+  Generator *gen = this->GetGenerator();
+  this->m_nodes = gen->GetNNodes();
+  this->m_links = gen->GetNNetworkHardwares();
+  this->m_applications = gen->GetNApplications();
+}
+
+void Autosave::Move(const std::vector<std::string> &names)
+{
+  std::vector<std::string> record;
+  record.push_back("move");
+  for(size_t i = 0; i < names.size(); i++)
+  {
+    DragObject *child = this->m_dw->GetChildFromName(names.at(i));
+    if(child)
+    {
+      record.push_back(names.at(i));
+      record.push_back(utils::integerToString((size_t)child->pos().x()));
+      record.push_back(utils::integerToString((size_t)child->pos().y()));
+    }
+  }
+  if(record.size() > 1)
+  {
+    this->Append(record);
+  }
+}
+
+void Autosave::Settings()
+{
+  std::vector<std::string> record;
+  record.push_back("settings");
+  record.push_back(this->GetGenerator()->GetScheduler());
+  record.push_back(this->GetGenerator()->GetParameterized() ? "1" : "0");
+  this->Append(record);
+}
+
+void Autosave::Discard()
+{
+  std::string snapshot = this->GetSnapshotName();
+  this->m_journal.Close();
+  if(snapshot != "")
+  {
+    remove(snapshot.c_str());
+  }
+  remove(this->GetJournalName().c_str());
+}
+
+ProjectFile::Node Autosave::DecodeNode(const std::vector<std::string> &record)
+{
+  Autosave::CheckRecord(record, 7);
+  ProjectFile::Node node;
+  node.type = record.at(1);
+  node.name = record.at(2);
+  node.nsc = record.at(3);
+  node.number = utils::stringToInteger(record.at(4));
+  node.x = utils::stringToInteger(record.at(5));
+  node.y = utils::stringToInteger(record.at(6));
+  return node;
+}
+
+ProjectFile::Link Autosave::DecodeLink(const std::vector<std::string> &record)
+{
+  Autosave::CheckRecord(record, 9);
+  ProjectFile::Link link;
+  link.hidden = (record.at(1) == "1");
+  link.type = record.at(2);
+  link.name = record.at(3);
+  link.dataRate = record.at(4);
+  link.delay = record.at(5);
+  link.trace = (record.at(6) == "1");
+  link.promisc = (record.at(7) == "1");
+  link.special = record.at(8);
+  link.members.assign(record.begin() + 9, record.end());
+  return link;
+}
+
+ProjectFile::Application Autosave::DecodeApplication(const std::vector<std::string> &record)
+{
+  Autosave::CheckRecord(record, 11);
+  ProjectFile::Application application;
+  application.type = record.at(1);
+  application.name = record.at(2);
+  application.sender = record.at(3);
+  application.receiver = record.at(4);
+  application.startTime = record.at(5);
+  application.endTime = record.at(6);
+  application.port = utils::stringToInteger(record.at(7));
+  application.packetSize = utils::stringToInteger(record.at(8));
+  application.maxPacketCount = utils::stringToInteger(record.at(9));
+  application.packetIntervalTime = record.at(10);
+  return application;
+}
+
+DragLines Autosave::DecodeLine(const std::vector<std::string> &record)
+{
+  Autosave::CheckRecord(record, 4);
+  DragLines line;
+  line.SetFirst(record.at(1));
+  line.SetSecond(record.at(2));
+  line.SetNetworkHardwareType(record.at(3));
+  return line;
+}
+
+Generator* Autosave::GetGenerator() const
+{
+  return this->m_dw->m_mw->GetGenerator();
+}
+
+void Autosave::Append(const std::vector<std::string> &record)
+{
+  if(!this->m_enabled)
+  {
+    return;
+  }
+  try
+  {
+    this->m_journal.Append(record);
+  }
+  catch(const std::exception &e)
+  {
+    this->Fail(e.what());
+    return;
+  }
+  if(this->m_journal.GetNRecords() >= Autosave::COMPACT_RECORDS)
+  {
+    this->Start();
+  }
+}
+
+void Autosave::Fail(const std::string &message)
+{
+  this->m_enabled = false;
+  this->m_journal.Close();
+  QMessageBox::warning(this->m_dw, "Autosave", QString("Autosave disabled! (") + message.c_str() + ").");
+}
+
+void Autosave::CheckRecord(const std::vector<std::string> &record, const size_t &size)
+{
+  if(record.size() < size)
+  {
+    throw std::logic_error("Replay failed! (" + record.at(0) + " record too short).");
+  }
+}
@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file autosave.h
+ * \brief Journal autosave of the edits.
+ */
+
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "journal.h"
+#include "project-file.h"
+#include "drag-lines.h"
+
+class DragWidget;
+class Generator;
+
+/**
+ * \ingroup generator
+ * \brief Journal autosave of the edits.
+ *
+ *  Each edit of the user is appended to a journal as a small record (added
+ *  node, link or application, install, line, removal, move, settings), so the
+ *  autosave cost is the one of the edit. Every COMPACT_RECORDS records, the
+ *  journal is compacted: the whole project is written into a binary snapshot
+ *  (see ProjectFile) and the journal restarts with a record naming it.
+ *
+ *  After a crash, the snapshot is loaded and the journal records are replayed
+ *  on it by the loader (see XmlLoader). The files are removed on a clean exit.
+ *
+ *  The added objects are found by their index: the generator only appends
+ *  them, Sync journals the objects added since its last call. It must be
+ *  called before an edit which refers to new objects or removes objects.
+ */
+class Autosave
+{
+  public:
+    /**
+     * \brief Number of journal records which triggers a compaction.
+     */
+    static const size_t COMPACT_RECORDS;
+
+    /**
+     * \brief Constructor.
+     * \param directory autosave directory
+     * \param dw the drag widget object
+     */
+    Autosave(const std::string &directory, DragWidget *dw);
+
+    /**
+     * \brief Destructor.
+     */
+    ~Autosave();
+
+    /**
+     * \brief Check if an autosaved session is left by a previous run.
+     * \return true if the journal holds edits or names a snapshot
+     */
+    bool HasSession() const;
+
+    /**
+     * \brief Get the snapshot file of the autosaved session.
+     * \return snapshot file name (empty if the session started empty)
+     */
+    std::string GetSnapshotName() const;
+
+    /**
+     * \brief Get the journal file name.
+     * \return journal file name
+     */
+    std::string GetJournalName() const;
+
+    /**
+     * \brief Start a new journal from a snapshot of the current project.
+     */
+    void Start();
+
+    /**
+     * \brief Journal the nodes, links and applications added since the last call.
+     */
+    void Sync();
+
+    /**
+     * \brief Journal the install of a node on a link.
+     * \param link link name
+     * \param node node name
+     */
+    void Install(const std::string &link, const std::string &node);
+
+    /**
+     * \brief Journal the uninstall of a node from a link.
+     * \param link link name
+     * \param node node name
+     */
+    void Uninstall(const std::string &link, const std::string &node);
+
+    /**
+     * \brief Journal an added canvas line.
+     * \param line drag line
+     */
+    void Line(const DragLines &line);
+
+    /**
+     * \brief Journal a removed canvas line.
+     * \param line drag line
+     */
+    void Unline(const DragLines &line);
+
+    /**
+     * \brief Journal removed objects (with Generator::RemoveObjects semantics).
+     * \param names names of the removed nodes and links
+     */
+    void Remove(const std::set<std::string> &names);
+
+    /**
+     * \brief Journal the positions of moved canvas objects.
+     * \param names names of the moved objects
+     */
+    void Move(const std::vector<std::string> &names);
+
+    /**
+     * \brief Journal the simulation settings (scheduler and parameterized).
+     */
+    void Settings();
+
+    /**
+     * \brief Remove the autosave files, at a clean exit.
+     */
+    void Discard();
+
+    /**
+     * \brief Decode a node record.
+     * \param record journal record
+     * \return node record
+     */
+    static ProjectFile::Node DecodeNode(const std::vector<std::string> &record);
+
+    /**
+     * \brief Decode a link record.
+     * \param record journal record
+     * \return link record
+     */
+    static ProjectFile::Link DecodeLink(const std::vector<std::string> &record);
+
+    /**
+     * \brief Decode an application record.
+     * \param record journal record
+     * \return application record
+     */
+    static ProjectFile::Application DecodeApplication(const std::vector<std::string> &record);
+
+    /**
+     * \brief Decode a line record.
+     * \param record journal record
+     * \return drag line
+     */
+    static DragLines DecodeLine(const std::vector<std::string> &record);
+
+    /**
+     * \brief Check the number of fields of a record.
+     * \param record journal record
+     * \param size expected minimum number of fields
+     */
+    static void CheckRecord(const std::vector<std::string> &record, const size_t &size);
+
+  private:
+    /**
+     * \brief Autosave directory.
+     */
+    std::string m_directory;
+
+    /**
+     * \brief The drag widget object.
+     */
+    DragWidget *m_dw;
+
+    /**
+     * \brief Journal.
+     */
+    Journal m_journal;
+
+    /**
+     * \brief Current snapshot file (empty if none).
+     */
+    std::string m_snapshot;
+
+    /**
+     * \brief Number of the next snapshot.
+     */
+    unsigned long long m_generation;
+
+    /**
+     * \brief Number of journaled nodes.
+     */
+    size_t m_nodes;
+
+    /**
+     * \brief Number of journaled links.
+     */
+    size_t m_links;
+
+    /**
+     * \brief Number of journaled applications.
+     */
+    size_t m_applications;
+
+    /**
+     * \brief Autosave state, it is disabled after a write error.
+     */
+    bool m_enabled;
+
+    /**
+     * \brief Get the generator.
+     * \return the generator object
+     */
+    Generator* GetGenerator() const;
+
+    /**
+     * \brief Append a record, compact the journal when it is too long.
+     * \param record record fields
+     */
+    void Append(const std::vector<std::string> &record);
+
+    /**
+     * \brief Disable the autosave after an error.
+     * \param message error message
+     */
+    void Fail(const std::string &message);
+};
+
+#endif /* AUTOSAVE_H */
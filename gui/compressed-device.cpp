@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file compressed-device.cpp
+ * \brief Qt device over a compressed file.
+ */
+
+#include <stdexcept>
+
+#include "compressed-device.h"
+
+CompressedDevice::CompressedDevice(const QString &fileName, const std::string &codec)
+{
+  this->m_fileName = fileName;
+  this->m_codec = codec;
+  this->m_error = "";
+}
+
+CompressedDevice::~CompressedDevice()
+{
+  if(this->isOpen())
+  {
+    this->close();
+  }
+}
+
+bool CompressedDevice::open(OpenMode mode)
+{
+  try
+  {
+    if(mode & QIODevice::WriteOnly)
+    {
+      this->m_file.Create(this->m_fileName.toStdString(), this->m_codec);
+    }
+    else
+    {
+      this->m_file.Open(this->m_fileName.toStdString());
+    }
+  }
+  catch(const std::exception &e)
+  {
+    this->Fail(e.what());
+    return false;
+  }
+  return QIODevice::open(mode & ~QIODevice::Text);
+}
+
+void CompressedDevice::close()
+{
+  QIODevice::close();
+  try
+  {
+    this->m_file.Close();
+  }
+  catch(const std::exception &e)
+  {
+    this->Fail(e.what());
+  }
+}
+
+bool CompressedDevice::isSequential() const
+{
+  return true;
+}
+
+qint64 CompressedDevice::GetFilePosition()
+{
+  return this->m_file.GetFilePosition();
+}
+
+qint64 CompressedDevice::readData(char *data, qint64 maxSize)
+{
+  try
+  {
+    return this->m_file.Read(data, maxSize);
+  }
+  catch(const std::exception &e)
+  {
+    this->Fail(e.what());
+    return -1;
+  }
+}
+
+qint64 CompressedDevice::writeData(const char *data, qint64 maxSize)
+{
+  try
+  {
+    this->m_file.Write(std::string(data, maxSize));
+  }
+  catch(const std::exception &e)
+  {
+    this->Fail(e.what());
+    return -1;
+  }
+  return maxSize;
+}
+
+QString CompressedDevice::GetError() const
+{
+  return this->m_error;
+}
+
+void CompressedDevice::Fail(const std::string &message)
+{
+  if(this->m_error == "")
+  {
+    this->m_error = QString(message.c_str());
+  }
+  this->setErrorString(this->m_error);
+}
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file compressed-device.h
+ * \brief Qt device over a compressed file.
+ */
+
+#ifndef COMPRESSED_DEVICE_H
+#define COMPRESSED_DEVICE_H
+
+#include <string>
+
+#include <QtCore>
+
+#include "compressed-file.h"
+
+/**
+ * \ingroup generator
+ * \brief Qt device over a compressed file.
+ *
+ *  The xml stream reader and writer use it to stream a compressed xml file
+ *  (see CompressedFile) without holding the whole file in memory. Opened for
+ *  reading, it reads plain files too.
+ */
+class CompressedDevice : public QIODevice
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param fileName file name
+     * \param codec codec name used for writing (empty for a plain file)
+     */
+    CompressedDevice(const QString &fileName, const std::string &codec);
+
+    /**
+     * \brief Destructor.
+     */
+    ~CompressedDevice();
+
+    /**
+     * \brief Open the file, ReadOnly or WriteOnly.
+     * \param mode open mode
+     * \return false if the file can not be opened
+     */
+    bool open(OpenMode mode);
+
+    /**
+     * \brief Close the file, the last blocks are written.
+     */
+    void close();
+
+    /**
+     * \brief The device can not seek.
+     * \return true
+     */
+    bool isSequential() const;
+
+    /**
+     * \brief Get the position into the file.
+     * \return number of file bytes (compressed) already read
+     */
+    qint64 GetFilePosition();
+
+    /**
+     * \brief Get the first error, the ones of the last blocks are known after close.
+     * \return error message (empty if none)
+     */
+    QString GetError() const;
+
+  protected:
+    /**
+     * \brief Read data.
+     * \param data buffer
+     * \param maxSize buffer size
+     * \return number of bytes read, -1 on error
+     */
+    qint64 readData(char *data, qint64 maxSize);
+
+    /**
+     * \brief Write data.
+     * \param data data to write
+     * \param maxSize data size
+     * \return number of bytes written, -1 on error
+     */
+    qint64 writeData(const char *data, qint64 maxSize);
+
+  private:
+    /**
+     * \brief File name.
+     */
+    QString m_fileName;
+
+    /**
+     * \brief Codec name used for writing.
+     */
+    std::string m_codec;
+
+    /**
+     * \brief The compressed file.
+     */
+    CompressedFile m_file;
+
+    /**
+     * \brief First error message.
+     */
+    QString m_error;
+
+    /**
+     * \brief Keep an error message.
+     * \param message error message
+     */
+    void Fail(const std::string &message);
+};
+
+#endif /* COMPRESSED_DEVICE_H */
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file drag-link.cpp
+ * \brief The drawn link item.
+ */
+
+#include "drag-link.h"
+#include "drag-object.h"
+#include "spatial-grid.h"
+
+DragLink::DragLink(const DragLines &line, DragObject *begin, DragObject *end, SpatialGrid *grid, const size_t &id)
+{
+  this->m_line = line;
+  this->m_begin = begin;
+  this->m_end = end;
+  this->m_grid = grid;
+  this->m_id = id;
+
+  this->m_begin->AddLink(this);
+  this->m_end->AddLink(this);
+  this->UpdatePosition();
+}
+
+DragLink::~DragLink()
+{
+  this->m_begin->RemoveLink(this);
+  this->m_end->RemoveLink(this);
+  this->m_grid->Remove(this->m_id);
+  this->Repaint();
+}
+
+DragLines DragLink::GetDragLines() const
+{
+  return this->m_line;
+}
+
+std::string DragLink::GetNetworkHardwareType() const
+{
+  return this->m_line.GetNetworkHardwareType();
+}
+
+QLineF DragLink::GetLine() const
+{
+  return this->m_segment;
+}
+
+size_t DragLink::GetId() const
+{
+  return this->m_id;
+}
+
+void DragLink::UpdatePosition()
+{
+  // repaint the old and new areas of the segment.
+  this->Repaint();
+
+  // the link of a collapsed object starts from its group
+  DragObject *begin = this->m_begin->GetVisible();
+  DragObject *end = this->m_end->GetVisible();
+  if(begin == end)
+  {
+    // inside a group, not drawn
+    this->m_segment = QLineF();
+    this->m_grid->Remove(this->m_id);
+    return;
+  }
+  this->m_segment = QLineF(begin->GetCenter(), end->GetCenter());
+  this->m_grid->SetSegment(this->m_id, this->m_segment.x1(), this->m_segment.y1(), this->m_segment.x2(), this->m_segment.y2());
+  this->Repaint();
+}
+
+void DragLink::Repaint()
+{
+  if(this->m_begin->scene() && !this->m_segment.isNull())
+  {
+    // the pen is 2 pixels wide.
+    QRectF area = QRectF(this->m_segment.p1(), this->m_segment.p2()).normalized();
+    this->m_begin->scene()->update(area.adjusted(-2, -2, 2, 2));
+  }
+}
+
+QPen DragLink::GetPen(const std::string &type)
+{
+  QPen pen(Qt::black);
+  pen.setWidth(2);
+  pen.setCapStyle(Qt::RoundCap);
+
+  if(type == "WifiLink")
+  {
+    pen.setStyle(Qt::DotLine);
+  }
+  else if(type == "P2pLink")
+  {
+    pen.setColor(Qt::green);
+  }
+  return pen;
+}
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file drag-link.h
+ * \brief The drawn link item.
+ */
+
+#ifndef DRAG_LINK_H
+#define DRAG_LINK_H
+
+#include <QtWidgets>
+
+#include "drag-lines.h"
+
+class DragObject;
+class SpatialGrid;
+
+/**
+ * \ingroup generator
+ * \brief Drawn link.
+ *
+ * This class represents a drag line on the canvas. It joins the centers
+ * of its two objects and is moved by them. The link is not a scene item,
+ * its segment is kept in the canvas spatial grid for the lookups and the
+ * hit tests and the canvas draws the visible links grouped by pen.
+ */
+class DragLink
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param line drag line
+     * \param begin first object
+     * \param end second object
+     * \param grid spatial grid of the canvas
+     * \param id id of the link into the grid
+     */
+    DragLink(const DragLines &line, DragObject *begin, DragObject *end, SpatialGrid *grid, const size_t &id);
+
+    /**
+     * \brief Destructor.
+     */
+    ~DragLink();
+
+    /**
+     * \brief Get the drag line.
+     * \return drag line
+     */
+    DragLines GetDragLines() const;
+
+    /**
+     * \brief Get the link type.
+     * \return link type
+     */
+    std::string GetNetworkHardwareType() const;
+
+    /**
+     * \brief Get the segment between the object centers.
+     * \return segment (in scene coordinates)
+     */
+    QLineF GetLine() const;
+
+    /**
+     * \brief Get the id of the link into the grid.
+     * \return id
+     */
+    size_t GetId() const;
+
+    /**
+     * \brief Move the link to the centers of its objects.
+     */
+    void UpdatePosition();
+
+    /**
+     * \brief Get the pen of a link type.
+     * \param type link type (WiredLink, WifiLink or P2pLink)
+     * \return pen
+     */
+    static QPen GetPen(const std::string &type);
+
+  private:
+    /**
+     * \brief Drag line.
+     */
+    DragLines m_line;
+
+    /**
+     * \brief First object.
+     */
+    DragObject *m_begin;
+
+    /**
+     * \brief Second object.
+     */
+    DragObject *m_end;
+
+    /**
+     * \brief Spatial grid of the canvas.
+     */
+    SpatialGrid *m_grid;
+
+    /**
+     * \brief Id into the grid.
+     */
+    size_t m_id;
+
+    /**
+     * \brief Segment between the object centers.
+     */
+    QLineF m_segment;
+
+    /**
+     * \brief Repaint the area of the segment.
+     */
+    void Repaint();
+};
+
+#endif /* DRAG_LINK_H */
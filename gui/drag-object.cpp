@@ -28,13 +28,26 @@
 #include <QtWidgets>
 #include <iostream>
 
+#include <algorithm>
+
 #include "drag-object.h"
-#include "drag-widget.h"
+#include "drag-link.h"
+#include "spatial-grid.h"
+
+const double DragObject::LOD_DOT = 0.35;
+const double DragObject::LOD_HEAT_MAP = 0.1;
 
-DragObject::DragObject(QWidget *parent) : QLabel(parent)
+DragObject::DragObject(QGraphicsItem *parent) : QGraphicsPixmapItem(parent)
 {
   this->m_name = "";
-  this->m_tooltip = "";
+  this->m_grid = NULL;
+  this->m_id = 0;
+  this->m_group = NULL;
+
+  setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable | QGraphicsItem::ItemSendsGeometryChanges);
+  // the whole icon is clickable, as the labels were.
+  setShapeMode(QGraphicsPixmapItem::BoundingRectShape);
+  setTransformationMode(Qt::SmoothTransformation);
 }
 
 DragObject::~DragObject()
@@ -51,19 +64,179 @@ std::string DragObject::GetName()
   return this->m_name;
 }
 
-void DragObject::Destroy()
+void DragObject::Reset()
+{
+  if(this->m_grid)
+  {
+    this->m_grid->Remove(this->m_id);
+    this->m_grid = NULL;
+  }
+  this->m_name = "";
+  this->m_id = 0;
+  this->m_group = NULL;
+  this->m_members.clear();
+  this->m_links.clear();
+  this->m_icon = QPixmap();
+  setSelected(false);
+  setPixmap(QPixmap());
+  setVisible(true);
+}
+
+
+void DragObject::AddLink(DragLink *link)
+{
+  this->m_links.push_back(link);
+}
+
+void DragObject::RemoveLink(DragLink *link)
+{
+  this->m_links.erase(std::remove(this->m_links.begin(), this->m_links.end(), link), this->m_links.end());
+}
+
+QPointF DragObject::GetCenter() const
+{
+  return sceneBoundingRect().center();
+}
+
+void DragObject::SetIndex(SpatialGrid *grid, const size_t &id)
+{
+  this->m_grid = grid;
+  this->m_id = id;
+  this->UpdateIndex();
+}
+
+size_t DragObject::GetId() const
+{
+  return this->m_id;
+}
+
+void DragObject::SetGroup(DragObject *group)
 {
-  this->m_name = "deleted";
-  this->destroy();
+  this->m_group = group;
+  setVisible(group == NULL);
+  if(group && this->m_grid)
+  {
+    // a folded object can not be clicked.
+    this->m_grid->Remove(this->m_id);
+  }
+  else
+  {
+    this->UpdateIndex();
+  }
+  this->UpdateLinks();
 }
 
-void DragObject::SetToolTipText(const QString &str)
+DragObject* DragObject::GetGroup() const
 {
-  this->m_tooltip = str;
+  return this->m_group;
 }
 
-QString DragObject::GetToolTipText()
+DragObject* DragObject::GetVisible()
 {
-  return this->m_tooltip;
+  return this->m_group ? this->m_group : this;
 }
 
+void DragObject::Collapse(const std::vector<DragObject*> &members)
+{
+  if(this->m_members.size() == 0)
+  {
+    this->m_icon = pixmap();
+  }
+  this->m_members = members;
+
+  // glyph: the icon with the number of members
+  QPixmap glyph = this->m_icon;
+  QPainter painter(&glyph);
+  QFont font = painter.font();
+  font.setBold(true);
+  painter.setFont(font);
+  QString text = "+" + QString::number(members.size());
+  QRectF badge = painter.boundingRect(glyph.rect(), Qt::AlignRight | Qt::AlignBottom, text).adjusted(-2, 0, 2, 0);
+  painter.setPen(Qt::NoPen);
+  painter.setBrush(QColor(200, 0, 0));
+  painter.drawRoundedRect(badge, 4, 4);
+  painter.setPen(Qt::white);
+  painter.drawText(badge, Qt::AlignCenter, text);
+  painter.end();
+  setPixmap(glyph);
+
+  for(size_t i = 0; i < members.size(); i++)
+  {
+    members.at(i)->SetGroup(this);
+  }
+}
+
+std::vector<DragObject*> DragObject::Expand()
+{
+  std::vector<DragObject*> members = this->m_members;
+  if(members.size() == 0)
+  {
+    return members;
+  }
+  this->m_members.clear();
+  setPixmap(this->m_icon);
+  for(size_t i = 0; i < members.size(); i++)
+  {
+    members.at(i)->SetGroup(NULL);
+  }
+  return members;
+}
+
+std::vector<DragObject*> DragObject::GetMembers() const
+{
+  return this->m_members;
+}
+
+void DragObject::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+  qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+  if(lod < DragObject::LOD_HEAT_MAP)
+  {
+    // drawn by the canvas density map
+    return;
+  }
+  if(lod < DragObject::LOD_DOT)
+  {
+    QColor color = isSelected() ? QColor(0, 0, 200) : (this->m_members.size() > 0 ? QColor(200, 0, 0) : Qt::darkGray);
+    painter->fillRect(boundingRect(), color);
+    return;
+  }
+  QGraphicsPixmapItem::paint(painter, option, widget);
+}
+
+void DragObject::UpdateLinks()
+{
+  for(size_t i = 0; i < this->m_links.size(); i++)
+  {
+    this->m_links.at(i)->UpdatePosition();
+  }
+  for(size_t i = 0; i < this->m_members.size(); i++)
+  {
+    this->m_members.at(i)->UpdateLinks();
+  }
+}
+
+void DragObject::UpdateIndex()
+{
+  if(this->m_grid && !this->m_group)
+  {
+    QRectF rect = sceneBoundingRect();
+    this->m_grid->SetRect(this->m_id, rect.left(), rect.top(), rect.right(), rect.bottom());
+  }
+}
+
+QVariant DragObject::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+  if(change == QGraphicsItem::ItemPositionChange)
+  {
+    // positions are saved as unsigned integers.
+    QPointF pos = value.toPointF();
+    return QPointF(qMax(pos.x(), (qreal)0), qMax(pos.y(), (qreal)0));
+  }
+  if(change == QGraphicsItem::ItemPositionHasChanged)
+  {
+    this->UpdateIndex();
+    this->UpdateLinks();
+  }
+  return QGraphicsPixmapItem::itemChange(change, value);
+}
@@ -31,22 +31,40 @@
 #include <vector>
 #include <QtWidgets>
 
-#include "drag-widget.h"
+class DragLink;
+class SpatialGrid;
 
 /**
  * \ingroup generator
  * \brief Dragged object.
  *
  * This class represents a dragged object.
+ * It is an item of the canvas scene, moving it moves the links attached to it.
+ *
+ * The icon is drawn at a normal zoom, a dot when zoomed out and nothing
+ * below the heat map zoom (the canvas draws the object density instead).
+ * A network hardware object can collapse the objects connected to it: they
+ * are hidden, their links are drawn from the group glyph and the glyph
+ * (the icon with the number of members) is built once per collapse.
  */
-class DragObject : public QLabel
+class DragObject : public QGraphicsPixmapItem
 {
   public:
+    /**
+     * \brief Zoom under which the objects are drawn as dots.
+     */
+    static const double LOD_DOT;
+
+    /**
+     * \brief Zoom under which the objects are drawn as a density heat map.
+     */
+    static const double LOD_HEAT_MAP;
+
     /**
      * \brief Constructor.
-     * \param parent the qwidget parent
+     * \param parent the parent item
      */
-    DragObject(QWidget *parent);
+    DragObject(QGraphicsItem *parent = 0);
 
     /**
      * \brief Destructor.
@@ -66,21 +84,90 @@ class DragObject : public QLabel
     std::string GetName();
 
     /**
-     * \brief Set tool tip text.
-     * \param str new tool tip text
+     * \brief Clear the object before its removal from the scene.
+     *
+     *  The object leaves the grid and loses its name, links, group and icon,
+     *  so it can be reused for a new object.
+     */
+    void Reset();
+
+    /**
+     * \brief Attach a link item which follows the object.
+     * \param link link item
+     */
+    void AddLink(DragLink *link);
+
+    /**
+     * \brief Detach a link item.
+     * \param link link item
+     */
+    void RemoveLink(DragLink *link);
+
+    /**
+     * \brief Get the center of the object.
+     * \return center (in scene coordinates)
+     */
+    QPointF GetCenter() const;
+
+    /**
+     * \brief Index the object into the canvas spatial grid.
+     * \param grid spatial grid
+     * \param id id of the object into the grid
+     */
+    void SetIndex(SpatialGrid *grid, const size_t &id);
+
+    /**
+     * \brief Get the id of the object into the grid.
+     * \return id
+     */
+    size_t GetId() const;
+
+    /**
+     * \brief Fold the object into a group glyph.
+     * \param group group object (NULL to unfold)
+     */
+    void SetGroup(DragObject *group);
+
+    /**
+     * \brief Get the group the object is folded into.
+     * \return group object (NULL if not folded)
+     */
+    DragObject* GetGroup() const;
+
+    /**
+     * \brief Get the object drawn for this one.
+     * \return the group object if folded, else this object
      */
-    void SetToolTipText(const QString &str);
+    DragObject* GetVisible();
 
     /**
-     * \brief Get tool tip text.
-     * \return tool tip text
+     * \brief Collapse objects into this one.
+     * \param members objects to fold
      */
-    QString GetToolTipText();
+    void Collapse(const std::vector<DragObject*> &members);
 
     /**
-     * \brief Destroy object from qwidget.
+     * \brief Expand the collapsed objects.
+     * \return objects unfolded
      */
-    void Destroy();
+    std::vector<DragObject*> Expand();
+
+    /**
+     * \brief Get the collapsed objects.
+     * \return objects folded into this one
+     */
+    std::vector<DragObject*> GetMembers() const;
+
+    /**
+     * \brief See Qt doc.
+     */
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+
+  protected:
+    /**
+     * \brief See Qt doc.
+     */
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
   private:
     /**
@@ -89,9 +176,44 @@ class DragObject : public QLabel
     std::string m_name;
 
     /**
-     * \brief tool tip text attribute.
+     * \brief Link items attached to the object.
+     */
+    std::vector<DragLink*> m_links;
+
+    /**
+     * \brief Spatial grid of the canvas (NULL if not indexed).
+     */
+    SpatialGrid *m_grid;
+
+    /**
+     * \brief Id into the grid.
+     */
+    size_t m_id;
+
+    /**
+     * \brief Group the object is folded into.
+     */
+    DragObject *m_group;
+
+    /**
+     * \brief Objects folded into this one.
+     */
+    std::vector<DragObject*> m_members;
+
+    /**
+     * \brief Icon kept while the group glyph is shown.
+     */
+    QPixmap m_icon;
+
+    /**
+     * \brief Put the object rectangle into the grid.
+     */
+    void UpdateIndex();
+
+    /**
+     * \brief Move the links of the object and of its members.
      */
-    QString m_tooltip;
+    void UpdateLinks();
 };
 
 #endif /* DRAG_OBJECT_H */
@@ -26,7 +26,10 @@
  */
 
 #include <QtWidgets>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <set>
 #include <stdexcept>
 
 #include "main-window.h"
@@ -34,6 +37,9 @@
 
 #include "drag-object.h"
 #include "drag-lines.h"
+#include "drag-link.h"
+#include "spatial-grid.h"
+#include "layout-engine.h"
 
 #include "emu.h"
 #include "tap.h"
@@ -42,13 +48,38 @@
 #include "gui-utils.h"
 #include "array-utils.h"
 
-DragWidget::DragWidget(QWidget *parent) : QWidget(parent)
+const size_t DragWidget::POOL_SIZE = 1024;
+
+DragWidget::DragWidget(QWidget *parent) : QGraphicsView(parent), m_pool(DragWidget::POOL_SIZE)
 {
   setMinimumSize(400, 400);
-  setAcceptDrops(true);
   setMouseTracking(true);
-
-  this->m_timer = new QTimer();
+  viewport()->setMouseTracking(true);
+
+  this->m_scene = new QGraphicsScene(this);
+  this->m_scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+  setScene(this->m_scene);
+  setAlignment(Qt::AlignLeft | Qt::AlignTop);
+  setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+  setOptimizationFlag(QGraphicsView::DontSavePainterState);
+  // repaint only the areas of the items which changed, nothing when idle.
+  setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+
+  // the scene index paints the objects, the grid answers the lookups of the objects and links.
+  this->m_grid = new SpatialGrid(64);
+  this->m_nextId = 0;
+  this->m_bundleSide = 0;
+  this->m_bundleRevision = 0;
+  this->m_lastObject = NULL;
+  this->m_pan = false;
+  this->m_hover = false;
+  this->m_rubberBand = new QRubberBand(QRubberBand::Rectangle, viewport());
+
+  // line to the cursor while tracing a link.
+  this->m_traceLine = new QGraphicsLineItem();
+  this->m_traceLine->setZValue(-1);
+  this->m_traceLine->hide();
+  this->m_scene->addItem(this->m_traceLine);
 
   // object used for link tracing.
   this->m_traceNetworkHardware = false;
@@ -64,11 +95,26 @@ DragWidget::DragWidget(QWidget *parent) : QWidget(parent)
   // the right and left application node
   this->m_appsClient = "";
   this->m_appsServer = "";
+
+  // the tool tips are built at the first hover.
+  this->m_adjacencyValid = false;
+
+  // automatic layout, the timer shows its progress.
+  this->m_layout = NULL;
+  this->m_layoutIteration = 0;
+  this->m_layoutTimer = new QTimer(this);
+  connect(this->m_layoutTimer, SIGNAL(timeout()), this, SLOT(UpdateLayout()));
 }
 
 DragWidget::~DragWidget()
 {
-  delete this->m_timer;
+  delete this->m_layout;
+  // links detach from their objects, delete them before the scene.
+  for(size_t i = 0; i < this->m_linkItems.size(); i++)
+  {
+    delete this->m_linkItems.at(i);
+  }
+  delete this->m_grid;
 }
 
 void DragWidget::CreateObject(const std::string &type, const std::string &name, size_t x /*=10*/, size_t y /*=10*/)
@@ -84,177 +130,61 @@ void DragWidget::CreateObject(const std::string &type, const std::string &name,
   ico["Bridge"]   = ":/Ico/Switch.png";
   ico["Router"]   = ":/Ico/Router.png";
 
-  DragObject *label = new DragObject(this);
+  // the objects of the deleted ones are reused.
+  DragObject *label = this->m_pool.Take();
   label->SetName(name);
-  this->UpdateToolTips();
-  
   label->setPixmap(QPixmap(QString((ico[type]).c_str())));
-  label->move(x, y);
-  label->show();
-  label->setAttribute(Qt::WA_DeleteOnClose);
-
-  this->m_timer = new QTimer();
-  this->m_timer->start(100);
-  connect(this->m_timer, SIGNAL(timeout()), this, SLOT(update()));
+  label->setPos(x, y);
+  this->m_scene->addItem(label);
+  label->SetIndex(this->m_grid, this->m_nextId);
+  this->m_idObjects[this->m_nextId++] = label;
+  this->m_objects[name] = label;
+  this->UpdateToolTips();
 }
 
-void DragWidget::dragEnterEvent(QDragEnterEvent *event)
+void DragWidget::mousePressEvent(QMouseEvent *event)
 {
-  if (event->mimeData()->hasFormat("application/x-dnditemdata")) 
-  {
-    if (event->source() == this) 
-    {
-      event->setDropAction(Qt::MoveAction);
-      event->accept();
-    } 
-    else 
-    {
-      event->acceptProposedAction();
-    }
-  } 
-  else 
+  this->m_pressPos = event->pos();
+  if(event->button() == Qt::MiddleButton)
   {
-    event->ignore();
+    this->m_pan = true;
+    this->m_panPosition = event->pos();
+    viewport()->setCursor(Qt::ClosedHandCursor);
+    event->accept();
+    return;
   }
-}
 
-void DragWidget::dropEvent(QDropEvent *event)
-{
-  if (event->mimeData()->hasFormat("application/x-dnditemdata")) 
-  {
-    QByteArray itemData = event->mimeData()->data("application/x-dnditemdata");
-    QDataStream dataStream(&itemData, QIODevice::ReadOnly);
-
-    QPixmap pixmap;
-    QPoint offset;
-    dataStream >> pixmap >> offset;
-
-    DragObject *child = static_cast<DragObject*>(childAt( this->m_lastPosition ));
-    DragObject *label = new DragObject(this);
-    if(child)
-    {
-      label->SetName(child->GetName());
-      this->UpdateToolTips();
-    }
-    label->setPixmap(pixmap);
-    label->move(event->pos() - offset);
-    label->show();
-    label->setAttribute(Qt::WA_DeleteOnClose);
-
-    update();
-
-    if (event->source() == this) 
-    {
-      event->setDropAction(Qt::MoveAction);
-      event->accept();
-    } 
-    else 
-    {
-      event->acceptProposedAction();
-    }
-  } 
-  else 
+  DragObject *child = NULL;
+  DragLink *link = NULL;
+  this->FindAt(event->pos(), child, link);
+  if(link)
   {
-    event->ignore();
+    // we are pointing on a drawn line
+    this->m_lastObject = NULL;
+    this->m_mw->m_delAction->setDisabled(false);
+    this->m_isDrawLine = true;
+    this->m_lastLine = link->GetDragLines();
+    QGraphicsView::mousePressEvent(event);
+    return;
   }
-}
 
-void DragWidget::mousePressEvent(QMouseEvent *event)
-{
-  DragObject *child = static_cast<DragObject*>(childAt(event->pos()));
-  if (!child)
+  if(!child)
   {
-    // test if we are looking for a drawed line
-    for(size_t i = 0; i < this->m_drawLines.size(); i++)
+    this->m_lastObject = NULL;
+    this->m_mw->m_delAction->setDisabled(true);
+    QGraphicsView::mousePressEvent(event);
+    if(event->button() == Qt::LeftButton && !this->m_traceNetworkHardware)
     {
-      // equipement A(xa, ya)
-      DragObject *begin = this->GetChildFromName(this->m_drawLines.at(i).GetFirst());
-      double xa = begin->pos().x() + (begin->width() / 2);
-      double ya = begin->pos().y() + (begin->height() / 2);
-      // equipement B(xb, yb)
-      DragObject *end = this->GetChildFromName(this->m_drawLines.at(i).GetSecond());
-      double xb = end->pos().x() + (end->width() / 2);
-      double yb = end->pos().y() + (end->height() / 2);
-
-      double dx = xb - xa;
-      double dy = yb - ya;
-      if(dx >= dy)
-      {
-        double b = ya - (dy / dx) * xa;
-        // C(xc, yc) is the mouse pointer
-        // if yc = xc * (dy/dx) + b we are pointing on a line !
-        if( ((double) event->y() - (double) 5) < ( (double)event->x() * ((double)(dy / dx)) + (double)b) &&
-            ((double) event->y() + (double) 5) > ( (double)event->x() * ((double)(dy / dx)) + (double)b) )
-        {
-          // check if we are focus on the right zone
-          if( (xb - xa) >= 0 )
-          {
-            if( event->x() > xa && event->y() < xb )
-            {
-              this->m_lastPosition = QPoint();
-              this->m_mw->m_delAction->setDisabled(false);
-              this->m_isDrawLine = true;
-              this->m_lastLine = this->m_drawLines.at(i);
-              return;
-            }
-          }
-          else
-          {
-            if( event->x() < xa && event->y() > xb )
-            {
-              this->m_lastPosition = QPoint();
-              this->m_mw->m_delAction->setDisabled(false);
-              this->m_isDrawLine = true;
-              this->m_lastLine = this->m_drawLines.at(i);
-              return;
-            }
-          }
-        }
-      }
-      else
-      {
-        double b = ya - (dx / dy) * xa;
-        // C(xc, yc) is the mouse pointer
-        // if yc = xc * (dx/dy) + b we are pointing on a line !
-        if( ((double) event->y() - (double) 10) < ( (double)event->x() * ((double)(dx / dy)) + (double)b) &&
-            ((double) event->y() + (double) 10) > ( (double)event->x() * ((double)(dx / dy)) + (double)b) )
-        { 
-          // check if we are focus on the right zone
-          if( (xb - xa) >= 0 )
-          {
-            if( event->x() > xa && event->y() < xb )
-            {
-              this->m_lastPosition = QPoint();
-              this->m_mw->m_delAction->setDisabled(false);
-              this->m_isDrawLine = true;
-              this->m_lastLine = this->m_drawLines.at(i);
-              return;
-            }
-          }
-          else
-          {
-            if( event->x() < xa && event->y() > xb )
-            {
-              this->m_lastPosition = QPoint();
-              this->m_mw->m_delAction->setDisabled(false);
-              this->m_isDrawLine = true;
-              this->m_lastLine = this->m_drawLines.at(i);
-              return;
-            }
-          }
-        }
-      }
+      // select the objects of an area
+      this->m_rubberOrigin = event->pos();
+      this->m_rubberBand->setGeometry(QRect(this->m_rubberOrigin, QSize()));
+      this->m_rubberBand->show();
     }
-  }
-
-  if(!child || child->GetName() == "deleted")
-  {
-    this->m_mw->m_delAction->setDisabled(true);
     return;
   }
 
   this->m_mw->m_delAction->setDisabled(false);
-  this->m_lastPosition = event->pos();
+  this->m_lastObject = child;
 
   // used if we are currently under drawing a line.
   DragObject *child2 = NULL;
@@ -264,6 +194,8 @@ void DragWidget::mousePressEvent(QMouseEvent *event)
     {
       // use this equipement as start of the drawing line
       this->m_networkHardwareBegin = child->GetName();
+      this->m_traceLine->setPen(DragLink::GetPen(this->m_networkHardwareType));
+      this->m_traceLine->setLine(QLineF(child->GetCenter(), child->GetCenter()));
     }
     else if(this->m_networkHardwareEnd == "")
     {
@@ -281,7 +213,7 @@ void DragWidget::mousePressEvent(QMouseEvent *event)
           lig.SetNetworkHardwareType(this->m_networkHardwareType);
 
           // add it to the vector containing all lines object
-          this->m_drawLines.push_back(lig);
+          this->AddDrawLine(lig);
 
           // validate the traced link
           size_t linkNumber = 0;
@@ -332,6 +264,16 @@ void DragWidget::mousePressEvent(QMouseEvent *event)
             }
           }
 
+          // the line is journaled unless the connection was refused.
+          for(size_t i = 0; i < this->m_drawLines.size(); i++)
+          {
+            if(this->m_drawLines.at(i).GetFirst() == lig.GetFirst() && this->m_drawLines.at(i).GetSecond() == lig.GetSecond())
+            {
+              this->m_mw->GetAutosave()->Line(lig);
+              break;
+            }
+          }
+
           // draw and clean
           this->DrawLines();
           this->ResetSelected();
@@ -340,37 +282,8 @@ void DragWidget::mousePressEvent(QMouseEvent *event)
     }
   }
 
-  QPixmap pixmap = *child->pixmap();
-
-  QByteArray itemData;
-  QDataStream dataStream(&itemData, QIODevice::WriteOnly);
-  dataStream << pixmap << QPoint(event->pos() - child->pos());
-
-  QMimeData *mimeData = new QMimeData;
-  mimeData->setData("application/x-dnditemdata", itemData);
-
-  QDrag *drag = new QDrag(this);
-  drag->setMimeData(mimeData);
-  drag->setPixmap(pixmap);
-  drag->setHotSpot(event->pos() - child->pos());
-
-  QPixmap tempPixmap = pixmap;
-  QPainter painter;
-  painter.begin(&tempPixmap);
-  painter.fillRect(pixmap.rect(), QColor(127, 127, 127, 127));
-  painter.end();
-
-  child->setPixmap(tempPixmap);
-
-  if (drag->start(Qt::CopyAction | Qt::MoveAction) == Qt::MoveAction)
-  {
-    child->close();
-  }
-  else 
-  {
-    child->show();
-    child->setPixmap(pixmap);
-  }
+  // move the object
+  QGraphicsView::mousePressEvent(event);
 
   /* application. */
   if(this->m_appsPing || this->m_appsUdpEcho || this->m_appsTcp)
@@ -431,9 +344,144 @@ void DragWidget::mousePressEvent(QMouseEvent *event)
   }
 }
 
-void DragWidget::mouseMoveEvent(QMouseEvent * /*event*/)
+void DragWidget::mouseMoveEvent(QMouseEvent *event)
+{
+  if(this->m_pan)
+  {
+    QPoint delta = event->pos() - this->m_panPosition;
+    this->m_panPosition = event->pos();
+    horizontalScrollBar()->setValue(horizontalScrollBar()->value() - delta.x());
+    verticalScrollBar()->setValue(verticalScrollBar()->value() - delta.y());
+    event->accept();
+    return;
+  }
+
+  // to show the drawing line when we are selecting the second equipement from interconnection,
+  // only the area of the line is repainted.
+  if(this->m_traceNetworkHardware && this->m_networkHardwareBegin != "" && this->m_networkHardwareEnd == "")
+  {
+    this->m_traceLine->setLine(QLineF(this->m_traceLine->line().p1(), mapToScene(event->pos())));
+    this->m_traceLine->show();
+  }
+
+  if(this->m_rubberBand->isVisible())
+  {
+    this->m_rubberBand->setGeometry(QRect(this->m_rubberOrigin, event->pos()).normalized());
+  }
+  else if(event->buttons() == Qt::NoButton)
+  {
+    // show what can be clicked
+    DragObject *child = NULL;
+    DragLink *link = NULL;
+    this->FindAt(event->pos(), child, link);
+    bool hover = (child || link);
+    if(hover != this->m_hover)
+    {
+      this->m_hover = hover;
+      if(hover)
+      {
+        viewport()->setCursor(Qt::PointingHandCursor);
+      }
+      else
+      {
+        viewport()->unsetCursor();
+      }
+    }
+  }
+  QGraphicsView::mouseMoveEvent(event);
+}
+
+void DragWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+  if(event->button() == Qt::MiddleButton && this->m_pan)
+  {
+    this->m_pan = false;
+    viewport()->unsetCursor();
+    this->m_hover = false;
+    event->accept();
+    return;
+  }
+  if(this->m_rubberBand->isVisible())
+  {
+    QRectF area = mapToScene(this->m_rubberBand->geometry()).boundingRect();
+    this->m_rubberBand->hide();
+    this->SelectIn(area, event->modifiers().testFlag(Qt::ControlModifier));
+    this->m_mw->m_delAction->setDisabled(this->m_scene->selectedItems().isEmpty());
+  }
+  else if(event->button() == Qt::LeftButton && this->m_lastObject && event->pos() != this->m_pressPos)
+  {
+    // the dragged objects: the selected ones and the clicked one.
+    std::vector<std::string> names;
+    QList<QGraphicsItem*> items = this->m_scene->selectedItems();
+    for(int i = 0; i < items.size(); i++)
+    {
+      DragObject *child = dynamic_cast<DragObject*>(items.at(i));
+      if(child && child != this->m_lastObject)
+      {
+        names.push_back(child->GetName());
+      }
+    }
+    names.push_back(this->m_lastObject->GetName());
+    this->m_mw->GetAutosave()->Move(names);
+  }
+  QGraphicsView::mouseReleaseEvent(event);
+}
+
+void DragWidget::wheelEvent(QWheelEvent *event)
+{
+  // one wheel step zooms by 15 %, under the cursor.
+  double factor = pow(1.15, event->angleDelta().y() / 120.0);
+  double zoom = transform().m11() * factor;
+  if(zoom < 0.01 || zoom > 10)
+  {
+    event->accept();
+    return;
+  }
+  scale(factor, factor);
+  event->accept();
+}
+
+void DragWidget::FindAt(const QPoint &pos, DragObject *&object, DragLink *&link)
+{
+  object = NULL;
+  link = NULL;
+
+  // links can be clicked at 5 pixels around them, whatever the zoom.
+  QPointF point = mapToScene(pos);
+  size_t id = 0;
+  if(!this->m_grid->FindAt(point.x(), point.y(), 5 / transform().m11(), id))
+  {
+    return;
+  }
+
+  std::map<size_t, DragObject*>::const_iterator obj = this->m_idObjects.find(id);
+  if(obj != this->m_idObjects.end())
+  {
+    object = obj->second;
+    return;
+  }
+  std::map<size_t, DragLink*>::const_iterator lnk = this->m_idLinks.find(id);
+  if(lnk != this->m_idLinks.end())
+  {
+    link = lnk->second;
+  }
+}
+
+void DragWidget::SelectIn(const QRectF &area, const bool &extend)
 {
-  update();
+  if(!extend)
+  {
+    this->m_scene->clearSelection();
+  }
+  std::vector<size_t> ids = this->m_grid->FindIn(area.left(), area.top(), area.right(), area.bottom());
+  for(size_t i = 0; i < ids.size(); i++)
+  {
+    std::map<size_t, DragObject*>::const_iterator obj = this->m_idObjects.find(ids.at(i));
+    if(obj != this->m_idObjects.end())
+    {
+      obj->second->setSelected(true);
+    }
+  }
 }
 
 void DragWidget::ResetSelected()
@@ -441,27 +489,64 @@ void DragWidget::ResetSelected()
   this->m_networkHardwareBegin = "";
   this->m_networkHardwareEnd = "";
   this->m_networkHardwareType = "";
+  this->m_traceLine->hide();
 }
 
 DragObject* DragWidget::GetChildFromName(const std::string &name)
 {
-  for(size_t i = 0; i < (size_t)this->children().size(); i++)
+  std::map<std::string, DragObject*>::const_iterator it = this->m_objects.find(name);
+  if(it == this->m_objects.end())
   {
-    DragObject *child = dynamic_cast<DragObject*>(this->children().at(i));
-    if(child)
-    {
-      if( child->GetName() == name)
-      {
-        return child;
-      }
-    }
+    return NULL;
+  }
+  return it->second;
+}
+
+std::vector<DragObject*> DragWidget::GetObjects()
+{
+  std::vector<DragObject*> objects;
+  objects.reserve(this->m_objects.size());
+  for(std::map<std::string, DragObject*>::const_iterator it = this->m_objects.begin(); it != this->m_objects.end(); it++)
+  {
+    objects.push_back(it->second);
+  }
+  return objects;
+}
+
+QImage DragWidget::GetPicture()
+{
+  QRectF rect = this->m_scene->itemsBoundingRect().adjusted(-10, -10, 10, 10);
+  QImage img(rect.size().toSize(), QImage::Format_ARGB32);
+  img.fill(Qt::white);
+
+  // the links are not painted by their items, draw them under the scene.
+  QPainter painter(&img);
+  painter.translate(-rect.topLeft());
+  this->DrawLinks(&painter, rect);
+  painter.resetTransform();
+  this->m_scene->render(&painter, QRectF(img.rect()), rect);
+  painter.end();
+
+  return img;
+}
+
+DragLink* DragWidget::CreateLink(const DragLines &dl)
+{
+  DragObject *begin = this->GetChildFromName(dl.GetFirst());
+  DragObject *end = this->GetChildFromName(dl.GetSecond());
+  if(!begin || !end)
+  {
+    return NULL;
   }
-  return new DragObject(this);
+  DragLink *link = new DragLink(dl, begin, end, this->m_grid, this->m_nextId);
+  this->m_idLinks[this->m_nextId++] = link;
+  return link;
 }
 
 void DragWidget::AddDrawLine(const DragLines &dl)
 {
   this->m_drawLines.push_back(dl);
+  this->m_linkItems.push_back(this->CreateLink(dl));
 }
 
 DragLines DragWidget::GetDrawLine(const size_t &index)
@@ -469,13 +554,19 @@ DragLines DragWidget::GetDrawLine(const size_t &index)
   return this->m_drawLines.at(index);
 }
 
-std::vector<DragLines> DragWidget::GetDrawLines()
+const std::vector<DragLines>& DragWidget::GetDrawLines() const
 {
   return this->m_drawLines;
 }
 
 void DragWidget::EraseDrawLine(const size_t &index)
 {
+  if(this->m_linkItems.at(index))
+  {
+    this->m_idLinks.erase(this->m_linkItems.at(index)->GetId());
+  }
+  delete this->m_linkItems.at(index);
+  this->m_linkItems.erase(this->m_linkItems.begin() + index);
   this->m_drawLines.erase(this->m_drawLines.begin() + index);
 }
 
@@ -509,83 +600,262 @@ std::vector<std::string> DragWidget::GetLastSelected()
 
 void DragWidget::DrawLines()
 {
-  update();
+  // the objects of a line may be created after it.
+  for(size_t i = 0; i < this->m_drawLines.size(); i++)
+  {
+    if(!this->m_linkItems.at(i))
+    {
+      this->m_linkItems.at(i) = this->CreateLink(this->m_drawLines.at(i));
+    }
+  }
+  this->UpdateGroups();
+  this->UpdateToolTips();
 }
 
-void DragWidget::paintEvent(QPaintEvent * /*event*/)
+void DragWidget::drawBackground(QPainter *painter, const QRectF &rect)
 {
-  QPainter paint(this);
+  QGraphicsView::drawBackground(painter, rect);
+  this->DrawLinks(painter, rect);
+}
 
-  QPen pen(Qt::black);
-  pen.setWidth(2);
-  pen.setCapStyle(Qt::RoundCap);
+void DragWidget::drawForeground(QPainter *painter, const QRectF &rect)
+{
+  QGraphicsView::drawForeground(painter, rect);
+  if(transform().m11() < DragObject::LOD_HEAT_MAP)
+  {
+    this->DrawDensity(painter, rect, transform().m11());
+  }
+}
 
-  QPen point(Qt::black);
-  point.setWidth(2);
-  point.setStyle(Qt::DotLine);
-  point.setCapStyle(Qt::RoundCap);
+void DragWidget::DrawDensity(QPainter *painter, const QRectF &rect, const double &lod)
+{
+  // a heat map cell is at least 8 pixels wide.
+  double cellSize = this->m_grid->GetCellSize();
+  long bucket = std::max(1L, (long)std::ceil(8 / (cellSize * lod)));
+  double side = cellSize * bucket;
 
-  QPen p2p(Qt::green);
-  p2p.setWidth(2);
-  p2p.setCapStyle(Qt::RoundCap);
+  std::map<SpatialGrid::Cell, size_t> counts = this->m_grid->CountRects(rect.left(), rect.top(), rect.right(), rect.bottom(), bucket);
+  for(std::map<SpatialGrid::Cell, size_t>::const_iterator it = counts.begin(); it != counts.end(); it++)
+  {
+    // blue for one object, red from 64 objects.
+    int hue = 240 - std::min(240, (int)(40 * std::log2((double)it->second)));
+    painter->fillRect(QRectF(it->first.first * side, it->first.second * side, side, side), QColor::fromHsv(hue, 255, 255, 160));
+  }
+}
 
+void DragWidget::DrawBundles(QPainter *painter, const double &lod)
+{
+  double side = 32 / lod;
+  if(side != this->m_bundleSide || this->m_grid->GetSegmentRevision() != this->m_bundleRevision)
+  {
+    std::map<int, QVector<QLineF> > bundles = this->ComputeBundles(side);
+    // the other areas show the old widths: repaint the whole view once.
+    if(side == this->m_bundleSide && bundles != this->m_bundles)
+    {
+      viewport()->update();
+    }
+    this->m_bundles = bundles;
+    this->m_bundleSide = side;
+    this->m_bundleRevision = this->m_grid->GetSegmentRevision();
+  }
 
-  for(size_t i = 0; i < this->m_drawLines.size(); i++)
+  for(std::map<int, QVector<QLineF> >::const_iterator it = this->m_bundles.begin(); it != this->m_bundles.end(); it++)
+  {
+    QPen pen(Qt::darkGray);
+    pen.setCosmetic(true);
+    pen.setWidth(it->first);
+    painter->setPen(pen);
+    painter->drawLines(it->second);
+  }
+}
+
+std::map<int, QVector<QLineF> > DragWidget::ComputeBundles(const double &side)
+{
+  // the links between the same areas are drawn as one edge, wider with the number of links.
+  std::map<std::pair<SpatialGrid::Cell, SpatialGrid::Cell>, size_t> bundles;
+  for(std::map<size_t, DragLink*>::const_iterator link = this->m_idLinks.begin(); link != this->m_idLinks.end(); link++)
   {
-    if(this->GetChildFromName(this->m_drawLines.at(i).GetFirst())->GetName() != "" && 
-       this->GetChildFromName(this->m_drawLines.at(i).GetSecond())->GetName() != "")
+    QLineF line = link->second->GetLine();
+    if(line.isNull())
+    {
+      continue;
+    }
+    SpatialGrid::Cell a((long)std::floor(line.x1() / side), (long)std::floor(line.y1() / side));
+    SpatialGrid::Cell b((long)std::floor(line.x2() / side), (long)std::floor(line.y2() / side));
+    if(a == b)
     {
-      std::string type = this->m_drawLines.at(i).GetNetworkHardwareType();
+      continue;
+    }
+    bundles[a < b ? std::make_pair(a, b) : std::make_pair(b, a)]++;
+  }
 
-      if(type == "WiredLink")
-      {
-        paint.setPen(pen);
-      }
-      else if(type == "WifiLink")
-      {
-        paint.setPen(point);
-      }
-      else if(type == "P2pLink")
-      {
-        paint.setPen(p2p);
-      }
-      DragObject *begin = this->GetChildFromName(this->m_drawLines.at(i).GetFirst());
-      DragObject *end = this->GetChildFromName(this->m_drawLines.at(i).GetSecond());
-      paint.drawLine((begin->pos().x() + (begin->width() / 2)), (begin->pos().y() + (begin->height() / 2)),
-                     (end->pos().x() + (end->width() / 2)), (end->pos().y() + (end->height() / 2)));
+  std::map<int, QVector<QLineF> > widths;
+  for(std::map<std::pair<SpatialGrid::Cell, SpatialGrid::Cell>, size_t>::const_iterator it = bundles.begin(); it != bundles.end(); it++)
+  {
+    const SpatialGrid::Cell &a = it->first.first;
+    const SpatialGrid::Cell &b = it->first.second;
+    widths[1 + (int)std::log2((double)it->second)].push_back(QLineF((a.first + 0.5) * side, (a.second + 0.5) * side,
+                                                                      (b.first + 0.5) * side, (b.second + 0.5) * side));
+  }
+  return widths;
+}
+
+void DragWidget::DrawLinks(QPainter *painter, const QRectF &rect)
+{
+  double lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+  if(lod < DragObject::LOD_DOT)
+  {
+    this->DrawBundles(painter, lod);
+    return;
+  }
+
+  std::vector<size_t> ids = this->m_grid->FindIn(rect.left(), rect.top(), rect.right(), rect.bottom());
+
+  // group the visible links by type, one drawLines call per pen.
+  std::map<std::string, QVector<QLineF> > batches;
+  for(size_t i = 0; i < ids.size(); i++)
+  {
+    std::map<size_t, DragLink*>::const_iterator link = this->m_idLinks.find(ids.at(i));
+    if(link != this->m_idLinks.end())
+    {
+      batches[link->second->GetNetworkHardwareType()].push_back(link->second->GetLine());
     }
   }
-  // to show the drawing line when we are selecting the second equipement from interconnection
-  if(this->m_traceNetworkHardware)
+
+  for(std::map<std::string, QVector<QLineF> >::const_iterator it = batches.begin(); it != batches.end(); it++)
   {
-    if(this->m_networkHardwareBegin != "" && this->m_networkHardwareEnd == "")
+    painter->setPen(DragLink::GetPen(it->first));
+    painter->drawLines(it->second);
+  }
+}
+
+void DragWidget::contextMenuEvent(QContextMenuEvent *event)
+{
+  DragObject *child = NULL;
+  DragLink *link = NULL;
+  this->FindAt(event->pos(), child, link);
+
+  QMenu menu(this);
+  QAction *collapse = NULL;
+  QAction *expand = NULL;
+  QAction *selectType = NULL;
+  std::string type("");
+  if(child)
+  {
+    if(child->GetMembers().size() > 0)
     {
-      if(this->m_networkHardwareType == "WiredLink")
-      {
-        paint.setPen(pen);
-      }
-      else if(this->m_networkHardwareType == "WifiLink")
-      {
-        paint.setPen(point);
-      }
-      else if(this->m_networkHardwareType == "P2pLink")
-      {
-        paint.setPen(p2p);
-      }
-      paint.drawLine((this->GetChildFromName(this->m_networkHardwareBegin))->pos().x() + 
-          ((this->GetChildFromName(this->m_networkHardwareBegin))->width() / 2),
-          (this->GetChildFromName(this->m_networkHardwareBegin))->pos().y() + 
-          ((this->GetChildFromName(this->m_networkHardwareBegin))->height() / 2),
-          mapFromGlobal(QCursor::pos()).x(),  mapFromGlobal(QCursor::pos()).y());
+      expand = menu.addAction("Expand");
+    }
+    else if(this->GetGroupMembers(child->GetName()).size() > 0)
+    {
+      collapse = menu.addAction("Collapse");
+    }
+    // "term_3" is of the type "term_".
+    type = child->GetName().substr(0, child->GetName().find('_') + 1);
+    if(type != "")
+    {
+      selectType = menu.addAction(QString("Select all %1*").arg(type.c_str()));
+    }
+  }
+  QAction *selectAll = menu.addAction("Select all");
+
+  QAction *action = menu.exec(event->globalPos());
+  if(action && action == collapse)
+  {
+    this->CollapseGroup(child);
+  }
+  else if(action && action == expand)
+  {
+    this->ExpandGroup(child);
+  }
+  else if(action && action == selectType)
+  {
+    this->SelectType(type);
+  }
+  else if(action && action == selectAll)
+  {
+    this->SelectType("");
+  }
+}
+
+std::vector<std::string> DragWidget::GetGroupMembers(const std::string &name)
+{
+  for(size_t i = 0; i < this->m_mw->GetGenerator()->GetNNetworkHardwares(); i++)
+  {
+    if(this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetNetworkHardwareName() == name)
+    {
+      return this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetInstalledNodes();
+    }
+  }
+  return std::vector<std::string>();
+}
+
+void DragWidget::CollapseGroup(DragObject *group)
+{
+  std::vector<std::string> names = this->GetGroupMembers(group->GetName());
+  std::vector<DragObject*> members;
+  for(size_t i = 0; i < names.size(); i++)
+  {
+    // the objects already folded or collapsing others stay out.
+    DragObject *member = this->GetChildFromName(names.at(i));
+    if(member && member != group && !member->GetGroup() && member->GetMembers().size() == 0)
+    {
+      members.push_back(member);
+    }
+  }
+  if(members.size() == 0)
+  {
+    return;
+  }
+  group->Collapse(members);
+  this->m_groups[group->GetName()] = names;
+}
+
+void DragWidget::ExpandGroup(DragObject *group)
+{
+  group->Expand();
+  this->m_groups.erase(group->GetName());
+}
+
+void DragWidget::UpdateGroups()
+{
+  // only the groups whose members changed are rebuilt.
+  std::map<std::string, std::vector<std::string> > groups = this->m_groups;
+  for(std::map<std::string, std::vector<std::string> >::const_iterator it = groups.begin(); it != groups.end(); it++)
+  {
+    if(this->GetGroupMembers(it->first) == it->second)
+    {
+      continue;
+    }
+    this->m_groups.erase(it->first);
+    DragObject *group = this->GetChildFromName(it->first);
+    if(group)
+    {
+      group->Expand();
+      this->CollapseGroup(group);
     }
   }
-  paint.setPen(pen);
 }
 
 void DragWidget::DeleteSelected()
 {
-  DragObject *child = static_cast<DragObject*>(childAt(this->m_lastPosition));
-  if(!child)
+  // the selected objects, else the last clicked one.
+  std::vector<std::string> names;
+  QList<QGraphicsItem*> items = this->m_scene->selectedItems();
+  for(int i = 0; i < items.size(); i++)
+  {
+    DragObject *child = dynamic_cast<DragObject*>(items.at(i));
+    if(child)
+    {
+      names.push_back(child->GetName());
+    }
+  }
+  if(names.size() == 0 && this->m_lastObject)
+  {
+    names.push_back(this->m_lastObject->GetName());
+  }
+
+  if(names.size() == 0)
   {
     // test if we are under deleting a line !
     if(this->m_isDrawLine)
@@ -607,12 +877,16 @@ void DragWidget::DeleteSelected()
       }
       if(isLinkToRemove)
       {
+        this->m_mw->GetAutosave()->Sync();
         if( (guiUtils::isNetworkHardware(this->m_lastLine.GetFirst()) &&
              guiUtils::isNetworkHardware(this->m_lastLine.GetSecond()) ) ||
             (!guiUtils::isNetworkHardware(this->m_lastLine.GetFirst()) &&
              !guiUtils::isNetworkHardware(this->m_lastLine.GetSecond()) )  )
         {
-          this->m_mw->GetGenerator()->RemoveNetworkHardware(this->m_mw->GetGenerator()->GetNetworkHardware(linkToRemove)->GetNetworkHardwareName());
+          std::set<std::string> removed;
+          removed.insert(this->m_mw->GetGenerator()->GetNetworkHardware(linkToRemove)->GetNetworkHardwareName());
+          this->m_mw->GetGenerator()->RemoveNetworkHardware(*removed.begin());
+          this->m_mw->GetAutosave()->Remove(removed);
         }
         else if( guiUtils::isNetworkHardware(this->m_lastLine.GetFirst()) )
         {
@@ -622,6 +896,7 @@ void DragWidget::DeleteSelected()
             if(nodes.at(i) == this->m_lastLine.GetSecond())
             {
               this->m_mw->GetGenerator()->GetNetworkHardware(linkToRemove)->removeInstalledNode(i);
+              this->m_mw->GetAutosave()->Uninstall(this->m_lastLine.GetFirst(), nodes.at(i));
               break;
             }
           }
@@ -634,6 +909,7 @@ void DragWidget::DeleteSelected()
             if(nodes.at(i) == this->m_lastLine.GetFirst())
             {
               this->m_mw->GetGenerator()->GetNetworkHardware(linkToRemove)->removeInstalledNode(i);
+              this->m_mw->GetAutosave()->Uninstall(this->m_lastLine.GetSecond(), nodes.at(i));
               break;
             }
           }
@@ -644,6 +920,7 @@ void DragWidget::DeleteSelected()
              this->m_drawLines.at(i).GetSecond() == this->m_lastLine.GetSecond())
           {
             this->EraseDrawLine(i);
+            this->m_mw->GetAutosave()->Unline(this->m_lastLine);
             break;
           }
         }
@@ -651,209 +928,217 @@ void DragWidget::DeleteSelected()
       this->UpdateToolTips();
     }
     this->m_isDrawLine = false;
-  }
-  
-  if (!child)
-  {
+    this->UpdateGroups();
     this->m_mw->m_delAction->setDisabled(true);
     return;
   }
 
-  // delete equipement
-  try
+  this->DeleteObjects(names);
+  this->m_mw->m_delAction->setDisabled(true);
+}
+
+void DragWidget::ReleaseObject(DragObject *child)
+{
+  this->m_objects.erase(child->GetName());
+  this->m_idObjects.erase(child->GetId());
+  if(child == this->m_lastObject)
   {
-    this->m_mw->GetGenerator()->RemoveNode(child->GetName());
+    this->m_lastObject = NULL;
   }
-  catch(const std::exception)
-  {}
+  child->Reset();
+  this->m_scene->removeItem(child);
+  this->m_pool.Release(child);
+}
 
-  // delete network hardware
-  try
+void DragWidget::SelectType(const std::string &prefix)
+{
+  this->m_scene->clearSelection();
+  // the names are sorted, the objects of a type are contiguous.
+  for(std::map<std::string, DragObject*>::const_iterator it = this->m_objects.lower_bound(prefix);
+      it != this->m_objects.end() && it->first.compare(0, prefix.size(), prefix) == 0; it++)
   {
-    this->m_mw->GetGenerator()->RemoveNetworkHardware(child->GetName());
+    it->second->setSelected(true);
   }
-  catch(const std::exception)
-  {}
+  this->m_mw->m_delAction->setDisabled(this->m_scene->selectedItems().isEmpty());
+}
 
-  // delete connections
-  std::vector<std::string> objDelLink;
-  for(size_t i = 0; i < this->m_mw->GetGenerator()->GetNNetworkHardwares(); i++)
+void DragWidget::DeleteObjects(const std::vector<std::string> &names)
+{
+  std::set<std::string> removed;
+  for(size_t i = 0; i < names.size(); i++)
   {
-    std::vector<std::string> nodes = this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetInstalledNodes();
-    for(size_t j = 0; j < nodes.size(); j++)
+    DragObject *child = this->GetChildFromName(names.at(i));
+    if(!child)
     {
-      // if the child to be deleted is connected ... we must remove it.
-      if(child->GetName() == nodes.at(j))
-      {
-        objDelLink.push_back(this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetNetworkHardwareName());
-        try
-        {
-          this->m_mw->GetGenerator()->GetNetworkHardware(i)->removeInstalledNode(j);
-        }
-        catch(const std::out_of_range &e)
-        {
-          this->m_mw->m_delAction->setDisabled(true);
-        }
-      }
+      continue;
     }
+    // a deleted group shows its members back, a folded member leaves its group.
+    if(child->GetMembers().size() > 0)
+    {
+      this->ExpandGroup(child);
+    }
+    if(child->GetGroup())
+    {
+      this->ExpandGroup(child->GetGroup());
+    }
+    removed.insert(child->GetName());
+  }
+  if(removed.size() == 0)
+  {
+    return;
   }
 
-  // delete hide hub
-  bool isHide = true;
-  for(size_t i = 0; i < objDelLink.size(); i++)
+  // the links of the canvas stay even alone, the hidden hubs of the node to node links go.
+  std::set<std::string> keep;
+  for(std::map<std::string, DragObject*>::const_iterator it = this->m_objects.begin(); it != this->m_objects.end(); it++)
   {
-    for(size_t j = 0; j < this->m_mw->GetGenerator()->GetNNetworkHardwares(); j++)
+    if(removed.find(it->first) == removed.end())
     {
-      if( objDelLink.at(i) == this->m_mw->GetGenerator()->GetNetworkHardware(j)->GetNetworkHardwareName() )
-      {
-        if(this->m_mw->GetGenerator()->GetNetworkHardware(j)->GetInstalledNodes().size() <= 1)
-        {
-          // the link where the deleted object 
-          // check if the link is hide. 
-          isHide = true;
-          for(size_t k = 0; k < (size_t)this->children().size(); k++)
-          {
-            if(dynamic_cast<DragObject*>((this->children().at(k))))
-            {
-              if( dynamic_cast<DragObject*>((this->children().at(k)))->GetName() == this->m_mw->GetGenerator()->GetNetworkHardware(j)->GetNetworkHardwareName())
-              {
-                isHide = false;
-              }
-            }
-          }
-          if(isHide)
-          {
-            this->m_mw->GetGenerator()->RemoveNetworkHardware(this->m_mw->GetGenerator()->GetNetworkHardware(j)->GetNetworkHardwareName());
-          }
-        }
-      }
+      keep.insert(keep.end(), it->first);
     }
   }
 
+  // nodes, memberships, links and applications, nothing is removed on error.
+  this->m_mw->GetAutosave()->Sync();
+  try
+  {
+    this->m_mw->GetGenerator()->RemoveObjects(removed, keep);
+  }
+  catch(const std::exception &e)
+  {
+    QMessageBox::warning(this, "Delete", e.what());
+    return;
+  }
+  this->m_mw->GetAutosave()->Remove(removed);
+
   // remove from link part ...
-  if(child->GetName() == this->GetChildFromName(this->m_networkHardwareBegin)->GetName())
+  if(removed.find(this->m_networkHardwareBegin) != removed.end())
   {
     this->m_networkHardwareBegin = "";
+    this->m_traceLine->hide();
   }
-  if(child->GetName() == this->GetChildFromName(this->m_networkHardwareEnd)->GetName())
+  if(removed.find(this->m_networkHardwareEnd) != removed.end())
   {
     this->m_networkHardwareEnd = "";
   }
+
+  // lines of the removed objects, in a single pass.
+  size_t kept = 0;
   for(size_t i = 0; i < this->m_drawLines.size(); i++)
   {
-    if(child->GetName() == this->GetChildFromName(this->m_drawLines.at(i).GetFirst())->GetName() || 
-       child->GetName() == this->GetChildFromName(this->m_drawLines.at(i).GetSecond())->GetName())
+    if(removed.find(this->m_drawLines.at(i).GetFirst()) != removed.end() ||
+       removed.find(this->m_drawLines.at(i).GetSecond()) != removed.end())
     {
-      try
-      {
-        this->m_drawLines.erase(this->m_drawLines.begin() + i);
-      }
-      catch(const std::out_of_range &e)
+      if(this->m_linkItems.at(i))
       {
-        this->m_mw->m_delAction->setDisabled(true);
+        this->m_idLinks.erase(this->m_linkItems.at(i)->GetId());
       }
+      delete this->m_linkItems.at(i);
+    }
+    else
+    {
+      this->m_drawLines.at(kept) = this->m_drawLines.at(i);
+      this->m_linkItems.at(kept) = this->m_linkItems.at(i);
+      kept++;
     }
   }
+  this->m_drawLines.resize(kept);
+  this->m_linkItems.resize(kept);
+
+  // clean gui, the scene repaints the removed areas at once.
+  for(std::set<std::string>::const_iterator it = removed.begin(); it != removed.end(); it++)
+  {
+    this->ReleaseObject(this->GetChildFromName(*it));
+  }
+  this->m_lastObject = NULL;
+  this->UpdateGroups();
+  this->UpdateToolTips();
+}
 
-  // remove application. 
-  std::string sender("");
-  std::string receiver("");
-  for(size_t i = 0; i < this->m_mw->GetGenerator()->GetNApplications(); i++)
+void DragWidget::UpdateToolTips()
+{
+  // the tool tips are built at the next hover.
+  this->m_adjacencyValid = false;
+}
+
+QString DragWidget::GetToolTip(const std::string &name)
+{
+  if(!this->m_adjacencyValid)
   {
-    if((child->GetName()).find("nodesGroup_") == 0)
+    this->BuildAdjacency();
+  }
+  std::string tooltip = name;
+  std::map<std::string, std::vector<std::string> >::const_iterator it = this->m_adjacency.find(name);
+  if(it != this->m_adjacency.end())
+  {
+    for(size_t i = 0; i < it->second.size(); i++)
     {
-      sender = this->m_mw->GetGenerator()->GetApplication(i)->GetSenderNode();
-      receiver = this->m_mw->GetGenerator()->GetApplication(i)->GetReceiverNode();
+      tooltip += "<br />" + it->second.at(i);
+    }
+  }
+  return QString(tooltip.c_str());
+}
 
-      if(sender.find("NodeContainer") == 0)
+void DragWidget::BuildAdjacency()
+{
+  Generator *gen = this->m_mw->GetGenerator();
+  this->m_adjacency.clear();
+
+  // addresses, with the interface of the emu and tap links.
+  std::map<std::string, std::vector<std::pair<size_t, std::string> > > addresses;
+  gen->GetAddresses(addresses);
+  for(std::map<std::string, std::vector<std::pair<size_t, std::string> > >::const_iterator it = addresses.begin();
+      it != addresses.end(); it++)
+  {
+    for(size_t i = 0; i < it->second.size(); i++)
+    {
+      NetworkHardware *link = gen->GetNetworkHardware(it->second.at(i).first);
+      std::string iface("");
+      if(link->GetNetworkHardwareName().find("emu_") == 0)
       {
-        sender = sender.substr((sender.find_first_of("(") + 1), (sender.find_first_of(".") - sender.find_first_of("(") - 1));
+        iface = " (" + dynamic_cast<Emu*>(link)->GetIfaceName() + ")";
       }
-      if(receiver.find("NodeContainer") == 0)
+      else if(link->GetNetworkHardwareName().find("tap_") == 0)
       {
-        receiver = receiver.substr(receiver.find_first_of("(") + 1, (receiver.find_first_of(".") - receiver.find_first_of("(") - 1));
+        iface = " (" + dynamic_cast<Tap*>(link)->GetIfaceName() + ")";
       }
+      this->m_adjacency[it->first].push_back(it->second.at(i).second + iface);
     }
-    else
-    {
-      sender = this->m_mw->GetGenerator()->GetApplication(i)->GetSenderNode();
-      receiver = this->m_mw->GetGenerator()->GetApplication(i)->GetReceiverNode(); 
-    }
+  }
 
-    if(child->GetName() == sender || child->GetName() == receiver )
+  // applications
+  for(size_t i = 0; i < gen->GetNApplications(); i++)
+  {
+    Application *app = gen->GetApplication(i);
+    this->m_adjacency[app->GetSenderNode()].push_back("Sender on " + app->GetAppName());
+    if(app->GetReceiverNode() != app->GetSenderNode())
     {
-      this->m_mw->GetGenerator()->RemoveApplication(this->m_mw->GetGenerator()->GetApplication(i)->GetAppName());
+      this->m_adjacency[app->GetReceiverNode()].push_back("Receiver on " + app->GetAppName());
     }
   }
-
-  // clean gui
-  this->UpdateToolTips();
-  child->clear();
-  child->Destroy();
-
-  this->m_mw->m_delAction->setDisabled(true);
+  this->m_adjacencyValid = true;
 }
 
-void DragWidget::UpdateToolTips()
+bool DragWidget::viewportEvent(QEvent *event)
 {
-  // Get all equipements on the drag n drop zone
-  for(size_t i = 0; i < (size_t)this->children().size(); i++)
+  if(event->type() == QEvent::ToolTip)
   {
-    DragObject *child = dynamic_cast<DragObject*>(this->children().at(i));
+    QHelpEvent *help = static_cast<QHelpEvent*>(event);
+    DragObject *child = NULL;
+    DragLink *link = NULL;
+    this->FindAt(help->pos(), child, link);
     if(child)
     {
-      if(child->GetName() != "deleted")
-      {
-        // start build new tool tip text !
-        std::string new_tooltip = child->GetName();
-        std::vector<std::string> connectedTo;
-        bool isConnected = false;
-        for(size_t i = 0; i < this->m_mw->GetGenerator()->GetNNetworkHardwares(); i++)
-        {
-          for(size_t j = 0; j < this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetInstalledNodes().size(); j++)
-          {
-            if( this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetInstalledNodes().at(j) == child->GetName() )
-            {
-              std::string iface("");
-              isConnected = true;
-              if(this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetNetworkHardwareName().find("emu_") == 0) 
-              {
-                iface = " (" + dynamic_cast<Emu*>(this->m_mw->GetGenerator()->GetNetworkHardware(i))->GetIfaceName() + ")";
-              }
-              else if( this->m_mw->GetGenerator()->GetNetworkHardware(i)->GetNetworkHardwareName().find("tap_") == 0)
-              {
-                iface = " (" + dynamic_cast<Tap*>(this->m_mw->GetGenerator()->GetNetworkHardware(i))->GetIfaceName() + ")";
-              }
-              
-              connectedTo.push_back("10.0." + utils::integerToString(i) + "." + utils::integerToString(j + 1) + iface);
-            }
-          }
-        }
-        if(isConnected)
-        {
-          for(size_t i = 0; i < connectedTo.size(); i++)
-          {
-            new_tooltip += "<br />"+connectedTo.at(i);
-          }
-        }
-
-        for(size_t i = 0;  i < this->m_mw->GetGenerator()->GetNApplications(); i++)
-        {
-          if(this->m_mw->GetGenerator()->GetApplication(i)->GetSenderNode() == child->GetName())
-          {
-            new_tooltip += "<br />Sender on " + this->m_mw->GetGenerator()->GetApplication(i)->GetAppName();
-          }
-          else if(this->m_mw->GetGenerator()->GetApplication(i)->GetReceiverNode() == child->GetName())
-          {
-            new_tooltip += "<br />Receiver on " + this->m_mw->GetGenerator()->GetApplication(i)->GetAppName();
-          }
-        }
-
-        child->SetToolTipText(QString(new_tooltip.c_str()));
-        child->setToolTip(QString(new_tooltip.c_str()));
-      }
+      QToolTip::showText(help->globalPos(), this->GetToolTip(child->GetName()), viewport());
+    }
+    else
+    {
+      QToolTip::hideText();
+      event->ignore();
     }
+    return true;
   }
+  return QGraphicsView::viewportEvent(event);
 }
 
 
@@ -873,6 +1158,10 @@ bool DragWidget::GetTraceNetworkHardware()
 void DragWidget::SetTraceNetworkHardware(const bool &state)
 {
   this->m_traceNetworkHardware = state;
+  if(!state)
+  {
+    this->m_traceLine->hide();
+  }
 }
 
 void DragWidget::SetNetworkHardwareBegin(const std::string &linkBegin)
@@ -905,3 +1194,110 @@ std::string DragWidget::GetNetworkHardwareType() const
   return this->m_networkHardwareType;
 }
 
+void DragWidget::Layout(const bool &tree)
+{
+  this->StopLayout();
+  std::vector<DragObject*> objects = this->GetObjects();
+  if(objects.size() == 0)
+  {
+    return;
+  }
+
+  // ideal distance between two connected objects.
+  this->m_layout = new LayoutEngine(120);
+  std::map<std::string, size_t> nodes;
+  for(size_t i = 0; i < objects.size(); i++)
+  {
+    nodes[objects.at(i)->GetName()] = this->m_layout->AddNode(objects.at(i)->pos().x(), objects.at(i)->pos().y());
+    this->m_layoutNames.push_back(objects.at(i)->GetName());
+  }
+  for(size_t i = 0; i < this->m_drawLines.size(); i++)
+  {
+    std::map<std::string, size_t>::const_iterator first = nodes.find(this->m_drawLines.at(i).GetFirst());
+    std::map<std::string, size_t>::const_iterator second = nodes.find(this->m_drawLines.at(i).GetSecond());
+    if(first != nodes.end() && second != nodes.end())
+    {
+      this->m_layout->AddEdge(first->second, second->second);
+    }
+  }
+
+  if(tree)
+  {
+    // the network hardwares are the inner nodes of the trees, the routers the top.
+    const char *prefixes[] = {"router_", "bridge_", "hub_", "ap_"};
+    std::vector<size_t> roots;
+    for(size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++)
+    {
+      for(size_t j = 0; j < this->m_layoutNames.size(); j++)
+      {
+        if(this->m_layoutNames.at(j).find(prefixes[i]) == 0)
+        {
+          roots.push_back(j);
+        }
+      }
+    }
+    this->m_layout->TreeLayout(roots);
+    this->ApplyLayout();
+    this->StopLayout();
+    return;
+  }
+
+  this->m_layoutIteration = 0;
+  this->m_layout->Start(300);
+  this->m_layoutTimer->start(100);
+}
+
+void DragWidget::StopLayout()
+{
+  this->m_layoutTimer->stop();
+  if(this->m_layout)
+  {
+    this->m_mw->GetAutosave()->Move(this->m_layoutNames);
+  }
+  delete this->m_layout;
+  this->m_layout = NULL;
+  this->m_layoutNames.clear();
+}
+
+void DragWidget::UpdateLayout()
+{
+  if(!this->m_layout)
+  {
+    this->m_layoutTimer->stop();
+    return;
+  }
+  // read the state first, the last iteration is then published when it is stopped.
+  bool running = this->m_layout->IsRunning();
+  size_t iteration = this->m_layout->GetIteration();
+  if(iteration != this->m_layoutIteration)
+  {
+    this->m_layoutIteration = iteration;
+    this->ApplyLayout();
+  }
+  if(!running)
+  {
+    this->StopLayout();
+  }
+}
+
+void DragWidget::ApplyLayout()
+{
+  std::vector<double> x, y;
+  this->m_layout->GetPositions(x, y);
+  if(x.size() == 0)
+  {
+    return;
+  }
+
+  // the objects stay at a positive position, keep the default margin.
+  double minX = *std::min_element(x.begin(), x.end());
+  double minY = *std::min_element(y.begin(), y.end());
+  for(size_t i = 0; i < x.size(); i++)
+  {
+    DragObject *child = this->GetChildFromName(this->m_layoutNames.at(i));
+    if(child)
+    {
+      child->setPos(x.at(i) - minX + 10, y.at(i) - minY + 10);
+    }
+  }
+}
@@ -28,32 +28,50 @@
 #ifndef DRAG_WIDGET_H
 #define DRAG_WIDGET_H
 
-#include <QFrame>
+#include <map>
 #include <vector>
 #include <QtWidgets>
 
 class DragObject;
+class DragLink;
+class SpatialGrid;
+class LayoutEngine;
 class MainWindow;
 class DragLines;
 
-class QDragEnterEvent;
-class QDropEvent;
-
 
 #include "drag-object.h"
 #include "drag-lines.h"
+#include "object-pool.h"
 
 /**
  * \ingroup generator
  * \brief The drag ne drop zone.
  *
- * This class create the drag n drop zone.
+ * This class create the drag n drop zone. The objects are items of a
+ * graphics scene indexed by a BSP tree, so only the visible ones are
+ * painted. The objects and the links are also kept in a spatial grid
+ * which answers the clicks, the hover and the area selection, and gives
+ * the visible links. The wheel zooms and the middle button pans the view.
+ * Zoomed out, the links are bundled and the objects become dots, then a
+ * density heat map. The context menu of a network hardware collapses the
+ * objects connected to it into a single glyph. Ctrl-click, the area
+ * selection and the context menu select several objects, which are deleted
+ * together. The deleted objects leave the scene and are reused by the next
+ * created ones. The objects can be laid out
+ * automatically, the force-directed layout runs in a background thread and
+ * the view follows its iterations.
  */
-class DragWidget : public QWidget
+class DragWidget : public QGraphicsView
 {
   Q_OBJECT
 
   public:
+    /**
+     * \brief Largest number of objects kept for reuse after their deletion.
+     */
+    static const size_t POOL_SIZE;
+
     /**
      * \brief Constructor.
      * \param parent 
@@ -136,9 +154,22 @@ class DragWidget : public QWidget
     /**
      * \brief Get the child object from his name.
      * \param name name of the object to find
+     * \return object or NULL if not found
      */
     DragObject* GetChildFromName(const std::string &name);
 
+    /**
+     * \brief Get the objects of the scene.
+     * \return objects
+     */
+    std::vector<DragObject*> GetObjects();
+
+    /**
+     * \brief Render the whole scene.
+     * \return picture of the scene
+     */
+    QImage GetPicture();
+
     /**
      * \brief Add draw line.
      * \param dl drag line to add
@@ -156,7 +187,7 @@ class DragWidget : public QWidget
      * \brief Get draw lines.
      * \return drawLines
      */
-    std::vector<DragLines> GetDrawLines();
+    const std::vector<DragLines>& GetDrawLines() const;
     
     /**
      * \brief Erase the index drag lines.
@@ -168,23 +199,42 @@ class DragWidget : public QWidget
      * \brief Draw the link.
      */
     void DrawLines();
-  
+
     /**
-     * \brief Paint widget.
-     * \param event event from Qt
+     * \brief Delete the selected objects, else the last selected element.
      */
-    void paintEvent(QPaintEvent *event);
+    void DeleteSelected();
 
     /**
-     * \brief Delete the last selected element.
+     * \brief Select the objects of a type.
+     * \param prefix name prefix of the type ("router_", ..., empty for all)
      */
-    void DeleteSelected();
+    void SelectType(const std::string &prefix);
 
     /**
-     * \brief Update all tool tip text from all equipements.
+     * \brief Mark the tool tips out of date after a change of the topology.
+     *
+     *  Nothing is computed here, the index of the addresses and applications
+     *  of the objects is rebuilt at the next hover.
      */
     void UpdateToolTips();
 
+    /**
+     * \brief Lay out the objects.
+     *
+     *  The tree layout puts the routers, then the switches, hubs and access
+     *  points at the top of the trees. The force-directed layout runs in
+     *  background, the objects move after each iteration.
+     *
+     * \param tree true for the tree layout, false for the force-directed one
+     */
+    void Layout(const bool &tree);
+
+    /**
+     * \brief Stop the force-directed layout, the objects stay where they are.
+     */
+    void StopLayout();
+
      /**
      * \brief Application server node name.
      */
@@ -218,9 +268,64 @@ class DragWidget : public QWidget
 
   private:
     /**
-     * \brief last position of last object which moved.
-     */ 
-    QPoint m_lastPosition;
+     * \brief Scene of the objects and links.
+     */
+    QGraphicsScene *m_scene;
+
+    /**
+     * \brief Objects of the scene by name.
+     */
+    std::map<std::string, DragObject*> m_objects;
+
+    /**
+     * \brief Spatial grid of the objects and links.
+     */
+    SpatialGrid *m_grid;
+
+    /**
+     * \brief Next id into the grid.
+     */
+    size_t m_nextId;
+
+    /**
+     * \brief Objects by grid id.
+     */
+    std::map<size_t, DragObject*> m_idObjects;
+
+    /**
+     * \brief Links by grid id.
+     */
+    std::map<size_t, DragLink*> m_idLinks;
+
+    /**
+     * \brief Bundled edges by pen width, for m_bundleSide and m_bundleRevision.
+     */
+    std::map<int, QVector<QLineF> > m_bundles;
+
+    /**
+     * \brief Side of the bundled areas of m_bundles (0 if not computed).
+     */
+    double m_bundleSide;
+
+    /**
+     * \brief Segment revision of the grid when m_bundles was computed.
+     */
+    size_t m_bundleRevision;
+
+    /**
+     * \brief Objects of the deleted ones, out of the scene, ready for reuse.
+     */
+    ObjectPool<DragObject> m_pool;
+
+    /**
+     * \brief Collapsed groups with their members names at the collapse.
+     */
+    std::map<std::string, std::vector<std::string> > m_groups;
+
+    /**
+     * \brief Last selected object.
+     */
+    DragObject *m_lastObject;
     
     /**
      * \brief last selected line boolean
@@ -232,11 +337,6 @@ class DragWidget : public QWidget
      */
     DragLines m_lastLine;
  
-    /**
-     * \brief Timer to refresh a line draw.
-     */
-    QTimer *m_timer;
-
     /**
      * \brief If we trace link or not.
      */
@@ -267,32 +367,241 @@ class DragWidget : public QWidget
      */
     std::vector<DragLines> m_drawLines;
 
+    /**
+     * \brief Items of the lines, NULL if an object of the line is not on the scene.
+     */
+    std::vector<DragLink*> m_linkItems;
+
+    /**
+     * \brief Line drawn to the cursor while tracing a link.
+     */
+    QGraphicsLineItem *m_traceLine;
+
+    /**
+     * \brief If the view is panned.
+     */
+    bool m_pan;
+
+    /**
+     * \brief Last position of the cursor while panning.
+     */
+    QPoint m_panPosition;
+
+    /**
+     * \brief If the cursor is over an object or a link.
+     */
+    bool m_hover;
+
+    /**
+     * \brief Area selection band.
+     */
+    QRubberBand *m_rubberBand;
+
+    /**
+     * \brief Start of the area selection.
+     */
+    QPoint m_rubberOrigin;
+
+    /**
+     * \brief Position of the last mouse press (a release elsewhere is a move).
+     */
+    QPoint m_pressPos;
+
+    /**
+     * \brief Tool tip lines (addresses, applications) of each object.
+     */
+    std::map<std::string, std::vector<std::string> > m_adjacency;
+
+    /**
+     * \brief If the tool tip lines are up to date.
+     */
+    bool m_adjacencyValid;
+
+    /**
+     * \brief Build the tool tip lines of all objects, in one pass on the links and applications.
+     */
+    void BuildAdjacency();
+
+    /**
+     * \brief Get the tool tip of an object.
+     * \param name object name
+     * \return tool tip text
+     */
+    QString GetToolTip(const std::string &name);
+
+    /**
+     * \brief Layout in progress (NULL if none).
+     */
+    LayoutEngine *m_layout;
+
+    /**
+     * \brief Names of the objects, in the layout node order.
+     */
+    std::vector<std::string> m_layoutNames;
+
+    /**
+     * \brief Last layout iteration shown.
+     */
+    size_t m_layoutIteration;
+
+    /**
+     * \brief Timer of the layout progress, it only runs during a layout.
+     */
+    QTimer *m_layoutTimer;
+
+    /**
+     * \brief Move the objects to the last layout positions.
+     */
+    void ApplyLayout();
+
+    /**
+     * \brief Create the item of a line.
+     * \param dl drag line
+     * \return link item or NULL if an object of the line is not on the scene
+     */
+    DragLink* CreateLink(const DragLines &dl);
+
+    /**
+     * \brief Draw the links of an area, grouped by pen.
+     * \param painter painter (in scene coordinates)
+     * \param rect area to draw (in scene coordinates)
+     */
+    void DrawLinks(QPainter *painter, const QRectF &rect);
+
+    /**
+     * \brief Draw the links as bundled edges (far zoom).
+     *
+     *  The bundles are computed over all the links, so an edge has the same
+     *  width in every repainted area, and kept until a link or the zoom
+     *  changes.
+     *
+     * \param painter painter (in scene coordinates)
+     * \param lod zoom level
+     */
+    void DrawBundles(QPainter *painter, const double &lod);
+
+    /**
+     * \brief Compute the bundled edges of all the links.
+     * \param side side of the bundled areas (in scene coordinates)
+     * \return edges by pen width
+     */
+    std::map<int, QVector<QLineF> > ComputeBundles(const double &side);
+
+    /**
+     * \brief Draw the object density heat map (farthest zoom).
+     * \param painter painter (in scene coordinates)
+     * \param rect area to draw (in scene coordinates)
+     * \param lod zoom level
+     */
+    void DrawDensity(QPainter *painter, const QRectF &rect, const double &lod);
+
+    /**
+     * \brief Get the names of the objects connected to a network hardware.
+     * \param name network hardware name
+     * \return names (empty if it is not a network hardware)
+     */
+    std::vector<std::string> GetGroupMembers(const std::string &name);
+
+    /**
+     * \brief Collapse the objects connected to a network hardware object.
+     * \param group network hardware object
+     */
+    void CollapseGroup(DragObject *group);
+
+    /**
+     * \brief Expand a collapsed group.
+     * \param group group object
+     */
+    void ExpandGroup(DragObject *group);
+
+    /**
+     * \brief Collapse again the groups whose members changed.
+     */
+    void UpdateGroups();
+
+    /**
+     * \brief Find the object or the link under a position.
+     * \param pos position (in view coordinates)
+     * \param object object found (output, NULL if none)
+     * \param link link found (output, NULL if none)
+     */
+    void FindAt(const QPoint &pos, DragObject *&object, DragLink *&link);
+
+    /**
+     * \brief Select the objects of an area.
+     * \param area area (in scene coordinates)
+     * \param extend true to add them to the selection (ctrl)
+     */
+    void SelectIn(const QRectF &area, const bool &extend);
+
+    /**
+     * \brief Delete objects with their links, lines and applications.
+     *
+     *  The generator removes them in a single pass and the lines are
+     *  filtered once, so deleting a subnet costs the same as one object.
+     *
+     * \param names names of the objects
+     */
+    void DeleteObjects(const std::vector<std::string> &names);
+
+    /**
+     * \brief Remove an object from the scene and the indexes, and pool it.
+     * \param child object
+     */
+    void ReleaseObject(DragObject *child);
+
     /**
      * \brief Get name of the last selected equipment.
      * \return last selected name.
      */
     std::vector<std::string> GetLastSelected();
 
+  private slots:
+    /**
+     * \brief Show the progress of the force-directed layout.
+     */
+    void UpdateLayout();
+
   protected:
     /**
      * \brief See Qt doc.
      */
-    void dragEnterEvent(QDragEnterEvent *event);
+    void mousePressEvent(QMouseEvent *event);
 
     /**
      * \brief See Qt doc.
      */
-    void dropEvent(QDropEvent *event);
+    void mouseMoveEvent(QMouseEvent *event);
 
     /**
      * \brief See Qt doc.
      */
-    void mousePressEvent(QMouseEvent *event);
+    void mouseReleaseEvent(QMouseEvent *event);
 
     /**
      * \brief See Qt doc.
      */
-    void mouseMoveEvent(QMouseEvent *event);
+    void wheelEvent(QWheelEvent *event);
+
+    /**
+     * \brief See Qt doc.
+     */
+    void drawBackground(QPainter *painter, const QRectF &rect);
+
+    /**
+     * \brief See Qt doc.
+     */
+    void drawForeground(QPainter *painter, const QRectF &rect);
+
+    /**
+     * \brief See Qt doc.
+     */
+    void contextMenuEvent(QContextMenuEvent *event);
+
+    /**
+     * \brief See Qt doc (shows the tool tip of the object under the cursor).
+     */
+    bool viewportEvent(QEvent *event);
 
 };
 
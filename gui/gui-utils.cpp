@@ -50,23 +50,17 @@ void saveXml(QXmlStreamWriter *writer, Generator *gen, DragWidget *dw)
   writer->writeStartElement("Nodes");//<Nodes>
   for(size_t i = 0; i < gen->GetNNodes(); i++)
   { 
-    for(size_t j = 0; j < (size_t)dw->children().size(); j++)
+    DragObject *child = dw->GetChildFromName(gen->GetNode(i)->GetNodeName());
+    if(child && child->GetName() != "")
     {
-      DragObject *child = dynamic_cast<DragObject*>(dw->children().at(j));
-      if(child)
-      {
-        if(child->GetName() == gen->GetNode(i)->GetNodeName() && child->GetName() != "" && child->GetName() != "deleted")
-        {
-          writer->writeStartElement("node");//<node>
-          writer->writeTextElement("type", QString((gen->GetNode(i)->GetNodeType()).c_str()));
-          writer->writeTextElement("nodeNbr", QString((utils::integerToString(gen->GetNode(i)->GetMachinesNumber())).c_str()));
-          writer->writeTextElement("name", QString((gen->GetNode(i)->GetNodeName()).c_str()));
-          writer->writeTextElement("nsc", QString((gen->GetNode(i)->GetNsc()).c_str()));
-          writer->writeTextElement("x", QString((utils::integerToString(child->pos().x())).c_str()));
-          writer->writeTextElement("y", QString((utils::integerToString(child->pos().y())).c_str())); 
-          writer->writeEndElement();//</node>
-        }
-      }
+      writer->writeStartElement("node");//<node>
+      writer->writeTextElement("type", QString((gen->GetNode(i)->GetNodeType()).c_str()));
+      writer->writeTextElement("nodeNbr", QString((utils::integerToString(gen->GetNode(i)->GetMachinesNumber())).c_str()));
+      writer->writeTextElement("name", QString((gen->GetNode(i)->GetNodeName()).c_str()));
+      writer->writeTextElement("nsc", QString((gen->GetNode(i)->GetNsc()).c_str()));
+      writer->writeTextElement("x", QString((utils::integerToString((size_t)child->pos().x())).c_str()));
+      writer->writeTextElement("y", QString((utils::integerToString((size_t)child->pos().y())).c_str())); 
+      writer->writeEndElement();//</node>
     }
   }
   writer->writeEndElement();//<Nodes>
@@ -78,21 +72,10 @@ void saveXml(QXmlStreamWriter *writer, Generator *gen, DragWidget *dw)
   writer->writeStartElement("NetworkHardwares");//<NetworkHardwares>
   for(size_t i = 0; i < gen->GetNNetworkHardwares(); i++)
   {
-    hidden = true;
     writer->writeStartElement("networkHardware");//<networkHardware>
     // check if link is hidden or not.
-    for(size_t j = 0; j < (size_t)dw->children().size(); j++)
-    {
-      DragObject *child = dynamic_cast<DragObject*>(dw->children().at(j));
-      if(child)
-      {
-        if(child->GetName() == gen->GetNetworkHardware(i)->GetNetworkHardwareName())
-        {
-          hidden = false;
-          break;
-        }
-      }
-    }
+    DragObject *child = dw->GetChildFromName(gen->GetNetworkHardware(i)->GetNetworkHardwareName());
+    hidden = (child == NULL);
     if(hidden)
     {
       writer->writeTextElement("hidden", "true");
@@ -146,19 +129,8 @@ void saveXml(QXmlStreamWriter *writer, Generator *gen, DragWidget *dw)
     }
     else if(gen->GetNetworkHardware(i)->GetNetworkHardwareName().find("hub_") == 0 && !hidden)
     {
-      for(size_t j = 0; j < (size_t)dw->children().size(); j++)
-      {
-        DragObject *child = dynamic_cast<DragObject*>(dw->children().at(j));
-        if(child)
-        {
-          if(child->GetName() == gen->GetNetworkHardware(i)->GetNetworkHardwareName())
-          {
-            writer->writeTextElement("hubPos", QString( ( utils::integerToString(child->pos().x()) + "-" + 
-                                                          utils::integerToString(child->pos().y())).c_str()));
-            break;
-          }
-        }
-      }
+      writer->writeTextElement("hubPos", QString( ( utils::integerToString((size_t)child->pos().x()) + "-" + 
+                                                    utils::integerToString((size_t)child->pos().y())).c_str()));
     }
     else
     {
@@ -224,240 +196,124 @@ void saveXml(QXmlStreamWriter *writer, Generator *gen, DragWidget *dw)
   }
   writer->writeEndElement();//</Lines>
 
+  //<Simulation>
+  writer->writeStartElement("Simulation");
+  writer->writeTextElement("scheduler", QString(gen->GetScheduler().c_str()));
+  writer->writeTextElement("parameterized", QString(utils::integerToString(gen->GetParameterized()).c_str()));
+  writer->writeEndElement();//</Simulation>
+
   writer->writeEndDocument();//</Gen>
 }
 
-void loadXml(QXmlStreamReader *reader, Generator *gen, DragWidget *dw)
+void saveProject(const std::string &fileName, Generator *gen, DragWidget *dw, const std::string &codec)
 {
-  reader->readNext();
-  while(!reader->atEnd())
-  {
-    if(reader->isStartElement()) 
-    {
-      if(reader->name() == "Nodes") 
-      {
-        guiUtils::jumpToNextStartElement(reader);
-        while(reader->name() == "node")
-        {
-          guiUtils::jumpToNextStartElement(reader);
-          std::string type = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          size_t nodeNbr = utils::stringToInteger(reader->readElementText().toStdString());
-
-          gen->AddNode(type, nodeNbr);
-          
-          guiUtils::jumpToNextStartElement(reader);
-          gen->GetNode(gen->GetNNodes() - 1)->SetNodeName( (reader->readElementText()).toStdString() );
-
-          guiUtils::jumpToNextStartElement(reader);
-          gen->GetNode(gen->GetNNodes() - 1)->SetNsc( (reader->readElementText()).toStdString() );
-          
-          guiUtils::jumpToNextStartElement(reader);
-          size_t x = utils::stringToInteger((reader->readElementText()).toStdString());
-
-          guiUtils::jumpToNextStartElement(reader);
-          size_t y = utils::stringToInteger((reader->readElementText()).toStdString());
-
-          dw->CreateObject(type, gen->GetNode(gen->GetNNodes() - 1)->GetNodeName(), x, y);
-
-          guiUtils::jumpToNextStartElement(reader);
-        }
-      }
-      if(reader->name() == "NetworkHardwares")
-      {
-        guiUtils::jumpToNextStartElement(reader);
-        while(reader->name() == "networkHardware")
-        {
-          guiUtils::jumpToNextStartElement(reader);
-          std::string hiddenState = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          std::string type = reader->readElementText().toStdString();
-        
-          guiUtils::jumpToNextStartElement(reader);
-          std::string name = reader->readElementText().toStdString();
-          
-          guiUtils::jumpToNextStartElement(reader);
-          std::string dataRate = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          std::string linkDelay = reader->readElementText().toStdString();
-        
-          guiUtils::jumpToNextStartElement(reader);
-          std::string enableTrace = reader->readElementText().toStdString();
-          
-          guiUtils::jumpToNextStartElement(reader);
-          std::string tracePromisc = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          std::string special = reader->readElementText().toStdString();
-          
-          std::vector<std::string> connectedNodes;
-          guiUtils::jumpToNextStartElement(reader);
-          if(reader->name() == "connectedNodes")
-          {
-            guiUtils::jumpToNextStartElement(reader);
-            while(reader->name() == "name")
-            {
-              connectedNodes.push_back(reader->readElementText().toStdString());
-              guiUtils::jumpToNextStartElement(reader);
-            }
-          }
-          
-          if(type == "Hub" || type == "PointToPoint")
-          {
-            gen->AddNetworkHardware(type);
-          }
-          else if(type == "Bridge" || type == "Ap")
-          {
-            gen->AddNetworkHardware(type, name);
-          } 
-          else // Emu, Tap
-          {
-            gen->AddNetworkHardware(type, name, special);
-          }
-        
-          gen->GetNetworkHardware(gen->GetNNetworkHardwares() - 1)->SetNetworkHardwareName(name);
-          gen->GetNetworkHardware(gen->GetNNetworkHardwares() - 1)->SetDataRate(dataRate);
-          gen->GetNetworkHardware(gen->GetNNetworkHardwares() - 1)->SetNetworkHardwareDelay(linkDelay);
-        
-          if(enableTrace == "true")
-          {
-            gen->GetNetworkHardware(gen->GetNNetworkHardwares() - 1)->SetTrace(true);
-          }
-          if(tracePromisc == "true")
-          {
-            gen->GetNetworkHardware(gen->GetNNetworkHardwares() - 1)->SetPromisc(true);
-          }
-
-          for(size_t i = 0; i < connectedNodes.size(); i++)
-          {
-            gen->GetNetworkHardware(gen->GetNNetworkHardwares() - 1)->Install(connectedNodes.at(i));
-          }
-        
-          if(hiddenState == "false" && type != "Emu" && type != "Tap" && type != "Ap" && type != "Bridge")
-          {
-            if(type == "Hub")
-            {
-              std::vector<std::string> vec;
-              utils::split(vec, special, '-');
-              dw->CreateObject(type, name, utils::stringToInteger(vec.at(0)), utils::stringToInteger(vec.at(1)));
-            }
-            else
-            {
-              dw->CreateObject(type, name);
-            }
-          }
-        }
-      }
-      if(reader->name() == "Applications")
-      {
-        guiUtils::jumpToNextStartElement(reader);
-        while(reader->name() == "application")
-        {
-          guiUtils::jumpToNextStartElement(reader);
-          std::string type = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          std::string name = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          std::string sender = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          std::string receiver = reader->readElementText().toStdString();
-
-          guiUtils::jumpToNextStartElement(reader);
-          size_t startTime = utils::stringToInteger(reader->readElementText().toStdString());
-          
-          guiUtils::jumpToNextStartElement(reader);
-          size_t endTime = utils::stringToInteger(reader->readElementText().toStdString());
-
-          guiUtils::jumpToNextStartElement(reader);
-          size_t port = 0;
-          size_t packetSize = 0;
-          size_t maxPacketCount = 0;
-          std::string packetIntervalTime = "";
-          if(reader->name() == "special")
-          {
-            guiUtils::jumpToNextStartElement(reader);
-            if(type == "TcpLargeTransfer")
-            {
-              port = utils::stringToInteger(reader->readElementText().toStdString());
-            }
-            else if(type == "UdpEcho")
-            {
-              port = utils::stringToInteger(reader->readElementText().toStdString());
-              
-              guiUtils::jumpToNextStartElement(reader);
-              packetSize = utils::stringToInteger(reader->readElementText().toStdString());
-
-              guiUtils::jumpToNextStartElement(reader);
-              maxPacketCount = utils::stringToInteger(reader->readElementText().toStdString());
-              
-              guiUtils::jumpToNextStartElement(reader);
-              packetIntervalTime = reader->readElementText().toStdString();
-            }
-          }
-  
-          if(type == "Ping")
-          {
-            gen->AddApplication(type, sender, receiver, startTime, endTime);
-          }
-          else if(type == "UdpEcho")
-          {
-            gen->AddApplication(type, sender, receiver, startTime, endTime, port);
-            UdpEcho *udp = dynamic_cast<UdpEcho*>(gen->GetApplication(gen->GetNApplications() - 1));
-            udp->SetPacketSize(packetSize);
-            udp->SetMaxPacketCount(maxPacketCount);
-            udp->SetPacketIntervalTime(packetIntervalTime);
-          }
-          else if(type == "TcpLargeTransfer")
-          {
-            gen->AddApplication(type, sender, receiver, startTime, endTime, port);
-          }
-
+  ProjectFile project;
 
-          if(type != "Ping")
-          {
-            guiUtils::jumpToNextStartElement(reader);
-          }
-        }
-      }
-      if(reader->name() == "Lines")
-      {
-        guiUtils::jumpToNextStartElement(reader);
-        while(reader->name() == "line")
-        {
-          DragLines dg;
-
-          guiUtils::jumpToNextStartElement(reader);
-          dg.SetFirst(reader->readElementText().toStdString());
-
-          guiUtils::jumpToNextStartElement(reader);
-          dg.SetSecond(reader->readElementText().toStdString());
+  ProjectFile::Node node;
+  for(size_t i = 0; i < gen->GetNNodes(); i++)
+  { 
+    if(guiUtils::nodeRecord(gen, dw, i, node))
+    {
+      project.AddNode(node);
+    }
+  }
+  for(size_t i = 0; i < gen->GetNNetworkHardwares(); i++)
+  {
+    project.AddLink(guiUtils::linkRecord(gen, dw, i));
+  }
+  for(size_t i = 0; i < gen->GetNApplications(); i++)
+  {
+    project.AddApplication(guiUtils::applicationRecord(gen, i));
+  }
+  for(size_t i = 0; i < dw->GetDrawLines().size(); i++)
+  {
+    ProjectFile::Line line;
+    line.first = dw->GetDrawLine(i).GetFirst();
+    line.second = dw->GetDrawLine(i).GetSecond();
+    line.type = dw->GetDrawLine(i).GetNetworkHardwareType();
+    project.AddLine(line);
+  }
 
-          guiUtils::jumpToNextStartElement(reader);
-          dg.SetNetworkHardwareType(reader->readElementText().toStdString());
+  project.SetScheduler(gen->GetScheduler());
+  project.SetParameterized(gen->GetParameterized());
+  project.Write(fileName, codec);
+}
 
-          dw->AddDrawLine(dg);
+bool nodeRecord(Generator *gen, DragWidget *dw, const size_t &index, ProjectFile::Node &node)
+{
+  DragObject *child = dw->GetChildFromName(gen->GetNode(index)->GetNodeName());
+  if(!child || child->GetName() == "")
+  {
+    return false;
+  }
+  node.type = gen->GetNode(index)->GetNodeType();
+  node.number = gen->GetNode(index)->GetMachinesNumber();
+  node.name = gen->GetNode(index)->GetNodeName();
+  node.nsc = gen->GetNode(index)->GetNsc();
+  node.x = (size_t)child->pos().x();
+  node.y = (size_t)child->pos().y();
+  return true;
+}
 
-          guiUtils::jumpToNextStartElement(reader);
-        }
-      }
-    }
-    reader->readNext();
+ProjectFile::Link linkRecord(Generator *gen, DragWidget *dw, const size_t &index)
+{
+  NetworkHardware *hardware = gen->GetNetworkHardware(index);
+  DragObject *child = dw->GetChildFromName(hardware->GetNetworkHardwareName());
+  ProjectFile::Link link;
+  link.hidden = (child == NULL);
+  link.type = hardware->GetLinkType();
+  link.name = hardware->GetNetworkHardwareName();
+  link.dataRate = hardware->GetDataRate();
+  link.delay = hardware->GetNetworkHardwareDelay();
+  link.trace = hardware->GetTrace();
+  link.promisc = hardware->GetPromisc();
+  // same special configs as the xml file
+  if(link.name.find("ap_") == 0)
+  {
+    link.special = dynamic_cast<Ap*>(hardware)->GetMobility() ? "true" : "false";
+  }
+  else if(link.name.find("emu_") == 0)
+  {
+    link.special = dynamic_cast<Emu*>(hardware)->GetIfaceName();
+  }
+  else if(link.name.find("tap_") == 0)
+  {
+    link.special = dynamic_cast<Tap*>(hardware)->GetIfaceName();
+  }
+  else if(link.name.find("hub_") == 0 && !link.hidden)
+  {
+    link.special = utils::integerToString((size_t)child->pos().x()) + "-" + utils::integerToString((size_t)child->pos().y());
   }
+  link.members = hardware->GetInstalledNodes();
+  return link;
 }
 
-void jumpToNextStartElement(QXmlStreamReader *reader)
+ProjectFile::Application applicationRecord(Generator *gen, const size_t &index)
 {
-  reader->readNext();
-  while(!reader->isStartElement() && !reader->atEnd())
+  Application *app = gen->GetApplication(index);
+  ProjectFile::Application application;
+  application.type = app->GetApplicationType();
+  application.name = app->GetAppName();
+  application.sender = app->GetSenderNode();
+  application.receiver = app->GetReceiverNode();
+  application.startTime = app->GetStartTime();
+  application.endTime = app->GetEndTime();
+  application.port = 0;
+  application.packetSize = 0;
+  application.maxPacketCount = 0;
+  if(application.name.find("tcp_") == 0)
+  {
+    application.port = dynamic_cast<TcpLargeTransfer*>(app)->GetPort();
+  } 
+  else if(application.name.find("udpEcho_") == 0)
   {
-    reader->readNext();
+    UdpEcho *udp = dynamic_cast<UdpEcho*>(app);
+    application.port = udp->GetPort();
+    application.packetSize = udp->GetPacketSize();
+    application.maxPacketCount = udp->GetMaxPacketCount();
+    application.packetIntervalTime = udp->GetPacketIntervalTime();
   }
+  return application;
 }
 
 bool isNetworkHardware(const std::string &equipement)
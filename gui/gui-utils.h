@@ -31,6 +31,7 @@
 #include <QtWidgets>
 
 #include "generator.h"
+#include "project-file.h"
 #include "drag-widget.h"
 
 /**
@@ -49,18 +50,40 @@ namespace guiUtils
 void saveXml(QXmlStreamWriter *writer, Generator *gen, DragWidget *dw);
 
 /**
- * \brief Load an xml file into the generator.
- * \param reader the xml reader
+ * \brief Write a binary project file, with the same content as the xml file.
+ * \param fileName the project file name
  * \param gen the generator object
  * \param dw the drag widget object
+ * \param codec codec name of a compressed project (empty for a plain one)
  */
-void loadXml(QXmlStreamReader *reader, Generator *gen, DragWidget *dw);
+void saveProject(const std::string &fileName, Generator *gen, DragWidget *dw, const std::string &codec = "");
 
 /**
- * \brief Procedure used to parse xml file.
- * \param reader the qt xml reader object
+ * \brief Build the record of a node, as saved into the project files.
+ * \param gen the generator object
+ * \param dw the drag widget object
+ * \param index node index
+ * \param node the node record (output)
+ * \return false if the node is not saved (it has no canvas object)
+ */
+bool nodeRecord(Generator *gen, DragWidget *dw, const size_t &index, ProjectFile::Node &node);
+
+/**
+ * \brief Build the record of a network hardware, as saved into the project files.
+ * \param gen the generator object
+ * \param dw the drag widget object
+ * \param index network hardware index
+ * \return link record
+ */
+ProjectFile::Link linkRecord(Generator *gen, DragWidget *dw, const size_t &index);
+
+/**
+ * \brief Build the record of an application, as saved into the project files.
+ * \param gen the generator object
+ * \param index application index
+ * \return application record
  */
-void jumpToNextStartElement(QXmlStreamReader *reader);
+ProjectFile::Application applicationRecord(Generator *gen, const size_t &index);
 
 /**
  * \brief Function used to test if an equipement is an NetworkHardware member.
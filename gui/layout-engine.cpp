@@ -0,0 +1,502 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file layout-engine.cpp
+ * \brief Automatic layout of the canvas objects.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "layout-engine.h"
+
+namespace
+{
+  /* largest number of points of a quadtree leaf. */
+  const size_t LEAF_SIZE = 8;
+  /* depth limit of the quadtree (many nodes at almost the same position). */
+  const size_t MAX_DEPTH = 24;
+  /* a cell seen under an angle smaller than THETA acts as a single mass. */
+  const double THETA = 1.0;
+  /* avoids the division by zero of two nodes at the same position. */
+  const double EPSILON = 1e-6;
+  /* temperature decrease of each iteration. */
+  const double COOLING = 0.97;
+  /* the background thread stops when no node moves more. */
+  const double MIN_MOVE = 0.5;
+  /* below, the iterations stay in the calling thread. */
+  const size_t NODES_BY_THREAD = 1024;
+  /* 180 * (3 - sqrt (5)) degrees, in radian. */
+  const double GOLDEN_ANGLE = 2.39996322972865332;
+}
+
+LayoutEngine::LayoutEngine(const double &edgeLength)
+{
+  if(edgeLength <= 0)
+  {
+    throw std::logic_error("Layout failed! (edge length must be positive).");
+  }
+  this->m_edgeLength = edgeLength;
+  this->m_temperature = -1;
+  this->m_threads = 1;
+  this->m_running = false;
+  this->m_stop = false;
+  this->m_iteration = 0;
+  this->SetThreads(0);
+}
+
+LayoutEngine::~LayoutEngine()
+{
+  this->Stop();
+}
+
+size_t LayoutEngine::AddNode(const double &x, const double &y)
+{
+  this->CheckStopped();
+  this->m_x.push_back(x);
+  this->m_y.push_back(y);
+  this->m_adjacency.push_back(std::vector<size_t>());
+  this->m_temperature = -1;
+  this->Publish();
+  return this->m_x.size() - 1;
+}
+
+void LayoutEngine::AddEdge(const size_t &a, const size_t &b)
+{
+  this->CheckStopped();
+  if(a >= this->m_x.size() || b >= this->m_x.size())
+  {
+    throw std::out_of_range("Layout failed! (unknown node).");
+  }
+  if(a == b)
+  {
+    return;
+  }
+  this->m_adjacency.at(a).push_back(b);
+  this->m_adjacency.at(b).push_back(a);
+  this->m_temperature = -1;
+}
+
+size_t LayoutEngine::GetNNodes() const
+{
+  return this->m_x.size();
+}
+
+void LayoutEngine::SetThreads(const size_t &threads)
+{
+  this->m_threads = threads;
+  if(this->m_threads == 0)
+  {
+    this->m_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+double LayoutEngine::Step()
+{
+  size_t n = this->m_x.size();
+  if(n == 0)
+  {
+    return 0;
+  }
+  if(this->m_temperature < 0)
+  {
+    this->Spread();
+    this->m_temperature = std::max(1.0, this->m_edgeLength * std::sqrt((double)n) / 10);
+  }
+
+  this->BuildTree();
+  this->m_dx.assign(n, 0);
+  this->m_dy.assign(n, 0);
+
+  /* the main thread computes the first range. */
+  size_t threads = std::max((size_t)1, std::min(this->m_threads, n / NODES_BY_THREAD));
+  std::vector<std::thread> workers;
+  for(size_t i = 1; i < threads; i++)
+  {
+    workers.push_back(std::thread(&LayoutEngine::Forces, this, n * i / threads, n * (i + 1) / threads));
+  }
+  this->Forces(0, n / threads);
+  for(size_t i = 0; i < workers.size(); i++)
+  {
+    workers.at(i).join();
+  }
+
+  double largest = 0;
+  for(size_t i = 0; i < n; i++)
+  {
+    double d = std::sqrt(this->m_dx[i] * this->m_dx[i] + this->m_dy[i] * this->m_dy[i]);
+    if(d > 0)
+    {
+      double move = std::min(d, this->m_temperature);
+      this->m_x[i] += this->m_dx[i] / d * move;
+      this->m_y[i] += this->m_dy[i] / d * move;
+      largest = std::max(largest, move);
+    }
+  }
+  this->m_temperature *= COOLING;
+  return largest;
+}
+
+void LayoutEngine::Start(const size_t &iterations)
+{
+  this->Stop();
+  this->m_stop = false;
+  this->m_running = true;
+  this->m_iteration = 0;
+  this->m_thread = std::thread(&LayoutEngine::Run, this, iterations);
+}
+
+void LayoutEngine::Stop()
+{
+  this->m_stop = true;
+  if(this->m_thread.joinable())
+  {
+    this->m_thread.join();
+  }
+  this->m_running = false;
+}
+
+bool LayoutEngine::IsRunning() const
+{
+  return this->m_running;
+}
+
+size_t LayoutEngine::GetIteration() const
+{
+  return this->m_iteration;
+}
+
+void LayoutEngine::GetPositions(std::vector<double> &x, std::vector<double> &y)
+{
+  std::lock_guard<std::mutex> lock(this->m_mutex);
+  x = this->m_publishedX;
+  y = this->m_publishedY;
+}
+
+void LayoutEngine::TreeLayout(const std::vector<size_t> &roots)
+{
+  this->CheckStopped();
+  size_t n = this->m_x.size();
+  std::vector<long> depth(n, -1);
+  std::vector<size_t> parent(n, 0);
+  std::vector<std::vector<size_t> > children(n);
+  std::vector<size_t> order;
+  std::vector<size_t> trees;
+  order.reserve(n);
+
+  /* breadth first from the roots, then from the nodes not reached. */
+  size_t head = 0;
+  for(size_t i = 0; i < roots.size() + n; i++)
+  {
+    size_t root = i < roots.size() ? roots.at(i) : i - roots.size();
+    if(root >= n)
+    {
+      throw std::out_of_range("Layout failed! (unknown root).");
+    }
+    if(depth[root] >= 0)
+    {
+      continue;
+    }
+    depth[root] = 0;
+    parent[root] = root;
+    trees.push_back(root);
+    order.push_back(root);
+    while(head < order.size())
+    {
+      size_t v = order[head++];
+      for(size_t j = 0; j < this->m_adjacency[v].size(); j++)
+      {
+        size_t w = this->m_adjacency[v][j];
+        if(depth[w] < 0)
+        {
+          depth[w] = depth[v] + 1;
+          parent[w] = v;
+          children[v].push_back(w);
+          order.push_back(w);
+        }
+      }
+    }
+  }
+
+  /* width of a subtree: its number of leaves. */
+  std::vector<double> width(n, 0);
+  for(size_t i = n; i-- > 0;)
+  {
+    size_t v = order[i];
+    width[v] = std::max(1.0, width[v]);
+    if(parent[v] != v)
+    {
+      width[parent[v]] += width[v];
+    }
+  }
+
+  std::vector<double> left(n, 0);
+  double offset = 0;
+  for(size_t i = 0; i < trees.size(); i++)
+  {
+    left[trees[i]] = offset;
+    offset += width[trees[i]] * this->m_edgeLength;
+  }
+  for(size_t i = 0; i < n; i++)
+  {
+    size_t v = order[i];
+    double cursor = left[v];
+    for(size_t j = 0; j < children[v].size(); j++)
+    {
+      left[children[v][j]] = cursor;
+      cursor += width[children[v][j]] * this->m_edgeLength;
+    }
+    this->m_x[v] = left[v] + (width[v] - 1) * this->m_edgeLength / 2;
+    this->m_y[v] = depth[v] * this->m_edgeLength;
+  }
+  this->Publish();
+}
+
+void LayoutEngine::Spread()
+{
+  size_t n = this->m_x.size();
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  const std::vector<double> &x = this->m_x;
+  const std::vector<double> &y = this->m_y;
+  std::sort(order.begin(), order.end(), [&x, &y](size_t a, size_t b)
+      {
+        return x[a] < x[b] || (x[a] == x[b] && y[a] < y[b]);
+      });
+
+  size_t first = 0;
+  for(size_t i = 1; i <= n; i++)
+  {
+    if(i < n && this->m_x[order[i]] == this->m_x[order[first]] && this->m_y[order[i]] == this->m_y[order[first]])
+    {
+      continue;
+    }
+    double cx = this->m_x[order[first]];
+    double cy = this->m_y[order[first]];
+    for(size_t k = 1; k < i - first; k++)
+    {
+      double r = this->m_edgeLength * std::sqrt((double)k) / 2;
+      this->m_x[order[first + k]] = cx + r * std::cos(k * GOLDEN_ANGLE);
+      this->m_y[order[first + k]] = cy + r * std::sin(k * GOLDEN_ANGLE);
+    }
+    first = i;
+  }
+}
+
+void LayoutEngine::BuildTree()
+{
+  size_t n = this->m_x.size();
+  double minX = *std::min_element(this->m_x.begin(), this->m_x.end());
+  double maxX = *std::max_element(this->m_x.begin(), this->m_x.end());
+  double minY = *std::min_element(this->m_y.begin(), this->m_y.end());
+  double maxY = *std::max_element(this->m_y.begin(), this->m_y.end());
+  double size = std::max(maxX - minX, maxY - minY) * (1 + EPSILON) + EPSILON;
+
+  this->m_order.resize(n);
+  std::iota(this->m_order.begin(), this->m_order.end(), 0);
+  this->m_cells.clear();
+  this->BuildCell(0, n, minX, minY, size, 0);
+
+  this->m_sx.resize(n);
+  this->m_sy.resize(n);
+  for(size_t i = 0; i < n; i++)
+  {
+    this->m_sx[i] = this->m_x[this->m_order[i]];
+    this->m_sy[i] = this->m_y[this->m_order[i]];
+  }
+}
+
+int LayoutEngine::BuildCell(const size_t &first, const size_t &count, const double &x0, const double &y0, const double &size,
+    const size_t &depth)
+{
+  Cell cell;
+  cell.cx = 0;
+  cell.cy = 0;
+  cell.mass = count;
+  cell.size = size;
+  cell.first = first;
+  cell.count = count;
+  for(size_t i = 0; i < 4; i++)
+  {
+    cell.child[i] = -1;
+  }
+  for(size_t i = first; i < first + count; i++)
+  {
+    cell.cx += this->m_x[this->m_order[i]];
+    cell.cy += this->m_y[this->m_order[i]];
+  }
+  cell.cx /= count;
+  cell.cy /= count;
+
+  int index = this->m_cells.size();
+  this->m_cells.push_back(cell);
+  if(count <= LEAF_SIZE || depth >= MAX_DEPTH)
+  {
+    return index;
+  }
+
+  /* split the range in four quadrants: left-top, left-bottom, right-top, right-bottom. */
+  double half = size / 2;
+  const std::vector<double> &x = this->m_x;
+  const std::vector<double> &y = this->m_y;
+  double midX = x0 + half;
+  double midY = y0 + half;
+  std::vector<size_t>::iterator begin = this->m_order.begin() + first;
+  std::vector<size_t>::iterator end = begin + count;
+  std::vector<size_t>::iterator right = std::partition(begin, end, [&x, midX](size_t i) { return x[i] < midX; });
+  std::vector<size_t>::iterator bounds[5];
+  bounds[0] = begin;
+  bounds[1] = std::partition(begin, right, [&y, midY](size_t i) { return y[i] < midY; });
+  bounds[2] = right;
+  bounds[3] = std::partition(right, end, [&y, midY](size_t i) { return y[i] < midY; });
+  bounds[4] = end;
+
+  for(size_t q = 0; q < 4; q++)
+  {
+    size_t quadrantCount = bounds[q + 1] - bounds[q];
+    if(quadrantCount > 0)
+    {
+      /* the recursion grows m_cells, keep the index and not a reference. */
+      int child = this->BuildCell(bounds[q] - this->m_order.begin(), quadrantCount, q < 2 ? x0 : midX,
+          q % 2 == 0 ? y0 : midY, half, depth + 1);
+      this->m_cells[index].child[q] = child;
+    }
+  }
+  return index;
+}
+
+void LayoutEngine::Forces(const size_t &begin, const size_t &end)
+{
+  const double k2 = this->m_edgeLength * this->m_edgeLength;
+  const double theta2 = THETA * THETA;
+  const double *sx = this->m_sx.data();
+  const double *sy = this->m_sy.data();
+  std::vector<int> stack;
+
+  for(size_t i = begin; i < end; i++)
+  {
+    double xi = this->m_x[i];
+    double yi = this->m_y[i];
+    double fx = 0;
+    double fy = 0;
+
+    /* repulsion k^2 / d, from the quadtree. */
+    stack.push_back(0);
+    while(!stack.empty())
+    {
+      const Cell &cell = this->m_cells[stack.back()];
+      stack.pop_back();
+      bool leaf = cell.child[0] < 0 && cell.child[1] < 0 && cell.child[2] < 0 && cell.child[3] < 0;
+      double dx = xi - cell.cx;
+      double dy = yi - cell.cy;
+      double d2 = dx * dx + dy * dy;
+      if(leaf)
+      {
+        /* near field, four independent sums so the loop has no dependency between lanes. */
+        double ax[4] = {0, 0, 0, 0};
+        double ay[4] = {0, 0, 0, 0};
+        size_t j = cell.first;
+        size_t last = cell.first + cell.count;
+        for(; j + 4 <= last; j += 4)
+        {
+          for(size_t l = 0; l < 4; l++)
+          {
+            double ddx = xi - sx[j + l];
+            double ddy = yi - sy[j + l];
+            double f = k2 / (ddx * ddx + ddy * ddy + EPSILON);
+            ax[l] += ddx * f;
+            ay[l] += ddy * f;
+          }
+        }
+        for(; j < last; j++)
+        {
+          double ddx = xi - sx[j];
+          double ddy = yi - sy[j];
+          double f = k2 / (ddx * ddx + ddy * ddy + EPSILON);
+          ax[0] += ddx * f;
+          ay[0] += ddy * f;
+        }
+        fx += (ax[0] + ax[1]) + (ax[2] + ax[3]);
+        fy += (ay[0] + ay[1]) + (ay[2] + ay[3]);
+      }
+      else if(cell.size * cell.size < theta2 * d2)
+      {
+        double f = k2 * cell.mass / d2;
+        fx += dx * f;
+        fy += dy * f;
+      }
+      else
+      {
+        for(size_t q = 0; q < 4; q++)
+        {
+          if(cell.child[q] >= 0)
+          {
+            stack.push_back(cell.child[q]);
+          }
+        }
+      }
+    }
+
+    /* attraction d^2 / k, along the edges. */
+    const std::vector<size_t> &neighbours = this->m_adjacency[i];
+    for(size_t j = 0; j < neighbours.size(); j++)
+    {
+      double dx = this->m_x[neighbours[j]] - xi;
+      double dy = this->m_y[neighbours[j]] - yi;
+      double d = std::sqrt(dx * dx + dy * dy);
+      fx += dx * d / this->m_edgeLength;
+      fy += dy * d / this->m_edgeLength;
+    }
+
+    this->m_dx[i] = fx;
+    this->m_dy[i] = fy;
+  }
+}
+
+void LayoutEngine::Run(const size_t &iterations)
+{
+  for(size_t i = 0; i < iterations && !this->m_stop; i++)
+  {
+    double move = this->Step();
+    this->Publish();
+    this->m_iteration++;
+    if(move < MIN_MOVE)
+    {
+      break;
+    }
+  }
+  this->m_running = false;
+}
+
+void LayoutEngine::Publish()
+{
+  std::lock_guard<std::mutex> lock(this->m_mutex);
+  this->m_publishedX = this->m_x;
+  this->m_publishedY = this->m_y;
+}
+
+void LayoutEngine::CheckStopped() const
+{
+  if(this->m_running)
+  {
+    throw std::logic_error("Layout failed! (layout in progress).");
+  }
+}
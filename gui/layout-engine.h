@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file layout-engine.h
+ * \brief Automatic layout of the canvas objects.
+ */
+
+#ifndef LAYOUT_ENGINE_H
+#define LAYOUT_ENGINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Automatic layout of the canvas objects.
+ *
+ * The objects are the nodes of a graph whose edges are the links. Two
+ * layouts are given:
+ *   - a force-directed one (Fruchterman-Reingold): the nodes repel each
+ *     other, the edges pull their ends together, and each iteration moves
+ *     the nodes by at most a temperature which cools down. The repulsion is
+ *     computed with a Barnes-Hut quadtree (a far cell acts as one mass at
+ *     its center), so an iteration is O(n log n) and not O(n^2),
+ *   - a tree one for the router/switch hierarchies: the nodes are put on
+ *     one row by depth from the given roots, each subtree gets a width
+ *     proportional to its number of leaves.
+ *
+ * The force iterations split the nodes between several threads, the
+ * quadtree is read-only while the forces are computed and each thread only
+ * writes the displacement of its nodes. The points of a quadtree leaf are
+ * stored contiguously, coordinate by coordinate, so the near-field kernel
+ * is a branch-free loop over two arrays.
+ *
+ * The iterations can run in a background thread (Start), the positions are
+ * then published after each iteration and read with GetPositions, so the
+ * canvas shows the layout while it converges.
+ */
+class LayoutEngine
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param edgeLength ideal edge length
+     */
+    LayoutEngine(const double &edgeLength);
+
+    /**
+     * \brief Destructor (stops the background thread).
+     */
+    ~LayoutEngine();
+
+    /**
+     * \brief Add a node.
+     * \param x position x
+     * \param y position y
+     * \return node index
+     */
+    size_t AddNode(const double &x, const double &y);
+
+    /**
+     * \brief Add an edge.
+     * \param a first node index
+     * \param b second node index
+     */
+    void AddEdge(const size_t &a, const size_t &b);
+
+    /**
+     * \brief Get the number of nodes.
+     * \return number of nodes
+     */
+    size_t GetNNodes() const;
+
+    /**
+     * \brief Set the number of threads of the force iterations.
+     * \param threads number of threads (0 for the number of cores)
+     */
+    void SetThreads(const size_t &threads);
+
+    /**
+     * \brief Run one force-directed iteration.
+     * \return largest move of a node
+     */
+    double Step();
+
+    /**
+     * \brief Run force-directed iterations in a background thread.
+     *
+     *  The thread stops after the given number of iterations, when the
+     *  nodes do not move anymore or when Stop is called.
+     *
+     * \param iterations maximum number of iterations
+     */
+    void Start(const size_t &iterations);
+
+    /**
+     * \brief Stop the background thread and wait for it.
+     */
+    void Stop();
+
+    /**
+     * \brief Check if the background thread runs.
+     * \return true if it runs
+     */
+    bool IsRunning() const;
+
+    /**
+     * \brief Get the number of iterations done.
+     * \return number of iterations
+     */
+    size_t GetIteration() const;
+
+    /**
+     * \brief Get the last published positions.
+     * \param x positions x (output)
+     * \param y positions y (output)
+     */
+    void GetPositions(std::vector<double> &x, std::vector<double> &y);
+
+    /**
+     * \brief Lay out the nodes as trees.
+     *
+     *  The nodes not reached from the roots start new trees, in their
+     *  index order.
+     *
+     * \param roots tree roots
+     */
+    void TreeLayout(const std::vector<size_t> &roots);
+
+  private:
+    /**
+     * \brief Quadtree cell.
+     */
+    struct Cell
+    {
+      double cx; /**< center of mass x */
+      double cy; /**< center of mass y */
+      double mass; /**< number of points */
+      double size; /**< side length */
+      int child[4]; /**< child cells (-1 if empty), all -1 for a leaf */
+      size_t first; /**< first point into the tree order */
+      size_t count; /**< number of points */
+    };
+
+    /**
+     * \brief Ideal edge length.
+     */
+    double m_edgeLength;
+
+    /**
+     * \brief Largest move of an iteration (negative before the first one).
+     */
+    double m_temperature;
+
+    /**
+     * \brief Number of threads.
+     */
+    size_t m_threads;
+
+    /**
+     * \brief Positions x.
+     */
+    std::vector<double> m_x;
+
+    /**
+     * \brief Positions y.
+     */
+    std::vector<double> m_y;
+
+    /**
+     * \brief Displacements x of the current iteration.
+     */
+    std::vector<double> m_dx;
+
+    /**
+     * \brief Displacements y of the current iteration.
+     */
+    std::vector<double> m_dy;
+
+    /**
+     * \brief Neighbours of each node.
+     */
+    std::vector<std::vector<size_t> > m_adjacency;
+
+    /**
+     * \brief Quadtree cells, the root is the first one.
+     */
+    std::vector<Cell> m_cells;
+
+    /**
+     * \brief Node indexes in the tree order.
+     */
+    std::vector<size_t> m_order;
+
+    /**
+     * \brief Positions x in the tree order.
+     */
+    std::vector<double> m_sx;
+
+    /**
+     * \brief Positions y in the tree order.
+     */
+    std::vector<double> m_sy;
+
+    /**
+     * \brief Published positions x.
+     */
+    std::vector<double> m_publishedX;
+
+    /**
+     * \brief Published positions y.
+     */
+    std::vector<double> m_publishedY;
+
+    /**
+     * \brief Lock of the published positions.
+     */
+    std::mutex m_mutex;
+
+    /**
+     * \brief Background thread.
+     */
+    std::thread m_thread;
+
+    /**
+     * \brief If the background thread runs.
+     */
+    std::atomic<bool> m_running;
+
+    /**
+     * \brief If the background thread has to stop.
+     */
+    std::atomic<bool> m_stop;
+
+    /**
+     * \brief Number of iterations done.
+     */
+    std::atomic<size_t> m_iteration;
+
+    /**
+     * \brief Spread the nodes which are at the same position.
+     *
+     *  The nodes stacked at a position are put on a sunflower spiral around
+     *  it, the forces between two nodes at the same position are null.
+     */
+    void Spread();
+
+    /**
+     * \brief Build the quadtree of the current positions.
+     */
+    void BuildTree();
+
+    /**
+     * \brief Build a quadtree cell.
+     * \param first first point into the tree order
+     * \param count number of points
+     * \param x0 cell left
+     * \param y0 cell top
+     * \param size cell side length
+     * \param depth cell depth
+     * \return cell index
+     */
+    int BuildCell(const size_t &first, const size_t &count, const double &x0, const double &y0, const double &size,
+        const size_t &depth);
+
+    /**
+     * \brief Compute the displacements of a range of nodes.
+     * \param begin first node
+     * \param end last node + 1
+     */
+    void Forces(const size_t &begin, const size_t &end);
+
+    /**
+     * \brief Body of the background thread.
+     * \param iterations maximum number of iterations
+     */
+    void Run(const size_t &iterations);
+
+    /**
+     * \brief Publish the current positions.
+     */
+    void Publish();
+
+    /**
+     * \brief Throw if the background thread runs.
+     */
+    void CheckStopped() const;
+};
+
+#endif /* LAYOUT_ENGINE_H */
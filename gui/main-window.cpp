@@ -44,10 +44,16 @@
 #include "array-utils.h"
 
 #include "application-dialog.h"
+#include "xml-loader.h"
+#include "autosave.h"
+#include "compressed-device.h"
+
+const size_t MainWindow::LOAD_BATCH = 1000;
 
 MainWindow::MainWindow(const std::string &simulationName)
 {
   this->m_dw = NULL;
+  this->m_autosave = NULL;
   this->m_gen = new Generator(simulationName);
 
   //
@@ -76,6 +82,9 @@ MainWindow::MainWindow(const std::string &simulationName)
   QAction *menuXmlLoad = menuFichier->addAction("Load XML file");
   connect(menuXmlLoad, SIGNAL(triggered()), this, SLOT(LoadXml()));
 
+  QAction *menuImport = menuFichier->addAction("Import topology");
+  connect(menuImport, SIGNAL(triggered()), this, SLOT(ImportTopology()));
+
   QAction *actionQuit = menuFichier->addAction("Quit");
   connect(actionQuit, SIGNAL(triggered()), qApp, SLOT(quit()));
 
@@ -89,6 +98,72 @@ MainWindow::MainWindow(const std::string &simulationName)
   connect(actionCpp, SIGNAL(triggered()), this, SLOT(GenerateCpp())); 
   QAction *actionPython = menuView->addAction("&Python");
   connect(actionPython, SIGNAL(triggered()), this, SLOT(GeneratePython()));
+  QAction *actionData = menuView->addAction("&Data-driven C++");
+  connect(actionData, SIGNAL(triggered()), this, SLOT(GenerateData()));
+  QAction *actionSharded = menuView->addAction("&Sharded C++");
+  connect(actionSharded, SIGNAL(triggered()), this, SLOT(GenerateSharded()));
+  menuView->addSeparator();
+  QAction *actionProfiling = menuView->addAction("Self-&profiling");
+  actionProfiling->setCheckable(true);
+  actionProfiling->setChecked(this->m_gen->GetProfiling());
+  connect(actionProfiling, SIGNAL(toggled(bool)), this, SLOT(ToggleProfiling(bool)));
+  QAction *actionBuildCache = menuView->addAction("&Build cache helper");
+  actionBuildCache->setCheckable(true);
+  actionBuildCache->setChecked(this->m_gen->GetBuildCache());
+  connect(actionBuildCache, SIGNAL(toggled(bool)), this, SLOT(ToggleBuildCache(bool)));
+  QAction *actionParameterized = menuView->addAction("Command line &parameters");
+  actionParameterized->setCheckable(true);
+  actionParameterized->setChecked(this->m_gen->GetParameterized());
+  connect(actionParameterized, SIGNAL(toggled(bool)), this, SLOT(ToggleParameterized(bool)));
+  this->m_parameterizedAction = actionParameterized;
+
+  QMenu *menuScheduler = menuView->addMenu("&Scheduler");
+  QActionGroup *schedulerGroup = new QActionGroup(menuScheduler);
+  QAction *actionDefault = menuScheduler->addAction("Default");
+  actionDefault->setData(QString(""));
+  actionDefault->setCheckable(true);
+  actionDefault->setChecked(true);
+  schedulerGroup->addAction(actionDefault);
+  std::vector<std::string> schedulers = Generator::GetSchedulers();
+  for(size_t i = 0; i < schedulers.size(); i++)
+  {
+    QAction *actionScheduler = menuScheduler->addAction(QString(schedulers.at(i).c_str()));
+    actionScheduler->setData(QString(schedulers.at(i).c_str()));
+    actionScheduler->setCheckable(true);
+    schedulerGroup->addAction(actionScheduler);
+  }
+  connect(schedulerGroup, SIGNAL(triggered(QAction*)), this, SLOT(SelectScheduler(QAction*)));
+  this->m_schedulerGroup = schedulerGroup;
+
+  QMenu *menuCompression = menuView->addMenu("C&ompression");
+  QActionGroup *compressionGroup = new QActionGroup(menuCompression);
+  QAction *actionPlain = menuCompression->addAction("None");
+  actionPlain->setData(QString(""));
+  actionPlain->setCheckable(true);
+  actionPlain->setChecked(true);
+  compressionGroup->addAction(actionPlain);
+  std::vector<std::string> codecs = Codec::GetCodecs();
+  for(size_t i = 0; i < codecs.size(); i++)
+  {
+    QAction *actionCodec = menuCompression->addAction(QString(codecs.at(i).c_str()));
+    actionCodec->setData(QString(codecs.at(i).c_str()));
+    actionCodec->setCheckable(true);
+    compressionGroup->addAction(actionCodec);
+  }
+  connect(compressionGroup, SIGNAL(triggered(QAction*)), this, SLOT(SelectCompression(QAction*)));
+
+  QAction *actionBenchCpp = menuView->addAction("Scheduler benchmark (C++)");
+  connect(actionBenchCpp, SIGNAL(triggered()), this, SLOT(GenerateSchedulerBenchmarkCpp()));
+  QAction *actionBenchPython = menuView->addAction("Scheduler benchmark (Python)");
+  connect(actionBenchPython, SIGNAL(triggered()), this, SLOT(GenerateSchedulerBenchmarkPython()));
+
+  QMenu *menuLayout = menuBar()->addMenu("&Layout");
+  QAction *actionForce = menuLayout->addAction("&Force-directed");
+  connect(actionForce, SIGNAL(triggered()), this, SLOT(LayoutForce()));
+  QAction *actionTree = menuLayout->addAction("&Tree");
+  connect(actionTree, SIGNAL(triggered()), this, SLOT(LayoutTree()));
+  QAction *actionStopLayout = menuLayout->addAction("&Stop");
+  connect(actionStopLayout, SIGNAL(triggered()), this, SLOT(StopLayout()));
 
   QMenu *menuHelp = menuBar()->addMenu("&Help");
   QAction *menuOnlineHelp = menuHelp->addAction("Online Help");
@@ -197,10 +272,19 @@ MainWindow::MainWindow(const std::string &simulationName)
   // 
   //
   this->m_dw->SetMainWindow(this);
+
+  //
+  // Autosave journal, kept until a clean exit.
+  //
+  QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+  QDir().mkpath(directory);
+  this->m_autosave = new Autosave(directory.toStdString(), this->m_dw);
 }
 
 MainWindow::~MainWindow()
 {
+  this->m_autosave->Discard();
+  delete this->m_autosave;
   delete this->m_gen;
 }
 
@@ -214,6 +298,25 @@ Generator* MainWindow::GetGenerator()
   return this->m_gen;
 }
 
+Autosave* MainWindow::GetAutosave()
+{
+  return this->m_autosave;
+}
+
+void MainWindow::RecoverAutosave()
+{
+  if(this->m_autosave->HasSession())
+  {
+    if(QMessageBox(QMessageBox::Question, "Autosave", "The previous session was not closed. Recover it?",
+          QMessageBox::Yes | QMessageBox::No, this).exec() == QMessageBox::Yes)
+    {
+      this->Load(QString::fromStdString(this->m_autosave->GetSnapshotName()), 
+          QString::fromStdString(this->m_autosave->GetJournalName()));
+    }
+  }
+  this->m_autosave->Start();
+}
+
 void MainWindow::CleanIface()
 {
   bool used = false;
@@ -250,6 +353,7 @@ void MainWindow::CreatePc()
 {
   this->m_gen->AddNode("Pc");
   this->m_dw->CreateObject("Pc", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreatePcGroup()
@@ -274,6 +378,7 @@ void MainWindow::CreatePcGroup()
 
   this->m_gen->AddNode("Pc-group",number);
   this->m_dw->CreateObject("Pc-group", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateEmu()
@@ -302,6 +407,7 @@ void MainWindow::CreateEmu()
   this->m_gen->AddNode("Emu");
   this->m_gen->AddNetworkHardware("Emu", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName(), text.toStdString());
   this->m_dw->CreateObject("Emu",this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1)->GetNetworkHardwareName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateTap()
@@ -330,6 +436,7 @@ void MainWindow::CreateTap()
   this->m_gen->AddNode("Tap");
   this->m_gen->AddNetworkHardware("Tap", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName(), text.toStdString());
   this->m_dw->CreateObject("Tap",this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1)->GetNetworkHardwareName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateAp()
@@ -337,18 +444,21 @@ void MainWindow::CreateAp()
   this->m_gen->AddNode("Ap");
   this->m_gen->AddNetworkHardware("Ap", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName());
   this->m_dw->CreateObject("Ap", this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1)->GetNetworkHardwareName() );
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateStation()
 {
   this->m_gen->AddNode("Station");
   this->m_dw->CreateObject("Station", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateHub()
 {
   this->m_gen->AddNetworkHardware("Hub");
   this->m_dw->CreateObject("Hub", this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1)->GetNetworkHardwareName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateSwitch()
@@ -356,12 +466,14 @@ void MainWindow::CreateSwitch()
   this->m_gen->AddNode("Bridge");
   this->m_gen->AddNetworkHardware("Bridge", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName());
   this->m_dw->CreateObject("Bridge",this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1)->GetNetworkHardwareName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateRouter()
 {
   this->m_gen->AddNode("Router");
   this->m_dw->CreateObject("Router", this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName());
+  this->m_autosave->Sync();
 }
 
 void MainWindow::CreateWiredLink()
@@ -472,7 +584,10 @@ void MainWindow::ConnectNode(const std::string &linkName, const std::string &nod
   }
 
   // install the params node to the dest network
+  this->m_autosave->Sync();
   this->m_gen->GetNetworkHardware(linkNumber)->Install(nodeName);
+  this->m_autosave->Install(linkName, nodeName);
+  this->m_dw->UpdateToolTips();
 }
 
 void MainWindow::GenerateCpp()
@@ -503,7 +618,7 @@ void MainWindow::GenerateCpp()
   
   if(fileName != "")
   {
-    QMessageBox(QMessageBox::Information, "Generated Cpp", "Code saved at " + fileName).exec();
+    QMessageBox(QMessageBox::Information, "Generated Cpp", "Code saved at " + QString(this->m_gen->OutputFileName(fileName.toStdString()).c_str())).exec();
   }
 }
 
@@ -535,8 +650,119 @@ void MainWindow::GeneratePython()
   
   if(fileName != "")
   {
-    QMessageBox(QMessageBox::Information, "Generated Python", "Code saved at " + fileName).exec();
+    QMessageBox(QMessageBox::Information, "Generated Python", "Code saved at " + QString(this->m_gen->OutputFileName(fileName.toStdString()).c_str())).exec();
+  }
+}
+
+void MainWindow::ToggleProfiling(bool state)
+{
+  this->m_gen->SetProfiling(state);
+}
+
+void MainWindow::ToggleBuildCache(bool state)
+{
+  this->m_gen->SetBuildCache(state);
+}
+
+void MainWindow::ToggleParameterized(bool state)
+{
+  this->m_gen->SetParameterized(state);
+  this->m_autosave->Settings();
+}
+
+void MainWindow::SelectScheduler(QAction *action)
+{
+  this->m_gen->SetScheduler(action->data().toString().toStdString());
+  this->m_autosave->Settings();
+}
+
+void MainWindow::SelectCompression(QAction *action)
+{
+  this->m_gen->SetCompression(action->data().toString().toStdString());
+}
+
+void MainWindow::UpdateScheduler()
+{
+  QList<QAction*> actions = this->m_schedulerGroup->actions();
+  for(int i = 0; i < actions.size(); i++)
+  {
+    if(actions.at(i)->data().toString().toStdString() == this->m_gen->GetScheduler())
+    {
+      actions.at(i)->setChecked(true);
+    }
+  }
+}
+
+void MainWindow::GenerateData()
+{
+  QString fileName = QFileDialog::getSaveFileName(this, tr("Generate data-driven C++"), "", tr("C++ files (*.cc)"));
+  if(fileName == "")
+  {
+    return;
+  }
+
+  this->m_gen->GenerateCodeData(fileName.toStdString());
+  QMessageBox(QMessageBox::Information, "Generated data-driven C++", "Code saved at " + QString(this->m_gen->OutputFileName(fileName.toStdString()).c_str()) +
+      "\nTopology saved at " + QString(ScenarioData::DataFileName(fileName.toStdString()).c_str())).exec();
+}
+
+void MainWindow::GenerateSharded()
+{
+  QString fileName = QFileDialog::getSaveFileName(this, tr("Generate sharded C++"), "", tr("C++ files (*.cc)"));
+  if(fileName == "")
+  {
+    return;
+  }
+
+  bool ok = false;
+  int shards = QInputDialog::getInt(this, tr("Generate sharded C++"), tr("Number of shard files:"),
+      QThread::idealThreadCount(), 1, 1024, 1, &ok);
+  if(!ok)
+  {
+    return;
+  }
+
+  std::vector<std::string> files = this->m_gen->GenerateCodeSharded(fileName.toStdString(), shards);
+  QString list = "";
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    list += QString("\n") + QString(files.at(i).c_str());
+  }
+  QMessageBox(QMessageBox::Information, "Generated sharded C++", "Code saved at:" + list).exec();
+}
+
+void MainWindow::GenerateSchedulerBenchmarkCpp()
+{
+  QString fileName = QFileDialog::getSaveFileName(this, tr("Scheduler benchmark (C++)"), "", tr("C++ files (*.cc)"));
+  if(fileName == "")
+  {
+    return;
+  }
+
+  std::vector<std::string> files = this->m_gen->GenerateSchedulerBenchmarkCpp(fileName.toStdString());
+  QString list = "";
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    list += QString("\n") + QString(files.at(i).c_str());
+  }
+  QMessageBox(QMessageBox::Information, "Scheduler benchmark", "Code saved at:" + list).exec();
+}
+
+void MainWindow::GenerateSchedulerBenchmarkPython()
+{
+  QString fileName = QFileDialog::getSaveFileName(this, tr("Scheduler benchmark (Python)"), "", tr("Python files (*.py)"));
+  if(fileName == "")
+  {
+    return;
+  }
+
+  std::vector<std::string> files = this->m_gen->GenerateSchedulerBenchmarkPython(fileName.toStdString());
+  QString list = "";
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    list += QString("\n") + QString(files.at(i).c_str());
   }
+  QMessageBox(QMessageBox::Information, "Scheduler benchmark", "Code saved at:" + list).exec();
 }
 
 void MainWindow::DeleteObject()
@@ -544,6 +770,21 @@ void MainWindow::DeleteObject()
   this->m_dw->DeleteSelected();
 }
 
+void MainWindow::LayoutForce()
+{
+  this->m_dw->Layout(false);
+}
+
+void MainWindow::LayoutTree()
+{
+  this->m_dw->Layout(true);
+}
+
+void MainWindow::StopLayout()
+{
+  this->m_dw->StopLayout();
+}
+
 void MainWindow::About()
 {
   QMessageBox::about(this, "About",
@@ -572,7 +813,7 @@ void MainWindow::SavePicture()
  
   if(dlg.exec())
   {
-    QImage img = this->m_dw->grab().toImage();
+    QImage img = this->m_dw->GetPicture();
     QString fileName = dlg.selectedFiles().at(0);
 
     /* check if file exists and notificate the user */
@@ -603,6 +844,8 @@ void MainWindow::SaveXml()
   dlg.setFileMode(QFileDialog::AnyFile);
   dlg.setAcceptMode(QFileDialog::AcceptSave);
   dlg.setDefaultSuffix(".xml");
+  dlg.setNameFilters(QStringList() << "Xml file (*.xml)" << "Binary project (*.ngp)"
+      << "Compressed xml file (*.xml.gz)" << "Compressed binary project (*.ngp.gz)");
  
   if(dlg.exec())
   {
@@ -619,6 +862,47 @@ void MainWindow::SaveXml()
     }
   }
 
+  /* the codec is given by the extension, "scenario.xml.gz" is a gzip xml file. */
+  std::string codec = Codec::FromFileName(fileName.toStdString());
+  QString baseName = fileName;
+  if(codec != "")
+  {
+    baseName = fileName.left(fileName.lastIndexOf('.'));
+  }
+
+  /* binary project file, opened without parsing */
+  if(baseName.endsWith(".ngp"))
+  {
+    try
+    {
+      guiUtils::saveProject(fileName.toStdString(), this->m_gen, this->m_dw, codec);
+    }
+    catch(const std::exception &e)
+    {
+      QMessageBox::warning(this, "Save Simulation", QString(e.what()));
+      return;
+    }
+    QMessageBox(QMessageBox::Information, "Save Simulation", "Simulation saved at " + fileName).exec();
+    return;
+  }
+
+  if(codec != "")
+  {
+    /* streamed through the block compression, the xml is never whole in memory. */
+    CompressedDevice device(fileName, codec);
+    device.open(QIODevice::WriteOnly);
+    QXmlStreamWriter writer(&device);
+    guiUtils::saveXml(&writer, this->m_gen, this->m_dw);
+    device.close();
+    if(device.GetError() != "")
+    {
+      QMessageBox::warning(this, "Save Simulation", device.GetError());
+      return;
+    }
+    QMessageBox(QMessageBox::Information, "Save Simulation", "Simulation saved at " + fileName).exec();
+    return;
+  }
+
   //QString fileName = "test.xml";
   QFile file(fileName);
   file.open(QFile::WriteOnly | QFile::Text);
@@ -648,14 +932,108 @@ void MainWindow::LoadXml()
     }
   }
 
-  QFile file(fileName);
-  file.open(QFile::ReadOnly | QFile::Text);
-  QXmlStreamReader *reader = new QXmlStreamReader(&file);
-  
-  guiUtils::loadXml(reader, this->m_gen, this->m_dw);
-  
-  file.close();
+  if(fileName == "")
+  {
+    return;
+  }
+
+  this->Load(fileName, "");
+}
+
+void MainWindow::ImportTopology()
+{
+  QString fileName = "";
+  QFileDialog dlg(this, tr("Import topology"));
+  dlg.setFileMode(QFileDialog::ExistingFile);
+  dlg.setNameFilter(tr("Topologies (*.graphml *.brite *.cch *.inet *.graphml.gz *.brite.gz *.cch.gz *.inet.gz)"));
+
+  if(dlg.exec())
+  {
+    fileName = dlg.selectedFiles().at(0);
+  }
+
+  if(fileName == "")
+  {
+    return;
+  }
+
+  /* the loader recognises the topology formats by their extension. */
+  this->Load(fileName, "");
+}
+
+bool MainWindow::Load(const QString &fileName, const QString &journalName)
+{
+  /* the file is parsed in a thread into a detached generator, the window stays responsive. */
+  Generator *model = new Generator("");
+  model->SetScheduler(this->m_gen->GetScheduler());
+  model->SetParameterized(this->m_gen->GetParameterized());
+
+  QProgressDialog progress("Loading " + (fileName != "" ? fileName : journalName) + "...", "Cancel", 0, 200, this);
+  progress.setWindowModality(Qt::WindowModal);
+  progress.setMinimumDuration(500);
+
+  XmlLoader loader(fileName, model, journalName);
+  QEventLoop loop;
+  connect(&loader, SIGNAL(Progress(int)), &progress, SLOT(setValue(int)));
+  connect(&progress, SIGNAL(canceled()), &loader, SLOT(Cancel()));
+  connect(&loader, SIGNAL(finished()), &loop, SLOT(quit()));
+  loader.start();
+  loop.exec();
+
+  if(!loader.GetCompleted())
+  {
+    /* canceled or failed: the current simulation is left untouched. */
+    delete model;
+    progress.reset();
+    if(loader.GetError() != "")
+    {
+      QMessageBox::warning(this, "Load Simulation", loader.GetError());
+    }
+    return false;
+  }
+
+  /* the loaded objects which collide with the current ones are renamed. */
+  std::map<std::string, std::string> renamed;
+  this->m_gen->Merge(*model, renamed);
+  delete model;
+
+  /* the canvas items are inserted in batches, without repaint until the end. */
+  progress.setCancelButton(0);
+  const std::vector<XmlLoader::Object> &objects = loader.GetObjects();
+  const std::vector<DragLines> &lines = loader.GetLines();
+  size_t total = objects.size() + lines.size();
+  this->m_dw->setUpdatesEnabled(false);
+  for(size_t i = 0; i < total; i++)
+  {
+    if(i % MainWindow::LOAD_BATCH == 0)
+    {
+      progress.setValue(100 + static_cast<int>(i * 100 / total));
+      QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+    if(i < objects.size())
+    {
+      const XmlLoader::Object &object = objects.at(i);
+      this->m_dw->CreateObject(object.type, Generator::RenamedNode(object.name, renamed), object.x, object.y);
+    }
+    else
+    {
+      DragLines line = lines.at(i - objects.size());
+      line.SetFirst(Generator::RenamedNode(line.GetFirst(), renamed));
+      line.SetSecond(Generator::RenamedNode(line.GetSecond(), renamed));
+      this->m_dw->AddDrawLine(line);
+    }
+  }
+  this->m_dw->UpdateToolTips();
+  this->m_dw->setUpdatesEnabled(true);
+  progress.setValue(200);
+
+  this->UpdateScheduler();
+  this->m_parameterizedAction->setChecked(this->m_gen->GetParameterized());
+
+  /* the loaded objects go into a new snapshot, the journal restarts from it. */
+  this->m_autosave->Start();
 
   QMessageBox(QMessageBox::Information, "Load Simulation", "Simulation loaded.").exec();
+  return true;
 }
 
@@ -34,6 +34,8 @@
 #include "generator.h"
 #include "application-dialog.h"
 
+class Autosave;
+
 /**
  * \ingroup generator
  * \brief The main window.
@@ -45,6 +47,11 @@ class MainWindow : public QMainWindow
   Q_OBJECT
 
   public:
+    /**
+     * \brief Number of canvas items inserted between two progress updates of a loading.
+     */
+    static const size_t LOAD_BATCH;
+
     /**
      * \brief Constructor.
      */
@@ -67,6 +74,17 @@ class MainWindow : public QMainWindow
      */
     Generator* GetGenerator();
 
+    /**
+     * \brief Get autosave object.
+     * \return autosave object
+     */
+    Autosave* GetAutosave();
+
+    /**
+     * \brief Offer to recover the session left by a crash, then start the autosave.
+     */
+    void RecoverAutosave();
+
     /**
      * \brief Procedure to erase the unused iface. 
      */
@@ -102,6 +120,26 @@ class MainWindow : public QMainWindow
      */
     DragWidget *m_dw;
 
+    /**
+     * \brief Autosave journal.
+     */
+    Autosave *m_autosave;
+
+    /**
+     * \brief Scheduler menu actions.
+     */
+    QActionGroup *m_schedulerGroup;
+
+    /**
+     * \brief Command line parameters menu action.
+     */
+    QAction *m_parameterizedAction;
+
+    /**
+     * \brief Check the scheduler menu entry of the generator scheduler.
+     */
+    void UpdateScheduler();
+
     /**
      * \brief interface which are used.
      */ 
@@ -184,6 +222,71 @@ class MainWindow : public QMainWindow
      */
     void GeneratePython();
 
+    /**
+     * \brief Generate the data-driven C++ code and its topology file.
+     */
+    void GenerateData();
+
+    /**
+     * \brief Generate the C++ code split into several files with its Makefile.
+     */
+    void GenerateSharded();
+
+    /**
+     * \brief Enable or disable the self-profiling harness of the generated code.
+     * \param state new state
+     */
+    void ToggleProfiling(bool state);
+
+    /**
+     * \brief Enable or disable the build cache helper of the generated C++ code.
+     * \param state new state
+     */
+    void ToggleBuildCache(bool state);
+
+    /**
+     * \brief Select the event scheduler of the generated code.
+     * \param action scheduler menu action
+     */
+    void SelectScheduler(QAction *action);
+
+    /**
+     * \brief Select the compression of the generated code files.
+     * \param action selected compression action (its data is the codec name)
+     */
+    void SelectCompression(QAction *action);
+
+    /**
+     * \brief Enable or disable the command line parameters of the generated code.
+     * \param state new state
+     */
+    void ToggleParameterized(bool state);
+
+    /**
+     * \brief Generate one profiled C++ file per scheduler.
+     */
+    void GenerateSchedulerBenchmarkCpp();
+
+    /**
+     * \brief Generate one profiled Python file per scheduler.
+     */
+    void GenerateSchedulerBenchmarkPython();
+
+    /**
+     * \brief Lay out the objects with the force-directed layout.
+     */
+    void LayoutForce();
+
+    /**
+     * \brief Lay out the objects as trees.
+     */
+    void LayoutTree();
+
+    /**
+     * \brief Stop the layout in progress.
+     */
+    void StopLayout();
+
     /**
      * \brief Procedure called by the tool bar to delete an object.
      */
@@ -209,6 +312,19 @@ class MainWindow : public QMainWindow
      */
     void LoadXml();
 
+    /**
+     * \brief Import a GraphML, BRITE, Rocketfuel or Inet topology.
+     */
+    void ImportTopology();
+
+  private:
+    /**
+     * \brief Load a simulation file and replay an autosave journal into the simulation.
+     * \param fileName xml, binary project or topology file name (empty if none)
+     * \param journalName autosave journal name (empty if none)
+     * \return true if the simulation is loaded
+     */
+    bool Load(const QString &fileName, const QString &journalName);
 };
 
 #endif /* MAIN_WINDOW_H */
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file object-pool.h
+ * \brief Bounded pool of released objects for reuse.
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Bounded pool of released objects for reuse.
+ *
+ * A released object is kept until the pool is full, then deleted. Take
+ * gives back the last released object, or allocates one if the pool is
+ * empty, so a create/delete session does not allocate once the pool holds
+ * its working set. The pool owns the objects it holds.
+ */
+template <class T>
+class ObjectPool
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param capacity largest number of objects kept
+     */
+    ObjectPool(const size_t &capacity) : m_capacity(capacity)
+    {
+    }
+
+    /**
+     * \brief Destructor, deletes the pooled objects.
+     */
+    ~ObjectPool()
+    {
+      for(size_t i = 0; i < this->m_objects.size(); i++)
+      {
+        delete this->m_objects.at(i);
+      }
+    }
+
+    /**
+     * \brief Take an object.
+     * \return a released object, or a new one if the pool is empty
+     */
+    T* Take()
+    {
+      if(this->m_objects.size() == 0)
+      {
+        return new T();
+      }
+      T *object = this->m_objects.back();
+      this->m_objects.pop_back();
+      return object;
+    }
+
+    /**
+     * \brief Release an object, it is deleted if the pool is full.
+     * \param object object, reset by the caller
+     */
+    void Release(T *object)
+    {
+      if(this->m_objects.size() < this->m_capacity)
+      {
+        this->m_objects.push_back(object);
+      }
+      else
+      {
+        delete object;
+      }
+    }
+
+    /**
+     * \brief Get the number of pooled objects.
+     * \return number of objects
+     */
+    size_t GetSize() const
+    {
+      return this->m_objects.size();
+    }
+
+    /**
+     * \brief Get the largest number of objects kept.
+     * \return capacity
+     */
+    size_t GetCapacity() const
+    {
+      return this->m_capacity;
+    }
+
+  private:
+    /**
+     * \brief Largest number of objects kept.
+     */
+    size_t m_capacity;
+
+    /**
+     * \brief Pooled objects.
+     */
+    std::vector<T*> m_objects;
+};
+
+#endif /* OBJECT_POOL_H */
+
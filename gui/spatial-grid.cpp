@@ -0,0 +1,354 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file spatial-grid.cpp
+ * \brief Uniform grid index of the canvas objects and links.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "spatial-grid.h"
+
+SpatialGrid::SpatialGrid(const double &cellSize)
+{
+  if(cellSize <= 0)
+  {
+    throw std::logic_error("SpatialGrid failed! (wrong cell size).");
+  }
+  this->m_cellSize = cellSize;
+  this->m_segmentRevision = 0;
+}
+
+SpatialGrid::~SpatialGrid()
+{
+}
+
+void SpatialGrid::SetRect(const size_t &id, const double &x1, const double &y1, const double &x2, const double &y2)
+{
+  Shape shape;
+  shape.segment = false;
+  shape.x1 = std::min(x1, x2);
+  shape.y1 = std::min(y1, y2);
+  shape.x2 = std::max(x1, x2);
+  shape.y2 = std::max(y1, y2);
+  this->Insert(id, shape);
+}
+
+void SpatialGrid::SetSegment(const size_t &id, const double &x1, const double &y1, const double &x2, const double &y2)
+{
+  Shape shape;
+  shape.segment = true;
+  shape.x1 = x1;
+  shape.y1 = y1;
+  shape.x2 = x2;
+  shape.y2 = y2;
+  this->Insert(id, shape);
+  this->m_segmentRevision++;
+}
+
+void SpatialGrid::Remove(const size_t &id)
+{
+  std::map<size_t, Shape>::iterator it = this->m_shapes.find(id);
+  if(it == this->m_shapes.end())
+  {
+    return;
+  }
+  if(it->second.segment)
+  {
+    this->m_segmentRevision++;
+  }
+
+  const std::vector<Cell> &cells = it->second.cells;
+  for(size_t i = 0; i < cells.size(); i++)
+  {
+    std::map<Cell, std::vector<size_t> >::iterator cell = this->m_cells.find(cells.at(i));
+    if(cell == this->m_cells.end())
+    {
+      continue;
+    }
+    cell->second.erase(std::remove(cell->second.begin(), cell->second.end(), id), cell->second.end());
+    if(cell->second.size() == 0)
+    {
+      this->m_cells.erase(cell);
+    }
+  }
+  this->m_shapes.erase(it);
+}
+
+size_t SpatialGrid::GetNShapes() const
+{
+  return this->m_shapes.size();
+}
+
+double SpatialGrid::GetCellSize() const
+{
+  return this->m_cellSize;
+}
+
+size_t SpatialGrid::GetSegmentRevision() const
+{
+  return this->m_segmentRevision;
+}
+
+bool SpatialGrid::FindAt(const double &x, const double &y, const double &tolerance, size_t &id) const
+{
+  bool found = false;
+  bool foundRect = false;
+  double best = tolerance;
+
+  for(long cx = this->ToCell(x - tolerance); cx <= this->ToCell(x + tolerance); cx++)
+  {
+    for(long cy = this->ToCell(y - tolerance); cy <= this->ToCell(y + tolerance); cy++)
+    {
+      std::map<Cell, std::vector<size_t> >::const_iterator cell = this->m_cells.find(Cell(cx, cy));
+      if(cell == this->m_cells.end())
+      {
+        continue;
+      }
+      for(size_t i = 0; i < cell->second.size(); i++)
+      {
+        size_t sid = cell->second.at(i);
+        const Shape &shape = this->m_shapes.find(sid)->second;
+        if(!shape.segment)
+        {
+          if(x >= shape.x1 && x <= shape.x2 && y >= shape.y1 && y <= shape.y2 && (!foundRect || sid > id))
+          {
+            id = sid;
+            found = true;
+            foundRect = true;
+          }
+        }
+        else if(!foundRect)
+        {
+          double distance = SpatialGrid::SegmentDistance(x, y, shape.x1, shape.y1, shape.x2, shape.y2);
+          if(distance <= best)
+          {
+            best = distance;
+            id = sid;
+            found = true;
+          }
+        }
+      }
+    }
+  }
+  return found;
+}
+
+std::vector<size_t> SpatialGrid::FindIn(const double &x1, const double &y1, const double &x2, const double &y2) const
+{
+  double left = std::min(x1, x2);
+  double top = std::min(y1, y2);
+  double right = std::max(x1, x2);
+  double bottom = std::max(y1, y2);
+
+  std::vector<size_t> candidates;
+  long cx1 = this->ToCell(left);
+  long cx2 = this->ToCell(right);
+  long cy1 = this->ToCell(top);
+  long cy2 = this->ToCell(bottom);
+  if((double)(cx2 - cx1 + 1) * (double)(cy2 - cy1 + 1) > (double)this->m_cells.size())
+  {
+    // large area, walk the non-empty cells only.
+    for(std::map<Cell, std::vector<size_t> >::const_iterator cell = this->m_cells.begin(); cell != this->m_cells.end(); cell++)
+    {
+      if(cell->first.first >= cx1 && cell->first.first <= cx2 && cell->first.second >= cy1 && cell->first.second <= cy2)
+      {
+        candidates.insert(candidates.end(), cell->second.begin(), cell->second.end());
+      }
+    }
+  }
+  else
+  {
+    for(long cx = cx1; cx <= cx2; cx++)
+    {
+      for(long cy = cy1; cy <= cy2; cy++)
+      {
+        std::map<Cell, std::vector<size_t> >::const_iterator cell = this->m_cells.find(Cell(cx, cy));
+        if(cell != this->m_cells.end())
+        {
+          candidates.insert(candidates.end(), cell->second.begin(), cell->second.end());
+        }
+      }
+    }
+  }
+
+  // a shape is listed once per crossed cell.
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  std::vector<size_t> res;
+  for(size_t i = 0; i < candidates.size(); i++)
+  {
+    if(SpatialGrid::Intersects(this->m_shapes.find(candidates.at(i))->second, left, top, right, bottom))
+    {
+      res.push_back(candidates.at(i));
+    }
+  }
+  return res;
+}
+
+std::map<SpatialGrid::Cell, size_t> SpatialGrid::CountRects(const double &x1, const double &y1, const double &x2, const double &y2,
+    const long &bucket) const
+{
+  std::map<Cell, size_t> counts;
+  long cx1 = this->ToCell(std::min(x1, x2));
+  long cx2 = this->ToCell(std::max(x1, x2));
+  long cy1 = this->ToCell(std::min(y1, y2));
+  long cy2 = this->ToCell(std::max(y1, y2));
+  for(std::map<Cell, std::vector<size_t> >::const_iterator cell = this->m_cells.begin(); cell != this->m_cells.end(); cell++)
+  {
+    if(cell->first.first < cx1 || cell->first.first > cx2 || cell->first.second < cy1 || cell->first.second > cy2)
+    {
+      continue;
+    }
+    size_t rects = 0;
+    for(size_t i = 0; i < cell->second.size(); i++)
+    {
+      if(!this->m_shapes.find(cell->second.at(i))->second.segment)
+      {
+        rects++;
+      }
+    }
+    if(rects > 0)
+    {
+      // floor division, the cells may be negative.
+      long bx = cell->first.first >= 0 ? cell->first.first / bucket : -((-cell->first.first + bucket - 1) / bucket);
+      long by = cell->first.second >= 0 ? cell->first.second / bucket : -((-cell->first.second + bucket - 1) / bucket);
+      counts[Cell(bx, by)] += rects;
+    }
+  }
+  return counts;
+}
+
+double SpatialGrid::SegmentDistance(const double &px, const double &py,
+    const double &x1, const double &y1, const double &x2, const double &y2)
+{
+  double dx = x2 - x1;
+  double dy = y2 - y1;
+  double length = dx * dx + dy * dy;
+  double t = 0;
+  if(length > 0)
+  {
+    // projection of the point on the segment line, kept between the ends.
+    t = ((px - x1) * dx + (py - y1) * dy) / length;
+    t = std::max(0.0, std::min(1.0, t));
+  }
+  double x = x1 + t * dx - px;
+  double y = y1 + t * dy - py;
+  return std::sqrt(x * x + y * y);
+}
+
+void SpatialGrid::Insert(const size_t &id, Shape &shape)
+{
+  this->Remove(id);
+
+  if(!shape.segment)
+  {
+    for(long cx = this->ToCell(shape.x1); cx <= this->ToCell(shape.x2); cx++)
+    {
+      for(long cy = this->ToCell(shape.y1); cy <= this->ToCell(shape.y2); cy++)
+      {
+        shape.cells.push_back(Cell(cx, cy));
+      }
+    }
+  }
+  else
+  {
+    // walk the columns crossed by the segment, it covers a range of rows in each of them.
+    double xa = shape.x1;
+    double ya = shape.y1;
+    double xb = shape.x2;
+    double yb = shape.y2;
+    if(xa > xb)
+    {
+      std::swap(xa, xb);
+      std::swap(ya, yb);
+    }
+    for(long cx = this->ToCell(xa); cx <= this->ToCell(xb); cx++)
+    {
+      double yl = ya;
+      double yr = yb;
+      if(xb > xa)
+      {
+        double left = std::max(xa, cx * this->m_cellSize);
+        double right = std::min(xb, (cx + 1) * this->m_cellSize);
+        yl = ya + (yb - ya) * (left - xa) / (xb - xa);
+        yr = ya + (yb - ya) * (right - xa) / (xb - xa);
+      }
+      for(long cy = this->ToCell(std::min(yl, yr)); cy <= this->ToCell(std::max(yl, yr)); cy++)
+      {
+        shape.cells.push_back(Cell(cx, cy));
+      }
+    }
+  }
+
+  for(size_t i = 0; i < shape.cells.size(); i++)
+  {
+    this->m_cells[shape.cells.at(i)].push_back(id);
+  }
+  this->m_shapes[id] = shape;
+}
+
+long SpatialGrid::ToCell(const double &v) const
+{
+  return (long)std::floor(v / this->m_cellSize);
+}
+
+bool SpatialGrid::Intersects(const Shape &shape, const double &x1, const double &y1, const double &x2, const double &y2)
+{
+  if(!shape.segment)
+  {
+    return shape.x1 <= x2 && shape.x2 >= x1 && shape.y1 <= y2 && shape.y2 >= y1;
+  }
+
+  // clip the segment by the area (Liang-Barsky).
+  double dx = shape.x2 - shape.x1;
+  double dy = shape.y2 - shape.y1;
+  double p[4] = {-dx, dx, -dy, dy};
+  double q[4] = {shape.x1 - x1, x2 - shape.x1, shape.y1 - y1, y2 - shape.y1};
+  double t0 = 0;
+  double t1 = 1;
+  for(size_t i = 0; i < 4; i++)
+  {
+    if(p[i] == 0)
+    {
+      if(q[i] < 0)
+      {
+        return false;
+      }
+      continue;
+    }
+    double t = q[i] / p[i];
+    if(p[i] < 0)
+    {
+      t0 = std::max(t0, t);
+    }
+    else
+    {
+      t1 = std::min(t1, t);
+    }
+    if(t0 > t1)
+    {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file spatial-grid.h
+ * \brief Uniform grid index of the canvas objects and links.
+ */
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Uniform grid index of the canvas objects and links.
+ *
+ * The plane is cut into square cells, each cell lists the shapes which
+ * cross it. An object rectangle is put in the cells it covers and a link
+ * segment only in the cells it actually goes through, so a long diagonal
+ * link does not fill the cells of its bounding box. A lookup visits the
+ * few cells around the point or the area and tests the exact geometry of
+ * their shapes (point to segment distance for the links).
+ *
+ * The cells are kept in a map, a lookup is logarithmic in the number of
+ * non-empty cells.
+ */
+class SpatialGrid
+{
+  public:
+    /**
+     * \brief Cell coordinates.
+     */
+    typedef std::pair<long, long> Cell;
+
+    /**
+     * \brief Constructor.
+     * \param cellSize cell side length
+     */
+    SpatialGrid(const double &cellSize);
+
+    /**
+     * \brief Destructor.
+     */
+    ~SpatialGrid();
+
+    /**
+     * \brief Add or move a rectangle.
+     * \param id shape id
+     * \param x1 left
+     * \param y1 top
+     * \param x2 right
+     * \param y2 bottom
+     */
+    void SetRect(const size_t &id, const double &x1, const double &y1, const double &x2, const double &y2);
+
+    /**
+     * \brief Add or move a segment.
+     * \param id shape id
+     * \param x1 first end x
+     * \param y1 first end y
+     * \param x2 second end x
+     * \param y2 second end y
+     */
+    void SetSegment(const size_t &id, const double &x1, const double &y1, const double &x2, const double &y2);
+
+    /**
+     * \brief Remove a shape (nothing is done if it is not indexed).
+     * \param id shape id
+     */
+    void Remove(const size_t &id);
+
+    /**
+     * \brief Get the number of indexed shapes.
+     * \return number of shapes
+     */
+    size_t GetNShapes() const;
+
+    /**
+     * \brief Get the cell side length.
+     * \return cell side length
+     */
+    double GetCellSize() const;
+
+    /**
+     * \brief Get the number of segment changes (add, move or remove) so far.
+     * \return segment revision
+     */
+    size_t GetSegmentRevision() const;
+
+    /**
+     * \brief Find the shape under a point.
+     *
+     * The rectangles containing the point come first (the greatest id is
+     * the last added, so the top most one), then the nearest segment.
+     *
+     * \param x point x
+     * \param y point y
+     * \param tolerance max distance between the point and a segment
+     * \param id shape id (output)
+     * \return true if a shape is found
+     */
+    bool FindAt(const double &x, const double &y, const double &tolerance, size_t &id) const;
+
+    /**
+     * \brief Find the shapes which intersect an area.
+     * \param x1 left
+     * \param y1 top
+     * \param x2 right
+     * \param y2 bottom
+     * \return shape ids (sorted)
+     */
+    std::vector<size_t> FindIn(const double &x1, const double &y1, const double &x2, const double &y2) const;
+
+    /**
+     * \brief Count the rectangles of the cells of an area.
+     *
+     * A cell of the result groups bucket x bucket cells of the grid.
+     *
+     * \param x1 left
+     * \param y1 top
+     * \param x2 right
+     * \param y2 bottom
+     * \param bucket number of grid cells grouped on each side
+     * \return number of rectangles of each non-empty cell
+     */
+    std::map<Cell, size_t> CountRects(const double &x1, const double &y1, const double &x2, const double &y2, const long &bucket) const;
+
+    /**
+     * \brief Get the distance between a point and a segment.
+     * \param px point x
+     * \param py point y
+     * \param x1 first end x
+     * \param y1 first end y
+     * \param x2 second end x
+     * \param y2 second end y
+     * \return distance
+     */
+    static double SegmentDistance(const double &px, const double &py,
+        const double &x1, const double &y1, const double &x2, const double &y2);
+
+  private:
+    /**
+     * \brief Indexed shape.
+     */
+    struct Shape
+    {
+      /**
+       * \brief If the shape is a segment (else a rectangle).
+       */
+      bool segment;
+
+      /**
+       * \brief Coordinates (rectangle corners or segment ends).
+       */
+      double x1, y1, x2, y2;
+
+      /**
+       * \brief Cells crossed by the shape.
+       */
+      std::vector<Cell> cells;
+    };
+
+    /**
+     * \brief Cell side length.
+     */
+    double m_cellSize;
+
+    /**
+     * \brief Number of segment changes.
+     */
+    size_t m_segmentRevision;
+
+    /**
+     * \brief Shapes by id.
+     */
+    std::map<size_t, Shape> m_shapes;
+
+    /**
+     * \brief Shape ids by cell.
+     */
+    std::map<Cell, std::vector<size_t> > m_cells;
+
+    /**
+     * \brief Index a shape (replaces the previous one with the same id).
+     * \param id shape id
+     * \param shape shape, its cells are computed
+     */
+    void Insert(const size_t &id, Shape &shape);
+
+    /**
+     * \brief Get the cell coordinate of a position.
+     * \param v position
+     * \return cell coordinate
+     */
+    long ToCell(const double &v) const;
+
+    /**
+     * \brief Check if a shape intersects an area.
+     * \param shape shape
+     * \param x1 left
+     * \param y1 top
+     * \param x2 right
+     * \param y2 bottom
+     * \return true if the shape intersects the area
+     */
+    static bool Intersects(const Shape &shape, const double &x1, const double &y1, const double &x2, const double &y2);
+};
+
+#endif /* SPATIAL_GRID_H */
@@ -0,0 +1,800 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file xml-loader.cpp
+ * \brief Xml and binary project file loader thread.
+ */
+
+#include <stdexcept>
+
+#include "xml-loader.h"
+#include "autosave.h"
+#include "journal.h"
+#include "compressed-device.h"
+#include "utils.h"
+
+#include "udp-echo.h"
+
+XmlLoader::XmlLoader(const QString &fileName, Generator *gen, const QString &journalName)
+{
+  this->m_fileName = fileName;
+  this->m_journalName = journalName;
+  this->m_gen = gen;
+  this->m_completed = false;
+  this->m_error = "";
+  this->m_size = 0;
+  this->m_device = NULL;
+  this->m_progress = -1;
+}
+
+XmlLoader::~XmlLoader()
+{
+  this->requestInterruption();
+  this->wait();
+}
+
+const std::vector<XmlLoader::Object>& XmlLoader::GetObjects() const
+{
+  return this->m_objects;
+}
+
+const std::vector<DragLines>& XmlLoader::GetLines() const
+{
+  return this->m_lines;
+}
+
+bool XmlLoader::GetCompleted() const
+{
+  return this->m_completed;
+}
+
+QString XmlLoader::GetError() const
+{
+  return this->m_error;
+}
+
+void XmlLoader::Cancel()
+{
+  this->requestInterruption();
+}
+
+void XmlLoader::run()
+{
+  /* an exception must not leave the thread. */
+  try
+  {
+    if(!this->Load())
+    {
+      return;
+    }
+    if(this->m_journalName != "")
+    {
+      this->m_completed = this->Replay(Journal::Read(this->m_journalName.toStdString()));
+    }
+  }
+  catch(const std::exception &e)
+  {
+    this->m_completed = false;
+    this->m_error = QString(e.what());
+  }
+}
+
+bool XmlLoader::Load()
+{
+  /* an autosave journal without snapshot starts from an empty simulation. */
+  if(this->m_fileName == "")
+  {
+    this->m_completed = true;
+    return true;
+  }
+
+  if(TopologyImporter::Detect(this->m_fileName.toStdString()) != "")
+  {
+    TopologyImporter importer(this);
+    this->m_completed = importer.Import(this->m_fileName.toStdString());
+    return this->m_completed;
+  }
+
+  if(ProjectFile::IsProjectFile(this->m_fileName.toStdString()))
+  {
+    ProjectFile project;
+    project.Open(this->m_fileName.toStdString());
+    this->m_completed = this->ParseProject(project);
+    return this->m_completed;
+  }
+
+  /* a compressed file is streamed through its blocks, a plain one is read as is. */
+  CompressedDevice file(this->m_fileName, "");
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    throw std::runtime_error("Can't open " + this->m_fileName.toStdString() + ".");
+  }
+  this->m_device = &file;
+  this->m_size = QFileInfo(this->m_fileName).size();
+
+  QXmlStreamReader reader(&file);
+  this->m_completed = this->Parse(&reader);
+  this->m_device = NULL;
+  file.close();
+  if(file.GetError() != "")
+  {
+    throw std::runtime_error(file.GetError().toStdString());
+  }
+  return this->m_completed;
+}
+
+bool XmlLoader::Parse(QXmlStreamReader *reader)
+{
+  if(!reader->readNextStartElement())
+  {
+    XmlLoader::Fail(reader, "no root element");
+  }
+
+  /* sections and fields are found by name, the unknown elements are skipped. */
+  while(reader->readNextStartElement())
+  {
+    if(reader->name() == "Nodes" || reader->name() == "NetworkHardwares" ||
+        reader->name() == "Applications" || reader->name() == "Lines")
+    {
+      while(reader->readNextStartElement())
+      {
+        if(!this->Continue(this->m_device->GetFilePosition(), this->m_size))
+        {
+          return false;
+        }
+
+        if(reader->name() == "node")
+        {
+          this->InsertNode(XmlLoader::ReadNode(reader));
+        }
+        else if(reader->name() == "networkHardware")
+        {
+          this->InsertLink(XmlLoader::ReadLink(reader));
+        }
+        else if(reader->name() == "application")
+        {
+          this->InsertApplication(XmlLoader::ReadApplication(reader));
+        }
+        else if(reader->name() == "line")
+        {
+          this->m_lines.push_back(XmlLoader::ReadLine(reader));
+        }
+        else
+        {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else if(reader->name() == "Simulation")
+    {
+      while(reader->readNextStartElement())
+      {
+        if(reader->name() == "scheduler")
+        {
+          this->m_gen->SetScheduler(XmlLoader::ReadText(reader));
+        }
+        else if(reader->name() == "parameterized")
+        {
+          this->m_gen->SetParameterized(XmlLoader::ReadInteger(reader) != 0);
+        }
+        else
+        {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else
+    {
+      reader->skipCurrentElement();
+    }
+  }
+
+  if(reader->hasError())
+  {
+    XmlLoader::Fail(reader, reader->errorString().toStdString());
+  }
+  return true;
+}
+
+ProjectFile::Node XmlLoader::ReadNode(QXmlStreamReader *reader)
+{
+  ProjectFile::Node node;
+  node.number = 1;
+  node.x = 10;
+  node.y = 10;
+  while(reader->readNextStartElement())
+  {
+    if(reader->name() == "type")
+    {
+      node.type = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "nodeNbr")
+    {
+      node.number = XmlLoader::ReadInteger(reader);
+    }
+    else if(reader->name() == "name")
+    {
+      node.name = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "nsc")
+    {
+      node.nsc = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "x")
+    {
+      node.x = XmlLoader::ReadInteger(reader);
+    }
+    else if(reader->name() == "y")
+    {
+      node.y = XmlLoader::ReadInteger(reader);
+    }
+    else
+    {
+      reader->skipCurrentElement();
+    }
+  }
+  if(node.type == "" || node.name == "")
+  {
+    XmlLoader::Fail(reader, "node without type or name");
+  }
+  return node;
+}
+
+ProjectFile::Link XmlLoader::ReadLink(QXmlStreamReader *reader)
+{
+  ProjectFile::Link link;
+  link.hidden = false;
+  link.trace = false;
+  link.promisc = false;
+  while(reader->readNextStartElement())
+  {
+    if(reader->name() == "hidden")
+    {
+      link.hidden = (XmlLoader::ReadText(reader) != "false");
+    }
+    else if(reader->name() == "type")
+    {
+      link.type = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "name")
+    {
+      link.name = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "dataRate")
+    {
+      link.dataRate = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "linkDelay")
+    {
+      link.delay = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "enableTrace")
+    {
+      link.trace = (XmlLoader::ReadText(reader) == "true");
+    }
+    else if(reader->name() == "tracePromisc")
+    {
+      link.promisc = (XmlLoader::ReadText(reader) == "true");
+    }
+    else if(reader->name() == "mobility" || reader->name() == "iface" || reader->name() == "hubPos" || reader->name() == "none")
+    {
+      link.special = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "connectedNodes")
+    {
+      while(reader->readNextStartElement())
+      {
+        if(reader->name() == "name")
+        {
+          link.members.push_back(XmlLoader::ReadText(reader));
+        }
+        else
+        {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else
+    {
+      reader->skipCurrentElement();
+    }
+  }
+  if(link.type == "" || link.name == "")
+  {
+    XmlLoader::Fail(reader, "network hardware without type or name");
+  }
+  if(link.type == "Hub" && !link.hidden && link.special.find('-') == std::string::npos)
+  {
+    XmlLoader::Fail(reader, "hub " + link.name + " without position");
+  }
+  return link;
+}
+
+ProjectFile::Application XmlLoader::ReadApplication(QXmlStreamReader *reader)
+{
+  ProjectFile::Application application;
+  application.port = 0;
+  application.packetSize = 0;
+  application.maxPacketCount = 0;
+  while(reader->readNextStartElement())
+  {
+    if(reader->name() == "type")
+    {
+      application.type = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "name")
+    {
+      application.name = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "sender")
+    {
+      application.sender = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "receiver")
+    {
+      application.receiver = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "startTime")
+    {
+      application.startTime = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "endTime")
+    {
+      application.endTime = XmlLoader::ReadText(reader);
+    }
+    else if(reader->name() == "special")
+    {
+      while(reader->readNextStartElement())
+      {
+        if(reader->name() == "port")
+        {
+          application.port = XmlLoader::ReadInteger(reader);
+        }
+        else if(reader->name() == "packetSize")
+        {
+          application.packetSize = XmlLoader::ReadInteger(reader);
+        }
+        else if(reader->name() == "maxPacketCount")
+        {
+          application.maxPacketCount = XmlLoader::ReadInteger(reader);
+        }
+        else if(reader->name() == "packetIntervalTime")
+        {
+          application.packetIntervalTime = XmlLoader::ReadText(reader);
+        }
+        else
+        {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else
+    {
+      reader->skipCurrentElement();
+    }
+  }
+  if(application.type == "" || application.sender == "" || application.receiver == "")
+  {
+    XmlLoader::Fail(reader, "application without type, sender or receiver");
+  }
+  return application;
+}
+
+DragLines XmlLoader::ReadLine(QXmlStreamReader *reader)
+{
+  DragLines dg;
+  while(reader->readNextStartElement())
+  {
+    if(reader->name() == "first")
+    {
+      dg.SetFirst(XmlLoader::ReadText(reader));
+    }
+    else if(reader->name() == "second")
+    {
+      dg.SetSecond(XmlLoader::ReadText(reader));
+    }
+    else if(reader->name() == "linkType")
+    {
+      dg.SetNetworkHardwareType(XmlLoader::ReadText(reader));
+    }
+    else
+    {
+      reader->skipCurrentElement();
+    }
+  }
+  return dg;
+}
+
+std::string XmlLoader::ReadText(QXmlStreamReader *reader)
+{
+  return reader->readElementText(QXmlStreamReader::SkipChildElements).trimmed().toStdString();
+}
+
+size_t XmlLoader::ReadInteger(QXmlStreamReader *reader)
+{
+  QString name = reader->name().toString();
+  bool ok = false;
+  size_t value = reader->readElementText(QXmlStreamReader::SkipChildElements).trimmed().toULongLong(&ok);
+  if(!ok)
+  {
+    XmlLoader::Fail(reader, name.toStdString() + " is not an integer");
+  }
+  return value;
+}
+
+void XmlLoader::Fail(QXmlStreamReader *reader, const std::string &message)
+{
+  throw std::logic_error("Load failed! (line " + utils::integerToString(reader->lineNumber()) + ": " + message + ").");
+}
+
+bool XmlLoader::ParseProject(const ProjectFile &project)
+{
+  size_t total = project.GetNNodes() + project.GetNLinks() + project.GetNApplications() + project.GetNLines();
+  size_t done = 0;
+
+  for(size_t i = 0; i < project.GetNNodes(); i++, done++)
+  {
+    if(!this->Continue(done, total))
+    {
+      return false;
+    }
+    this->InsertNode(project.GetNode(i));
+  }
+  for(size_t i = 0; i < project.GetNLinks(); i++, done++)
+  {
+    if(!this->Continue(done, total))
+    {
+      return false;
+    }
+    this->InsertLink(project.GetLink(i));
+  }
+  for(size_t i = 0; i < project.GetNApplications(); i++, done++)
+  {
+    if(!this->Continue(done, total))
+    {
+      return false;
+    }
+    this->InsertApplication(project.GetApplication(i));
+  }
+  for(size_t i = 0; i < project.GetNLines(); i++, done++)
+  {
+    if(!this->Continue(done, total))
+    {
+      return false;
+    }
+    ProjectFile::Line line = project.GetLine(i);
+    DragLines dg;
+    dg.SetFirst(line.first);
+    dg.SetSecond(line.second);
+    dg.SetNetworkHardwareType(line.type);
+    this->m_lines.push_back(dg);
+  }
+
+  this->m_gen->SetScheduler(project.GetScheduler());
+  this->m_gen->SetParameterized(project.GetParameterized());
+  return true;
+}
+
+bool XmlLoader::Replay(const std::vector<std::vector<std::string> > &records)
+{
+  std::map<std::string, NetworkHardware*> links;
+  for(size_t i = 0; i < this->m_gen->GetNNetworkHardwares(); i++)
+  {
+    links[this->m_gen->GetNetworkHardware(i)->GetNetworkHardwareName()] = this->m_gen->GetNetworkHardware(i);
+  }
+
+  for(size_t i = 0; i < records.size(); i++)
+  {
+    if(!this->Continue(i, records.size()))
+    {
+      return false;
+    }
+
+    const std::vector<std::string> &record = records.at(i);
+    if(record.size() == 0)
+    {
+      continue;
+    }
+    const std::string &kind = record.at(0);
+    if(kind == "node")
+    {
+      this->InsertNode(Autosave::DecodeNode(record));
+    }
+    else if(kind == "link")
+    {
+      this->InsertLink(Autosave::DecodeLink(record));
+      NetworkHardware *hardware = this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1);
+      links[hardware->GetNetworkHardwareName()] = hardware;
+    }
+    else if(kind == "application")
+    {
+      this->InsertApplication(Autosave::DecodeApplication(record));
+    }
+    else if(kind == "line")
+    {
+      this->m_lines.push_back(Autosave::DecodeLine(record));
+    }
+    else if(kind == "unline")
+    {
+      DragLines line = Autosave::DecodeLine(record);
+      for(size_t j = 0; j < this->m_lines.size(); j++)
+      {
+        if(this->m_lines.at(j).GetFirst() == line.GetFirst() && this->m_lines.at(j).GetSecond() == line.GetSecond())
+        {
+          this->m_lines.erase(this->m_lines.begin() + j);
+          break;
+        }
+      }
+    }
+    else if(kind == "install" || kind == "uninstall")
+    {
+      if(record.size() < 3 || links.find(record.at(1)) == links.end())
+      {
+        throw std::logic_error("Replay failed! (" + kind + " of an unknown link).");
+      }
+      NetworkHardware *hardware = links[record.at(1)];
+      if(kind == "install")
+      {
+        hardware->Install(record.at(2));
+        continue;
+      }
+      for(size_t j = 0; j < hardware->GetInstalledNodes().size(); j++)
+      {
+        if(hardware->GetInstalledNodes().at(j) == record.at(2))
+        {
+          hardware->removeInstalledNode(j);
+          break;
+        }
+      }
+    }
+    else if(kind == "remove")
+    {
+      this->RemoveObjects(std::set<std::string>(record.begin() + 1, record.end()));
+      links.clear();
+      for(size_t j = 0; j < this->m_gen->GetNNetworkHardwares(); j++)
+      {
+        links[this->m_gen->GetNetworkHardware(j)->GetNetworkHardwareName()] = this->m_gen->GetNetworkHardware(j);
+      }
+    }
+    else if(kind == "move")
+    {
+      for(size_t j = 1; j + 2 < record.size(); j += 3)
+      {
+        std::map<std::string, size_t>::const_iterator it = this->m_objectIndex.find(record.at(j));
+        if(it != this->m_objectIndex.end())
+        {
+          this->m_objects.at(it->second).x = utils::stringToInteger(record.at(j + 1));
+          this->m_objects.at(it->second).y = utils::stringToInteger(record.at(j + 2));
+        }
+      }
+    }
+    else if(kind == "settings")
+    {
+      Autosave::CheckRecord(record, 3);
+      this->m_gen->SetScheduler(record.at(1));
+      this->m_gen->SetParameterized(record.at(2) == "1");
+    }
+    /* the snapshot record and the unknown ones are skipped. */
+  }
+  return true;
+}
+
+void XmlLoader::RemoveObjects(const std::set<std::string> &names)
+{
+  // as the canvas: the shown links stay even alone.
+  std::set<std::string> keep;
+  for(size_t i = 0; i < this->m_objects.size(); i++)
+  {
+    if(names.find(this->m_objects.at(i).name) == names.end())
+    {
+      keep.insert(this->m_objects.at(i).name);
+    }
+  }
+  this->m_gen->RemoveObjects(names, keep);
+
+  size_t kept = 0;
+  this->m_objectIndex.clear();
+  for(size_t i = 0; i < this->m_objects.size(); i++)
+  {
+    if(names.find(this->m_objects.at(i).name) == names.end())
+    {
+      this->m_objects.at(kept) = this->m_objects.at(i);
+      this->m_objectIndex[this->m_objects.at(kept).name] = kept;
+      kept++;
+    }
+  }
+  this->m_objects.resize(kept);
+
+  kept = 0;
+  for(size_t i = 0; i < this->m_lines.size(); i++)
+  {
+    if(names.find(this->m_lines.at(i).GetFirst()) == names.end() && names.find(this->m_lines.at(i).GetSecond()) == names.end())
+    {
+      this->m_lines.at(kept++) = this->m_lines.at(i);
+    }
+  }
+  this->m_lines.resize(kept);
+}
+
+void XmlLoader::InsertNode(const ProjectFile::Node &node)
+{
+  this->m_gen->AddNode(node.type, node.number);
+  Node *equi = this->m_gen->GetNode(this->m_gen->GetNNodes() - 1);
+  if(node.name != "")
+  {
+    equi->SetNodeName(node.name);
+  }
+  equi->SetNsc(node.nsc);
+  this->AddObject(node.type, equi->GetNodeName(), node.x, node.y);
+}
+
+void XmlLoader::InsertLink(const ProjectFile::Link &link)
+{
+  if(link.type == "Hub" || link.type == "PointToPoint")
+  {
+    this->m_gen->AddNetworkHardware(link.type);
+  }
+  else if(link.type == "Bridge" || link.type == "Ap")
+  {
+    this->m_gen->AddNetworkHardware(link.type, link.name);
+  } 
+  else // Emu, Tap
+  {
+    this->m_gen->AddNetworkHardware(link.type, link.name, link.special);
+  }
+
+  NetworkHardware *hardware = this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1);
+  if(link.name != "")
+  {
+    hardware->SetNetworkHardwareName(link.name);
+  }
+  if(link.dataRate != "")
+  {
+    hardware->SetDataRate(link.dataRate);
+  }
+  if(link.delay != "")
+  {
+    hardware->SetNetworkHardwareDelay(link.delay);
+  }
+  if(link.trace)
+  {
+    hardware->SetTrace(true);
+  }
+  if(link.promisc)
+  {
+    hardware->SetPromisc(true);
+  }
+  for(size_t i = 0; i < link.members.size(); i++)
+  {
+    hardware->Install(link.members.at(i));
+  }
+
+  if(!link.hidden && link.type != "Emu" && link.type != "Tap" && link.type != "Ap" && link.type != "Bridge")
+  {
+    if(link.type == "Hub")
+    {
+      std::vector<std::string> vec;
+      utils::split(vec, link.special, '-');
+      this->AddObject(link.type, hardware->GetNetworkHardwareName(), utils::stringToInteger(vec.at(0)), utils::stringToInteger(vec.at(1)));
+    }
+    else
+    {
+      this->AddObject(link.type, hardware->GetNetworkHardwareName(), 10, 10);
+    }
+  }
+}
+
+void XmlLoader::InsertApplication(const ProjectFile::Application &application)
+{
+  size_t startTime = utils::stringToInteger(application.startTime);
+  size_t endTime = utils::stringToInteger(application.endTime);
+  if(application.type == "Ping")
+  {
+    this->m_gen->AddApplication(application.type, application.sender, application.receiver, startTime, endTime);
+  }
+  else if(application.type == "UdpEcho")
+  {
+    this->m_gen->AddApplication(application.type, application.sender, application.receiver, startTime, endTime, application.port);
+    UdpEcho *udp = dynamic_cast<UdpEcho*>(this->m_gen->GetApplication(this->m_gen->GetNApplications() - 1));
+    udp->SetPacketSize(application.packetSize);
+    udp->SetMaxPacketCount(application.maxPacketCount);
+    udp->SetPacketIntervalTime(application.packetIntervalTime);
+  }
+  else if(application.type == "TcpLargeTransfer")
+  {
+    this->m_gen->AddApplication(application.type, application.sender, application.receiver, startTime, endTime, application.port);
+  }
+}
+
+void XmlLoader::AddObject(const std::string &type, const std::string &name, const size_t &x, const size_t &y)
+{
+  Object object;
+  object.type = type;
+  object.name = name;
+  object.x = x;
+  object.y = y;
+  this->m_objectIndex[name] = this->m_objects.size();
+  this->m_objects.push_back(object);
+}
+
+void XmlLoader::Reserve(const size_t &nodes, const size_t &links)
+{
+  this->m_gen->Reserve(nodes, links);
+  this->m_objects.reserve(nodes);
+  this->m_lines.reserve(links);
+}
+
+std::string XmlLoader::AddNode(const ProjectFile::Node &node)
+{
+  this->InsertNode(node);
+  return this->m_gen->GetNode(this->m_gen->GetNNodes() - 1)->GetNodeName();
+}
+
+std::string XmlLoader::AddLink(const ProjectFile::Link &link)
+{
+  this->InsertLink(link);
+  NetworkHardware *hardware = this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1);
+  if(!link.hidden)
+  {
+    this->m_hubs[hardware->GetNetworkHardwareName()] = hardware;
+  }
+  return hardware->GetNetworkHardwareName();
+}
+
+void XmlLoader::Install(const std::string &link, const std::string &node)
+{
+  std::map<std::string, NetworkHardware*>::iterator it = this->m_hubs.find(link);
+  if(it == this->m_hubs.end())
+  {
+    throw std::logic_error("Import failed! (" + link + ") not found.");
+  }
+  it->second->Install(node);
+}
+
+void XmlLoader::AddLine(const ProjectFile::Line &line)
+{
+  DragLines lig;
+  lig.SetFirst(line.first);
+  lig.SetSecond(line.second);
+  lig.SetNetworkHardwareType(line.type);
+  this->m_lines.push_back(lig);
+}
+
+bool XmlLoader::Advance(const size_t &done, const size_t &total)
+{
+  return this->Continue(static_cast<qint64>(done), static_cast<qint64>(total));
+}
+
+bool XmlLoader::Continue(const qint64 &done, const qint64 &total)
+{
+  if(this->isInterruptionRequested())
+  {
+    return false;
+  }
+  if(total > 0)
+  {
+    int progress = static_cast<int>(qMin(done * 100 / total, qint64(100)));
+    if(progress != this->m_progress)
+    {
+      this->m_progress = progress;
+      emit Progress(progress);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,378 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file xml-loader.h
+ * \brief Xml and binary project file loader thread.
+ */
+
+#ifndef XML_LOADER_H
+#define XML_LOADER_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <QtWidgets>
+
+#include "generator.h"
+#include "project-file.h"
+#include "topology-importer.h"
+#include "drag-lines.h"
+
+class CompressedDevice;
+
+/**
+ * \ingroup generator
+ * \brief Xml and binary project file loader thread.
+ *
+ *  The file is parsed in a thread into a detached generator, which is not
+ *  seen by the user interface until the loading is done. The canvas objects
+ *  and lines are only collected, the user interface inserts them afterwards.
+ *  The parsing can be canceled, the detached generator is then left
+ *  unfinished and the current simulation is not modified.
+ *
+ *  A binary project file (see ProjectFile) is recognised by its magic, its
+ *  records go through the same insertion as the xml ones. Both can be
+ *  compressed (see CompressedFile), they are decompressed while parsed.
+ *
+ *  An autosave journal (see Autosave) can be replayed after the file, its
+ *  records go through the same insertion too.
+ *
+ *  A GraphML, BRITE, Rocketfuel or Inet file (see TopologyImporter) is
+ *  recognised by its extension and imported, the loader is the sink of the
+ *  importer.
+ */
+class XmlLoader : public QThread, public TopologyImporter::Sink
+{
+  Q_OBJECT
+
+  public:
+    /**
+     * \brief Canvas object to create.
+     */
+    struct Object
+    {
+      /**
+       * \brief Object type.
+       */
+      std::string type;
+
+      /**
+       * \brief Object name.
+       */
+      std::string name;
+
+      /**
+       * \brief Object position.
+       */
+      size_t x;
+
+      /**
+       * \brief Object position.
+       */
+      size_t y;
+    };
+
+    /**
+     * \brief Constructor.
+     * \param fileName xml or binary project file name
+     * \param gen detached generator filled by the loader
+     * \param journalName autosave journal replayed after the file (empty if none)
+     */
+    XmlLoader(const QString &fileName, Generator *gen, const QString &journalName = "");
+
+    /**
+     * \brief Destructor.
+     */
+    ~XmlLoader();
+
+    /**
+     * \brief Get the canvas objects to create, in the file order.
+     * \return canvas objects
+     */
+    const std::vector<Object>& GetObjects() const;
+
+    /**
+     * \brief Get the canvas lines to draw, in the file order.
+     * \return canvas lines
+     */
+    const std::vector<DragLines>& GetLines() const;
+
+    /**
+     * \brief Get if the whole file has been loaded.
+     * \return false if the loading was canceled or failed
+     */
+    bool GetCompleted() const;
+
+    /**
+     * \brief Get the error message of a failed loading.
+     * \return error message (empty if none)
+     */
+    QString GetError() const;
+
+  public slots:
+    /**
+     * \brief Cancel the loading.
+     */
+    void Cancel();
+
+  signals:
+    /**
+     * \brief Progress of the parsing.
+     * \param percent part of the file already parsed (0 to 100)
+     */
+    void Progress(int percent);
+
+  protected:
+    /**
+     * \brief Thread body, parse the file and replay the journal.
+     */
+    void run();
+
+  private:
+    /**
+     * \brief Xml file name.
+     */
+    QString m_fileName;
+
+    /**
+     * \brief Autosave journal file name.
+     */
+    QString m_journalName;
+
+    /**
+     * \brief Detached generator.
+     */
+    Generator *m_gen;
+
+    /**
+     * \brief Canvas objects.
+     */
+    std::vector<Object> m_objects;
+
+    /**
+     * \brief Canvas object index by name.
+     */
+    std::map<std::string, size_t> m_objectIndex;
+
+    /**
+     * \brief Canvas lines.
+     */
+    std::vector<DragLines> m_lines;
+
+    /**
+     * \brief Whole file loaded state.
+     */
+    bool m_completed;
+
+    /**
+     * \brief Error message.
+     */
+    QString m_error;
+
+    /**
+     * \brief Xml file size (in bytes).
+     */
+    qint64 m_size;
+
+    /**
+     * \brief Device of the xml file being parsed (NULL if none).
+     */
+    CompressedDevice *m_device;
+
+    /**
+     * \brief Last emitted progress.
+     */
+    int m_progress;
+
+    /**
+     * \brief Imported hubs, by name.
+     */
+    std::map<std::string, NetworkHardware*> m_hubs;
+
+    /**
+     * \brief Load the file, the xml or binary one.
+     * \return false if the loading was canceled
+     */
+    bool Load();
+
+    /**
+     * \brief Parse the xml file.
+     *
+     *  The file is streamed record by record. The sections and the fields
+     *  are found by their name, in any order, and the unknown elements are
+     *  skipped. A malformed file or record throws a logic_error with its line.
+     *
+     * \param reader the xml reader
+     * \return false if the parsing was canceled
+     */
+    bool Parse(QXmlStreamReader *reader);
+
+    /**
+     * \brief Parse the opened binary project file.
+     * \param project the binary project file
+     * \return false if the parsing was canceled
+     */
+    bool ParseProject(const ProjectFile &project);
+
+    /**
+     * \brief Replay the records of an autosave journal.
+     *
+     *  The unknown records are skipped, a malformed one throws a logic_error.
+     *
+     * \param records journal records
+     * \return false if the replay was canceled
+     */
+    bool Replay(const std::vector<std::vector<std::string> > &records);
+
+    /**
+     * \brief Remove objects as the canvas does.
+     * \param names names of the nodes and links to remove
+     */
+    void RemoveObjects(const std::set<std::string> &names);
+
+    /**
+     * \brief Add a node record to the generator and the canvas objects.
+     * \param node node record
+     */
+    void InsertNode(const ProjectFile::Node &node);
+
+    /**
+     * \brief Add a link record to the generator and the canvas objects.
+     * \param link link record
+     */
+    void InsertLink(const ProjectFile::Link &link);
+
+    /**
+     * \brief Add an application record to the generator.
+     * \param application application record
+     */
+    void InsertApplication(const ProjectFile::Application &application);
+
+    /**
+     * \brief Read a node element.
+     * \param reader the xml reader, on the node start element
+     * \return node record
+     */
+    static ProjectFile::Node ReadNode(QXmlStreamReader *reader);
+
+    /**
+     * \brief Read a network hardware element.
+     * \param reader the xml reader, on the network hardware start element
+     * \return link record
+     */
+    static ProjectFile::Link ReadLink(QXmlStreamReader *reader);
+
+    /**
+     * \brief Read an application element.
+     * \param reader the xml reader, on the application start element
+     * \return application record
+     */
+    static ProjectFile::Application ReadApplication(QXmlStreamReader *reader);
+
+    /**
+     * \brief Read a line element.
+     * \param reader the xml reader, on the line start element
+     * \return drag line
+     */
+    static DragLines ReadLine(QXmlStreamReader *reader);
+
+    /**
+     * \brief Read the text of the current element.
+     * \param reader the xml reader
+     * \return text, without the surrounding spaces
+     */
+    static std::string ReadText(QXmlStreamReader *reader);
+
+    /**
+     * \brief Read the integer of the current element.
+     * \param reader the xml reader
+     * \return integer
+     */
+    static size_t ReadInteger(QXmlStreamReader *reader);
+
+    /**
+     * \brief Throw a load error at the current line.
+     * \param reader the xml reader
+     * \param message error message
+     */
+    static void Fail(QXmlStreamReader *reader, const std::string &message);
+
+    /**
+     * \brief Add a canvas object.
+     * \param type object type
+     * \param name object name
+     * \param x object position
+     * \param y object position
+     */
+    void AddObject(const std::string &type, const std::string &name, const size_t &x, const size_t &y);
+
+    /**
+     * \brief Reserve the generator and the canvas lists for an import.
+     * \param nodes number of nodes
+     * \param links number of links
+     */
+    void Reserve(const size_t &nodes, const size_t &links);
+
+    /**
+     * \brief Add an imported node.
+     * \param node node record
+     * \return node name
+     */
+    std::string AddNode(const ProjectFile::Node &node);
+
+    /**
+     * \brief Add an imported link.
+     * \param link link record
+     * \return link name
+     */
+    std::string AddLink(const ProjectFile::Link &link);
+
+    /**
+     * \brief Install an imported node on an imported hub.
+     * \param link hub name
+     * \param node node name
+     */
+    void Install(const std::string &link, const std::string &node);
+
+    /**
+     * \brief Add an imported canvas line.
+     * \param line line record
+     */
+    void AddLine(const ProjectFile::Line &line);
+
+    /**
+     * \brief Progress of the import.
+     * \param done part of the file already read
+     * \param total whole file
+     * \return false if the loading is canceled
+     */
+    bool Advance(const size_t &done, const size_t &total);
+
+    /**
+     * \brief Emit the progress if it changed and check the cancellation.
+     * \param done part of the file already parsed
+     * \param total whole file
+     * \return false if the loading is canceled
+     */
+    bool Continue(const qint64 &done, const qint64 &total);
+};
+
+#endif /* XML_LOADER_H */
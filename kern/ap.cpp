@@ -42,6 +42,11 @@ Ap::~Ap()
 {
 }
 
+std::string Ap::GetSignature()
+{
+  return NetworkHardware::GetSignature() + (this->m_mobility ? "1" : "0") + "\n" + this->m_apName + "\n" + this->m_apNode + "\n";
+}
+
 std::string Ap::GetApNode()
 {
   return this->m_apNode;
@@ -81,127 +86,79 @@ std::vector<std::string> Ap::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Ap::GenerateNetworkHardwareCpp()
+std::vector<Statement> Ap::DescribeNetworkHardware()
 {
-  std::vector<std::string> generatedLink;
+  std::vector<Statement> generatedLink;
   /* creation of the link. */
-  generatedLink.push_back("YansWifiPhyHelper wifiPhy_" + this->GetNetworkHardwareName() + " = YansWifiPhyHelper::Default ();");
-  generatedLink.push_back("YansWifiChannelHelper wifiChannel_" + this->GetNetworkHardwareName() + " = YansWifiChannelHelper::Default ();");
-  generatedLink.push_back("wifiPhy_" + this->GetNetworkHardwareName() + ".SetChannel (wifiChannel_" + this->GetNetworkHardwareName() + ".Create ());");
+  generatedLink.push_back(Statement::Define("YansWifiPhyHelper", "wifiPhy_" + this->GetNetworkHardwareName(), Expression::Static("YansWifiPhyHelper", "Default")));
+  generatedLink.push_back(Statement::Define("YansWifiChannelHelper", "wifiChannel_" + this->GetNetworkHardwareName(), Expression::Static("YansWifiChannelHelper", "Default")));
+  generatedLink.push_back(Statement::Call("wifiPhy_" + this->GetNetworkHardwareName(), "SetChannel").Arg(Expression::Method("wifiChannel_" + this->GetNetworkHardwareName(), "Create")));
 
   return generatedLink;
 }
 
-std::vector<std::string> Ap::GenerateNetDeviceCpp()
+std::vector<Statement> Ap::DescribeNetDevice()
 {
-  std::vector<std::string> ndc;
-
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp(); //all station nodes !
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + ";");
-  ndc.push_back("Ssid ssid_" + this->GetNetworkHardwareName() + " = Ssid (\"" + this->m_apName + "\");");
-  ndc.push_back("WifiHelper wifi_" + this->GetNetworkHardwareName() + " = WifiHelper::Default ();");
-  ndc.push_back("NqosWifiMacHelper wifiMac_" + this->GetNetworkHardwareName() + " = NqosWifiMacHelper::Default ();");
-  ndc.push_back("wifi_" + this->GetNetworkHardwareName() + ".SetRemoteStationManager (\"ns3::ArfWifiManager\");");
-
-  ndc.push_back("wifiMac_" + this->GetNetworkHardwareName() + ".SetType (\"ns3::ApWifiMac\", ");
-  ndc.push_back("   \"Ssid\", SsidValue (ssid_" + this->GetNetworkHardwareName() + "), ");
-  ndc.push_back("   \"BeaconGeneration\", BooleanValue (true),"); 
-  ndc.push_back("   \"BeaconInterval\", TimeValue (Seconds (2.5)));");
-  ndc.push_back(this->GetNdcName() + ".Add (wifi_" + this->GetNetworkHardwareName() + ".Install (wifiPhy_" + this->GetNetworkHardwareName() + ", wifiMac_" + this->GetNetworkHardwareName() + ", " + this->m_apNode + "));");
-
-  ndc.push_back("wifiMac_" + this->GetNetworkHardwareName() + ".SetType (\"ns3::StaWifiMac\",");
-  ndc.push_back("   \"Ssid\", SsidValue (ssid_" + this->GetNetworkHardwareName() + "), ");
-  ndc.push_back("   \"ActiveProbing\", BooleanValue (false));");
-  ndc.push_back(this->GetNdcName() + ".Add (wifi_" + this->GetNetworkHardwareName() + ".Install (wifiPhy_" + this->GetNetworkHardwareName() + ", wifiMac_" + this->GetNetworkHardwareName() + ", " + this->GetAllNodeContainer() + " ));");
-
-  ndc.push_back("MobilityHelper mobility_" + this->GetNetworkHardwareName() + ";");
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".SetMobilityModel (\"ns3::ConstantPositionMobilityModel\");");
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".Install (" + this->m_apNode + ");"); 
+  std::vector<Statement> ndc = this->GroupAsNodeContainer(); //all station nodes !
+  std::string wifi = "wifi_" + this->GetNetworkHardwareName();
+  std::string wifiMac = "wifiMac_" + this->GetNetworkHardwareName();
+  std::string mobility = "mobility_" + this->GetNetworkHardwareName();
+
+  ndc.push_back(Statement::Declare("NetDeviceContainer", this->GetNdcName()));
+  ndc.push_back(Statement::Define("Ssid", "ssid_" + this->GetNetworkHardwareName(), Expression::Function("Ssid").Arg(Expression::String(this->m_apName))));
+  ndc.push_back(Statement::Define("WifiHelper", wifi, Expression::Static("WifiHelper", "Default")));
+  ndc.push_back(Statement::Define("NqosWifiMacHelper", wifiMac, Expression::Static("NqosWifiMacHelper", "Default")));
+  ndc.push_back(Statement::Call(wifi, "SetRemoteStationManager").Arg(Expression::String("ns3::ArfWifiManager")));
+
+  ndc.push_back(Statement::Call(wifiMac, "SetType").Arg(Expression::String("ns3::ApWifiMac"))
+      .Arg(Expression::String("Ssid")).Arg(Expression::Function("SsidValue").Arg(Expression::Name("ssid_" + this->GetNetworkHardwareName())))
+      .Arg(Expression::String("BeaconGeneration")).Arg(Expression::Function("BooleanValue").Arg(Expression::Boolean(true)))
+      .Arg(Expression::String("BeaconInterval")).Arg(Expression::Function("TimeValue").Arg(Expression::Function("Seconds").Arg(Expression::Real("2.5")))));
+  ndc.push_back(Statement::Call(this->GetNdcName(), "Add").Arg(Expression::Method(wifi, "Install")
+        .Arg(Expression::Name("wifiPhy_" + this->GetNetworkHardwareName())).Arg(Expression::Name(wifiMac)).Arg(Expression::Name(this->m_apNode))));
+
+  ndc.push_back(Statement::Call(wifiMac, "SetType").Arg(Expression::String("ns3::StaWifiMac"))
+      .Arg(Expression::String("Ssid")).Arg(Expression::Function("SsidValue").Arg(Expression::Name("ssid_" + this->GetNetworkHardwareName())))
+      .Arg(Expression::String("ActiveProbing")).Arg(Expression::Function("BooleanValue").Arg(Expression::Boolean(false))));
+  ndc.push_back(Statement::Call(this->GetNdcName(), "Add").Arg(Expression::Method(wifi, "Install")
+        .Arg(Expression::Name("wifiPhy_" + this->GetNetworkHardwareName())).Arg(Expression::Name(wifiMac)).Arg(Expression::Name(this->GetAllNodeContainer()))));
+
+  ndc.push_back(Statement::Declare("MobilityHelper", mobility));
+  ndc.push_back(Statement::Call(mobility, "SetMobilityModel").Arg(Expression::String("ns3::ConstantPositionMobilityModel")));
+  ndc.push_back(Statement::Call(mobility, "Install").Arg(Expression::Name(this->m_apNode)));
 
   if(this->m_mobility)//if random walk is activated.
   {
-    ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".SetMobilityModel (\"ns3::RandomWalk2dMobilityModel\",\"Bounds\", RectangleValue (Rectangle (-50, 50, -50, 50)));");
+    ndc.push_back(Statement::Call(mobility, "SetMobilityModel").Arg(Expression::String("ns3::RandomWalk2dMobilityModel"))
+        .Arg(Expression::String("Bounds")).Arg(Expression::Function("RectangleValue").Arg(Expression::Function("Rectangle")
+            .Arg(Expression::Name("-50")).Arg(Expression::Name("50")).Arg(Expression::Name("-50")).Arg(Expression::Name("50")))));
   }
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".Install(" + this->GetAllNodeContainer() + ");");
+  ndc.push_back(Statement::Call(mobility, "Install").Arg(Expression::Name(this->GetAllNodeContainer())));
 
   return ndc;
 }
 
-std::vector<std::string> Ap::GenerateTraceCpp()
+std::vector<Statement> Ap::DescribeTrace()
 {
-  std::vector<std::string> trace;
+  std::vector<Statement> trace;
 
   if(this->GetTrace())
   {
-    trace.push_back("wifiPhy_" + this->GetNetworkHardwareName() + ".EnablePcap (\"" + this->GetNetworkHardwareName() + "\", " + this->GetNdcName() + ".Get(0));");
+    trace.push_back(Statement::Call("wifiPhy_" + this->GetNetworkHardwareName(), "EnablePcap").Arg(Expression::String(this->GetNetworkHardwareName()))
+        .Arg(Expression::Method(this->GetNdcName(), "Get").Arg(Expression::Name("0"))));
   }
 
   return trace;
-}  
-
-std::vector<std::string> Ap::GenerateNetworkHardwarePython()
-{
-  std::vector<std::string> generatedLink;
-
-  /* creation of the link. */
-  generatedLink.push_back("wifiPhy_" + this->GetNetworkHardwareName() + " = ns3.YansWifiPhyHelper.Default()");
-  generatedLink.push_back("wifiChannel_" + this->GetNetworkHardwareName() + " = ns3.YansWifiChannelHelper.Default()");
-  generatedLink.push_back("wifiPhy_" + this->GetNetworkHardwareName() + ".SetChannel(wifiChannel_" + this->GetNetworkHardwareName() + ".Create())");
-
-  return generatedLink;
 }
 
-std::vector<std::string> Ap::GenerateNetDevicePython()
+std::vector<Statement> Ap::DescribeVars()
 {
-  std::vector<std::string> ndc;
-
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerPython(); //all station nodes !
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back(this->GetNdcName() + " = ns3.NetDeviceContainer()");
-  ndc.push_back("ssid_" + this->GetNetworkHardwareName() + " = ns3.Ssid(\"" + this->m_apName + "\")");
-  ndc.push_back("wifi_" + this->GetNetworkHardwareName() + " = ns3.WifiHelper.Default()");
-  ndc.push_back("wifiMac_" + this->GetNetworkHardwareName() + " = ns3.NqosWifiMacHelper.Default()");
-  ndc.push_back("wifi_" + this->GetNetworkHardwareName() + ".SetRemoteStationManager(\"ns3::ArfWifiManager\")");
-
-  ndc.push_back("wifiMac_" + this->GetNetworkHardwareName() + ".SetType (\"ns3::ApWifiMac\", ");
-  ndc.push_back("   \"Ssid\", ns3.SsidValue(ssid_" + this->GetNetworkHardwareName() + "), ");
-  ndc.push_back("   \"BeaconGeneration\", ns3.BooleanValue(True),");
-  ndc.push_back("   \"BeaconInterval\", ns3.TimeValue(ns3.Seconds(2.5)))");
-  ndc.push_back(this->GetNdcName() + ".Add(wifi_" + this->GetNetworkHardwareName() + ".Install(wifiPhy_" + this->GetNetworkHardwareName() + ", wifiMac_" + this->GetNetworkHardwareName() + ", " + this->m_apNode + "))");
-
-  ndc.push_back("wifiMac_" + this->GetNetworkHardwareName() + ".SetType(\"ns3::StaWifiMac\",");
-  ndc.push_back("   \"Ssid\", ns3.SsidValue(ssid_" + this->GetNetworkHardwareName() + "), ");
-  ndc.push_back("   \"ActiveProbing\", ns3.BooleanValue(False))");
-  ndc.push_back(this->GetNdcName() + ".Add(wifi_" + this->GetNetworkHardwareName() + ".Install(wifiPhy_" + this->GetNetworkHardwareName() + ", wifiMac_" + this->GetNetworkHardwareName() + ", " + this->GetAllNodeContainer() + " ))");
-
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + " = ns3.MobilityHelper()");
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".SetMobilityModel (\"ns3::ConstantPositionMobilityModel\")");
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".Install(" + this->m_apNode + ")");
-
-  if(this->m_mobility)//if random walk is activated.
-  {
-    ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".SetMobilityModel (\"ns3::RandomWalk2dMobilityModel\",\"Bounds\", RectangleValue (Rectangle (-50, 50, -50, 50)))");
-  }
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".Install(" + this->GetAllNodeContainer() + ")");
-
-  return ndc;
+  std::vector<Statement> vars;
+  return vars;
 }
 
-std::vector<std::string> Ap::GenerateTracePython()
+std::vector<Statement> Ap::DescribeCmdLine()
 {
-  std::vector<std::string> trace;
-
-  if(this->GetTrace())
-  {
-    trace.push_back("wifiPhy_" + this->GetNetworkHardwareName() + ".EnablePcap(\"" + this->GetNetworkHardwareName() + "\", " + this->GetNdcName() + ".Get(0))");
-  }
-
-  return trace;
+  std::vector<Statement> cmdLine;
+  return cmdLine;
 }
@@ -79,6 +79,12 @@ class Ap : public NetworkHardware
      */
     virtual ~Ap();
 
+    /**
+     * \brief Get the inputs of the code generation of the access point.
+     * \return signature (one field per line)
+     */
+    virtual std::string GetSignature();
+
     /**
      * \brief Switch mobility on the connected station.
      * \param mobility bool to apply mobility or not
@@ -122,40 +128,37 @@ class Ap : public NetworkHardware
     virtual std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate the build link C++ code.
+     * \brief Describe the build link code.
      * \return build link code.
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual std::vector<Statement> DescribeNetworkHardware();
 
     /**
-     * \brief Generate build of the net device container C++ code.
+     * \brief Describe build of the net device container code.
      * \return net device container
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual std::vector<Statement> DescribeNetDevice();
 
     /**
-     * \brief Generate the trace line C++ code.
+     * \brief Describe the trace line code.
      * \return trace line
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
-    
-    /**
-     * \brief Generate link python code.
-     * \return link code
-     */
-    virtual std::vector<std::string> GenerateNetworkHardwarePython();
+    virtual std::vector<Statement> DescribeTrace();
 
     /**
-     * \brief Generate net device container python code.
-     * \return net device container code
+     * \brief Describe vars code.
+     *
+     * The wifi channel has no data rate nor delay parameter.
+     *
+     * \return vars code
      */
-    virtual std::vector<std::string> GenerateNetDevicePython();
+    virtual std::vector<Statement> DescribeVars();
 
     /**
-     * \brief Generate trace line python code.
-     * \return trace line code
+     * \brief Describe cmd line code.
+     * \return cmd line code
      */
-    virtual std::vector<std::string> GenerateTracePython();
+    virtual std::vector<Statement> DescribeCmdLine();
 };
 
 #endif /* AP_H */
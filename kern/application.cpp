@@ -38,6 +38,7 @@ Application::Application(const std::string &type, const size_t &indice, const st
   this->m_receiverNode = receiverNode;
   this->m_startTime = startTime;
   this->m_endTime = endTime;
+  this->m_parameterized = false;
 }
 
 Application::~Application()
@@ -114,3 +115,78 @@ std::string Application::GetApplicationType()
   return this->m_applicationType;
 }
 
+void Application::SetParameterized(const bool &state)
+{
+  this->m_parameterized = state;
+}
+
+bool Application::GetParameterized()
+{
+  return this->m_parameterized;
+}
+
+std::string Application::GetSignature()
+{
+  return this->m_applicationType + "\n" + utils::integerToString(this->m_indice) + "\n" + this->m_appName + "\n" +
+    this->m_senderNode + "\n" + this->m_receiverNode + "\n" + utils::integerToString(this->m_startTime) + "\n" +
+    utils::integerToString(this->m_endTime) + "\n" + (this->m_parameterized ? "1" : "0") + "\n";
+}
+
+std::string Application::GetParameterValue(const std::string &parameter, const std::string &value)
+{
+  if(this->m_parameterized)
+  {
+    return parameter + "_" + this->m_appName;
+  }
+  return value;
+}
+
+std::string Application::GetStartTimeValue(const std::string &fraction)
+{
+  if(this->m_parameterized)
+  {
+    return "startTime_" + this->m_appName + " + 0." + fraction;
+  }
+  return this->GetStartTime() + "." + fraction;
+}
+
+std::string Application::GetEndTimeValue(const std::string &fraction)
+{
+  if(this->m_parameterized)
+  {
+    return "endTime_" + this->m_appName + " + 0." + fraction;
+  }
+  return this->GetEndTime() + "." + fraction;
+}
+
+std::vector<Statement> Application::DescribeStartStop(const std::string &container, const std::string &start, const std::string &end)
+{
+  std::vector<Statement> startStop;
+  startStop.push_back(Statement::Call(container, "Start").Arg(Expression::Function("Seconds").Arg(Expression::Name(this->GetStartTimeValue(start)))));
+  startStop.push_back(Statement::Call(container, "Stop").Arg(Expression::Function("Seconds").Arg(Expression::Name(this->GetEndTimeValue(end)))));
+  return startStop;
+}
+
+std::vector<Statement> Application::DescribeVars()
+{
+  std::vector<Statement> vars;
+  if(this->m_parameterized)
+  {
+    vars.push_back(Statement::Define("double", "startTime_" + this->m_appName, Expression::Real(this->GetStartTime())));
+    vars.push_back(Statement::Define("double", "endTime_" + this->m_appName, Expression::Real(this->GetEndTime())));
+  }
+  return vars;
+}
+
+std::vector<Statement> Application::DescribeCmdLine()
+{
+  std::vector<Statement> cmdLine;
+  if(this->m_parameterized)
+  {
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("startTime_" + this->m_appName))
+        .Arg(Expression::String("Start time of " + this->m_appName + " (s)")).Arg(Expression::Name("startTime_" + this->m_appName)));
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("endTime_" + this->m_appName))
+        .Arg(Expression::String("End time of " + this->m_appName + " (s)")).Arg(Expression::Name("endTime_" + this->m_appName)));
+  }
+  return cmdLine;
+}
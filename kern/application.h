@@ -32,6 +32,8 @@
 #include <string>
 #include <vector>
 
+#include "statement.h"
+
 /**
  * \ingroup generator
  * \brief The main class of applications.
@@ -53,9 +55,11 @@
  *      ~NewApplication();
  *      
  *      virtual std::vector<std::string> GenerateHeader();
- *      virtual std::vector<std::string> GenerateApplicationCpp(std::string, size_t);
- *      virtual std::vector<std::string> GenerateApplicationPython(std::string, size_t);
+ *      virtual std::vector<Statement> DescribeApplication(const std::string&, const std::string&);
  *    }
+ *
+ *  The code is described once (see Statement), the Generator renders it in
+ *  C++ and in python.
  */
 class Application
 {
@@ -95,6 +99,11 @@ class Application
      */
     std::string m_applicationType;
 
+    /**
+     * \brief If the attributes are lifted into command line parameters.
+     */
+    bool m_parameterized;
+
   public:
     /**
      * \brief Constructor.
@@ -119,22 +128,13 @@ class Application
     virtual std::vector<std::string> GenerateHeader() = 0;
 
     /**
-     * \brief Generate the application C++ code.
-     * \param netDeviceContainer is the ns3 net device containe
-     * \param numberIntoNetDevice is the place from the sender node in the assigned ip network
-     * \param numberIntoNetDevice example sender node is 192.168.0.5, then the number is 5
-     * \return code from the application
-     */
-    virtual std::vector<std::string> GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice) = 0;
-
-    /**
-     * \brief Generate the application python code.
+     * \brief Describe the application code.
      * \param netDeviceContainer is the ns3 net device containe
      * \param numberIntoNetDevice is the place from the sender node in the assigned ip network
      * \param numberIntoNetDevice example sender node is 192.168.0.5, then the number is 5
      * \return code from the application
      */
-    virtual std::vector<std::string> GenerateApplicationPython(std::string netDeviceContainer, size_t numberIntoNetDevice) = 0;
+    virtual std::vector<Statement> DescribeApplication(const std::string &netDeviceContainer, const std::string &numberIntoNetDevice) = 0;
 
     /**
      * \brief Get application number.
@@ -219,6 +219,76 @@ class Application
      * \return application type
      */
     std::string GetApplicationType();
+
+    /**
+     * \brief Enable/disable the command line parameters.
+     *
+     * When enabled, the start and end times (and the subclass attributes)
+     * are generated as variables which can be changed from the command line.
+     *
+     * \param state parameterized state
+     */
+    void SetParameterized(const bool &state);
+
+    /**
+     * \brief Get the command line parameters state.
+     * \return parameterized state
+     */
+    bool GetParameterized();
+
+    /**
+     * \brief Get the inputs of the code generation of the application.
+     *
+     *  Two applications with the same signature generate the same code, it keys
+     *  the fragment cache (see FragmentCache).
+     *
+     * \return signature (one field per line)
+     */
+    virtual std::string GetSignature();
+
+    /**
+     * \brief Describe vars code.
+     * \return vars code
+     */
+    virtual std::vector<Statement> DescribeVars();
+
+    /**
+     * \brief Describe cmd line code.
+     * \return cmd line code
+     */
+    virtual std::vector<Statement> DescribeCmdLine();
+
+  protected:
+    /**
+     * \brief Get the expression of an attribute used into the generated code.
+     * \param parameter parameter name prefix
+     * \param value attribute value
+     * \return value, or the "<parameter>_<appName>" variable if parameterized
+     */
+    std::string GetParameterValue(const std::string &parameter, const std::string &value);
+
+    /**
+     * \brief Get the start time expression (in s) used into the generated code.
+     * \param fraction tenth of second added to the start time
+     * \return start time expression
+     */
+    std::string GetStartTimeValue(const std::string &fraction);
+
+    /**
+     * \brief Get the end time expression (in s) used into the generated code.
+     * \param fraction tenth of second added to the end time
+     * \return end time expression
+     */
+    std::string GetEndTimeValue(const std::string &fraction);
+
+    /**
+     * \brief Describe the start and the stop of an application container.
+     * \param container application container name
+     * \param start tenth of second added to the start time
+     * \param end tenth of second added to the end time
+     * \return start and stop code
+     */
+    std::vector<Statement> DescribeStartStop(const std::string &container, const std::string &start, const std::string &end);
 };
 
 #endif /* APPLICATION_H */
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file backend.cpp
+ * \brief Rendering of the code description into a language.
+ */
+
+#include "backend.h"
+
+Backend::~Backend()
+{
+}
+
+std::vector<std::string> Backend::Render(const std::vector<Statement> &statements) const
+{
+  std::vector<std::string> lines;
+  for(size_t i = 0; i < statements.size(); i++)
+  {
+    std::vector<std::string> statement = this->RenderStatement(statements.at(i));
+    lines.insert(lines.end(), statement.begin(), statement.end());
+  }
+  return lines;
+}
+
+std::string Backend::RenderArgs(const std::vector<Expression> &args) const
+{
+  std::string code = "";
+  for(size_t i = 0; i < args.size(); i++)
+  {
+    if(i > 0)
+    {
+      code += ", ";
+    }
+    code += this->RenderExpression(args.at(i));
+  }
+  return code;
+}
+
+void Backend::RenderBody(const std::vector<Statement> &body, std::vector<std::string> &lines) const
+{
+  std::vector<std::string> code = this->Render(body);
+  for(size_t i = 0; i < code.size(); i++)
+  {
+    lines.push_back(this->GetIndent() + code.at(i));
+  }
+}
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file backend.h
+ * \brief Rendering of the code description into a language.
+ */
+
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include <string>
+#include <vector>
+
+#include "statement.h"
+
+/**
+ * \ingroup generator
+ * \brief Rendering of the code description into a language.
+ *
+ *  The nodes, links and applications describe their code once (see
+ *  Statement) and the Generator renders the description with the backend of
+ *  each generated language, so all the languages are generated by a single
+ *  traversal of the model. A new language is a subclass of Backend.
+ */
+class Backend
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~Backend();
+
+    /**
+     * \brief Get the language name ("cpp", "python", ...).
+     * \return language name
+     */
+    virtual std::string GetName() const = 0;
+
+    /**
+     * \brief Get the indentation of a block level.
+     * \return indentation
+     */
+    virtual std::string GetIndent() const = 0;
+
+    /**
+     * \brief Render an expression.
+     * \param expression expression
+     * \return code
+     */
+    virtual std::string RenderExpression(const Expression &expression) const = 0;
+
+    /**
+     * \brief Render a statement.
+     * \param statement statement
+     * \return code lines (several for a loop)
+     */
+    virtual std::vector<std::string> RenderStatement(const Statement &statement) const = 0;
+
+    /**
+     * \brief Render a list of statements.
+     * \param statements statements
+     * \return code lines
+     */
+    std::vector<std::string> Render(const std::vector<Statement> &statements) const;
+
+  protected:
+    /**
+     * \brief Render the arguments of a call.
+     * \param args arguments
+     * \return arguments separated by a comma
+     */
+    std::string RenderArgs(const std::vector<Expression> &args) const;
+
+    /**
+     * \brief Render the body of a loop, indented.
+     * \param body body statements
+     * \param lines code to complete (output)
+     */
+    void RenderBody(const std::vector<Statement> &body, std::vector<std::string> &lines) const;
+};
+
+#endif /* BACKEND_H */
@@ -42,6 +42,11 @@ Bridge::~Bridge()
 {
 }
 
+std::string Bridge::GetSignature()
+{
+  return NetworkHardware::GetSignature() + this->m_nodeBridge + "\n";
+}
+
 std::string Bridge::GetNodeBridge()
 {
   return this->m_nodeBridge;
@@ -61,118 +66,53 @@ std::vector<std::string> Bridge::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Bridge::GenerateNetworkHardwareCpp()
-{
-  std::vector<std::string> generatedLink;
-  /* creation of the link. */
-  generatedLink.push_back("CsmaHelper csma_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\",  TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
-
-  return generatedLink;
-}
-
-std::vector<std::string> Bridge::GenerateNetDeviceCpp()
-{
-  std::vector<std::string> ndc;
-  //ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-
-  ndc.push_back("NetDeviceContainer terminalDevices_" + this->GetNetworkHardwareName() + ";");
-  ndc.push_back("NetDeviceContainer BridgeDevices_" + this->GetNetworkHardwareName() + ";");
-
-  ndc.push_back("for (int i = 0; i < " + utils::integerToString(allNodes.size() - 1) + "; i++)");
-  ndc.push_back("{");
-  ndc.push_back(" NetDeviceContainer link = csma_" + this->GetNetworkHardwareName() + ".Install(NodeContainer(" + this->GetAllNodeContainer() + ".Get(i), " + this->m_nodeBridge + "));");
-  ndc.push_back(" terminalDevices_" + this->GetNetworkHardwareName() + ".Add (link.Get(0));");
-  ndc.push_back(" BridgeDevices_" + this->GetNetworkHardwareName() + ".Add (link.Get(1));");
-  ndc.push_back("}");
-
-  ndc.push_back("BridgeHelper bridge_" + this->GetNetworkHardwareName() + ";");
-  ndc.push_back("bridge_" + this->GetNetworkHardwareName() + ".Install (" + this->m_nodeBridge + ".Get(0), BridgeDevices_" + this->GetNetworkHardwareName() + ");");
-
-  ndc.push_back("NetDeviceContainer ndc_" + this->GetNetworkHardwareName() + " = terminalDevices_" + this->GetNetworkHardwareName() + ";"); 
-
-  return ndc;
-}
-
-std::vector<std::string> Bridge::GenerateTraceCpp()
+std::vector<Statement> Bridge::DescribeNetworkHardware()
 {
-  std::vector<std::string> trace;
-
-  if(this->GetTrace())
-  {
-    if(this->GetPromisc())
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", true);");
-    }
-    else
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", false);");
-    }
-  }
-
-  return trace;
-}
-
-std::vector<std::string> Bridge::GenerateNetworkHardwarePython()
-{
-  std::vector<std::string> generatedLink;
-
+  std::vector<Statement> generatedLink;
   /* creation of the link. */
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + " = ns3.CsmaHelper();");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute(\"DataRate\", ns3.DataRateValue (ns3.DataRate(" + this->GetDataRate() + ")))");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute(\"Delay\",  ns3.TimeValue (ns3.MilliSeconds(" + this->GetNetworkHardwareDelay() + ")))");
+  generatedLink.push_back(Statement::Declare("CsmaHelper", "csma_" + this->GetNetworkHardwareName()));
+  std::vector<Statement> attributes = this->DescribeDataRateDelay("csma_" + this->GetNetworkHardwareName(), "SetChannelAttribute");
+  generatedLink.insert(generatedLink.end(), attributes.begin(), attributes.end());
 
   return generatedLink;
 }
 
-std::vector<std::string> Bridge::GenerateNetDevicePython()
+std::vector<Statement> Bridge::DescribeNetDevice()
 {
-  std::vector<std::string> ndc;
-  //ndc.push_back("" + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install(" + this->GetAllNodeContainer() + ")");
-
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerPython();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
+  std::vector<Statement> ndc = this->GroupAsNodeContainer();
+  /* the first statement declares the container, the others add the nodes. */
+  size_t count = ndc.size() - 1;
+  std::string csma = "csma_" + this->GetNetworkHardwareName();
+  std::string terminalDevices = "terminalDevices_" + this->GetNetworkHardwareName();
+  std::string bridgeDevices = "BridgeDevices_" + this->GetNetworkHardwareName();
 
-  ndc.push_back("terminalDevices_" + this->GetNetworkHardwareName() + " = ns3.NetDeviceContainer()");
-  ndc.push_back("BridgeDevices_" + this->GetNetworkHardwareName() + " = ns3.NetDeviceContainer()");
+  ndc.push_back(Statement::Declare("NetDeviceContainer", terminalDevices));
+  ndc.push_back(Statement::Declare("NetDeviceContainer", bridgeDevices));
 
-  ndc.push_back("for i in range(" + utils::integerToString(allNodes.size() - 1) + "):");
-  ndc.push_back("    link = csma_" + this->GetNetworkHardwareName() + ".Install(NodeContainer(" + this->GetAllNodeContainer() + ".Get(i), " + this->GetNodeBridge() + "))");
-  ndc.push_back("    terminalDevices_" + this->GetNetworkHardwareName() + ".Add(link.Get(0))");
-  ndc.push_back("    BridgeDevices_" + this->GetNetworkHardwareName() + ".Add(link.Get(1))");
+  Statement loop = Statement::Loop("i", utils::integerToString(count));
+  loop.Add(Statement::Define("NetDeviceContainer", "link", Expression::Method(csma, "Install").Arg(Expression::Function("NodeContainer")
+          .Arg(Expression::Method(this->GetAllNodeContainer(), "Get").Arg(Expression::Name("i"))).Arg(Expression::Name(this->m_nodeBridge)))));
+  loop.Add(Statement::Call(terminalDevices, "Add").Arg(Expression::Method("link", "Get").Arg(Expression::Name("0"))));
+  loop.Add(Statement::Call(bridgeDevices, "Add").Arg(Expression::Method("link", "Get").Arg(Expression::Name("1"))));
+  ndc.push_back(loop);
 
-  ndc.push_back("bridge_" + this->GetNetworkHardwareName() + " = ns3.BridgeHelper");
-  ndc.push_back("bridge_" + this->GetNetworkHardwareName() + ".Install(" + this->m_nodeBridge + ".Get(0), BridgeDevices_" + this->GetNetworkHardwareName() + ")");
+  ndc.push_back(Statement::Declare("BridgeHelper", "bridge_" + this->GetNetworkHardwareName()));
+  ndc.push_back(Statement::Call("bridge_" + this->GetNetworkHardwareName(), "Install")
+      .Arg(Expression::Method(this->m_nodeBridge, "Get").Arg(Expression::Name("0"))).Arg(Expression::Name(bridgeDevices)));
 
-  ndc.push_back("ndc_" + this->GetNetworkHardwareName() + " = terminalDevices_" + this->GetNetworkHardwareName() + ""); 
+  ndc.push_back(Statement::Define("NetDeviceContainer", "ndc_" + this->GetNetworkHardwareName(), Expression::Name(terminalDevices)));
 
   return ndc;
 }
 
-std::vector<std::string> Bridge::GenerateTracePython()
+std::vector<Statement> Bridge::DescribeTrace()
 {
-  std::vector<std::string> trace;
+  std::vector<Statement> trace;
 
   if(this->GetTrace())
   {
-    if(this->GetPromisc())
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll(\"csma_" + this->GetNetworkHardwareName() + "\", true)");
-    }
-    else
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll(\"csma_" + this->GetNetworkHardwareName() + "\", false)");
-    }
+    trace.push_back(Statement::Call("csma_" + this->GetNetworkHardwareName(), "EnablePcapAll")
+        .Arg(Expression::String("csma_" + this->GetNetworkHardwareName())).Arg(Expression::Boolean(this->GetPromisc())));
   }
 
   return trace;
@@ -69,6 +69,12 @@ class Bridge : public NetworkHardware
      */
     virtual ~Bridge();
 
+    /**
+     * \brief Get the inputs of the code generation of the bridge.
+     * \return signature (one field per line)
+     */
+    virtual std::string GetSignature();
+
     /**
      * \brief Get bridge node name.
      * \return node name
@@ -88,40 +94,22 @@ class Bridge : public NetworkHardware
     virtual std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate build link C++ code.
-     * \return build link code
-     */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
-
-    /**
-     * \brief Generate build of the net device container for C++.
-     * \return net device container code
-     */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
-
-    /**
-     * \brief Generate trace line for C++.
-     * \return trace line code
-     */
-    virtual std::vector<std::string> GenerateTraceCpp();
-    
-    /**
-     * \brief Generate build link python code.
+     * \brief Describe build link code.
      * \return build link code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwarePython();
+    virtual std::vector<Statement> DescribeNetworkHardware();
 
     /**
-     * \brief Generate build of the net device container for python.
+     * \brief Describe build of the net device container.
      * \return net device container code
      */
-    virtual std::vector<std::string> GenerateNetDevicePython();
+    virtual std::vector<Statement> DescribeNetDevice();
 
     /**
-     * \brief Generate trace line for python.
+     * \brief Describe trace line.
      * \return trace line code
      */
-    virtual std::vector<std::string> GenerateTracePython();
+    virtual std::vector<Statement> DescribeTrace();
 };
 
 #endif /* BRIDGE_H */
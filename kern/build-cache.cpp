@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file build-cache.cpp
+ * \brief Structure hash of the generated C++ code and its build cache helper.
+ */
+
+#include <cctype>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#include "build-cache.h"
+#include "codec.h"
+#include "fragment-cache.h"
+#include "sharding.h"
+
+BuildCache::BuildCache(const std::string &fileName)
+{
+  this->m_fileName = fileName;
+}
+
+BuildCache::~BuildCache()
+{
+}
+
+void BuildCache::AddParameters(const std::vector<std::string> &vars, const std::vector<std::string> &cmdLine)
+{
+  /* cmd.AddValue ("option", "help", variable); */
+  for(size_t i = 0; i < cmdLine.size(); i++)
+  {
+    const std::string &line = cmdLine.at(i);
+    std::string::size_type call = line.find("cmd.AddValue");
+    std::string::size_type begin = line.find('"', call);
+    std::string::size_type end = line.find('"', begin + 1);
+    std::string::size_type comma = line.find_last_of(',');
+    std::string::size_type close = line.find_last_of(')');
+    if(call == std::string::npos || end == std::string::npos || comma == std::string::npos || close == std::string::npos || close < comma)
+    {
+      continue;
+    }
+    std::string variable = line.substr(comma + 1, close - comma - 1);
+    variable.erase(0, variable.find_first_not_of(' '));
+    variable.erase(variable.find_last_not_of(' ') + 1);
+    this->m_options[variable] = line.substr(begin + 1, end - begin - 1);
+  }
+
+  std::string::size_type begin = 0;
+  std::string name, value;
+  for(size_t i = 0; i < vars.size(); i++)
+  {
+    std::map<std::string, std::string>::const_iterator option;
+    if(!BuildCache::SplitDefinition(vars.at(i), begin, name, value) || (option = this->m_options.find(name)) == this->m_options.end())
+    {
+      continue;
+    }
+
+    /* a string literal is given without its quotes. */
+    if(value.size() >= 2 && value[0] == '"' && value[value.size() - 1] == '"')
+    {
+      std::string literal = "";
+      for(size_t j = 1; j + 1 < value.size(); j++)
+      {
+        if(value[j] == '\\' && j + 2 < value.size())
+        {
+          j++;
+        }
+        literal += value[j];
+      }
+      value = literal;
+    }
+    this->m_values.push_back(std::make_pair(option->second, value));
+  }
+}
+
+void BuildCache::AddLine(const std::string &line)
+{
+  std::string::size_type begin = 0;
+  std::string name, value;
+  if(!this->m_options.empty() && BuildCache::SplitDefinition(line, begin, name, value) && this->m_options.find(name) != this->m_options.end())
+  {
+    /* "uint64_t dataRate_hub_0 = 100000000;" is hashed as "uint64_t dataRate_hub_0;". */
+    this->m_buffer.append(line, 0, begin + name.size());
+    this->m_buffer += ";\n";
+  }
+  else
+  {
+    this->m_buffer += line;
+    this->m_buffer += '\n';
+  }
+
+  /* the lines are hashed by blocks, the code is never held in memory. */
+  if(this->m_buffer.size() >= (1 << 20))
+  {
+    this->m_hash = FragmentCache::Hash(this->m_hash + this->m_buffer);
+    this->m_buffer.clear();
+  }
+}
+
+std::string BuildCache::GetHash()
+{
+  return FragmentCache::Hash(this->m_hash + this->m_buffer);
+}
+
+std::string BuildCache::GetScriptName() const
+{
+  std::string::size_type slash = this->m_fileName.find_last_of("/\\");
+  std::string::size_type dot = this->m_fileName.find_last_of('.');
+  if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return this->m_fileName + "-build.sh";
+  }
+  return this->m_fileName.substr(0, dot) + "-build.sh";
+}
+
+std::vector<std::string> BuildCache::GenerateScript(const std::vector<std::string> &headers, const std::vector<std::string> &files,
+    const std::string &compression, const bool &makefile)
+{
+  std::vector<std::string> script;
+  std::string program = BuildCache::BaseName(this->m_fileName);
+  program = program.substr(0, program.find_last_of('.'));
+
+  std::string extension = "";
+  if(compression != "")
+  {
+    Codec *codec = Codec::Create(compression);
+    extension = codec->GetExtension();
+    delete codec;
+  }
+
+  script.push_back("#!/bin/sh");
+  script.push_back("# Build cache helper of the " + program + " simulation, usage: sh " + BuildCache::BaseName(this->GetScriptName()) + " [arguments].");
+  script.push_back("# The program is built once per structure hash and run with the parameter values of this scenario.");
+  script.push_back("# NS3_BUILD_CACHE sets the cache directory, NS3_BUILD_ONLY=1 only prints the program path, the build log goes to stderr.");
+  script.push_back("HASH=" + this->GetHash());
+  script.push_back("NS3_PKG_PREFIX=${NS3_PKG_PREFIX-libns3-dev-}");
+  script.push_back("NS3_PKG_SUFFIX=${NS3_PKG_SUFFIX--debug}");
+  script.push_back("NS3_MODULES=\"" + Sharding::GetModules(headers) + "\"");
+  script.push_back("NS3_BUILD_CACHE=${NS3_BUILD_CACHE:-${XDG_CACHE_HOME:-$HOME/.cache}/ns-3-generator}");
+  script.push_back("CXX=${CXX:-c++}");
+  script.push_back("DIR=$(cd \"$(dirname \"$0\")\" && pwd) || exit 1");
+  script.push_back("PKGS=");
+  script.push_back("for module in $NS3_MODULES; do PKGS=\"$PKGS $NS3_PKG_PREFIX$module$NS3_PKG_SUFFIX\"; done");
+  script.push_back("");
+  script.push_back("# the compiler, its flags and the ns-3 version are part of the key.");
+  script.push_back("TOOLS=$({ \"$CXX\" --version 2>/dev/null | head -n 1; echo \"$CXXFLAGS $LDFLAGS\"; pkg-config --modversion $PKGS 2>/dev/null; } | cksum | cut -d ' ' -f 1)");
+  script.push_back("PROGRAM=\"$NS3_BUILD_CACHE/$HASH-$TOOLS/simulation\"");
+  script.push_back("");
+  script.push_back("# build into a private directory, the rename makes the program visible at once.");
+  script.push_back("if [ ! -x \"$PROGRAM\" ]; then");
+  script.push_back("  mkdir -p \"$NS3_BUILD_CACHE/$HASH-$TOOLS\" || exit 1");
+  script.push_back("  BUILD=$(mktemp -d \"$NS3_BUILD_CACHE/build.XXXXXX\") || exit 1");
+  script.push_back("  (");
+  script.push_back("    cd \"$BUILD\" &&");
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    std::string file = BuildCache::BaseName(files.at(i));
+    if(compression != "")
+    {
+      script.push_back("    " + compression + " -dc \"$DIR\"/" + BuildCache::Quote(file + extension) + " > " + BuildCache::Quote(file) + " &&");
+    }
+    else
+    {
+      script.push_back("    cp \"$DIR\"/" + BuildCache::Quote(file) + " . &&");
+    }
+  }
+  if(makefile)
+  {
+    script.push_back("    make NS3_PKG_PREFIX=\"$NS3_PKG_PREFIX\" NS3_PKG_SUFFIX=\"$NS3_PKG_SUFFIX\" CXX=\"$CXX\" ${NS3_BUILD_JOBS:+-j$NS3_BUILD_JOBS} >&2 &&");
+    script.push_back("    mv -f " + BuildCache::Quote(program) + " simulation");
+  }
+  else
+  {
+    script.push_back("    \"$CXX\" $CXXFLAGS $(pkg-config --cflags $PKGS) -o simulation " + BuildCache::Quote(BuildCache::BaseName(this->m_fileName)) +
+        " $LDFLAGS $(pkg-config --libs $PKGS) >&2");
+  }
+  script.push_back("  ) && mv -f \"$BUILD/simulation\" \"$PROGRAM\"");
+  script.push_back("  STATUS=$?");
+  script.push_back("  rm -rf \"$BUILD\"");
+  script.push_back("  [ $STATUS -eq 0 ] || exit $STATUS");
+  script.push_back("fi");
+  script.push_back("");
+  script.push_back("if [ -n \"$NS3_BUILD_ONLY\" ]; then");
+  script.push_back("  echo \"$PROGRAM\"");
+  script.push_back("  exit 0");
+  script.push_back("fi");
+  script.push_back("exec \"$PROGRAM\" \\");
+  for(size_t i = 0; i < this->m_values.size(); i++)
+  {
+    script.push_back("  " + BuildCache::Quote("--" + this->m_values.at(i).first + "=" + this->m_values.at(i).second) + " \\");
+  }
+  script.push_back("  \"$@\"");
+
+  return script;
+}
+
+void BuildCache::WriteScript(const std::vector<std::string> &script)
+{
+  std::string fileName = this->GetScriptName();
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::trunc);
+  if(!file.is_open())
+  {
+    throw std::runtime_error("Write build script failed! (" + fileName + ") can not be opened.");
+  }
+  for(size_t i = 0; i < script.size(); i++)
+  {
+    file << script.at(i) << '\n';
+  }
+  file.close();
+#ifndef _WIN32
+  chmod(fileName.c_str(), 0755);
+#endif
+}
+
+bool BuildCache::SplitDefinition(const std::string &line, std::string::size_type &begin, std::string &name, std::string &value)
+{
+  std::string::size_type equal = line.find(" = ");
+  std::string::size_type end = line.find_last_not_of(' ');
+  if(equal == std::string::npos || equal == 0 || end == std::string::npos || line[end] != ';' || end < equal + 3)
+  {
+    return false;
+  }
+
+  /* the name is the last word before " = ", a type comes before it. */
+  std::string::size_type space = line.find_last_of(' ', equal - 1);
+  if(space == std::string::npos || line.find_first_not_of(' ') >= space)
+  {
+    return false;
+  }
+  begin = space + 1;
+  name = line.substr(begin, equal - begin);
+  if(name == "" || !(isalpha(name[0]) || name[0] == '_'))
+  {
+    return false;
+  }
+  value = line.substr(equal + 3, end - equal - 3);
+  return true;
+}
+
+std::string BuildCache::BaseName(const std::string &fileName)
+{
+  std::string::size_type slash = fileName.find_last_of("/\\");
+  if(slash == std::string::npos)
+  {
+    return fileName;
+  }
+  return fileName.substr(slash + 1);
+}
+
+std::string BuildCache::Quote(const std::string &str)
+{
+  std::string quoted = "'";
+  for(size_t i = 0; i < str.size(); i++)
+  {
+    if(str[i] == '\'')
+    {
+      quoted += "'\\''";
+    }
+    else
+    {
+      quoted += str[i];
+    }
+  }
+  return quoted + "'";
+}
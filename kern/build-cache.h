@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file build-cache.h
+ * \brief Structure hash of the generated C++ code and its build cache helper.
+ */
+
+#ifndef BUILD_CACHE_H
+#define BUILD_CACHE_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Structure hash of the generated C++ code and its build cache helper.
+ *
+ *  The structure hash is the hash of the generated C++ files where the
+ *  default value of each CommandLine parameter is left out: two scenarios
+ *  which only differ by their parameter values (data rates, delays, times,
+ *  group sizes, ... with the command line parameters enabled) have the same
+ *  hash, one compiled program runs both.
+ *
+ *  The build cache helper is a shell script generated next to the code. It
+ *  looks for the program of the hash in a local cache directory, builds it
+ *  on a miss, then runs it with the parameter values of this scenario:
+ *    - "sh scenario-build.sh [args]" builds or reuses the program and runs it,
+ *      the arguments override the scenario values,
+ *    - NS3_BUILD_ONLY=1 only prints the program path,
+ *    - NS3_BUILD_CACHE sets the cache directory (default
+ *      "~/.cache/ns-3-generator"),
+ *    - the compiler, its flags and the ns-3 version are part of the key,
+ *    - a program is built in a private directory then renamed, concurrent
+ *      helpers never run a partial program.
+ */
+class BuildCache
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param fileName generated main file name
+     */
+    BuildCache(const std::string &fileName);
+
+    /**
+     * \brief Destructor.
+     */
+    ~BuildCache();
+
+    /**
+     * \brief Add the CommandLine parameters.
+     *
+     *  The variables bound by a "cmd.AddValue" line are parameters, their
+     *  default values are left out of the hash and given to the program by
+     *  the helper.
+     *
+     * \param vars variables code
+     * \param cmdLine command line code
+     */
+    void AddParameters(const std::vector<std::string> &vars, const std::vector<std::string> &cmdLine);
+
+    /**
+     * \brief Add a generated line to the hash.
+     * \param line code line
+     */
+    void AddLine(const std::string &line);
+
+    /**
+     * \brief Get the structure hash of the added lines.
+     * \return hash (32 hex digits)
+     */
+    std::string GetHash();
+
+    /**
+     * \brief Get the build cache helper name.
+     *
+     * "dir/scenario.cc" gives "dir/scenario-build.sh".
+     *
+     * \return helper file name
+     */
+    std::string GetScriptName() const;
+
+    /**
+     * \brief Generate the build cache helper.
+     *
+     *  The generated files are copied (or decompressed) into the build
+     *  directory, then the main file is compiled, or "make" is run if a
+     *  Makefile is generated with the code.
+     *
+     * \param headers ns-3 headers code (gives the pkg-config modules)
+     * \param files generated file names, as written
+     * \param compression codec of the generated files (empty for plain files)
+     * \param makefile true if the files have their own Makefile
+     * \return helper content
+     */
+    std::vector<std::string> GenerateScript(const std::vector<std::string> &headers, const std::vector<std::string> &files,
+        const std::string &compression, const bool &makefile);
+
+    /**
+     * \brief Write the build cache helper (plain and executable).
+     * \param script helper content
+     */
+    void WriteScript(const std::vector<std::string> &script);
+
+  private:
+    /**
+     * \brief Generated main file name.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief Option name of each parameter variable.
+     */
+    std::map<std::string, std::string> m_options;
+
+    /**
+     * \brief Option name and value of the parameters, in the order they are added.
+     */
+    std::vector<std::pair<std::string, std::string> > m_values;
+
+    /**
+     * \brief Lines not hashed yet.
+     */
+    std::string m_buffer;
+
+    /**
+     * \brief Hash of the lines already hashed.
+     */
+    std::string m_hash;
+
+    /**
+     * \brief Split a variable definition "Type name = value;".
+     * \param line code line
+     * \param begin position of the name (output)
+     * \param name variable name (output)
+     * \param value variable value (output)
+     * \return true if the line is a variable definition
+     */
+    static bool SplitDefinition(const std::string &line, std::string::size_type &begin, std::string &name, std::string &value);
+
+    /**
+     * \brief Remove the directory of a file name.
+     * \param fileName file name
+     * \return base name
+     */
+    static std::string BaseName(const std::string &fileName);
+
+    /**
+     * \brief Quote a string for the shell.
+     * \param str string to quote
+     * \return quoted string
+     */
+    static std::string Quote(const std::string &str);
+};
+
+#endif /* BUILD_CACHE_H */
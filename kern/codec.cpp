@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file codec.cpp
+ * \brief Block compression codec.
+ */
+
+#include <stdexcept>
+
+#include "codec.h"
+#include "gzip-codec.h"
+
+Codec::~Codec()
+{
+}
+
+Codec* Codec::Create(const std::string &name)
+{
+  if(name == "gzip")
+  {
+    return new GzipCodec();
+  }
+  throw std::logic_error("Codec failed! (" + name + ") unknown codec.");
+}
+
+std::vector<std::string> Codec::GetCodecs()
+{
+  std::vector<std::string> codecs;
+  codecs.push_back("gzip");
+  return codecs;
+}
+
+std::string Codec::FromFileName(const std::string &fileName)
+{
+  std::vector<std::string> codecs = Codec::GetCodecs();
+  for(size_t i = 0; i < codecs.size(); i++)
+  {
+    Codec *codec = Codec::Create(codecs.at(i));
+    std::string extension = codec->GetExtension();
+    delete codec;
+    if(fileName.size() > extension.size() && fileName.compare(fileName.size() - extension.size(), extension.size(), extension) == 0)
+    {
+      return codecs.at(i);
+    }
+  }
+  return "";
+}
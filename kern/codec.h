@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file codec.h
+ * \brief Block compression codec.
+ */
+
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Block compression codec.
+ *
+ *  A compressed file (see CompressedFile) is a sequence of self-contained
+ *  frames, each one holding a compressed block. A codec encodes a block into
+ *  a frame, gives the size of a frame from its header and decodes a frame, so
+ *  the blocks of a file can be compressed and decompressed in parallel.
+ *
+ *  The codecs are known by their name. A new codec is a subclass added to
+ *  Create and GetCodecs.
+ */
+class Codec
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~Codec();
+
+    /**
+     * \brief Get the codec name.
+     * \return codec name
+     */
+    virtual std::string GetName() const = 0;
+
+    /**
+     * \brief Get the file name extension of the codec.
+     * \return extension (with the dot)
+     */
+    virtual std::string GetExtension() const = 0;
+
+    /**
+     * \brief Get the size of a frame header.
+     * \return header size (in bytes)
+     */
+    virtual size_t GetHeaderSize() const = 0;
+
+    /**
+     * \brief Get the size of a frame from its header.
+     * \param header frame header (GetHeaderSize bytes)
+     * \return frame size (in bytes, header included), 0 if it is not a frame of this codec
+     */
+    virtual size_t GetFrameSize(const std::string &header) const = 0;
+
+    /**
+     * \brief Get the largest frame the codec writes for a block.
+     * \param blockSize block size (in bytes)
+     * \return frame size bound (in bytes, header included)
+     */
+    virtual size_t GetMaxFrameSize(const size_t &blockSize) const = 0;
+
+    /**
+     * \brief Compress a block into a frame.
+     * \param block block to compress
+     * \return frame
+     */
+    virtual std::string Compress(const std::string &block) const = 0;
+
+    /**
+     * \brief Decompress a frame.
+     * \param frame frame to decompress
+     * \param maxBlockSize largest block size accepted (the frame is rejected before the block is allocated)
+     * \return block
+     */
+    virtual std::string Decompress(const std::string &frame, const size_t &maxBlockSize) const = 0;
+
+    /**
+     * \brief Create a codec from its name.
+     * \param name codec name
+     * \return codec (to be deleted by the caller)
+     */
+    static Codec* Create(const std::string &name);
+
+    /**
+     * \brief Get the available codec names.
+     * \return codec names
+     */
+    static std::vector<std::string> GetCodecs();
+
+    /**
+     * \brief Find the codec of a file from its name extension.
+     * \param fileName file name
+     * \return codec name (empty if the file is not compressed)
+     */
+    static std::string FromFileName(const std::string &fileName);
+};
+
+#endif /* CODEC_H */
@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file compressed-file.cpp
+ * \brief File compressed by blocks in parallel.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "compressed-file.h"
+
+const size_t CompressedFile::BLOCK_SIZE = 1 << 20;
+
+CompressedFile::CompressedFile()
+{
+  this->m_codec = NULL;
+  this->m_outputPos = 0;
+  this->m_threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+CompressedFile::~CompressedFile()
+{
+  try
+  {
+    this->Close();
+  }
+  catch(const std::exception &)
+  {
+    /* a destructor does not throw, Close reports the errors. */
+  }
+}
+
+void CompressedFile::Create(const std::string &fileName, const std::string &codec)
+{
+  this->Close();
+  this->m_codec = codec != "" ? Codec::Create(codec) : NULL;
+  this->m_out.open(fileName.c_str(), std::ios::binary);
+  if(!this->m_out.is_open())
+  {
+    delete this->m_codec;
+    this->m_codec = NULL;
+    throw std::runtime_error("Create compressed file failed! (" + fileName + ") can not be opened.");
+  }
+  this->m_fileName = fileName;
+}
+
+void CompressedFile::Write(const std::string &data)
+{
+  if(!this->m_out.is_open())
+  {
+    throw std::logic_error("Write compressed file failed! (no file created).");
+  }
+  if(!this->m_codec)
+  {
+    this->m_out.write(data.data(), data.size());
+    return;
+  }
+  this->m_pending += data;
+  if(this->m_pending.size() >= CompressedFile::BLOCK_SIZE * this->m_threads)
+  {
+    this->Flush(false);
+  }
+}
+
+void CompressedFile::Open(const std::string &fileName)
+{
+  this->Close();
+  this->m_in.open(fileName.c_str(), std::ios::binary);
+  if(!this->m_in.is_open())
+  {
+    throw std::runtime_error("Open compressed file failed! (" + fileName + ") can not be opened.");
+  }
+  this->m_fileName = fileName;
+  this->m_codec = this->Detect();
+}
+
+size_t CompressedFile::Read(char *data, const size_t &size)
+{
+  if(!this->m_in.is_open())
+  {
+    throw std::logic_error("Read compressed file failed! (no file opened).");
+  }
+  if(!this->m_codec)
+  {
+    this->m_in.read(data, size);
+    return this->m_in.gcount();
+  }
+
+  size_t done = 0;
+  while(done < size)
+  {
+    if(this->m_outputPos == this->m_output.size() && !this->Fill())
+    {
+      break;
+    }
+    size_t n = std::min(size - done, this->m_output.size() - this->m_outputPos);
+    this->m_output.copy(data + done, n, this->m_outputPos);
+    this->m_outputPos += n;
+    done += n;
+  }
+  return done;
+}
+
+bool CompressedFile::IsOpen() const
+{
+  return this->m_out.is_open() || this->m_in.is_open();
+}
+
+void CompressedFile::Close()
+{
+  if(this->m_out.is_open())
+  {
+    if(this->m_codec)
+    {
+      this->Flush(true);
+    }
+    this->m_out.close();
+    if(this->m_out.fail())
+    {
+      delete this->m_codec;
+      this->m_codec = NULL;
+      throw std::runtime_error("Write compressed file failed! (" + this->m_fileName + ") can not be written.");
+    }
+  }
+  if(this->m_in.is_open())
+  {
+    this->m_in.close();
+  }
+  this->m_in.clear();
+  this->m_out.clear();
+  delete this->m_codec;
+  this->m_codec = NULL;
+  this->m_pending.clear();
+  this->m_output.clear();
+  this->m_outputPos = 0;
+}
+
+size_t CompressedFile::GetFilePosition()
+{
+  std::streamoff pos = this->m_in.tellg();
+  return pos < 0 ? 0 : static_cast<size_t>(pos);
+}
+
+std::string CompressedFile::GetCodec() const
+{
+  return this->m_codec ? this->m_codec->GetName() : "";
+}
+
+bool CompressedFile::IsCompressed(const std::string &fileName)
+{
+  CompressedFile file;
+  file.Open(fileName);
+  return file.GetCodec() != "";
+}
+
+std::string CompressedFile::ReadFile(const std::string &fileName)
+{
+  CompressedFile file;
+  file.Open(fileName);
+  std::string content;
+  std::vector<char> buffer(CompressedFile::BLOCK_SIZE);
+  size_t n = 0;
+  while((n = file.Read(&buffer[0], buffer.size())) > 0)
+  {
+    content.append(&buffer[0], n);
+  }
+  return content;
+}
+
+void CompressedFile::Flush(const bool &all)
+{
+  std::vector<std::string> blocks;
+  size_t pos = 0;
+  while(this->m_pending.size() - pos >= CompressedFile::BLOCK_SIZE || (all && pos < this->m_pending.size()))
+  {
+    blocks.push_back(this->m_pending.substr(pos, CompressedFile::BLOCK_SIZE));
+    pos += blocks.back().size();
+  }
+  this->m_pending.erase(0, pos);
+
+  CompressedFile::Transform(this->m_codec, true, blocks, this->m_threads);
+  for(size_t i = 0; i < blocks.size(); i++)
+  {
+    this->m_out.write(blocks.at(i).data(), blocks.at(i).size());
+  }
+}
+
+bool CompressedFile::Fill()
+{
+  std::vector<std::string> frames;
+  size_t headerSize = this->m_codec->GetHeaderSize();
+  while(frames.size() < this->m_threads)
+  {
+    std::string frame(headerSize, '\0');
+    this->m_in.read(&frame[0], headerSize);
+    if(this->m_in.gcount() == 0)
+    {
+      break;
+    }
+    size_t size = this->m_codec->GetFrameSize(frame);
+    if(static_cast<size_t>(this->m_in.gcount()) < headerSize || size == 0)
+    {
+      throw std::logic_error("Read compressed file failed! (" + this->m_fileName + ") bad frame.");
+    }
+    /* a corrupted size must not allocate more than one block can take. */
+    if(size > this->m_codec->GetMaxFrameSize(CompressedFile::BLOCK_SIZE))
+    {
+      throw std::logic_error("Read compressed file failed! (" + this->m_fileName + ") oversized frame.");
+    }
+    frame.resize(size);
+    this->m_in.read(&frame[headerSize], size - headerSize);
+    if(static_cast<size_t>(this->m_in.gcount()) < size - headerSize)
+    {
+      throw std::logic_error("Read compressed file failed! (" + this->m_fileName + ") truncated frame.");
+    }
+    frames.push_back(frame);
+  }
+  if(frames.size() == 0)
+  {
+    return false;
+  }
+
+  CompressedFile::Transform(this->m_codec, false, frames, this->m_threads);
+  this->m_output.clear();
+  for(size_t i = 0; i < frames.size(); i++)
+  {
+    this->m_output += frames.at(i);
+  }
+  this->m_outputPos = 0;
+  return true;
+}
+
+Codec* CompressedFile::Detect()
+{
+  std::vector<std::string> codecs = Codec::GetCodecs();
+  for(size_t i = 0; i < codecs.size(); i++)
+  {
+    Codec *codec = Codec::Create(codecs.at(i));
+    std::string header(codec->GetHeaderSize(), '\0');
+    this->m_in.read(&header[0], header.size());
+    header.resize(this->m_in.gcount());
+    this->m_in.clear();
+    this->m_in.seekg(0);
+    if(codec->GetFrameSize(header) > 0)
+    {
+      return codec;
+    }
+    delete codec;
+  }
+  return NULL;
+}
+
+void CompressedFile::Transform(const Codec *codec, const bool &compress, std::vector<std::string> &blocks, const size_t &threads)
+{
+  // block i goes to the thread i % threads, an error is thrown after the join.
+  std::vector<std::string> errors(threads);
+  std::vector<std::thread> workers;
+  for(size_t i = 0; i < threads && i < blocks.size(); i++)
+  {
+    workers.push_back(std::thread(&CompressedFile::TransformRange, codec, compress, &blocks, i, threads, &errors.at(i)));
+  }
+  for(size_t i = 0; i < workers.size(); i++)
+  {
+    workers.at(i).join();
+  }
+  for(size_t i = 0; i < errors.size(); i++)
+  {
+    if(errors.at(i) != "")
+    {
+      throw std::runtime_error(errors.at(i));
+    }
+  }
+}
+
+void CompressedFile::TransformRange(const Codec *codec, const bool compress, std::vector<std::string> *blocks, const size_t first,
+    const size_t step, std::string *error)
+{
+  try
+  {
+    for(size_t i = first; i < blocks->size(); i += step)
+    {
+      blocks->at(i) = compress ? codec->Compress(blocks->at(i)) : codec->Decompress(blocks->at(i), CompressedFile::BLOCK_SIZE);
+    }
+  }
+  catch(const std::exception &e)
+  {
+    *error = e.what();
+  }
+}
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file compressed-file.h
+ * \brief File compressed by blocks in parallel.
+ */
+
+#ifndef COMPRESSED_FILE_H
+#define COMPRESSED_FILE_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "codec.h"
+
+/**
+ * \ingroup generator
+ * \brief File compressed by blocks in parallel.
+ *
+ *  The written data is cut into blocks of BLOCK_SIZE bytes. The blocks are
+ *  compressed by a codec (see Codec) on one thread per core and written as
+ *  frames in their order, so the memory used is a few blocks per core
+ *  whatever the file size. The reading decompresses the frames in parallel
+ *  the same way.
+ *
+ *  The codec of a read file is found from its first frame. A file without
+ *  a known frame is read as is, so a reader accepts plain files too.
+ */
+class CompressedFile
+{
+  public:
+    /**
+     * \brief Size of the compressed blocks (in bytes).
+     */
+    static const size_t BLOCK_SIZE;
+
+    /**
+     * \brief Constructor.
+     */
+    CompressedFile();
+
+    /**
+     * \brief Destructor, close the file.
+     */
+    ~CompressedFile();
+
+    /**
+     * \brief Create a file for writing.
+     * \param fileName file name
+     * \param codec codec name (empty to write a plain file)
+     */
+    void Create(const std::string &fileName, const std::string &codec);
+
+    /**
+     * \brief Write data.
+     * \param data data to write
+     */
+    void Write(const std::string &data);
+
+    /**
+     * \brief Open a file for reading.
+     * \param fileName file name
+     */
+    void Open(const std::string &fileName);
+
+    /**
+     * \brief Read data.
+     * \param data buffer
+     * \param size buffer size
+     * \return number of bytes read, 0 at the end of the file
+     */
+    size_t Read(char *data, const size_t &size);
+
+    /**
+     * \brief Get if a file is opened.
+     * \return true if a file is opened
+     */
+    bool IsOpen() const;
+
+    /**
+     * \brief Close the file, the last blocks are written.
+     */
+    void Close();
+
+    /**
+     * \brief Get the position into the read file.
+     * \return number of file bytes (compressed) already read
+     */
+    size_t GetFilePosition();
+
+    /**
+     * \brief Get the codec of the opened file.
+     * \return codec name (empty for a plain file)
+     */
+    std::string GetCodec() const;
+
+    /**
+     * \brief Check if a file is compressed by a known codec.
+     * \param fileName file name
+     * \return true if the file starts with a frame of a known codec
+     */
+    static bool IsCompressed(const std::string &fileName);
+
+    /**
+     * \brief Read a whole file, compressed or not.
+     * \param fileName file name
+     * \return file content
+     */
+    static std::string ReadFile(const std::string &fileName);
+
+  private:
+    /**
+     * \brief Written file.
+     */
+    std::ofstream m_out;
+
+    /**
+     * \brief Read file.
+     */
+    std::ifstream m_in;
+
+    /**
+     * \brief File name.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief Codec (NULL for a plain file).
+     */
+    Codec *m_codec;
+
+    /**
+     * \brief Written data not compressed yet.
+     */
+    std::string m_pending;
+
+    /**
+     * \brief Decompressed data not read yet.
+     */
+    std::string m_output;
+
+    /**
+     * \brief Read position into m_output.
+     */
+    size_t m_outputPos;
+
+    /**
+     * \brief Number of compression threads.
+     */
+    size_t m_threads;
+
+    /**
+     * \brief Compress and write the pending blocks.
+     * \param all true to write the last incomplete block too
+     */
+    void Flush(const bool &all);
+
+    /**
+     * \brief Read and decompress the next frames.
+     * \return false at the end of the file
+     */
+    bool Fill();
+
+    /**
+     * \brief Find the codec of the first frame of the read file.
+     * \return codec (NULL if none)
+     */
+    Codec* Detect();
+
+    /**
+     * \brief Apply the codec to blocks, one thread per core.
+     * \param codec the codec
+     * \param compress true to compress, false to decompress
+     * \param blocks blocks, replaced by the result
+     * \param threads number of threads
+     */
+    static void Transform(const Codec *codec, const bool &compress, std::vector<std::string> &blocks, const size_t &threads);
+
+    /**
+     * \brief Thread body of Transform, apply the codec to every step-th block.
+     * \param codec the codec
+     * \param compress true to compress, false to decompress
+     * \param blocks blocks, replaced by the result
+     * \param first first block of the thread
+     * \param step number of threads
+     * \param error error message (output, unchanged if none)
+     */
+    static void TransformRange(const Codec *codec, const bool compress, std::vector<std::string> *blocks, const size_t first,
+        const size_t step, std::string *error);
+};
+
+#endif /* COMPRESSED_FILE_H */
@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file cpp-backend.cpp
+ * \brief C++ backend.
+ */
+
+#include "cpp-backend.h"
+
+CppBackend::~CppBackend()
+{
+}
+
+std::string CppBackend::GetName() const
+{
+  return "cpp";
+}
+
+std::string CppBackend::GetIndent() const
+{
+  return "  ";
+}
+
+std::string CppBackend::RenderExpression(const Expression &expression) const
+{
+  switch(expression.GetKind())
+  {
+    case Expression::STRING:
+      return "\"" + expression.GetName() + "\"";
+    case Expression::FUNCTION:
+      return expression.GetName() + " (" + this->RenderArgs(expression.GetArgs()) + ")";
+    case Expression::CONVERT:
+      return this->RenderExpression(expression.GetArgs().at(0));
+    case Expression::STATIC:
+      return expression.GetName() + "::" + expression.GetMethod() + " (" + this->RenderArgs(expression.GetArgs()) + ")";
+    case Expression::METHOD:
+      return expression.GetName() + "." + expression.GetMethod() + " (" + this->RenderArgs(expression.GetArgs()) + ")";
+    case Expression::MAX:
+      {
+        /* std::max takes two values. */
+        const std::vector<Expression> &args = expression.GetArgs();
+        std::string code = this->RenderExpression(args.back());
+        for(size_t i = args.size() - 1; i > 0; i--)
+        {
+          code = "std::max (" + this->RenderExpression(args.at(i - 1)) + ", " + code + ")";
+        }
+        return code;
+      }
+    default:
+      return expression.GetName();
+  }
+}
+
+std::vector<std::string> CppBackend::RenderStatement(const Statement &statement) const
+{
+  std::vector<std::string> lines;
+  switch(statement.GetKind())
+  {
+    case Statement::DECLARE:
+      lines.push_back(statement.GetType() + " " + statement.GetName() + ";");
+      break;
+    case Statement::DEFINE:
+      lines.push_back(statement.GetType() + " " + statement.GetName() + " = " + this->RenderExpression(statement.GetExpression()) + ";");
+      break;
+    case Statement::CONSTRUCT:
+      /* "Type name ();" would declare a function. */
+      if(statement.GetExpression().GetArgs().size() == 0)
+      {
+        lines.push_back(statement.GetType() + " " + statement.GetName() + ";");
+      }
+      else
+      {
+        lines.push_back(statement.GetType() + " " + statement.GetName() + " (" + this->RenderArgs(statement.GetExpression().GetArgs()) + ");");
+      }
+      break;
+    case Statement::ASSIGN:
+      lines.push_back(statement.GetName() + " = " + this->RenderExpression(statement.GetExpression()) + ";");
+      break;
+    case Statement::EVALUATE:
+      lines.push_back(this->RenderExpression(statement.GetExpression()) + ";");
+      break;
+    case Statement::LOOP:
+      lines.push_back("for (int " + statement.GetName() + " = 0; " + statement.GetName() + " < " +
+          this->RenderExpression(statement.GetExpression()) + "; " + statement.GetName() + "++)");
+      lines.push_back("{");
+      this->RenderBody(statement.GetBody(), lines);
+      lines.push_back("}");
+      break;
+    case Statement::COMMENT:
+      lines.push_back("/* " + statement.GetName() + " */");
+      break;
+    case Statement::VERBATIM:
+      lines.push_back(statement.GetName());
+      break;
+  }
+  return lines;
+}
@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file cpp-backend.h
+ * \brief C++ backend.
+ */
+
+#ifndef CPP_BACKEND_H
+#define CPP_BACKEND_H
+
+#include "backend.h"
+
+/**
+ * \ingroup generator
+ * \brief C++ backend.
+ *
+ *  The statements are written in the ns-3 C++ style: a space before the
+ *  parenthesis of a call and a semicolon at the end.
+ */
+class CppBackend : public Backend
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~CppBackend();
+
+    /**
+     * \brief Get the language name.
+     * \return "cpp"
+     */
+    virtual std::string GetName() const;
+
+    /**
+     * \brief Get the indentation of a block level.
+     * \return indentation
+     */
+    virtual std::string GetIndent() const;
+
+    /**
+     * \brief Render an expression.
+     * \param expression expression
+     * \return code
+     */
+    virtual std::string RenderExpression(const Expression &expression) const;
+
+    /**
+     * \brief Render a statement.
+     * \param statement statement
+     * \return code lines
+     */
+    virtual std::vector<std::string> RenderStatement(const Statement &statement) const;
+};
+
+#endif /* CPP_BACKEND_H */
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file dead-object-pass.cpp
+ * \brief Removal of the scenario objects which take no part in the simulation.
+ */
+
+#include "dead-object-pass.h"
+
+DeadObjectPass::~DeadObjectPass()
+{
+}
+
+std::string DeadObjectPass::GetName() const
+{
+  return "dead-objects";
+}
+
+void DeadObjectPass::Run(Program &program, std::vector<std::string> &report)
+{
+  std::set<std::string> nodes = DeadObjectPass::Names(program, Program::OBJECT_NODE);
+
+  /* the object lists are copied, Remove changes them. */
+  std::vector<Program::Object> links = program.GetObjects(Program::OBJECT_LINK);
+  for(size_t i = 0; i < links.size(); i++)
+  {
+    const Program::Object &link = links.at(i);
+    std::string missing = DeadObjectPass::Missing(link.members, nodes);
+    if(missing == "")
+    {
+      missing = DeadObjectPass::Missing(link.uses, nodes);
+    }
+    std::set<std::string> members(link.members.begin(), link.members.end());
+    if(missing != "")
+    {
+      program.Remove(Program::OBJECT_LINK, link.name);
+      report.push_back("removed link " + link.name + " (" + missing + " deleted)");
+    }
+    else if(!link.external && members.size() < 2)
+    {
+      program.Remove(Program::OBJECT_LINK, link.name);
+      report.push_back("removed link " + link.name + " (fewer than two members)");
+    }
+  }
+
+  std::set<std::string> liveLinks = DeadObjectPass::Names(program, Program::OBJECT_LINK);
+  std::vector<Program::Object> applications = program.GetObjects(Program::OBJECT_APPLICATION);
+  for(size_t i = 0; i < applications.size(); i++)
+  {
+    const Program::Object &application = applications.at(i);
+    std::string deleted = DeadObjectPass::Missing(application.members, nodes);
+    std::string removed = DeadObjectPass::Missing(application.uses, liveLinks);
+    if(deleted != "")
+    {
+      program.Remove(Program::OBJECT_APPLICATION, application.name);
+      report.push_back("removed application " + application.name + " (" + deleted + " deleted)");
+    }
+    else if(removed != "")
+    {
+      program.Remove(Program::OBJECT_APPLICATION, application.name);
+      report.push_back("removed application " + application.name + " (" + removed + " removed)");
+    }
+  }
+
+  /* the nodes still used by a link or an application. */
+  std::set<std::string> used;
+  for(size_t kind = Program::OBJECT_LINK; kind <= Program::OBJECT_APPLICATION; kind++)
+  {
+    const std::vector<Program::Object> &objects = program.GetObjects(static_cast<Program::ObjectKind>(kind));
+    for(size_t i = 0; i < objects.size(); i++)
+    {
+      used.insert(objects.at(i).members.begin(), objects.at(i).members.end());
+      used.insert(objects.at(i).uses.begin(), objects.at(i).uses.end());
+    }
+  }
+  std::vector<Program::Object> nodeObjects = program.GetObjects(Program::OBJECT_NODE);
+  for(size_t i = 0; i < nodeObjects.size(); i++)
+  {
+    if(used.find(nodeObjects.at(i).name) == used.end())
+    {
+      program.Remove(Program::OBJECT_NODE, nodeObjects.at(i).name);
+      report.push_back("removed node " + nodeObjects.at(i).name + " (no link and no application)");
+    }
+  }
+}
+
+std::set<std::string> DeadObjectPass::Names(const Program &program, const Program::ObjectKind &kind)
+{
+  std::set<std::string> names;
+  const std::vector<Program::Object> &objects = program.GetObjects(kind);
+  for(size_t i = 0; i < objects.size(); i++)
+  {
+    names.insert(objects.at(i).name);
+  }
+  return names;
+}
+
+std::string DeadObjectPass::Missing(const std::vector<std::string> &objects, const std::set<std::string> &live)
+{
+  for(size_t i = 0; i < objects.size(); i++)
+  {
+    if(live.find(objects.at(i)) == live.end())
+    {
+      return objects.at(i);
+    }
+  }
+  return "";
+}
+
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file dead-object-pass.h
+ * \brief Removal of the scenario objects which take no part in the simulation.
+ */
+
+#ifndef DEAD_OBJECT_PASS_H
+#define DEAD_OBJECT_PASS_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "pass.h"
+
+/**
+ * \ingroup generator
+ * \brief Removal of the scenario objects which take no part in the simulation.
+ *
+ *  An edited scenario keeps objects which do nothing: a hub left with one
+ *  node, a link to a deleted node, a node on no link, an application whose
+ *  link is gone. They are still created by the simulation. This pass removes
+ *  in order:
+ *    - the links with a deleted endpoint or with fewer than two endpoints
+ *      (an emu or tap link only needs its node);
+ *    - the applications with a removed endpoint or receiver link;
+ *    - the nodes which are used by no remaining link or application.
+ *
+ *  A node is removed only if nothing uses it, so one sweep is enough.
+ */
+class DeadObjectPass : public Pass
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~DeadObjectPass();
+
+    /**
+     * \brief Get the pass name.
+     * \return "dead-objects"
+     */
+    virtual std::string GetName() const;
+
+    /**
+     * \brief Remove the dead objects of a program.
+     * \param program program to transform
+     * \param report removed objects (output)
+     */
+    virtual void Run(Program &program, std::vector<std::string> &report);
+
+  private:
+    /**
+     * \brief Get the names of the objects of a kind.
+     * \param program program
+     * \param kind object kind
+     * \return object names
+     */
+    static std::set<std::string> Names(const Program &program, const Program::ObjectKind &kind);
+
+    /**
+     * \brief Find an object which is not in a list.
+     * \param objects object names to check
+     * \param live names of the existing objects
+     * \return first missing name, empty if all the objects exist
+     */
+    static std::string Missing(const std::vector<std::string> &objects, const std::set<std::string> &live);
+};
+
+#endif /* DEAD_OBJECT_PASS_H */
+
@@ -41,6 +41,11 @@ Emu::~Emu()
 {
 }
 
+std::string Emu::GetSignature()
+{
+  return NetworkHardware::GetSignature() + this->m_emuNode + "\n" + this->m_ifaceName + "\n";
+}
+
 std::string Emu::GetEmuName()
 {
   return this->m_emuNode;
@@ -70,111 +75,48 @@ std::vector<std::string> Emu::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Emu::GenerateNetworkHardwareCpp()
-{
-  std::vector<std::string> generatedLink;
-  generatedLink.push_back("EmuHelper " + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back(this->GetNetworkHardwareName() + ".SetAttribute (\"DeviceName\", StringValue (emuDevice_" + this->GetNetworkHardwareName() + "));");
-
-  return generatedLink;
-}
-
-std::vector<std::string> Emu::GenerateNetDeviceCpp()
-{
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = " + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  return ndc;
-}
-
-std::vector<std::string> Emu::GenerateVarsCpp()
-{
-  std::vector<std::string> vars;
-  vars.push_back("std::string emuDevice_" + this->GetNetworkHardwareName() + " = \"" + this->GetIfaceName() + "\";");
-  return vars;
-}
-
-std::vector<std::string> Emu::GenerateCmdLineCpp()
+std::vector<Statement> Emu::DescribeNetworkHardware()
 {
-  std::vector<std::string> cmdLine;
-  cmdLine.push_back("cmd.AddValue(\"deviceName_" + this->GetNetworkHardwareName() + "\", \"device name\", emuDevice_" + this->GetNetworkHardwareName() + ");");
-  return cmdLine;
-}
-
-std::vector<std::string> Emu::GenerateTraceCpp()
-{
-  std::vector<std::string> trace;
-
-  if(this->GetTrace())
-  {
-    if(this->GetPromisc())
-    {
-      trace.push_back("EmuHelper::EnablePcap (\"Emu-" + this->GetNetworkHardwareName() + "\",\"" + this->m_ifaceName + "\", true);");
-    }
-    else
-    {
-      trace.push_back("EmuHelper::EnablePcap (\"Emu-" + this->GetNetworkHardwareName() + "\",\"" + this->m_ifaceName + "\", false);");
-    }
-  }
-
-  return trace;
-}
-
-std::vector<std::string> Emu::GenerateNetworkHardwarePython()
-{
-  std::vector<std::string> generatedLink;
-  generatedLink.push_back(this->GetNetworkHardwareName() + " = ns3.EmuHelper()");
-  generatedLink.push_back(this->GetNetworkHardwareName() + ".SetAttribute (\"DeviceName\", StringValue (emuDevice_" + this->GetNetworkHardwareName() + "))");
+  std::vector<Statement> generatedLink;
+  generatedLink.push_back(Statement::Declare("EmuHelper", this->GetNetworkHardwareName()));
+  generatedLink.push_back(Statement::Call(this->GetNetworkHardwareName(), "SetAttribute").Arg(Expression::String("DeviceName"))
+      .Arg(Expression::Function("StringValue").Arg(Expression::Name("emuDevice_" + this->GetNetworkHardwareName()))));
 
   return generatedLink;
 }
 
-std::vector<std::string> Emu::GenerateNetDevicePython()
+std::vector<Statement> Emu::DescribeNetDevice()
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerPython();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back(this->GetNdcName() + " = " + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ")");
+  std::vector<Statement> ndc = this->GroupAsNodeContainer();
+  ndc.push_back(Statement::Define("NetDeviceContainer", this->GetNdcName(),
+        Expression::Method(this->GetNetworkHardwareName(), "Install").Arg(Expression::Name(this->GetAllNodeContainer()))));
 
   return ndc;
 }
 
-std::vector<std::string> Emu::GenerateVarsPython()
+std::vector<Statement> Emu::DescribeVars()
 {
-  std::vector<std::string> vars;
-  vars.push_back("emuDevice_" + this->GetNetworkHardwareName() + " = \"" + this->m_ifaceName + "\"");
+  std::vector<Statement> vars;
+  vars.push_back(Statement::Define("std::string", "emuDevice_" + this->GetNetworkHardwareName(), Expression::String(this->GetIfaceName())));
   return vars;
 }
 
-std::vector<std::string> Emu::GenerateCmdLinePython()
+std::vector<Statement> Emu::DescribeCmdLine()
 {
-  std::vector<std::string> cmdLine;
-  cmdLine.push_back("cmd.AddValue(\"deviceName_" + this->GetNetworkHardwareName() + "\", \"device name\", emuDevice_" + this->GetNetworkHardwareName() + ")");
+  std::vector<Statement> cmdLine;
+  cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("deviceName_" + this->GetNetworkHardwareName()))
+      .Arg(Expression::String("device name")).Arg(Expression::Name("emuDevice_" + this->GetNetworkHardwareName())));
   return cmdLine;
 }
 
-std::vector<std::string> Emu::GenerateTracePython()
+std::vector<Statement> Emu::DescribeTrace()
 {
-  std::vector<std::string> trace;
+  std::vector<Statement> trace;
 
   if(this->GetTrace())
   {
-    if(this->GetPromisc())
-    {
-      trace.push_back("EmuHelper::EnablePcap (\"Emu-" + this->GetNetworkHardwareName() + "\",\"" + this->m_ifaceName + "\", true)");
-    }
-    else
-    {
-      trace.push_back("EmuHelper::EnablePcap (\"Emu-" + this->GetNetworkHardwareName() + "\",\"" + this->m_ifaceName + "\", false)");
-    }
+    trace.push_back(Statement::Evaluate(Expression::Static("EmuHelper", "EnablePcap").Arg(Expression::String("Emu-" + this->GetNetworkHardwareName()))
+          .Arg(Expression::String(this->m_ifaceName)).Arg(Expression::Boolean(this->GetPromisc()))));
   }
 
   return trace;
@@ -95,6 +95,12 @@ class Emu : public NetworkHardware
      */
     virtual ~Emu();
 
+    /**
+     * \brief Get the inputs of the code generation of the emu link.
+     * \return signature (one field per line)
+     */
+    virtual std::string GetSignature();
+
     /**
      * \brief Get emu node name.
      * \return emu node name
@@ -126,68 +132,36 @@ class Emu : public NetworkHardware
     virtual std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate build link C++ code.
-     * \return build link code
-     */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
-
-    /**
-     * \brief Generate build of the net device container C++ code.
-     * \return net device container code
-     */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
-
-    /**
-     * \brief Rewritted from base class.
-     * \return vars code
-     * \see Link
-     */
-    std::vector<std::string> GenerateVarsCpp();
-
-    /**
-     * \brief Rewritted from base class.
-     * \return cmd line code
-     * \see Link
-     */
-    virtual std::vector<std::string> GenerateCmdLineCpp();
-
-    /**
-     * \brief Generate the trace line C++ code.
-     * \return trace line
-     */
-    virtual std::vector<std::string> GenerateTraceCpp();
-    
-    /**
-     * \brief Generate build link python code.
+     * \brief Describe build link code.
      * \return build link code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwarePython();
+    virtual std::vector<Statement> DescribeNetworkHardware();
 
     /**
-     * \brief Generate build of the net device container python code.
+     * \brief Describe build of the net device container code.
      * \return net device container code
      */
-    virtual std::vector<std::string> GenerateNetDevicePython();
+    virtual std::vector<Statement> DescribeNetDevice();
 
     /**
      * \brief Rewritted from base class.
      * \return vars code
      * \see Link
      */
-    std::vector<std::string> GenerateVarsPython();
+    std::vector<Statement> DescribeVars();
 
     /**
      * \brief Rewritted from base class.
      * \return cmd line code
      * \see Link
      */
-    virtual std::vector<std::string> GenerateCmdLinePython();
+    virtual std::vector<Statement> DescribeCmdLine();
 
     /**
-     * \brief Generate the trace line python code.
+     * \brief Describe the trace line code.
      * \return trace line
      */
-    virtual std::vector<std::string> GenerateTracePython();
+    virtual std::vector<Statement> DescribeTrace();
 };
 
 #endif /* EMU_H */
@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file fragment-cache.cpp
+ * \brief Content-addressed on-disk cache of generated code fragments.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#include "fragment-cache.h"
+
+/**
+ * \brief Magic of an entry file.
+ */
+static const char ENTRY_MAGIC[] = "ngfc";
+
+/**
+ * \brief Rotate a 64 bits integer.
+ * \param x integer
+ * \param r rotation (in bits)
+ * \return rotated integer
+ */
+static uint64_t Rotate(const uint64_t &x, const int &r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * \brief Final mix of a MurmurHash3 half.
+ * \param k half of the hash
+ * \return mixed half
+ */
+static uint64_t Mix(uint64_t k)
+{
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+/**
+ * \brief Read a little endian 64 bits integer.
+ * \param data bytes, the missing ones (after size) are zero
+ * \param size number of bytes available
+ * \return integer
+ */
+static uint64_t ReadBlock(const unsigned char *data, const size_t &size)
+{
+  uint64_t value = 0;
+  for(size_t i = 0; i < 8 && i < size; i++)
+  {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+FragmentCache::FragmentCache(const std::string &directory)
+{
+  this->m_directory = directory;
+  this->m_hits = 0;
+  this->m_misses = 0;
+  this->m_writes = 0;
+
+  std::random_device random;
+  std::ostringstream token;
+  token << std::hex << random() << random();
+  this->m_token = token.str();
+}
+
+FragmentCache::~FragmentCache()
+{
+}
+
+bool FragmentCache::Find(const std::string &key, std::vector<std::vector<std::string> > &fragments)
+{
+  fragments.clear();
+  std::ifstream in(this->EntryName(key).c_str(), std::ios::binary);
+  if(!in.is_open())
+  {
+    this->m_misses++;
+    return false;
+  }
+
+  /* "ngfc <version> <fragments>", then "<lines>" and the lines of each fragment. */
+  std::string magic;
+  unsigned int version = 0;
+  size_t count = 0;
+  std::string line;
+  bool valid = static_cast<bool>(in >> magic >> version >> count) && magic == ENTRY_MAGIC && version == FragmentCache::VERSION;
+  valid = valid && std::getline(in, line) && line == "";
+  for(size_t i = 0; valid && i < count; i++)
+  {
+    size_t lines = 0;
+    valid = static_cast<bool>(in >> lines) && std::getline(in, line) && line == "";
+    fragments.push_back(std::vector<std::string>());
+    fragments.back().reserve(valid ? lines : 0);
+    for(size_t j = 0; valid && j < lines; j++)
+    {
+      valid = static_cast<bool>(std::getline(in, line));
+      fragments.back().push_back(line);
+    }
+  }
+  /* a complete entry ends with its end marker. */
+  valid = valid && std::getline(in, line) && line == ENTRY_MAGIC;
+
+  if(!valid)
+  {
+    fragments.clear();
+    this->m_misses++;
+    return false;
+  }
+  this->m_hits++;
+  return true;
+}
+
+void FragmentCache::Store(const std::string &key, const std::vector<std::vector<std::string> > &fragments)
+{
+  std::ostringstream entry;
+  entry << ENTRY_MAGIC << " " << FragmentCache::VERSION << " " << fragments.size() << "\n";
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    entry << fragments.at(i).size() << "\n";
+    for(size_t j = 0; j < fragments.at(i).size(); j++)
+    {
+      /* a line is a record, a multi-line fragment can not be stored. */
+      if(fragments.at(i).at(j).find('\n') != std::string::npos)
+      {
+        return;
+      }
+      entry << fragments.at(i).at(j) << "\n";
+    }
+  }
+  entry << ENTRY_MAGIC << "\n";
+
+  std::string fileName = this->EntryName(key);
+  FragmentCache::MakeDirectory(this->m_directory);
+  FragmentCache::MakeDirectory(fileName.substr(0, fileName.find_last_of('/')));
+
+  /* the entry is renamed once complete, the readers never see a partial one. */
+  std::ostringstream tmpName;
+  tmpName << fileName << ".tmp." << this->m_token << "." << this->m_writes++;
+  std::ofstream out(tmpName.str().c_str(), std::ios::binary);
+  if(!out.is_open())
+  {
+    return;
+  }
+  std::string data = entry.str();
+  out.write(data.c_str(), data.size());
+  out.close();
+  if(out.fail() || std::rename(tmpName.str().c_str(), fileName.c_str()) != 0)
+  {
+    /* a failed write, or an entry already there (on Windows), is not an error. */
+    std::remove(tmpName.str().c_str());
+  }
+}
+
+std::string FragmentCache::GetDirectory() const
+{
+  return this->m_directory;
+}
+
+size_t FragmentCache::GetHits() const
+{
+  return this->m_hits;
+}
+
+size_t FragmentCache::GetMisses() const
+{
+  return this->m_misses;
+}
+
+std::string FragmentCache::Hash(const std::string &data)
+{
+  /* MurmurHash3 x64 128 bits, with a zero seed. */
+  const uint64_t c1 = 0x87c37b91114253d5ULL;
+  const uint64_t c2 = 0x4cf5ad432745937fULL;
+  const unsigned char *bytes = reinterpret_cast<const unsigned char*>(data.data());
+  size_t size = data.size();
+  size_t blocks = size / 16;
+  uint64_t h1 = 0;
+  uint64_t h2 = 0;
+
+  for(size_t i = 0; i < blocks; i++)
+  {
+    uint64_t k1 = ReadBlock(bytes + i * 16, 8);
+    uint64_t k2 = ReadBlock(bytes + i * 16 + 8, 8);
+
+    k1 *= c1;
+    k1 = Rotate(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+    h1 = Rotate(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = Rotate(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+    h2 = Rotate(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  /* tail: the last 0 to 15 bytes. */
+  size_t tail = size - blocks * 16;
+  const unsigned char *rest = bytes + blocks * 16;
+  if(tail > 8)
+  {
+    uint64_t k2 = ReadBlock(rest + 8, tail - 8);
+    k2 *= c2;
+    k2 = Rotate(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+  }
+  if(tail > 0)
+  {
+    uint64_t k1 = ReadBlock(rest, tail);
+    k1 *= c1;
+    k1 = Rotate(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+  }
+
+  h1 ^= size;
+  h2 ^= size;
+  h1 += h2;
+  h2 += h1;
+  h1 = Mix(h1);
+  h2 = Mix(h2);
+  h1 += h2;
+  h2 += h1;
+
+  char hex[33];
+  snprintf(hex, sizeof(hex), "%016llx%016llx", static_cast<unsigned long long>(h1), static_cast<unsigned long long>(h2));
+  return std::string(hex);
+}
+
+std::string FragmentCache::EntryName(const std::string &key) const
+{
+  return this->m_directory + "/" + key.substr(0, 2) + "/" + key;
+}
+
+void FragmentCache::MakeDirectory(const std::string &directory)
+{
+  /* an existing directory is not an error, a failure shows when writing. */
+#ifdef _WIN32
+  _mkdir(directory.c_str());
+#else
+  mkdir(directory.c_str(), 0755);
+#endif
+}
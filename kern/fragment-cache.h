@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file fragment-cache.h
+ * \brief Content-addressed on-disk cache of generated code fragments.
+ */
+
+#ifndef FRAGMENT_CACHE_H
+#define FRAGMENT_CACHE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Content-addressed on-disk cache of generated code fragments.
+ *
+ *  An entry is the code generated for a run of objects, one fragment (list
+ *  of lines) per generation phase, stored under the hash of the generation
+ *  inputs of these objects. The cache directory can be shared by several
+ *  processes and runs:
+ *    - an entry is written into a temporary file then renamed, a reader sees
+ *      a whole entry or none,
+ *    - two writers of the same key write the same content, the last rename
+ *      wins,
+ *    - an unreadable or malformed entry is a miss, a failed write is ignored
+ *      (the cache is never required to generate the code).
+ *
+ *  Layout: "<directory>/<2 first hex digits>/<32 hex digits key>".
+ *  Entries are never removed, the directory can be deleted at any time.
+ */
+class FragmentCache
+{
+  public:
+    /**
+     * \brief Version of the code generation, part of every key.
+     *
+     *  It must be increased when the generated code changes for the same
+     *  objects, the entries of the other versions are then never found.
+     */
+    static const unsigned int VERSION = 2;
+
+    /**
+     * \brief Constructor.
+     * \param directory cache directory (created on the first write)
+     */
+    FragmentCache(const std::string &directory);
+
+    /**
+     * \brief Destructor.
+     */
+    ~FragmentCache();
+
+    /**
+     * \brief Find an entry.
+     * \param key entry key (see Hash)
+     * \param fragments entry fragments (output)
+     * \return false if the entry is not in the cache
+     */
+    bool Find(const std::string &key, std::vector<std::vector<std::string> > &fragments);
+
+    /**
+     * \brief Store an entry.
+     * \param key entry key (see Hash)
+     * \param fragments entry fragments
+     */
+    void Store(const std::string &key, const std::vector<std::vector<std::string> > &fragments);
+
+    /**
+     * \brief Get the cache directory.
+     * \return cache directory
+     */
+    std::string GetDirectory() const;
+
+    /**
+     * \brief Get the number of entries found.
+     * \return number of hits
+     */
+    size_t GetHits() const;
+
+    /**
+     * \brief Get the number of entries not found.
+     * \return number of misses
+     */
+    size_t GetMisses() const;
+
+    /**
+     * \brief Hash data into a key (128 bits MurmurHash3).
+     * \param data data to hash
+     * \return 32 hex digits key
+     */
+    static std::string Hash(const std::string &data);
+
+  private:
+    /**
+     * \brief Cache directory.
+     */
+    std::string m_directory;
+
+    /**
+     * \brief Number of entries found.
+     */
+    size_t m_hits;
+
+    /**
+     * \brief Number of entries not found.
+     */
+    size_t m_misses;
+
+    /**
+     * \brief Random token of this cache, makes its temporary file names unique.
+     */
+    std::string m_token;
+
+    /**
+     * \brief Number of temporary files written by this cache.
+     */
+    size_t m_writes;
+
+    /**
+     * \brief Get the file name of an entry.
+     * \param key entry key
+     * \return file name
+     */
+    std::string EntryName(const std::string &key) const;
+
+    /**
+     * \brief Create a directory, if it does not exist.
+     * \param directory directory name
+     */
+    static void MakeDirectory(const std::string &directory);
+};
+
+#endif /* FRAGMENT_CACHE_H */
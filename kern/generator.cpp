@@ -25,6 +25,8 @@
  * \date 2009
  */
 
+#include <algorithm>
+#include <cctype>
 #include <cstdlib> 
 #include <iostream>
 #include <fstream>
@@ -41,6 +43,9 @@
 #include "tcp-large-transfer.h"
 #include "tap.h"
 #include "emu.h"
+#include "scenario-data.h"
+#include "cpp-backend.h"
+#include "python-backend.h"
 #include "utils.h"
 
 using utils::split;
@@ -48,6 +53,14 @@ using utils::split;
 Generator::Generator(const std::string &simulationName)
 {
   this->m_simulationName = simulationName;
+  this->m_profiling = false;
+  this->m_scheduler = "";
+  this->m_parameterized = false;
+  this->m_compression = "";
+  this->m_fragmentCache = NULL;
+  this->m_buildCache = false;
+  this->m_structureHash = "";
+  this->m_structure = NULL;
 
   /* Node. */
   this->m_indiceNodePc = 0;
@@ -92,6 +105,1093 @@ Generator::~Generator()
   {
     delete this->m_listApplication.at(i);
   }
+
+  delete this->m_fragmentCache;
+  delete this->m_structure;
+}
+
+void Generator::SetProfiling(const bool &state)
+{
+  this->m_profiling = state;
+}
+
+bool Generator::GetProfiling() const
+{
+  return this->m_profiling;
+}
+
+void Generator::SetScheduler(const std::string &scheduler)
+{
+  std::vector<std::string> schedulers = Generator::GetSchedulers();
+  if(scheduler != "" && std::find(schedulers.begin(), schedulers.end(), scheduler) == schedulers.end())
+  {
+    throw std::logic_error("Set scheduler failed! (" + scheduler + ") unknow.");
+  }
+  this->m_scheduler = scheduler;
+}
+
+std::string Generator::GetScheduler() const
+{
+  return this->m_scheduler;
+}
+
+void Generator::SetCompression(const std::string &codec)
+{
+  std::vector<std::string> codecs = Codec::GetCodecs();
+  if(codec != "" && std::find(codecs.begin(), codecs.end(), codec) == codecs.end())
+  {
+    throw std::logic_error("Set compression failed! (" + codec + ") unknow.");
+  }
+  this->m_compression = codec;
+}
+
+std::string Generator::GetCompression() const
+{
+  return this->m_compression;
+}
+
+std::string Generator::OutputFileName(const std::string &fileName) const
+{
+  if(this->m_compression == "" || fileName == "")
+  {
+    return fileName;
+  }
+  Codec *codec = Codec::Create(this->m_compression);
+  std::string extension = codec->GetExtension();
+  delete codec;
+  return fileName + extension;
+}
+
+void Generator::SetFragmentCache(const std::string &directory)
+{
+  delete this->m_fragmentCache;
+  this->m_fragmentCache = directory != "" ? new FragmentCache(directory) : NULL;
+}
+
+FragmentCache* Generator::GetFragmentCache()
+{
+  return this->m_fragmentCache;
+}
+
+void Generator::SetBuildCache(const bool &state)
+{
+  this->m_buildCache = state;
+}
+
+bool Generator::GetBuildCache() const
+{
+  return this->m_buildCache;
+}
+
+std::string Generator::GetStructureHash() const
+{
+  return this->m_structureHash;
+}
+
+void Generator::AddPass(const std::string &name)
+{
+  this->m_passes.Add(name);
+}
+
+void Generator::ClearPasses()
+{
+  this->m_passes.Clear();
+}
+
+std::vector<std::string> Generator::GetPasses() const
+{
+  return this->m_passes.GetPasses();
+}
+
+std::vector<std::string> Generator::GetPassReport() const
+{
+  return this->m_passes.GetReport();
+}
+
+void Generator::LoadFragments()
+{
+  /* the passes rewrite the code of the whole program, the objects are then
+   * described without the fragment cache. */
+  bool passes = !this->m_passes.IsEmpty();
+  Program program = this->BuildProgram(passes);
+  if(passes)
+  {
+    this->m_passes.Run(program);
+  }
+  this->m_fragments.assign(this->m_backends.size(), std::map<std::string, std::vector<std::string> >());
+  for(size_t section = 0; section < Program::SECTIONS; section++)
+  {
+    std::vector<std::vector<std::string> > code = this->Render(program.GetStatements(static_cast<Program::Section>(section)));
+    for(size_t i = 0; i < this->m_backends.size(); i++)
+    {
+      this->m_fragments.at(i)[Program::GetSectionName(static_cast<Program::Section>(section))] = code.at(i);
+    }
+  }
+  if(passes)
+  {
+    return;
+  }
+
+  for(size_t kind = FRAGMENT_NODE; kind <= FRAGMENT_APPLICATION; kind++)
+  {
+    std::vector<std::string> phases;
+    std::vector<Program::Section> sections = Generator::FragmentSections(static_cast<FragmentKind>(kind));
+    for(size_t i = 0; i < sections.size(); i++)
+    {
+      phases.push_back(Program::GetSectionName(sections.at(i)));
+    }
+    size_t count = this->m_listApplication.size();
+    if(kind == FRAGMENT_NODE)
+    {
+      count = this->m_listNode.size();
+    }
+    else if(kind == FRAGMENT_LINK)
+    {
+      count = this->m_listNetworkHardware.size();
+    }
+
+    /* without cache, each object is described and rendered on its own. */
+    if(!this->m_fragmentCache)
+    {
+      for(size_t i = 0; i < count; i++)
+      {
+        this->LoadFragments(static_cast<FragmentKind>(kind), i, i + 1, "", phases);
+      }
+      continue;
+    }
+
+    /* a run ends after an object whose key is a multiple of RUN_OBJECTS: the
+     * cuts move with the objects, an insertion does not shift the next runs.
+     * The object keys do not depend on the language, all the languages have
+     * the same runs. */
+    const size_t RUN_OBJECTS = 64;
+    const size_t MAX_RUN_OBJECTS = 4096;
+    std::string keys = "";
+    size_t first = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+      std::string key = FragmentCache::Hash(this->FragmentSignature(static_cast<FragmentKind>(kind), i));
+      keys += key;
+      if(i + 1 == count || i + 1 - first >= MAX_RUN_OBJECTS || strtoul(key.substr(0, 8).c_str(), NULL, 16) % RUN_OBJECTS == 0)
+      {
+        this->LoadFragments(static_cast<FragmentKind>(kind), first, i + 1, keys, phases);
+        keys = "";
+        first = i + 1;
+      }
+    }
+  }
+}
+
+void Generator::LoadFragments(const FragmentKind &kind, const size_t &first, const size_t &last, const std::string &keys,
+    const std::vector<std::string> &phases)
+{
+  std::vector<std::string> runKeys;
+  std::vector<std::vector<std::vector<std::string> > > fragments(this->m_backends.size());
+  std::vector<size_t> missing;
+  for(size_t i = 0; i < this->m_backends.size(); i++)
+  {
+    runKeys.push_back(FragmentCache::Hash(utils::integerToString(FragmentCache::VERSION) + "\n" + this->m_backends.at(i)->GetName() + "\n" + keys));
+    if(!this->m_fragmentCache || !this->m_fragmentCache->Find(runKeys.back(), fragments.at(i)) || fragments.at(i).size() != phases.size())
+    {
+      fragments.at(i).assign(phases.size(), std::vector<std::string>());
+      missing.push_back(i);
+    }
+  }
+
+  /* the objects are described once, for all the missing languages. */
+  for(size_t i = first; i < last && missing.size() > 0; i++)
+  {
+    std::vector<std::vector<Statement> > object = this->DescribeFragments(kind, i);
+    for(size_t j = 0; j < missing.size(); j++)
+    {
+      Backend *backend = this->m_backends.at(missing.at(j));
+      for(size_t k = 0; k < phases.size(); k++)
+      {
+        std::vector<std::string> code = backend->Render(object.at(k));
+        fragments.at(missing.at(j)).at(k).insert(fragments.at(missing.at(j)).at(k).end(), code.begin(), code.end());
+      }
+    }
+  }
+  for(size_t i = 0; i < missing.size() && this->m_fragmentCache; i++)
+  {
+    this->m_fragmentCache->Store(runKeys.at(missing.at(i)), fragments.at(missing.at(i)));
+  }
+
+  for(size_t i = 0; i < this->m_backends.size(); i++)
+  {
+    for(size_t j = 0; j < phases.size(); j++)
+    {
+      std::vector<std::string> &code = this->m_fragments.at(i)[phases.at(j)];
+      code.insert(code.end(), fragments.at(i).at(j).begin(), fragments.at(i).at(j).end());
+    }
+  }
+}
+
+std::string Generator::FragmentSignature(const FragmentKind &kind, const size_t &index)
+{
+  if(kind == FRAGMENT_NODE)
+  {
+    return "node\n" + this->m_listNode.at(index)->GetSignature();
+  }
+  if(kind == FRAGMENT_LINK)
+  {
+    return "link\n" + this->m_listNetworkHardware.at(index)->GetSignature();
+  }
+
+  /* the receiver address is an input of the application code. */
+  size_t nodeNumber = 0;
+  std::vector<std::string> nodeGroups;
+  size_t linkNumber = this->FindReceiver(this->m_listApplication.at(index), nodeNumber, nodeGroups);
+  std::string ndcName = "";
+  if(linkNumber < this->m_listNetworkHardware.size())
+  {
+    ndcName = this->m_listNetworkHardware.at(linkNumber)->GetNdcName();
+  }
+  return "application\n" + this->m_listApplication.at(index)->GetSignature() + ndcName + "\n" + Generator::IndexValue(nodeNumber, nodeGroups) + "\n";
+}
+
+std::vector<std::vector<Statement> > Generator::DescribeFragments(const FragmentKind &kind, const size_t &index)
+{
+  std::vector<std::vector<Statement> > fragments;
+  if(kind == FRAGMENT_NODE)
+  {
+    Node *node = this->m_listNode.at(index);
+    fragments.push_back(node->DescribeNode());
+    /* the bridges have no IP stack. */
+    if(node->GetNodeName().find("bridge_") != 0)
+    {
+      fragments.push_back(node->DescribeIpStack());
+    }
+    else
+    {
+      fragments.push_back(std::vector<Statement>());
+    }
+  }
+  else if(kind == FRAGMENT_LINK)
+  {
+    NetworkHardware *link = this->m_listNetworkHardware.at(index);
+    fragments.push_back(link->DescribeNetworkHardware());
+    fragments.push_back(link->DescribeNetDevice());
+    fragments.push_back(link->DescribeTapBridge());
+    fragments.push_back(link->DescribeTrace());
+  }
+  else
+  {
+    fragments.push_back(this->DescribeApplication(index));
+  }
+  return fragments;
+}
+
+std::vector<Program::Section> Generator::FragmentSections(const FragmentKind &kind)
+{
+  std::vector<Program::Section> sections;
+  if(kind == FRAGMENT_NODE)
+  {
+    sections.push_back(Program::NODES);
+    sections.push_back(Program::IP_STACK);
+  }
+  else if(kind == FRAGMENT_LINK)
+  {
+    sections.push_back(Program::LINKS);
+    sections.push_back(Program::NET_DEVICES);
+    sections.push_back(Program::TAP_BRIDGE);
+    sections.push_back(Program::TRACES);
+  }
+  else
+  {
+    sections.push_back(Program::APPLICATIONS);
+  }
+  return sections;
+}
+
+Program Generator::BuildProgram(const bool &objects)
+{
+  Program program;
+  for(size_t kind = FRAGMENT_NODE; kind <= FRAGMENT_APPLICATION && objects; kind++)
+  {
+    std::vector<Program::Section> sections = Generator::FragmentSections(static_cast<FragmentKind>(kind));
+    size_t count = this->m_listApplication.size();
+    Program::ObjectKind objectKind = Program::OBJECT_APPLICATION;
+    if(kind == FRAGMENT_NODE)
+    {
+      count = this->m_listNode.size();
+      objectKind = Program::OBJECT_NODE;
+    }
+    else if(kind == FRAGMENT_LINK)
+    {
+      count = this->m_listNetworkHardware.size();
+      objectKind = Program::OBJECT_LINK;
+    }
+    for(size_t i = 0; i < count; i++)
+    {
+      std::vector<std::vector<Statement> > fragments = this->DescribeFragments(static_cast<FragmentKind>(kind), i);
+      for(size_t j = 0; j < sections.size(); j++)
+      {
+        program.Add(sections.at(j), objectKind, this->FragmentOwner(static_cast<FragmentKind>(kind), i), fragments.at(j));
+      }
+    }
+  }
+
+  /* the scenario variables, the command line and the addresses are never cached. */
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    NetworkHardware *link = this->m_listNetworkHardware.at(i);
+    program.Add(Program::VARS, Program::OBJECT_LINK, link->GetNetworkHardwareName(), link->DescribeVars());
+    program.Add(Program::CMD_LINE, Program::OBJECT_LINK, link->GetNetworkHardwareName(), link->DescribeCmdLine());
+    program.Add(Program::IP_ASSIGN, Program::OBJECT_LINK, link->GetNetworkHardwareName(), this->DescribeIpAssign(i));
+  }
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    program.Add(Program::VARS, Program::OBJECT_NODE, this->m_listNode.at(i)->GetNodeName(), this->m_listNode.at(i)->DescribeVars());
+    program.Add(Program::CMD_LINE, Program::OBJECT_NODE, this->m_listNode.at(i)->GetNodeName(), this->m_listNode.at(i)->DescribeCmdLine());
+  }
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  {
+    program.Add(Program::VARS, Program::OBJECT_APPLICATION, this->m_listApplication.at(i)->GetAppName(), this->m_listApplication.at(i)->DescribeVars());
+    program.Add(Program::CMD_LINE, Program::OBJECT_APPLICATION, this->m_listApplication.at(i)->GetAppName(), this->m_listApplication.at(i)->DescribeCmdLine());
+  }
+
+  /* add nsc var if used. */
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    if( (this->m_listNode.at(i))->GetNsc() != "")
+    {
+      program.Add(Program::VARS, Program::OBJECT_NODE, this->m_listNode.at(i)->GetNodeName(),
+          std::vector<Statement>(1, Statement::Define("std::string", "nscStack", Expression::String((this->m_listNode.at(i))->GetNsc()))));
+    }
+  }
+
+  /* the objects and their dependencies, for the passes. */
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    program.AddObject(Program::OBJECT_NODE, this->m_listNode.at(i)->GetNodeName(), std::vector<std::string>(), std::vector<std::string>());
+  }
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    NetworkHardware *link = this->m_listNetworkHardware.at(i);
+    std::vector<std::string> members;
+    std::vector<std::string> uses;
+    bool external = false;
+    std::vector<std::string> nodes = link->GetInstalledNodes();
+    for(size_t j = 0; j < nodes.size(); j++)
+    {
+      members.push_back(Generator::ContainerName(nodes.at(j)));
+    }
+    /* the access point, the emu and the tap nodes are endpoints of their
+     * link (the emu and tap links join their node to the host, it is the
+     * only one they need), a bridge node only forwards. */
+    if(Ap *ap = dynamic_cast<Ap*>(link))
+    {
+      members.push_back(ap->GetApNode());
+    }
+    else if(Emu *emu = dynamic_cast<Emu*>(link))
+    {
+      members.push_back(emu->GetEmuName());
+      external = true;
+    }
+    else if(Tap *tap = dynamic_cast<Tap*>(link))
+    {
+      members.push_back(tap->GetTapName());
+      external = true;
+    }
+    else if(Bridge *bridge = dynamic_cast<Bridge*>(link))
+    {
+      uses.push_back(bridge->GetNodeBridge());
+    }
+    program.AddObject(Program::OBJECT_LINK, link->GetNetworkHardwareName(), members, uses, external);
+  }
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  {
+    Application *application = this->m_listApplication.at(i);
+    std::vector<std::string> members;
+    members.push_back(Generator::ContainerName(application->GetSenderNode()));
+    members.push_back(Generator::ContainerName(application->GetReceiverNode()));
+    size_t nodeNumber = 0;
+    std::vector<std::string> nodeGroups;
+    size_t linkNumber = this->FindReceiver(application, nodeNumber, nodeGroups);
+    std::vector<std::string> uses;
+    if(linkNumber < this->m_listNetworkHardware.size())
+    {
+      uses.push_back(this->m_listNetworkHardware.at(linkNumber)->GetNetworkHardwareName());
+    }
+    program.AddObject(Program::OBJECT_APPLICATION, application->GetAppName(), members, uses);
+  }
+  return program;
+}
+
+std::string Generator::FragmentOwner(const FragmentKind &kind, const size_t &index)
+{
+  if(kind == FRAGMENT_NODE)
+  {
+    return this->m_listNode.at(index)->GetNodeName();
+  }
+  if(kind == FRAGMENT_LINK)
+  {
+    return this->m_listNetworkHardware.at(index)->GetNetworkHardwareName();
+  }
+  return this->m_listApplication.at(index)->GetAppName();
+}
+
+std::vector<std::vector<std::string> > Generator::Render(const std::vector<Statement> &statements)
+{
+  std::vector<std::vector<std::string> > code;
+  for(size_t i = 0; i < this->m_backends.size(); i++)
+  {
+    code.push_back(this->m_backends.at(i)->Render(statements));
+  }
+  return code;
+}
+
+std::vector<std::vector<std::string> > Generator::GeneratePhase(const std::string &phase, const std::vector<Statement> &declarations)
+{
+  std::vector<std::vector<std::string> > code = this->Render(declarations);
+  for(size_t i = 0; i < this->m_backends.size(); i++)
+  {
+    const std::vector<std::string> &fragments = this->m_fragments.at(i)[phase];
+    code.at(i).insert(code.at(i).end(), fragments.begin(), fragments.end());
+  }
+  return code;
+}
+
+std::vector<std::string> Generator::GetSchedulers()
+{
+  std::vector<std::string> schedulers;
+  schedulers.push_back("Map");
+  schedulers.push_back("Heap");
+  schedulers.push_back("List");
+  schedulers.push_back("Calendar");
+  schedulers.push_back("PriorityQueue");
+  return schedulers;
+}
+
+std::vector<std::string> Generator::GenerateSchedulerBenchmarkCpp(const std::string &fileName)
+{
+  if(fileName == "")
+  {
+    throw std::logic_error("Scheduler benchmark failed! (no file name).");
+  }
+
+  std::string scheduler = this->m_scheduler;
+  bool profiling = this->m_profiling;
+  std::vector<std::string> schedulers = Generator::GetSchedulers();
+  std::vector<std::string> files;
+
+  /* the generator leaves the benchmark mode even if a variant fails. */
+  this->m_profiling = true;
+  try
+  {
+    for(size_t i = 0; i < schedulers.size(); i++)
+    {
+      this->m_scheduler = schedulers.at(i);
+      files.push_back(Generator::SchedulerFileName(fileName, schedulers.at(i)));
+      this->GenerateCodeCpp(files.back());
+      files.back() = this->OutputFileName(files.back());
+    }
+  }
+  catch(...)
+  {
+    this->m_scheduler = scheduler;
+    this->m_profiling = profiling;
+    throw;
+  }
+  this->m_scheduler = scheduler;
+  this->m_profiling = profiling;
+
+  return files;
+}
+
+std::vector<std::string> Generator::GenerateSchedulerBenchmarkPython(const std::string &fileName)
+{
+  if(fileName == "")
+  {
+    throw std::logic_error("Scheduler benchmark failed! (no file name).");
+  }
+
+  std::string scheduler = this->m_scheduler;
+  bool profiling = this->m_profiling;
+  std::vector<std::string> schedulers = Generator::GetSchedulers();
+  std::vector<std::string> files;
+
+  /* the generator leaves the benchmark mode even if a variant fails. */
+  this->m_profiling = true;
+  try
+  {
+    for(size_t i = 0; i < schedulers.size(); i++)
+    {
+      this->m_scheduler = schedulers.at(i);
+      files.push_back(Generator::SchedulerFileName(fileName, schedulers.at(i)));
+      this->GenerateCodePython(files.back());
+      files.back() = this->OutputFileName(files.back());
+    }
+  }
+  catch(...)
+  {
+    this->m_scheduler = scheduler;
+    this->m_profiling = profiling;
+    throw;
+  }
+  this->m_scheduler = scheduler;
+  this->m_profiling = profiling;
+
+  return files;
+}
+
+void Generator::GenerateCodeData(const std::string &fileName)
+{
+  if(fileName == "")
+  {
+    throw std::logic_error("Generate data failed! (no file name).");
+  }
+
+  /* the data file holds values, not parameters: the objects are
+   * unparameterized for the generation only. */
+  std::vector<bool> states = this->GetParameterizedStates();
+  this->UpdateParameterized(false);
+  try
+  {
+    this->WriteCodeData(fileName);
+  }
+  catch(...)
+  {
+    this->SetParameterizedStates(states);
+    throw;
+  }
+  this->SetParameterizedStates(states);
+}
+
+void Generator::WriteCodeData(const std::string &fileName)
+{
+  ScenarioData data;
+
+  /* nodes, the bridge nodes have no IP stack. */
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    Node *node = this->m_listNode.at(i);
+    uint32_t flags = node->GetNodeName().find("bridge_") == 0 ? ScenarioData::FLAG_NO_STACK : 0;
+    data.AddNode(node->GetNodeName(), node->GetMachinesNumber(), node->GetNsc(), flags);
+  }
+
+  /* links and their members. */
+  bool realtime = false;
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    NetworkHardware *link = this->m_listNetworkHardware.at(i);
+    uint32_t kind = ScenarioData::LINK_HUB;
+    uint32_t flags = 0;
+    uint32_t sub = ScenarioData::NONE;
+    uint32_t node = ScenarioData::NONE;
+    std::string iface = "";
+
+    if(dynamic_cast<PointToPoint*>(link))
+    {
+      kind = ScenarioData::LINK_POINT_TO_POINT;
+    }
+    else if(Bridge *bridge = dynamic_cast<Bridge*>(link))
+    {
+      kind = ScenarioData::LINK_BRIDGE;
+      this->FindDataNode(bridge->GetNodeBridge(), node, sub);
+    }
+    else if(Ap *ap = dynamic_cast<Ap*>(link))
+    {
+      kind = ScenarioData::LINK_AP;
+      this->FindDataNode(ap->GetApNode(), node, sub);
+      iface = ap->GetApName();
+      flags |= ap->GetMobility() ? ScenarioData::FLAG_MOBILITY : 0;
+    }
+    else if(Emu *emu = dynamic_cast<Emu*>(link))
+    {
+      kind = ScenarioData::LINK_EMU;
+      this->FindDataNode(emu->GetEmuName(), node, sub);
+      iface = emu->GetIfaceName();
+      realtime = true;
+    }
+    else if(Tap *tap = dynamic_cast<Tap*>(link))
+    {
+      kind = ScenarioData::LINK_TAP;
+      this->FindDataNode(tap->GetTapName(), node, sub);
+      iface = tap->GetIfaceName();
+      realtime = true;
+    }
+    flags |= link->GetTrace() ? ScenarioData::FLAG_TRACE : 0;
+    flags |= link->GetPromisc() ? ScenarioData::FLAG_PROMISC : 0;
+
+    data.AddLink(kind, link->GetNetworkHardwareName(), strtoull(link->GetDataRate().c_str(), NULL, 10),
+        strtoul(link->GetNetworkHardwareDelay().c_str(), NULL, 10), flags, node, iface);
+
+    std::vector<std::string> nodes = link->GetInstalledNodes();
+    for(size_t j = 0; j <  nodes.size(); j++)
+    {
+      /* the ap node is installed by the link itself. */
+      if(nodes.at(j).find("ap_") == 0)
+      {
+        continue;
+      }
+      this->FindDataNode(nodes.at(j), node, sub);
+      if(node == ScenarioData::NONE)
+      {
+        throw std::logic_error("Generate data failed! (" + nodes.at(j) + ") unknow.");
+      }
+      data.AddMember(node, sub);
+    }
+  }
+
+  /* applications. */
+  size_t stopTime = 0;
+  size_t nodeNumber = 0;
+  std::vector<std::string> nodeGroups;
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  {
+    Application *application = this->m_listApplication.at(i);
+    uint32_t kind = ScenarioData::APPLICATION_PING;
+    uint32_t port = 0;
+    uint32_t packetSize = 0;
+    uint32_t maxPackets = 0;
+    double interval = 0;
+    if(UdpEcho *udpEcho = dynamic_cast<UdpEcho*>(application))
+    {
+      kind = ScenarioData::APPLICATION_UDP_ECHO;
+      port = udpEcho->GetPort();
+      packetSize = udpEcho->GetPacketSize();
+      maxPackets = udpEcho->GetMaxPacketCount();
+      interval = strtod(udpEcho->GetPacketIntervalTime().c_str(), NULL);
+    }
+    else if(TcpLargeTransfer *tcp = dynamic_cast<TcpLargeTransfer*>(application))
+    {
+      kind = ScenarioData::APPLICATION_TCP_LARGE_TRANSFER;
+      port = tcp->GetPort();
+    }
+
+    uint32_t sender = ScenarioData::NONE;
+    uint32_t senderSub = ScenarioData::NONE;
+    uint32_t receiver = ScenarioData::NONE;
+    uint32_t receiverSub = ScenarioData::NONE;
+    this->FindDataNode(application->GetSenderNode(), sender, senderSub);
+    this->FindDataNode(application->GetReceiverNode(), receiver, receiverSub);
+    if(sender == ScenarioData::NONE || receiver == ScenarioData::NONE)
+    {
+      throw std::logic_error("Generate data failed! (" + application->GetAppName() + ") has an unknow node.");
+    }
+
+    size_t linkNumber = this->FindReceiver(application, nodeNumber, nodeGroups);
+    uint32_t receiverLink = linkNumber < this->m_listNetworkHardware.size() ? linkNumber : ScenarioData::NONE;
+
+    data.AddApplication(kind, application->GetAppName(), sender, senderSub, receiver, receiverSub, receiverLink, nodeNumber,
+        utils::stringToInteger(application->GetStartTime()), application->GetEndTimeNumber(), port, packetSize, maxPackets, interval);
+
+    if(application->GetEndTimeNumber() > stopTime)
+    {
+      stopTime = application->GetEndTimeNumber();
+    }
+  }
+
+  data.SetFlags(realtime ? ScenarioData::FLAG_REALTIME : 0);
+  data.SetStopTime(stopTime + 1);
+  data.SetScheduler(this->m_scheduler);
+
+  std::string dataFileName = ScenarioData::DataFileName(fileName);
+  data.Write(dataFileName);
+
+  this->m_cppFile.Create(this->OutputFileName(fileName), this->m_compression);
+  std::string::size_type slash = dataFileName.find_last_of("/\\");
+  std::vector<std::string> driver = ScenarioData::GenerateDriverCpp(slash == std::string::npos ? dataFileName : dataFileName.substr(slash + 1));
+  delete this->m_structure;
+  this->m_structure = new BuildCache(fileName);
+  this->m_structure->AddParameters(driver, driver);
+  for(size_t i = 0; i <  driver.size(); i++)
+  {
+    this->WriteCpp(driver.at(i));
+  }
+  this->WriteStructureHashCpp(driver, std::vector<std::string>(1, fileName), false);
+  this->m_cppFile.Close();
+}
+
+std::vector<std::string> Generator::GenerateCodeSharded(const std::string &fileName, const size_t &shards)
+{
+  if(fileName == "")
+  {
+    throw std::logic_error("Generate shards failed! (no file name).");
+  }
+
+  Sharding sharding(fileName, shards);
+  Profiling profiling(this->m_simulationName, Profiling::OutputNameFromFile(fileName));
+  profiling.SetScheduler(this->m_scheduler);
+  CppBackend cpp;
+  this->UpdateParameterized(this->m_parameterized);
+
+  std::vector<std::string> headers;
+  headers.push_back("#include \"ns3/core-module.h\"");
+  headers.push_back("#include \"ns3/global-route-manager.h\"");
+  headers.push_back("#include \"ns3/network-module.h\"");
+  headers.push_back("#include \"ns3/internet-module.h\"");
+  std::vector<std::string> allHeaders = GenerateHeader();
+  headers.insert(headers.end(), allHeaders.begin(), allHeaders.end());
+
+  /* the passes are run on the whole program, there is no fragment cache here. */
+  Program program = this->BuildProgram(true);
+  this->m_passes.Run(program);
+
+  /* the scenario variables become globals, the profiling ones stay in main. */
+  std::vector<std::string> scenarioVars = cpp.Render(program.GetStatements(Program::VARS));
+  std::vector<std::string> allVars = sharding.AddVars(scenarioVars);
+  std::vector<std::string> allCmdLine = cpp.Render(program.GetStatements(Program::CMD_LINE));
+  if(this->m_profiling)
+  {
+    std::vector<std::string> profilingVars = profiling.GenerateVarsCpp();
+    allVars.insert(allVars.end(), profilingVars.begin(), profilingVars.end());
+    scenarioVars.insert(scenarioVars.end(), profilingVars.begin(), profilingVars.end());
+    std::vector<std::string> profilingCmdLine = profiling.GenerateCmdLineCpp();
+    allCmdLine.insert(allCmdLine.end(), profilingCmdLine.begin(), profilingCmdLine.end());
+  }
+  delete this->m_structure;
+  this->m_structure = new BuildCache(fileName);
+  this->m_structure->AddParameters(scenarioVars, allCmdLine);
+
+  /* dispatch the setup code object by object, "ipStack" is the "IpStack" phase. */
+  for(size_t section = Program::NODES; section < Program::SECTIONS; section++)
+  {
+    const std::vector<Program::Block> &blocks = program.GetBlocks(static_cast<Program::Section>(section));
+    std::string phase = Program::GetSectionName(static_cast<Program::Section>(section));
+    phase[0] = toupper(phase[0]);
+    if(section == Program::IP_STACK)
+    {
+      sharding.AddBlock(phase, 0, 1, cpp.Render(std::vector<Statement>(1, Statement::Declare("InternetStackHelper", "internetStackH"))));
+    }
+    else if(section == Program::IP_ASSIGN)
+    {
+      sharding.AddBlock(phase, 0, 1, cpp.Render(std::vector<Statement>(1, Statement::Declare("Ipv4AddressHelper", "ipv4"))));
+    }
+    for(size_t i = 0; i <  blocks.size(); i++)
+    {
+      sharding.AddBlock(phase, i, blocks.size(), cpp.Render(blocks.at(i).statements));
+    }
+  }
+
+  /* shared header, shards and Makefile. */
+  std::vector<std::string> files;
+  files.push_back(fileName);
+  files.push_back(sharding.GetHeaderName());
+  this->WriteCppFile(files.back(), sharding.GenerateHeaderCpp(headers));
+  for(size_t i = 0; i < shards; i++)
+  {
+    files.push_back(sharding.GetShardName(i));
+    this->WriteCppFile(files.back(), sharding.GenerateShardCpp(i));
+  }
+  files.push_back(sharding.GetMakefileName());
+  this->WriteCppFile(files.back(), sharding.GenerateMakefile(headers));
+
+  /* main file */
+  this->m_cppFile.Create(this->OutputFileName(fileName), this->m_compression);
+  std::string header = sharding.GetHeaderName();
+  this->WriteCpp("#include \"" + header.substr(header.find_last_of("/\\") + 1) + "\"");
+  if(this->m_profiling)
+  {
+    std::vector<std::string> profilingHeaders = profiling.GenerateHeader();
+    for(size_t i = 0; i <  profilingHeaders.size(); i++)
+    {
+      this->WriteCpp(profilingHeaders.at(i));
+    }
+  }
+  this->WriteCpp("");
+
+  std::vector<std::string> globals = sharding.GenerateGlobalsCpp();
+  for(size_t i = 0; i <  globals.size(); i++)
+  {
+    this->WriteCpp(globals.at(i));
+  }
+  this->WriteCpp("");
+
+  if(this->m_profiling)
+  {
+    std::vector<std::string> profilingHelpers = profiling.GenerateHelpersCpp();
+    for(size_t i = 0; i <  profilingHelpers.size(); i++)
+    {
+      this->WriteCpp(profilingHelpers.at(i));
+    }
+    this->WriteCpp("");
+  }
+
+  this->WriteCpp("int main(int argc, char *argv[])");
+  this->WriteCpp("{");
+  for(size_t i = 0; i <  allVars.size(); i++)
+  {
+    this->WriteCpp("  " + allVars.at(i));
+    this->WriteCpp("");
+  }
+
+  this->WriteCpp("  CommandLine cmd;");
+  for(size_t i = 0; i <  allCmdLine.size(); i++)
+  {
+    this->WriteCpp("  " + allCmdLine.at(i));
+  }
+  this->WriteCpp("  cmd.Parse (argc, argv);");
+
+  this->WriteCpp("");
+  this->WriteCpp("  /* Configuration. */");
+  std::vector<std::string> conf = cpp.Render(this->DescribeConfig());
+  for(size_t i = 0; i <  conf.size(); i++)
+  {
+    this->WriteCpp("  " + conf.at(i));
+  }
+  std::vector<std::string> allScheduler = cpp.Render(this->DescribeScheduler());
+  for(size_t i = 0; i <  allScheduler.size(); i++)
+  {
+    this->WriteCpp("  " + allScheduler.at(i));
+  }
+  this->WriteProfilingPhaseCpp(profiling, "configuration");
+
+  this->WriteShardCallsCpp(sharding, profiling, "Nodes", "Build nodes.", "nodes");
+  this->WriteShardCallsCpp(sharding, profiling, "Links", "Build link.", "links");
+  this->WriteShardCallsCpp(sharding, profiling, "NetDevices", "Build link net device container.", "netDevices");
+  this->WriteShardCallsCpp(sharding, profiling, "IpStack", "Install the IP stack.", "ipStack");
+  this->WriteShardCallsCpp(sharding, profiling, "IpAssign", "IP assign.", "ipAssign");
+  this->WriteShardCallsCpp(sharding, profiling, "TapBridge", "Tap Bridge.", "tapBridge");
+
+  this->WriteCpp("");
+  this->WriteCpp("  /* Generate Route. */");
+  std::vector<std::string> allRoutes = cpp.Render(this->DescribeRoute());
+  for(size_t i = 0; i <  allRoutes.size(); i++)
+  {
+    this->WriteCpp("  " + allRoutes.at(i));
+  }
+  this->WriteProfilingPhaseCpp(profiling, "routes");
+
+  this->WriteShardCallsCpp(sharding, profiling, "Applications", "Generate Application.", "applications");
+  this->WriteShardCallsCpp(sharding, profiling, "Traces", "Pcap output.", "tracing");
+
+  this->WriteCpp("");
+  this->WriteCpp("  /* Stop the simulation after x seconds. */");
+  std::vector<std::string> allStop = cpp.Render(this->DescribeStop());
+  for(size_t i = 0; i <  allStop.size(); i++)
+  {
+    this->WriteCpp("  " + allStop.at(i));
+  }
+
+  this->WriteCpp("  /* Start and clean simulation. */");
+  if(this->m_profiling)
+  {
+    std::vector<std::string> profilingRun = profiling.GenerateRunCpp();
+    for(size_t i = 0; i <  profilingRun.size(); i++)
+    {
+      this->WriteCpp("  " + profilingRun.at(i));
+    }
+  }
+  else
+  {
+    std::vector<std::string> allRun = cpp.Render(this->DescribeRun());
+    for(size_t i = 0; i <  allRun.size(); i++)
+    {
+      this->WriteCpp("  " + allRun.at(i));
+    }
+  }
+  this->WriteCpp("}");
+  this->WriteStructureHashCpp(headers, files, true);
+  this->m_cppFile.Close();
+
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    files.at(i) = this->OutputFileName(files.at(i));
+  }
+  return files;
+}
+
+void Generator::FindDataNode(const std::string &nodeName, uint32_t &nodeIndex, uint32_t &subIndex)
+{
+  std::string name = nodeName;
+  nodeIndex = ScenarioData::NONE;
+  subIndex = ScenarioData::NONE;
+
+  /* group member: NodeContainer(name.Get(k)) */
+  if(name.find("NodeContainer(") == 0)
+  {
+    std::string member = name.substr(std::string("NodeContainer(").size());
+    std::string::size_type get = member.find(".Get(");
+    if(get == std::string::npos)
+    {
+      return;
+    }
+    name = member.substr(0, get);
+    subIndex = utils::stringToInteger(member.substr(get + 5, member.find(')', get) - get - 5));
+  }
+
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    if(this->m_listNode.at(i)->GetNodeName() == name)
+    {
+      nodeIndex = i;
+      return;
+    }
+  }
+}
+
+void Generator::SetParameterized(const bool &state)
+{
+  this->m_parameterized = state;
+}
+
+bool Generator::GetParameterized() const
+{
+  return this->m_parameterized;
+}
+
+void Generator::UpdateParameterized(const bool &state)
+{
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    this->m_listNode.at(i)->SetParameterized(state);
+  }
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    this->m_listNetworkHardware.at(i)->SetParameterized(state);
+  }
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  {
+    this->m_listApplication.at(i)->SetParameterized(state);
+  }
+}
+
+std::vector<bool> Generator::GetParameterizedStates()
+{
+  std::vector<bool> states;
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    states.push_back(this->m_listNode.at(i)->GetParameterized());
+  }
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    states.push_back(this->m_listNetworkHardware.at(i)->GetParameterized());
+  }
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  {
+    states.push_back(this->m_listApplication.at(i)->GetParameterized());
+  }
+  return states;
+}
+
+void Generator::SetParameterizedStates(const std::vector<bool> &states)
+{
+  size_t state = 0;
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  {
+    this->m_listNode.at(i)->SetParameterized(states.at(state++));
+  }
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    this->m_listNetworkHardware.at(i)->SetParameterized(states.at(state++));
+  }
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  {
+    this->m_listApplication.at(i)->SetParameterized(states.at(state++));
+  }
+}
+
+std::string Generator::IndexValue(const size_t &nodeNumber, const std::vector<std::string> &nodeGroups)
+{
+  std::string index = "";
+  for(size_t i = 0; i < nodeGroups.size(); i++)
+  {
+    index += nodeGroups.at(i) + " + ";
+  }
+  if(index != "" && nodeNumber == 0)
+  {
+    return index.substr(0, index.size() - 3);
+  }
+  return index + utils::integerToString(nodeNumber);
+}
+
+size_t Generator::FindReceiver(Application *application, size_t &nodeNumber, std::vector<std::string> &nodeGroups)
+{
+  std::string receiverName = application->GetReceiverNode();
+  size_t linkNumber = this->m_listNetworkHardware.size();
+  nodeNumber = 0;
+  nodeGroups.clear();
+
+  /* if the receiver is in NodeContainer */
+  if(receiverName.find("NodeContainer(") == 0)
+  {
+    std::string oldReceiverName = receiverName;
+
+    std::vector<std::string> tab_name;
+    split(tab_name, receiverName, '(');
+
+    std::string str_get = tab_name.at(1);
+    std::vector<std::string> tab_name2;
+    split(tab_name2, str_get, '.');
+
+    receiverName = tab_name2.at(0);
+    for(size_t x = 0;  x < this->m_listNetworkHardware.size(); x++)
+    {
+      std::vector<std::string> nodes = this->m_listNetworkHardware.at(x)->GetInstalledNodes();
+      for(size_t y = 0; y < nodes.size(); y++)
+      {
+        if(nodes.at(y) == receiverName || nodes.at(y) == oldReceiverName)
+        {
+          linkNumber = x;
+          break;
+        }
+      }
+    }
+    if(linkNumber < this->m_listNetworkHardware.size())
+    {
+      std::vector<std::string> linksNode = this->m_listNetworkHardware.at(linkNumber)->GetInstalledNodes();
+      for(size_t j = 0; j < linksNode.size(); j++)
+      {
+        if(linksNode.at(j) == oldReceiverName)
+        {
+          nodeNumber = j;
+          break;
+        }
+      }
+    }
+    return linkNumber;
+  }
+
+  /* name lookup of the installed nodes (the first node of a name wins). */
+  std::map<std::string, Node*> nodesByName;
+  for(size_t l = 0; l <  this->m_listNode.size(); l++)
+  {
+    nodesByName.insert(std::make_pair(this->m_listNode.at(l)->GetNodeName(), this->m_listNode.at(l)));
+  }
+
+  for(size_t j = 0; j <  this->m_listNetworkHardware.size(); j++)
+  {
+    nodeNumber = 0;
+    nodeGroups.clear();
+    std::vector<std::string> nodes = (this->m_listNetworkHardware.at(j))->GetInstalledNodes();
+    for(size_t k = 0; k <  nodes.size(); k++)
+    {
+      if( nodes.at(k) == receiverName)
+      {
+        return j;
+      }
+      std::map<std::string, Node*>::const_iterator node = nodesByName.find(nodes.at(k));
+      if(node != nodesByName.end())
+      {
+        if(node->second->HasMachinesNumberParameter())
+        {
+          nodeGroups.push_back(node->second->GetMachinesNumberValue());
+        }
+        else
+        {
+          nodeNumber += node->second->GetMachinesNumber();
+        }
+      }
+    }
+  }
+  return linkNumber;
+}
+
+std::string Generator::SchedulerFileName(const std::string &fileName, const std::string &scheduler)
+{
+  std::string suffix = "-" + scheduler;
+  std::transform(suffix.begin(), suffix.end(), suffix.begin(), ::tolower);
+
+  std::string::size_type slash = fileName.find_last_of("/\\");
+  std::string::size_type dot = fileName.find_last_of('.');
+  if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return fileName + suffix;
+  }
+  return fileName.substr(0, dot) + suffix + fileName.substr(dot);
 }
 
 void Generator::AddConfig(const std::string &config)
@@ -452,707 +1552,593 @@ size_t Generator::GetNNetworkHardwares() const
   return this->m_listNetworkHardware.size();
 }
 
-//
-// Part around the C++ code Generation.
-// This part is looking about the code to write.
-//
-
-void Generator::GenerateCodeCpp(std::string fileName) 
-{
-  if(fileName != ""){
-    this->m_cppFile.open(fileName.c_str());
-  }
-
-  //
-  // Generate headers 
-  //
-  this->WriteCpp("#include \"ns3/core-module.h\"");
-  this->WriteCpp("#include \"ns3/global-route-manager.h\"");
-  this->WriteCpp("#include \"ns3/network-module.h\"");
-  this->WriteCpp("#include \"ns3/internet-module.h\"");
-
-  std::vector<std::string> allHeaders = GenerateHeader();
-  for(size_t i = 0; i <  allHeaders.size(); i++)
-  {
-    this->WriteCpp("" + allHeaders.at(i));
-  }
-
-  this->WriteCpp("");
-  this->WriteCpp("using namespace ns3;");
-  this->WriteCpp("");
-
-  this->WriteCpp("int main(int argc, char *argv[])");
-  this->WriteCpp("{");
-
-  //
-  // Tap/Emu variables
-  //
-  std::vector<std::string> allVars = GenerateVarsCpp();
-  for(size_t i = 0; i <  allVars.size(); i++)
-  {
-    this->WriteCpp("  " + allVars.at(i));
-    this->WriteCpp("");
-  }
-
-  //
-  // Generate Command Line 
-  //
-  this->WriteCpp("  CommandLine cmd;");
-
-  std::vector<std::string> allCmdLine = GenerateCmdLineCpp();
-  for(size_t i = 0; i <  allCmdLine.size(); i++)
-  {
-    this->WriteCpp("  " + allCmdLine.at(i));
-  } 
-
-  this->WriteCpp("  cmd.Parse (argc, argv);");
-
-  //
-  // Generate Optional configuration
-  // 
-  this->WriteCpp("");
-  this->WriteCpp("  /* Configuration. */");
-  std::vector<std::string> conf = GenerateConfigCpp();
-  for(size_t i = 0; i <  conf.size(); i++)
-  {
-    this->WriteCpp("  " + conf.at(i));
-  }
-
-  //
-  // Generate Nodes. 
-  //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Build nodes. */");
-  std::vector<std::string> nodeBuild = GenerateNodeCpp();
-  for(size_t i = 0; i <  nodeBuild.size(); i++)
-  {
-    this->WriteCpp("  " + nodeBuild.at(i));
-  }
-
-  //
-  // Generate Link.
-  //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Build link. */");
-  std::vector<std::string> linkBuild = GenerateNetworkHardwareCpp(); 
-  for(size_t i = 0; i <  linkBuild.size(); i++)
-  {
-    this->WriteCpp("  " + linkBuild.at(i));
-  }
-
-  //
-  // Generate link net device container.
-  //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Build link net device container. */");
-  std::vector<std::string> linkNdcBuild = GenerateNetDeviceCpp(); 
-  for(size_t i = 0; i <  linkNdcBuild.size(); i++)
-  {
-    this->WriteCpp("  " + linkNdcBuild.at(i));
-  }
-
-  //
-  // Generate Ip Stack. 
-  //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Install the IP stack. */");
-  std::vector<std::string> allStacks = GenerateIpStackCpp();
-  for(size_t i = 0; i <  allStacks.size(); i++)
-  {
-    this->WriteCpp("  " + allStacks.at(i));
-  }
-
-  //
-  // Generate IP assignation.
-  // 
-  this->WriteCpp("");
-  this->WriteCpp("  /* IP assign. */");
-  std::vector<std::string> allAssign = GenerateIpAssignCpp();
-  for(size_t i = 0; i <  allAssign.size(); i++)
-  {
-    this->WriteCpp("  " + allAssign.at(i));
-  } 
-
-  //
-  // Generate TapBridge if tap is used.
-  //
-  std::vector<std::string> allTapBridge = GenerateTapBridgeCpp();
-  if(allTapBridge.size() > 0)
-  {
-    this->WriteCpp("");
-    this->WriteCpp("  /* Tap Bridge. */");
-  }
-  for(size_t i = 0; i <  allTapBridge.size(); i++)
-  {
-    this->WriteCpp("  " + allTapBridge.at(i));
-  } 
-
-  //
-  // Generate Route.
-  //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Generate Route. */");
-  std::vector<std::string> allRoutes = GenerateRouteCpp();
-  for(size_t i = 0; i <  allRoutes.size(); i++)
-  {
-    this->WriteCpp("  " + allRoutes.at(i));
-  } 
-
-  //
-  // Generate Application.
-  //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Generate Application. */");
-  std::vector<std::string> allApps = GenerateApplicationCpp();
-  for(size_t i = 0; i <  allApps.size(); i++)
-  {
-    this->WriteCpp("  " + allApps.at(i));
-  } 
-
-  //
-  // Others
-  //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Simulation. */");
-
-  this->WriteCpp("  /* Pcap output. */");
-  std::vector<std::string> allTrace = GenerateTraceCpp();
-  for(size_t i = 0; i <  allTrace.size(); i++)
-  {
-    this->WriteCpp("  " + allTrace.at(i));
-  } 
-
-  /* Set stop time. */
-  size_t stopTime = 0;/* default stop time. */
-  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
-  {
-    if( (this->m_listApplication.at(i))->GetEndTimeNumber() > stopTime)
-    {
-      stopTime = (this->m_listApplication.at(i))->GetEndTimeNumber();
-    }
-  }
-  stopTime += 1;
-
-  this->WriteCpp("  /* Stop the simulation after x seconds. */");
-  this->WriteCpp("  uint32_t stopTime = "+ utils::integerToString(stopTime) +";"); 
-  this->WriteCpp("  Simulator::Stop (Seconds (stopTime));");
-
-  this->WriteCpp("  /* Start and clean simulation. */");
-  this->WriteCpp("  Simulator::Run ();");
-  this->WriteCpp("  Simulator::Destroy ();");
-
-  this->WriteCpp("}"); 
-  
-  if(fileName != ""){
-    this->m_cppFile.close();
-  }
-}
-
-std::vector<std::string> Generator::GenerateHeader() 
+void Generator::RemoveObjects(const std::set<std::string> &names, const std::set<std::string> &keep)
 {
-  std::vector<std::string> allHeaders;
-  // get all headers.
-  /* from m_listNode. */
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  std::set<std::string> found;
+  for(size_t i = 0; i < this->m_listNode.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNode.at(i))->GenerateHeader();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(names.find(this->m_listNode.at(i)->GetNodeName()) != names.end())
     {
-      allHeaders.push_back(trans.at(j));
+      found.insert(this->m_listNode.at(i)->GetNodeName());
     }
   }
-  /* from m_listLink */
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  for(size_t i = 0; i < this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateHeader();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(names.find(this->m_listNetworkHardware.at(i)->GetNetworkHardwareName()) != names.end())
     {
-      allHeaders.push_back(trans.at(j));
+      found.insert(this->m_listNetworkHardware.at(i)->GetNetworkHardwareName());
     }
   }
-  /* from m_listApplication */
-  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  if(found.size() != names.size())
   {
-    std::vector<std::string> trans = (this->m_listApplication.at(i))->GenerateHeader();
-    for(size_t j = 0; j <  trans.size(); j++)
+    for(std::set<std::string>::const_iterator it = names.begin(); it != names.end(); it++)
     {
-      allHeaders.push_back(trans.at(j));
+      if(found.find(*it) == found.end())
+      {
+        throw std::logic_error("Remove failed! (" + *it + ") not found.");
+      }
     }
   }
 
-  /* check for duplicate */
-  std::vector<std::string> headersWithoutDuplicateElem;
-  bool isDuplicate = false;
-  /* iterate all headers string */
-  for(size_t i = 0; i <  allHeaders.size(); i++)
+  /* links: the removed ones, the memberships and the links left alone. */
+  size_t kept = 0;
+  for(size_t i = 0; i < this->m_listNetworkHardware.size(); i++)
   {
-    isDuplicate = false;
-    /* iterate the vector whith no duplicate */
-    for(size_t j = 0; j <  headersWithoutDuplicateElem.size(); j++)
-    {
-      /* check if the string into the allHeaders vector is also in the vector without duplicate */
-      if( allHeaders.at(i) == headersWithoutDuplicateElem.at(j))
-      {
-        /* it's an duplicated elem. */
-        isDuplicate = true;
-        break;
-      }	
-    }
-    /* add the string from allHeaders if no duplicate have been detected. */
-    if(!isDuplicate)
+    NetworkHardware *link = this->m_listNetworkHardware.at(i);
+    std::string name = link->GetNetworkHardwareName();
+    bool remove = names.find(name) != names.end();
+    if(!remove && link->RemoveInstalledNodes(names) > 0)
     {
-      headersWithoutDuplicateElem.push_back(allHeaders.at(i));
+      remove = link->GetInstalledNodes().size() <= 1 && keep.find(name) == keep.end();
     }
-  }
-  return headersWithoutDuplicateElem;
-}
-
-std::vector<std::string> Generator::GenerateVarsCpp()
-{
-  std::vector<std::string> allVars;
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
-  {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateVarsCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(remove)
     {
-      allVars.push_back(trans.at(j));
+      delete link;
     }
-  }
-
-  /* add nsc var if used. */
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
-  {
-    if( (this->m_listNode.at(i))->GetNsc() != "")
+    else
     {
-      allVars.push_back("std::string nscStack = \"" + (this->m_listNode.at(i))->GetNsc() + "\";");
+      this->m_listNetworkHardware.at(kept++) = link;
     }
   }
-  return allVars;
-}
+  this->m_listNetworkHardware.resize(kept);
 
-std::vector<std::string> Generator::GenerateCmdLineCpp() 
-{
-  std::vector<std::string> allCmdLine;
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  kept = 0;
+  for(size_t i = 0; i < this->m_listNode.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateCmdLineCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(names.find(this->m_listNode.at(i)->GetNodeName()) != names.end())
+    {
+      delete this->m_listNode.at(i);
+    }
+    else
     {
-      allCmdLine.push_back(trans.at(j));
+      this->m_listNode.at(kept++) = this->m_listNode.at(i);
     }
   }
-  return allCmdLine;
-}
+  this->m_listNode.resize(kept);
 
-std::vector<std::string> Generator::GenerateConfigCpp() 
-{
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  kept = 0;
+  for(size_t i = 0; i < this->m_listApplication.size(); i++)
   {
-    if( ((this->m_listNode.at(i))->GetNodeName()).find("tap_") == 0)
+    Application *app = this->m_listApplication.at(i);
+    if(names.find(Generator::ContainerName(app->GetSenderNode())) != names.end() ||
+       names.find(Generator::ContainerName(app->GetReceiverNode())) != names.end())
     {
-      this->AddConfig("GlobalValue::Bind (\"SimulatorImplementationType\", StringValue (\"ns3::RealtimeSimulatorImpl\"));");
-      this->AddConfig("GlobalValue::Bind (\"ChecksumEnabled\", BooleanValue (true));");
+      delete app;
     }
-  }
-
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
-  { 
-    if( ((this->m_listNetworkHardware.at(i))->GetNetworkHardwareName()).find("emu_") == 0 )
+    else
     {
-      this->AddConfig("GlobalValue::Bind (\"SimulatorImplementationType\", StringValue (\"ns3::RealtimeSimulatorImpl\"));");
-      this->AddConfig("GlobalValue::Bind (\"ChecksumEnabled\", BooleanValue (true));");
+      this->m_listApplication.at(kept++) = app;
     }
-  } 
-
-  std::vector<std::string> allConf;
-  for(size_t i = 0; i <  this->m_listConfiguration.size(); i++)
-  {
-    allConf.push_back(this->m_listConfiguration.at(i));
   }
+  this->m_listApplication.resize(kept);
+}
 
-  return allConf;
+void Generator::Reserve(const size_t &nodes, const size_t &links)
+{
+  this->m_listNode.reserve(nodes);
+  this->m_listNetworkHardware.reserve(links);
 }
 
-std::vector<std::string> Generator::GenerateNodeCpp() 
+void Generator::Merge(Generator &other, std::map<std::string, std::string> &renamed)
 {
-  std::vector<std::string> allNodes;
-  /* get all the node code. */
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  renamed.clear();
+  std::set<std::string> names;
+  for(size_t i = 0; i < this->m_listNode.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNode.at(i))->GenerateNodeCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    names.insert(this->m_listNode.at(i)->GetNodeName());
+  }
+  for(size_t i = 0; i < this->m_listNetworkHardware.size(); i++)
+  {
+    names.insert(this->m_listNetworkHardware.at(i)->GetNetworkHardwareName());
+  }
+  for(size_t i = 0; i < this->m_listApplication.size(); i++)
+  {
+    names.insert(this->m_listApplication.at(i)->GetAppName());
+  }
+
+  /* the new names must be free on both sides. */
+  std::vector<std::string> incoming;
+  for(size_t i = 0; i < other.m_listNode.size(); i++)
+  {
+    incoming.push_back(other.m_listNode.at(i)->GetNodeName());
+  }
+  for(size_t i = 0; i < other.m_listNetworkHardware.size(); i++)
+  {
+    incoming.push_back(other.m_listNetworkHardware.at(i)->GetNetworkHardwareName());
+  }
+  for(size_t i = 0; i < other.m_listApplication.size(); i++)
+  {
+    incoming.push_back(other.m_listApplication.at(i)->GetAppName());
+  }
+  std::set<std::string> used(names);
+  used.insert(incoming.begin(), incoming.end());
+  for(size_t i = 0; i < incoming.size(); i++)
+  {
+    if(names.find(incoming.at(i)) != names.end() && renamed.find(incoming.at(i)) == renamed.end())
     {
-      allNodes.push_back(trans.at(j));
+      renamed[incoming.at(i)] = Generator::FreeName(incoming.at(i), used);
     }
   }
-  return allNodes;
-}
 
-std::vector<std::string> Generator::GenerateNetworkHardwareCpp() 
-{
-  std::vector<std::string> allLink;
-  /* get all the link build code. */
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  for(size_t i = 0; i < other.m_listNode.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateNetworkHardwareCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    Node *node = other.m_listNode.at(i);
+    std::map<std::string, std::string>::const_iterator it = renamed.find(node->GetNodeName());
+    if(it != renamed.end())
     {
-      allLink.push_back(trans.at(j));
+      node->SetNodeName(it->second);
+      node->SetIpInterfaceName("iface_" + it->second);
     }
   }
-  return allLink;
-}
-std::vector<std::string> Generator::GenerateNetDeviceCpp() 
-{
-  std::vector<std::string> allNdc;
-  /* get all the link build code. */
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  for(size_t i = 0; i < other.m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateNetDeviceCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    NetworkHardware *link = other.m_listNetworkHardware.at(i);
+    std::map<std::string, std::string>::const_iterator it = renamed.find(link->GetNetworkHardwareName());
+    if(it != renamed.end())
+    {
+      link->SetNetworkHardwareName(it->second);
+    }
+    for(size_t j = 0; j < link->GetInstalledNodes().size(); j++)
+    {
+      link->SetInstalledNode(j, Generator::RenamedNode(link->GetInstalledNode(j), renamed));
+    }
+    /* the loader sets the link names, not the ones derived from them. */
+    link->SetNdcName("ndc_" + link->GetNetworkHardwareName());
+    link->SetAllNodeContainer("all_" + link->GetNetworkHardwareName());
+
+    Ap *ap = dynamic_cast<Ap*>(link);
+    Bridge *bridge = dynamic_cast<Bridge*>(link);
+    Emu *emu = dynamic_cast<Emu*>(link);
+    Tap *tap = dynamic_cast<Tap*>(link);
+    if(ap)
+    {
+      std::string name = ap->GetNetworkHardwareName();
+      ap->SetApNode(Generator::RenamedNode(ap->GetApNode(), renamed));
+      ap->SetApName("wifi-default-" + name.substr(name.find_last_of('_') + 1));
+    }
+    else if(bridge)
+    {
+      bridge->SetNodeBridge(Generator::RenamedNode(bridge->GetNodeBridge(), renamed));
+    }
+    else if(emu)
+    {
+      emu->SetEmuName(Generator::RenamedNode(emu->GetEmuName(), renamed));
+    }
+    else if(tap)
     {
-      allNdc.push_back(trans.at(j));
+      tap->SetTapName(Generator::RenamedNode(tap->GetTapName(), renamed));
     }
   }
-  return allNdc;
-}
-
-std::vector<std::string> Generator::GenerateIpStackCpp() 
-{
-  std::vector<std::string> allStack;
-
-  /* construct node without bridge Node. */
-  allStack.push_back("InternetStackHelper internetStackH;");
-  std::string nodeName = "";
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  for(size_t i = 0; i < other.m_listApplication.size(); i++)
   {
-    nodeName = (this->m_listNode.at(i))->GetNodeName();
-    /* if it is not a bridge you can add it. */
-    if(nodeName.find("bridge_") != 0)
+    Application *app = other.m_listApplication.at(i);
+    std::map<std::string, std::string>::const_iterator it = renamed.find(app->GetAppName());
+    if(it != renamed.end())
     {
-      std::vector<std::string> trans = (this->m_listNode.at(i)->GenerateIpStackCpp());
-      for(size_t j = 0; j <  trans.size(); j++)
-      {
-        allStack.push_back(trans.at(j));
-      }
+      app->SetAppName(it->second);
     }
-  }
-
-  return allStack;
+    app->SetSenderNode(Generator::RenamedNode(app->GetSenderNode(), renamed));
+    app->SetReceiverNode(Generator::RenamedNode(app->GetReceiverNode(), renamed));
+  }
+
+  this->m_listNode.insert(this->m_listNode.end(), other.m_listNode.begin(), other.m_listNode.end());
+  this->m_listNetworkHardware.insert(this->m_listNetworkHardware.end(), other.m_listNetworkHardware.begin(), other.m_listNetworkHardware.end());
+  this->m_listApplication.insert(this->m_listApplication.end(), other.m_listApplication.begin(), other.m_listApplication.end());
+  other.m_listNode.clear();
+  other.m_listNetworkHardware.clear();
+  other.m_listApplication.clear();
+
+  this->m_indiceNodePc += other.m_indiceNodePc;
+  this->m_indiceNodeRouter += other.m_indiceNodeRouter;
+  this->m_indiceNodeAp += other.m_indiceNodeAp;
+  this->m_indiceNodeStation += other.m_indiceNodeStation;
+  this->m_indiceNodeBridge += other.m_indiceNodeBridge;
+  this->m_indiceNodeTap += other.m_indiceNodeTap;
+  this->m_indiceNodeEmu += other.m_indiceNodeEmu;
+  this->m_indiceApplicationPing += other.m_indiceApplicationPing;
+  this->m_indiceApplicationTcpLargeTransfer += other.m_indiceApplicationTcpLargeTransfer;
+  this->m_indiceApplicationUdpEcho += other.m_indiceApplicationUdpEcho;
+  this->m_indiceNetworkHardwareAp += other.m_indiceNetworkHardwareAp;
+  this->m_indiceNetworkHardwareEmu += other.m_indiceNetworkHardwareEmu;
+  this->m_indiceNetworkHardwarePointToPoint += other.m_indiceNetworkHardwarePointToPoint;
+  this->m_indiceNetworkHardwareTap += other.m_indiceNetworkHardwareTap;
+  this->m_indiceNetworkHardwareHub += other.m_indiceNetworkHardwareHub;
+  this->m_indiceNetworkHardwareBridge += other.m_indiceNetworkHardwareBridge;
+
+  this->m_scheduler = other.m_scheduler;
+  this->m_parameterized = other.m_parameterized;
 }
 
-std::vector<std::string> Generator::GenerateIpAssignCpp() 
+void Generator::GetAddresses(std::map<std::string, std::vector<std::pair<size_t, std::string> > > &addresses)
 {
-  std::vector<std::string> ipAssign;
-  ipAssign.push_back("Ipv4AddressHelper ipv4;");
-
-  size_t ipRange = 0;
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  addresses.clear();
+  std::map<std::string, size_t> machines;
+  for(size_t i = 0; i < this->m_listNode.size(); i++)
   {
-    ipAssign.push_back("ipv4.SetBase (\"10.0." + utils::integerToString(ipRange) + ".0\", \"255.255.255.0\");");
-    ipAssign.push_back("Ipv4InterfaceContainer iface_" + this->m_listNetworkHardware.at(i)->GetNdcName() + " = ipv4.Assign (" + this->m_listNetworkHardware.at(i)->GetNdcName() + ");");
-    ipRange += 1;
-  } 
-
-  return ipAssign;
-}
-
-std::vector<std::string> Generator::GenerateRouteCpp() 
-{
-  std::vector<std::string> allRoutes;
- 
-  allRoutes.push_back("Ipv4GlobalRoutingHelper::PopulateRoutingTables ();");
-
-  return allRoutes;
-}
+    machines[this->m_listNode.at(i)->GetNodeName()] = this->m_listNode.at(i)->GetMachinesNumber();
+  }
 
-std::vector<std::string> Generator::GenerateApplicationCpp() 
-{
-  size_t nodeNumber = 0;
-  std::string ndcName = "";
-  size_t linkNumber = 0;
-  std::vector<std::string> allApps;
-  /* get all the ip assign code. */
-  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  for(size_t i = 0; i < this->m_listNetworkHardware.size(); i++)
   {
-    /* get NetDeviceContainer and number from the receiver. */
-    std::string receiverName = this->m_listApplication.at(i)->GetReceiverNode();
-    nodeNumber = 0;
-    ndcName = "";
-    linkNumber = 0;
-
-    /* if the receiver is in NodeContainer */
-    if(receiverName.find("NodeContainer(") == 0)
-    {
-      std::string oldReceiverName = receiverName;
-      
-      std::vector<std::string> tab_name;
-      split(tab_name, receiverName, '(');
-      
-      std::string str_get = tab_name.at(1);
-      std::vector<std::string> tab_name2;
-      split(tab_name2, str_get, '.');
-      
-      receiverName = tab_name2.at(0);
-      for(size_t x = 0;  x < this->m_listNetworkHardware.size(); x++)
-      {
-        nodeNumber = 0;
-        for(size_t y = 0; y < this->m_listNetworkHardware.at(x)->GetInstalledNodes().size(); y++)
-        {
-          if(this->m_listNetworkHardware.at(x)->GetInstalledNodes().at(y) == receiverName || this->m_listNetworkHardware.at(x)->GetInstalledNodes().at(y) == oldReceiverName)
-          {
-            ndcName = (this->m_listNetworkHardware.at(x))->GetNdcName();
-            linkNumber = x;
-            break;
-          }
-          if(ndcName != "")
-          {
-            break;
-          }
-        }
-      }
-      std::vector<std::string> linksNode = this->m_listNetworkHardware.at(linkNumber)->GetInstalledNodes();
-      for(size_t j = 0; j < linksNode.size(); j++)
-      {
-        if(linksNode.at(j) == oldReceiverName)
-        {
-          nodeNumber = j;
-          break;
-        }
-      }
+    NetworkHardware *link = this->m_listNetworkHardware.at(i);
+    std::string subnet = "10.0." + utils::integerToString(i) + ".";
+    size_t host = 1;
+
+    std::vector<std::string> nodes;
+    Ap *ap = dynamic_cast<Ap*>(link);
+    if(ap)
+    {
+      nodes.push_back(ap->GetApNode());
     }
-    else
+    std::vector<std::string> members = link->GetInstalledNodes();
+    for(size_t j = 0; j < members.size(); j++)
     {
-      for(size_t j = 0; j <  this->m_listNetworkHardware.size(); j++)
+      if(members.at(j).find("ap_") != 0)
       {
-        nodeNumber = 0;
-        linkNumber = 0;
-        std::vector<std::string> nodes = (this->m_listNetworkHardware.at(j))->GetInstalledNodes();
-        for(size_t k = 0; k <  nodes.size(); k++)
-        {
-          if( nodes.at(k) == receiverName)
-          {
-            ndcName = (this->m_listNetworkHardware.at(j))->GetNdcName();
-            break;
-          }
-          else
-          {
-            for(size_t l = 0; l <  this->m_listNode.size(); l++)
-            {
-              if(this->m_listNode.at(l)->GetNodeName() == nodes.at(k))
-              {
-                nodeNumber += this->m_listNode.at(l)->GetMachinesNumber();
-                break;
-              }
-            }
-          }
-        }
-        if(ndcName != "")
-        {
-          break;
-        }
+        nodes.push_back(members.at(j));
       }
     }
-    /* get the application code with param. */
-    std::vector<std::string> trans = (this->m_listApplication.at(i)->GenerateApplicationCpp(ndcName, nodeNumber));
-    for(size_t j = 0; j <  trans.size(); j++)
+
+    for(size_t j = 0; j < nodes.size(); j++)
     {
-      allApps.push_back(trans.at(j));
+      std::map<std::string, size_t>::const_iterator it = machines.find(nodes.at(j));
+      size_t number = (it != machines.end() && it->second > 0) ? it->second : 1;
+      std::string address = subnet + utils::integerToString(host);
+      if(number > 1)
+      {
+        address += " - " + subnet + utils::integerToString(host + number - 1);
+      }
+      addresses[nodes.at(j)].push_back(std::make_pair(i, address));
+      host += number;
     }
   }
-
-  return allApps;
 }
 
-std::vector<std::string> Generator::GenerateTapBridgeCpp()
+std::string Generator::ContainerName(const std::string &nodeName)
 {
-  std::vector<std::string> allTapBridge;
-
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  /* group member: NodeContainer(name.Get(k)) */
+  if(nodeName.find("NodeContainer(") == 0)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateTapBridgeCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allTapBridge.push_back(trans.at(j));
-    }
+    std::string member = nodeName.substr(std::string("NodeContainer(").size());
+    return member.substr(0, member.find(".Get("));
   }
-
-  return allTapBridge;
+  return nodeName;
 }
 
-std::vector<std::string> Generator::GenerateTraceCpp()
+std::string Generator::RenamedNode(const std::string &nodeName, const std::map<std::string, std::string> &renamed)
 {
-  std::vector<std::string> allTrace;
-
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  std::string container = Generator::ContainerName(nodeName);
+  std::map<std::string, std::string>::const_iterator it = renamed.find(container);
+  if(it == renamed.end())
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateTraceCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allTrace.push_back(trans.at(j));
-    }
+    return nodeName;
   }
+  std::string res = nodeName;
+  res.replace(res.find(container), container.size(), it->second);
+  return res;
+}
 
-  return allTrace;
+std::string Generator::FreeName(const std::string &name, std::set<std::string> &used)
+{
+  std::string prefix = name.substr(0, name.find_last_of('_') + 1);
+  size_t number = 0;
+  while(used.find(prefix + utils::integerToString(number)) != used.end())
+  {
+    number++;
+  }
+  used.insert(prefix + utils::integerToString(number));
+  return prefix + utils::integerToString(number);
 }
 
 //
 // Part around the C++ code Generation.
 // This part is looking about the code to write.
+//
+
+void Generator::GenerateCodeCpp(std::string fileName) 
+{
+  CppBackend cpp;
+  this->GenerateCode(std::vector<Backend*>(1, &cpp), std::vector<std::string>(1, fileName));
+}
 
 void Generator::GenerateCodePython(std::string fileName)
 {
-  if(fileName != ""){
-    this->m_pyFile.open(fileName.c_str());
+  PythonBackend python;
+  this->GenerateCode(std::vector<Backend*>(1, &python), std::vector<std::string>(1, fileName));
+}
+
+void Generator::GenerateCode(const std::string &cppFileName, const std::string &pythonFileName)
+{
+  CppBackend cpp;
+  PythonBackend python;
+  std::vector<Backend*> backends;
+  std::vector<std::string> fileNames;
+  backends.push_back(&cpp);
+  fileNames.push_back(cppFileName);
+  backends.push_back(&python);
+  fileNames.push_back(pythonFileName);
+  this->GenerateCode(backends, fileNames);
+}
+
+void Generator::GenerateCode(const std::vector<Backend*> &backends, const std::vector<std::string> &fileNames)
+{
+  this->m_backends = backends;
+  std::vector<Profiling*> profilings;
+  for(size_t i = 0; i < backends.size(); i++)
+  {
+    if(fileNames.at(i) != "")
+    {
+      CompressedFile &file = backends.at(i)->GetName() == "cpp" ? this->m_cppFile : this->m_pyFile;
+      file.Create(this->OutputFileName(fileNames.at(i)), this->m_compression);
+    }
+    profilings.push_back(new Profiling(this->m_simulationName, Profiling::OutputNameFromFile(fileNames.at(i))));
+    profilings.back()->SetScheduler(this->m_scheduler);
   }
-  
-  //
-  // Generate headers 
-  //
-  this->WritePython("import ns3");
-  this->WritePython("");
-  this->WritePython("def main(argv):");
-  this->WritePython("");
+  this->UpdateParameterized(this->m_parameterized);
+  this->LoadFragments();
 
   //
-  // Tap/Emu variables
+  // Headers, vars and command line.
   //
-  std::vector<std::string> allVars = GenerateVarsPython();
-  for(size_t i = 0; i <  allVars.size(); i++)
-  {
-    this->WritePython("    " + allVars.at(i));
-    this->WritePython("");
+  std::vector<std::string> allHeaders;
+  allHeaders.push_back("#include \"ns3/core-module.h\"");
+  allHeaders.push_back("#include \"ns3/global-route-manager.h\"");
+  allHeaders.push_back("#include \"ns3/network-module.h\"");
+  allHeaders.push_back("#include \"ns3/internet-module.h\"");
+  std::vector<std::string> headers = GenerateHeader();
+  allHeaders.insert(allHeaders.end(), headers.begin(), headers.end());
+
+  std::vector<std::vector<std::string> > allVars = this->GeneratePhase("vars", std::vector<Statement>());
+  std::vector<std::vector<std::string> > allCmdLine = this->GeneratePhase("cmdLine", std::vector<Statement>());
+  for(size_t i = 0; i < backends.size(); i++)
+  {
+    if(backends.at(i)->GetName() == "cpp")
+    {
+      this->WriteMainCpp(*profilings.at(i), allHeaders, allVars.at(i), allCmdLine.at(i), fileNames.at(i));
+    }
+    else
+    {
+      this->WriteMainPython(*profilings.at(i), allVars.at(i), allCmdLine.at(i));
+    }
   }
 
   //
-  // Generate Command Line 
+  // Setup phases, each one is written in all the languages.
   //
-  this->WritePython("    cmd = ns3.CommandLine()");
+  std::vector<Statement> configuration = this->DescribeConfig();
+  std::vector<Statement> scheduler = this->DescribeScheduler();
+  configuration.insert(configuration.end(), scheduler.begin(), scheduler.end());
+  this->WritePhase(profilings, "Configuration.", this->Render(configuration), "configuration");
+  this->WritePhase(profilings, "Build nodes.", this->GeneratePhase("nodes", std::vector<Statement>()), "nodes");
+  this->WritePhase(profilings, "Build link.", this->GeneratePhase("links", std::vector<Statement>()), "links");
+  this->WritePhase(profilings, "Build link net device container.", this->GeneratePhase("netDevices", std::vector<Statement>()), "netDevices");
+  this->WritePhase(profilings, "Install the IP stack.",
+      this->GeneratePhase("ipStack", std::vector<Statement>(1, Statement::Declare("InternetStackHelper", "internetStackH"))), "ipStack");
+  this->WritePhase(profilings, "IP assign.",
+      this->GeneratePhase("ipAssign", std::vector<Statement>(1, Statement::Declare("Ipv4AddressHelper", "ipv4"))), "ipAssign");
 
-  std::vector<std::string> allCmdLine = GenerateCmdLinePython();
-  for(size_t i = 0; i <  allCmdLine.size(); i++)
+  /* the tap bridge phase is written only if a tap is used. */
+  std::vector<std::vector<std::string> > allTapBridge = this->GeneratePhase("tapBridge", std::vector<Statement>());
+  if(allTapBridge.size() > 0 && allTapBridge.at(0).size() > 0)
   {
-    this->WritePython("    " + allCmdLine.at(i));
-  } 
+    this->WritePhase(profilings, "Tap Bridge.", allTapBridge, "tapBridge");
+  }
 
-  this->WritePython("    cmd.Parse (argv)");
+  this->WritePhase(profilings, "Generate Route.", this->Render(this->DescribeRoute()), "routes");
+  this->WritePhase(profilings, "Generate Application.", this->GeneratePhase("applications", std::vector<Statement>()), "applications");
 
   //
-  // Generate Optional configuration
-  // 
-  this->WritePython("");
-  this->WritePython("    # Configuration.");
-  std::vector<std::string> conf = GenerateConfigPython();
-  for(size_t i = 0; i <  conf.size(); i++)
+  // Others
+  //
+  std::vector<std::vector<std::string> > allTrace = this->GeneratePhase("traces", std::vector<Statement>());
+  std::vector<std::vector<std::string> > allStop = this->Render(this->DescribeStop());
+  std::vector<std::vector<std::string> > allRun = this->Render(this->DescribeRun());
+  for(size_t i = 0; i < backends.size(); i++)
+  {
+    bool cpp = backends.at(i)->GetName() == "cpp";
+    this->Write(i, "");
+    this->WriteComment(i, "Simulation.");
+    this->WriteComment(i, "Pcap output.");
+    this->WriteLines(i, allTrace.at(i));
+    this->WriteProfilingPhase(i, *profilings.at(i), "tracing");
+
+    this->WriteComment(i, "Stop the simulation after x seconds.");
+    this->WriteLines(i, allStop.at(i));
+    this->WriteComment(i, "Start and clean simulation.");
+    if(this->m_profiling)
+    {
+      this->WriteLines(i, cpp ? profilings.at(i)->GenerateRunCpp() : profilings.at(i)->GenerateRunPython());
+    }
+    else
+    {
+      this->WriteLines(i, allRun.at(i));
+    }
+
+    if(cpp)
+    {
+      this->WriteCpp("}"); 
+      this->WriteStructureHashCpp(allHeaders, std::vector<std::string>(1, fileNames.at(i)), false);
+    }
+    else
+    {
+      this->WritePython("");
+      this->WritePython("if __name__ == '__main__':");
+      this->WritePython("    import sys");
+      this->WritePython("    main(sys.argv)");
+    }
+  }
+  
+  this->m_fragments.clear();
+  for(size_t i = 0; i < backends.size(); i++)
   {
-    this->WritePython("    " + conf.at(i));
+    if(fileNames.at(i) != "")
+    {
+      CompressedFile &file = backends.at(i)->GetName() == "cpp" ? this->m_cppFile : this->m_pyFile;
+      file.Close();
+    }
+    delete profilings.at(i);
   }
+  this->m_backends.clear();
+}
 
-  //
-  // Generate Nodes. 
-  //
-  this->WritePython("");
-  this->WritePython("    # Build nodes");
-  std::vector<std::string> nodeBuild = GenerateNodePython();
-  for(size_t i = 0; i <  nodeBuild.size(); i++)
+std::vector<std::string> Generator::GenerateHeader() 
+{
+  std::vector<std::string> allHeaders;
+  // get all headers.
+  /* from m_listNode. */
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
   {
-    this->WritePython("    " + nodeBuild.at(i));
+    std::vector<std::string> trans = (this->m_listNode.at(i))->GenerateHeader();
+    for(size_t j = 0; j <  trans.size(); j++)
+    {
+      allHeaders.push_back(trans.at(j));
+    }
   }
-
-  //
-  // Generate Link.
-  //
-  this->WritePython("");
-  this->WritePython("    # Build link.");
-  std::vector<std::string> linkBuild = GenerateNetworkHardwarePython();
-  for(size_t i = 0; i <  linkBuild.size(); i++)
+  /* from m_listLink */
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateHeader();
+    for(size_t j = 0; j <  trans.size(); j++)
+    {
+      allHeaders.push_back(trans.at(j));
+    }
+  }
+  /* from m_listApplication */
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
   {
-    this->WritePython("    " + linkBuild.at(i));
+    std::vector<std::string> trans = (this->m_listApplication.at(i))->GenerateHeader();
+    for(size_t j = 0; j <  trans.size(); j++)
+    {
+      allHeaders.push_back(trans.at(j));
+    }
   }
 
-  //
-  // Generate link net device container.
-  //
-  this->WritePython("");
-  this->WritePython("    # Build link net device container.");
-  std::vector<std::string> linkNdcBuild = GenerateNetDevicePython(); 
-  for(size_t i = 0; i <  linkNdcBuild.size(); i++)
+  /* check for duplicate */
+  std::vector<std::string> headersWithoutDuplicateElem;
+  bool isDuplicate = false;
+  /* iterate all headers string */
+  for(size_t i = 0; i <  allHeaders.size(); i++)
   {
-    this->WritePython("    " + linkNdcBuild.at(i));
+    isDuplicate = false;
+    /* iterate the vector whith no duplicate */
+    for(size_t j = 0; j <  headersWithoutDuplicateElem.size(); j++)
+    {
+      /* check if the string into the allHeaders vector is also in the vector without duplicate */
+      if( allHeaders.at(i) == headersWithoutDuplicateElem.at(j))
+      {
+        /* it's an duplicated elem. */
+        isDuplicate = true;
+        break;
+      }	
+    }
+    /* add the string from allHeaders if no duplicate have been detected. */
+    if(!isDuplicate)
+    {
+      headersWithoutDuplicateElem.push_back(allHeaders.at(i));
+    }
   }
+  return headersWithoutDuplicateElem;
+}
 
-  //
-  // Generate IP Stack. 
-  //
-  this->WritePython("");
-  this->WritePython("    # Install the IP stack.");
-  std::vector<std::string> allStacks = GenerateIpStackPython();
-  for(size_t i = 0; i <  allStacks.size(); i++)
+std::vector<Statement> Generator::DescribeConfig() 
+{
+  std::vector<Statement> allConf;
+  for(size_t i = 0; i <  this->m_listConfiguration.size(); i++)
   {
-    this->WritePython("    " + allStacks.at(i));
+    allConf.push_back(Statement::Verbatim(this->m_listConfiguration.at(i)));
   }
 
-  //
-  // Generate IP assignation.
-  // 
-  this->WritePython("");
-  this->WritePython("    # IP assign.");
-  std::vector<std::string> allAssign = GenerateIpAssignPython();
-  for(size_t i = 0; i <  allAssign.size(); i++)
+  /* a tap or an emu link runs the simulation in real time. */
+  bool realtime = false;
+  for(size_t i = 0; i <  this->m_listNode.size(); i++)
   {
-    this->WritePython("    " + allAssign.at(i));
+    realtime = realtime || ((this->m_listNode.at(i))->GetNodeName()).find("tap_") == 0;
+  }
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  { 
+    realtime = realtime || ((this->m_listNetworkHardware.at(i))->GetNetworkHardwareName()).find("emu_") == 0;
   } 
-
-  //
-  // Generate TapBridge if tap is used.
-  //
-  std::vector<std::string> allTapBridge = GenerateTapBridgePython();
-  if(allTapBridge.size() > 0)
+  if(realtime)
   {
-    this->WritePython("");
-    this->WritePython("    # Tap Bridge.");
+    allConf.push_back(Statement::Evaluate(Expression::Static("GlobalValue", "Bind").Arg(Expression::String("SimulatorImplementationType"))
+          .Arg(Expression::Function("StringValue").Arg(Expression::String("ns3::RealtimeSimulatorImpl")))));
+    allConf.push_back(Statement::Evaluate(Expression::Static("GlobalValue", "Bind").Arg(Expression::String("ChecksumEnabled"))
+          .Arg(Expression::Function("BooleanValue").Arg(Expression::Boolean(true)))));
   }
-  for(size_t i = 0; i <  allTapBridge.size(); i++)
-  {
-    this->WritePython("    " + allTapBridge.at(i));
-  } 
 
-  //
-  // Generate Route.
-  //
-  this->WritePython("");
-  this->WritePython("    # Generate Route.");
-  std::vector<std::string> allRoutes = GenerateRoutePython();
-  for(size_t i = 0; i <  allRoutes.size(); i++)
-  {
-    this->WritePython("    " + allRoutes.at(i));
-  } 
+  return allConf;
+}
 
-  //
-  // Generate Application.
-  //
-  this->WritePython("");
-  this->WritePython("    # Generate Application.");
-  std::vector<std::string> allApps = GenerateApplicationPython();
-  for(size_t i = 0; i <  allApps.size(); i++)
+std::vector<Statement> Generator::DescribeScheduler()
+{
+  std::vector<Statement> scheduler;
+  if(this->m_scheduler != "")
   {
-    this->WritePython("    " + allApps.at(i));
-  } 
+    scheduler.push_back(Statement::Declare("ObjectFactory", "schedulerFactory"));
+    scheduler.push_back(Statement::Call("schedulerFactory", "SetTypeId").Arg(Expression::String("ns3::" + this->m_scheduler + "Scheduler")));
+    scheduler.push_back(Statement::Evaluate(Expression::Static("Simulator", "SetScheduler").Arg(Expression::Name("schedulerFactory"))));
+  }
+  return scheduler;
+}
 
-  //
-  // Others
-  //
-  this->WritePython("");
-  this->WritePython("    # Simulation.");
+std::vector<Statement> Generator::DescribeIpAssign(const size_t &index)
+{
+  std::vector<Statement> ipAssign;
+  std::string ndcName = this->m_listNetworkHardware.at(index)->GetNdcName();
+  ipAssign.push_back(Statement::Call("ipv4", "SetBase").Arg(Expression::Convert("Ipv4Address", Expression::String("10.0." + utils::integerToString(index) + ".0")))
+      .Arg(Expression::Convert("Ipv4Mask", Expression::String("255.255.255.0"))));
+  ipAssign.push_back(Statement::Define("Ipv4InterfaceContainer", "iface_" + ndcName, Expression::Method("ipv4", "Assign").Arg(Expression::Name(ndcName))));
+
+  return ipAssign;
+}
+
+std::vector<Statement> Generator::DescribeRoute() 
+{
+  std::vector<Statement> allRoutes;
+ 
+  allRoutes.push_back(Statement::Evaluate(Expression::Static("Ipv4GlobalRoutingHelper", "PopulateRoutingTables")));
+
+  return allRoutes;
+}
 
+std::vector<Statement> Generator::DescribeApplication(const size_t &index)
+{
+  size_t nodeNumber = 0;
+  std::vector<std::string> nodeGroups;
 
-  this->WritePython("    # Pcap output.");
-  std::vector<std::string> allTrace = GenerateTracePython();
-  for(size_t i = 0; i <  allTrace.size(); i++)
+  /* get NetDeviceContainer and number from the receiver. */
+  size_t linkNumber = this->FindReceiver(this->m_listApplication.at(index), nodeNumber, nodeGroups);
+  std::string ndcName = "";
+  if(linkNumber < this->m_listNetworkHardware.size())
   {
-    this->WritePython("    " + allTrace.at(i));
-  } 
+    ndcName = this->m_listNetworkHardware.at(linkNumber)->GetNdcName();
+  }
+  /* get the application code with param. */
+  return this->m_listApplication.at(index)->DescribeApplication(ndcName, Generator::IndexValue(nodeNumber, nodeGroups));
+}
 
+std::vector<Statement> Generator::DescribeStop()
+{
   /* Set stop time. */
   size_t stopTime = 0;/* default stop time. */
   for(size_t i = 0; i <  this->m_listApplication.size(); i++)
@@ -1164,311 +2150,298 @@ void Generator::GenerateCodePython(std::string fileName)
   }
   stopTime += 1;
 
-  this->WritePython("    # Stop the simulation after x seconds.");
-  this->WritePython("    stopTime = "+ utils::integerToString(stopTime) ); 
-  this->WritePython("    ns3.Simulator.Stop (ns3.Seconds(stopTime))");
-
-  this->WritePython("    # Start and clean simulation.");
-  this->WritePython("    ns3.Simulator.Run()");
-  this->WritePython("    ns3.Simulator.Destroy()");
+  /* the end times given on the command line move the stop time. */
+  Expression lastEnd = Expression::Max();
+  bool parameterized = false;
+  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  {
+    Application *application = this->m_listApplication.at(i);
+    if(application->GetParameterized())
+    {
+      lastEnd.Arg(Expression::Name("endTime_" + application->GetAppName() + " + 1"));
+      parameterized = true;
+    }
+    else
+    {
+      lastEnd.Arg(Expression::Name(utils::integerToString(application->GetEndTimeNumber() + 1) + ".0"));
+    }
+  }
 
-  this->WritePython("");
-  this->WritePython("if __name__ == '__main__':");
-  this->WritePython("    import sys");
-  this->WritePython("    main(sys.argv)");
-  
-  if(fileName != ""){
-    this->m_pyFile.close();
+  std::vector<Statement> stop;
+  if(parameterized)
+  {
+    stop.push_back(Statement::Define("double", "stopTime", lastEnd));
+  }
+  else
+  {
+    stop.push_back(Statement::Define("uint32_t", "stopTime", Expression::Name(utils::integerToString(stopTime))));
   }
+  stop.push_back(Statement::Evaluate(Expression::Static("Simulator", "Stop").Arg(Expression::Function("Seconds").Arg(Expression::Name("stopTime")))));
+  return stop;
 }
 
-
-std::vector<std::string> Generator::GenerateVarsPython()
+std::vector<Statement> Generator::DescribeRun()
 {
-  std::vector<std::string> ret;
-  return ret;
+  std::vector<Statement> run;
+  run.push_back(Statement::Evaluate(Expression::Static("Simulator", "Run")));
+  run.push_back(Statement::Evaluate(Expression::Static("Simulator", "Destroy")));
+  return run;
 }
 
-std::vector<std::string> Generator::GenerateCmdLinePython()
-{
-  std::vector<std::string> allCmdLine;
+//
+// Part around the code writing.
+//
 
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+void Generator::Write(const size_t &backend, const std::string &line)
+{
+  if(this->m_backends.at(backend)->GetName() == "cpp")
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateCmdLinePython();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allCmdLine.push_back(trans.at(j));
-    }
+    this->WriteCpp(line);
+  }
+  else
+  {
+    this->WritePython(line);
   }
-  return allCmdLine;
 }
 
-std::vector<std::string> Generator::GenerateConfigPython()
+void Generator::WriteLines(const size_t &backend, const std::vector<std::string> &lines)
 {
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  std::string indent = this->m_backends.at(backend)->GetIndent();
+  for(size_t i = 0; i <  lines.size(); i++)
   {
-    if( ((this->m_listNode.at(i))->GetNodeName()).find("tap_") == 0)
-    {
-      this->AddConfig("ns3.GlobalValue.Bind (\"SimulatorImplementationType\", ns3.StringValue (\"ns3::RealtimeSimulatorImpl\"));");
-      this->AddConfig("ns3.GlobalValue.Bind (\"ChecksumEnabled\", ns3.BooleanValue (true));");
-    }
+    this->Write(backend, indent + lines.at(i));
   }
+}
 
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+void Generator::WriteComment(const size_t &backend, const std::string &text)
+{
+  this->WriteLines(backend, this->m_backends.at(backend)->RenderStatement(Statement::Comment(text)));
+}
+
+void Generator::WriteProfilingPhase(const size_t &backend, Profiling &profiling, const std::string &phase)
+{
+  if(this->m_backends.at(backend)->GetName() == "cpp")
   {
-    if( ((this->m_listNetworkHardware.at(i))->GetNetworkHardwareName()).find("emu_") == 0 )
-    {
-      this->AddConfig("ns3.GlobalValue.Bind (\"SimulatorImplementationType\", ns3.StringValue (\"ns3::RealtimeSimulatorImpl\"));");
-      this->AddConfig("ns3.GlobalValue.Bind (\"ChecksumEnabled\", ns3.BooleanValue (true));");
-    }
+    this->WriteProfilingPhaseCpp(profiling, phase);
   }
-
-  std::vector<std::string> allConf;
-  for(size_t i = 0; i <  this->m_listConfiguration.size(); i++)
+  else
   {
-    allConf.push_back(this->m_listConfiguration.at(i));
+    this->WriteProfilingPhasePython(profiling, phase);
   }
-
-  return allConf;
 }
 
-std::vector<std::string> Generator::GenerateNodePython()
+void Generator::WritePhase(const std::vector<Profiling*> &profilings, const std::string &comment, const std::vector<std::vector<std::string> > &code,
+    const std::string &phase)
 {
-  std::vector<std::string> allNodes;
-  /* get all the node code. */
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  for(size_t i = 0; i < this->m_backends.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNode.at(i))->GenerateNodePython();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allNodes.push_back(trans.at(j));
-    }
+    this->Write(i, "");
+    this->WriteComment(i, comment);
+    this->WriteLines(i, code.at(i));
+    this->WriteProfilingPhase(i, *profilings.at(i), phase);
   }
-  return allNodes;
 }
 
-std::vector<std::string> Generator::GenerateNetworkHardwarePython()
+void Generator::WriteMainCpp(Profiling &profiling, const std::vector<std::string> &headers, const std::vector<std::string> &vars,
+    const std::vector<std::string> &cmdLine, const std::string &fileName)
 {
-  std::vector<std::string> allLink;
-  /* get all the link build code. */
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  //
+  // Structure hash, the command line parameters values are left out.
+  //
+  std::vector<std::string> allVars = vars;
+  std::vector<std::string> allCmdLine = cmdLine;
+  if(this->m_profiling)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateNetworkHardwarePython();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allLink.push_back(trans.at(j));
-    }
+    std::vector<std::string> profilingVars = profiling.GenerateVarsCpp();
+    allVars.insert(allVars.end(), profilingVars.begin(), profilingVars.end());
+    std::vector<std::string> profilingCmdLine = profiling.GenerateCmdLineCpp();
+    allCmdLine.insert(allCmdLine.end(), profilingCmdLine.begin(), profilingCmdLine.end());
   }
-  return allLink;
-}
+  delete this->m_structure;
+  this->m_structure = new BuildCache(fileName);
+  this->m_structure->AddParameters(allVars, allCmdLine);
 
-std::vector<std::string> Generator::GenerateNetDevicePython()
-{
-  std::vector<std::string> allNdc;
-  /* get all the link build code. */
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  //
+  // Generate headers 
+  //
+  for(size_t i = 0; i <  headers.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateNetDevicePython();
-    for(size_t j = 0; j <  trans.size(); j++)
+    this->WriteCpp(headers.at(i));
+  }
+  if(this->m_profiling)
+  {
+    std::vector<std::string> profilingHeaders = profiling.GenerateHeader();
+    for(size_t i = 0; i <  profilingHeaders.size(); i++)
     {
-      allNdc.push_back(trans.at(j));
+      this->WriteCpp(profilingHeaders.at(i));
     }
   }
-  return allNdc;
-}
 
-std::vector<std::string> Generator::GenerateIpStackPython()
-{
-  std::vector<std::string> allStack;
+  this->WriteCpp("");
+  this->WriteCpp("using namespace ns3;");
+  this->WriteCpp("");
 
-  /* construct node without bridge Node. */
-  allStack.push_back("internetStackH = ns3.InternetStackHelper()");
-  std::string nodeName = "";
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  //
+  // Self-profiling helpers
+  //
+  if(this->m_profiling)
   {
-    nodeName = (this->m_listNode.at(i))->GetNodeName();
-    /* if it is not a bridge you can add it. */
-    if(nodeName.find("bridge_") != 0)
+    std::vector<std::string> profilingHelpers = profiling.GenerateHelpersCpp();
+    for(size_t i = 0; i <  profilingHelpers.size(); i++)
     {
-      std::vector<std::string> trans = (this->m_listNode.at(i)->GenerateIpStackPython());
-      for(size_t j = 0; j <  trans.size(); j++)
-      {
-        allStack.push_back(trans.at(j));
-      }
+      this->WriteCpp(profilingHelpers.at(i));
     }
+    this->WriteCpp("");
   }
 
-  return allStack;
-}
-
-std::vector<std::string> Generator::GenerateIpAssignPython()
-{
-  std::vector<std::string> ipAssign;
-  ipAssign.push_back("ipv4 = ns3.Ipv4AddressHelper()");
+  this->WriteCpp("int main(int argc, char *argv[])");
+  this->WriteCpp("{");
 
-  size_t ipRange = 0;
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  //
+  // Tap/Emu variables
+  //
+  for(size_t i = 0; i <  allVars.size(); i++)
   {
-    ipAssign.push_back("ipv4.SetBase (ns3.Ipv4Address(\"10.0." + utils::integerToString(ipRange) + ".0\"), ns3.Ipv4Mask(\"255.255.255.0\"))");
-    ipAssign.push_back("iface_" + this->m_listNetworkHardware.at(i)->GetNdcName() + " = ipv4.Assign (" + this->m_listNetworkHardware.at(i)->GetNdcName() + ")");
-    ipRange += 1;
+    this->WriteCpp("  " + allVars.at(i));
+    this->WriteCpp("");
   }
 
-  return ipAssign;
+  //
+  // Generate Command Line 
+  //
+  this->WriteCpp("  CommandLine cmd;");
+  for(size_t i = 0; i <  allCmdLine.size(); i++)
+  {
+    this->WriteCpp("  " + allCmdLine.at(i));
+  } 
+  this->WriteCpp("  cmd.Parse (argc, argv);");
 }
 
-std::vector<std::string> Generator::GenerateTapBridgePython()
+void Generator::WriteMainPython(Profiling &profiling, const std::vector<std::string> &vars, const std::vector<std::string> &cmdLine)
 {
-  std::vector<std::string> allTapBridge;
+  //
+  // Generate headers 
+  //
+  this->WritePython("import ns3");
+  this->WritePython("");
 
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  //
+  // Self-profiling helpers
+  //
+  if(this->m_profiling)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateTapBridgePython();
-    for(size_t j = 0; j <  trans.size(); j++)
+    std::vector<std::string> profilingHelpers = profiling.GenerateHelpersPython();
+    for(size_t i = 0; i <  profilingHelpers.size(); i++)
     {
-      allTapBridge.push_back(trans.at(j));
+      this->WritePython(profilingHelpers.at(i));
     }
+    this->WritePython("");
   }
+  this->WritePython("def main(argv):");
+  this->WritePython("");
 
-  return allTapBridge;
-}
+  //
+  // Tap/Emu variables
+  //
+  std::vector<std::string> allVars = vars;
+  if(this->m_profiling)
+  {
+    std::vector<std::string> profilingVars = profiling.GenerateVarsPython();
+    allVars.insert(allVars.end(), profilingVars.begin(), profilingVars.end());
+  }
+  for(size_t i = 0; i <  allVars.size(); i++)
+  {
+    this->WritePython("    " + allVars.at(i));
+    this->WritePython("");
+  }
 
-std::vector<std::string> Generator::GenerateRoutePython()
-{
-  std::vector<std::string> allRoutes;
+  //
+  // Generate Command Line 
+  //
+  std::vector<std::string> allCmdLine = cmdLine;
+  if(this->m_profiling)
+  {
+    std::vector<std::string> profilingCmdLine = profiling.GenerateCmdLinePython();
+    allCmdLine.insert(allCmdLine.end(), profilingCmdLine.begin(), profilingCmdLine.end());
+  }
+  this->WritePython("    cmd = ns3.CommandLine()");
+  for(size_t i = 0; i <  allCmdLine.size(); i++)
+  {
+    this->WritePython("    " + allCmdLine.at(i));
+  } 
+  this->WritePython("    cmd.Parse (argv)");
+}
 
-  allRoutes.push_back("ns3.Ipv4GlobalRoutingHelper.PopulateRoutingTables ()");
+//
+// Cpp generation operation part.
+//
 
-  return allRoutes;
+void Generator::WriteCpp(const std::string &line) 
+{
+  std::cout << line << std::endl;
+  if(this->m_structure)
+  {
+    this->m_structure->AddLine(line);
+  }
+  if(this->m_cppFile.IsOpen())
+  {
+    this->m_cppFile.Write(line + '\n');
+  }
 }
 
-std::vector<std::string> Generator::GenerateApplicationPython()
+void Generator::WriteProfilingPhaseCpp(Profiling &profiling, const std::string &phase)
 {
-  size_t nodeNumber = 0;
-  std::string ndcName = "";
-  size_t linkNumber = 0;
-  std::vector<std::string> allApps;
-  
-  /* get all the ip assign code. */
-  for(size_t i = 0; i <  this->m_listApplication.size(); i++)
+  if(!this->m_profiling)
   {
-    /* get NetDeviceContainer and number from the receiver. */
-    std::string receiverName = this->m_listApplication.at(i)->GetReceiverNode();
-    nodeNumber = 0;
-    ndcName = "";
-    linkNumber = 0;
-
-    /* if the receiver is in NodeContainer */
-    if(receiverName.find("NodeContainer(") == 0)
-    {
-      std::string oldReceiverName = receiverName;
-      
-      std::vector<std::string> tab_name;
-      split(tab_name, receiverName, '(');
-      
-      std::string str_get = tab_name.at(1);
-      std::vector<std::string> tab_name2;
-      split(tab_name2, str_get, '.');
-      
-      receiverName = tab_name2.at(0);
-      for(size_t x = 0;  x < this->m_listNetworkHardware.size(); x++)
-      {
-        nodeNumber = 0;
-        for(size_t y = 0; y < this->m_listNetworkHardware.at(x)->GetInstalledNodes().size(); y++)
-        {
-          if(this->m_listNetworkHardware.at(x)->GetInstalledNodes().at(y) == receiverName || this->m_listNetworkHardware.at(x)->GetInstalledNodes().at(y) == oldReceiverName)
-          {
-            ndcName = (this->m_listNetworkHardware.at(x))->GetNdcName();
-            linkNumber = x;
-            break;
-          }
-          if(ndcName != "")
-          {
-            break;
-          }
-        }
-      }
-      std::vector<std::string> linksNode = this->m_listNetworkHardware.at(linkNumber)->GetInstalledNodes();
-      for(size_t j = 0; j < linksNode.size(); j++)
-      {
-        if(linksNode.at(j) == oldReceiverName)
-        {
-          nodeNumber = j;
-          break;
-        }
-      }
-    }
-    else
-    {
-      for(size_t j = 0; j <  this->m_listNetworkHardware.size(); j++)
-      {
-        nodeNumber = 0;
-        linkNumber = 0;
-        std::vector<std::string> nodes = (this->m_listNetworkHardware.at(j))->GetInstalledNodes();
-        for(size_t k = 0; k <  nodes.size(); k++)
-        {
-          if( nodes.at(k) == receiverName)
-          {
-            ndcName = (this->m_listNetworkHardware.at(j))->GetNdcName();
-            break;
-          }
-          else
-          {
-            for(size_t l = 0; l <  this->m_listNode.size(); l++)
-            {
-              if(this->m_listNode.at(l)->GetNodeName() == nodes.at(k))
-              {
-                nodeNumber += this->m_listNode.at(l)->GetMachinesNumber();
-                break;
-              }
-            }
-          }
-        }
-        if(ndcName != "")
-        {
-          break;
-        }
-      }
-    }
-    /* get the application code with param. */
-    std::vector<std::string> trans = (this->m_listApplication.at(i)->GenerateApplicationPython(ndcName, nodeNumber));
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allApps.push_back(trans.at(j));
-    }
+    return;
+  }
+  std::vector<std::string> lines = profiling.GeneratePhaseCpp(phase);
+  for(size_t i = 0; i <  lines.size(); i++)
+  {
+    this->WriteCpp("  " + lines.at(i));
   }
-
-  return allApps;
 }
 
-std::vector<std::string> Generator::GenerateTracePython()
+void Generator::WriteCppFile(const std::string &fileName, const std::vector<std::string> &lines)
 {
-  std::vector<std::string> allTrace;
-
-  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  this->m_cppFile.Create(this->OutputFileName(fileName), this->m_compression);
+  for(size_t i = 0; i <  lines.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateTracePython();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allTrace.push_back(trans.at(j));
-    }
+    this->WriteCpp(lines.at(i));
   }
-
-  return allTrace;
+  this->m_cppFile.Close();
 }
 
-//
-// Cpp generation operation part.
-//
+void Generator::WriteShardCallsCpp(Sharding &sharding, Profiling &profiling, const std::string &phase, const std::string &comment,
+    const std::string &profilingPhase)
+{
+  std::vector<std::string> calls = sharding.GenerateCallsCpp(phase);
+  if(calls.size() == 0)
+  {
+    return;
+  }
+  this->WriteCpp("");
+  this->WriteCpp("  /* " + comment + " */");
+  for(size_t i = 0; i <  calls.size(); i++)
+  {
+    this->WriteCpp("  " + calls.at(i));
+  }
+  this->WriteProfilingPhaseCpp(profiling, profilingPhase);
+}
 
-void Generator::WriteCpp(const std::string &line) 
+void Generator::WriteStructureHashCpp(const std::vector<std::string> &headers, const std::vector<std::string> &files, const bool &makefile)
 {
-  std::cout << line << std::endl;
-  if(this->m_cppFile.is_open())
+  this->m_structureHash = this->m_structure->GetHash();
+  if(this->m_buildCache && files.size() > 0 && files.at(0) != "")
   {
-    this->m_cppFile << line + '\n';
+    this->m_structure->WriteScript(this->m_structure->GenerateScript(headers, files, this->m_compression, makefile));
   }
+  delete this->m_structure;
+  this->m_structure = NULL;
+
+  /* the hash line itself is not hashed. */
+  this->WriteCpp("");
+  this->WriteCpp("/* Structure hash: " + this->m_structureHash + " (build cache key). */");
 }
 
 //
@@ -1478,8 +2451,21 @@ void Generator::WriteCpp(const std::string &line)
 void Generator::WritePython(const std::string &line)
 {
   std::cout << line << std::endl;
-  if(this->m_pyFile.is_open())
+  if(this->m_pyFile.IsOpen())
+  {
+    this->m_pyFile.Write(line + '\n');
+  }
+}
+
+void Generator::WriteProfilingPhasePython(Profiling &profiling, const std::string &phase)
+{
+  if(!this->m_profiling)
+  {
+    return;
+  }
+  std::vector<std::string> lines = profiling.GeneratePhasePython(phase);
+  for(size_t i = 0; i <  lines.size(); i++)
   {
-    this->m_pyFile << line + '\n';
+    this->WritePython("    " + lines.at(i));
   }
 }
@@ -31,9 +31,20 @@
 #include "node.h"
 #include "network-hardware.h"
 #include "application.h"
+#include "profiling.h"
+#include "scenario-data.h"
+#include "sharding.h"
+#include "compressed-file.h"
+#include "fragment-cache.h"
+#include "build-cache.h"
+#include "backend.h"
+#include "program.h"
+#include "pass-manager.h"
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -224,6 +235,70 @@ class Generator
      */
     size_t GetNNetworkHardwares() const;
 
+    /**
+     * \brief Remove nodes and links with everything which refers to them.
+     *
+     *  The given nodes and links are removed with the memberships of the
+     *  nodes and the applications sent or received by a removed node. A link
+     *  which loses members and keeps at most one node is removed too, except
+     *  if it is in keep (the links shown to the user).
+     *
+     *  Each list is filtered in a single pass. Nothing is removed if a name
+     *  is unknown.
+     *
+     * \param names names of the nodes and links to remove
+     * \param keep links kept even with at most one node left
+     */
+    void RemoveObjects(const std::set<std::string> &names, const std::set<std::string> &keep);
+
+    /**
+     * \brief Reserve the node and link lists before a bulk insertion.
+     * \param nodes expected number of nodes
+     * \param links expected number of links
+     */
+    void Reserve(const size_t &nodes, const size_t &links);
+
+    /**
+     * \brief Move the objects of another generator into this one.
+     *
+     *  The nodes, links and applications of other are appended (other is left
+     *  empty), its name counters are added to the ones of this generator and
+     *  its scheduler and parameterized state replace the current ones. It is
+     *  used to build a model apart (in a loader thread) and insert it at once.
+     *
+     *  An object of other whose name is already used here is renamed with the
+     *  same prefix and the first free number; the references to it (link
+     *  members, applications) follow. A node and a link which share a name
+     *  (emu_0, tap_0) keep sharing the new one.
+     *
+     * \param other generator to merge
+     * \param renamed filled with the old name to new name of the renamed objects
+     */
+    void Merge(Generator &other, std::map<std::string, std::string> &renamed);
+
+    /**
+     * \brief Apply a renaming to an object name.
+     *
+     *  "NodeContainer(term_0.Get(2))" follows the renaming of "term_0".
+     *
+     * \param nodeName object or group member name
+     * \param renamed old name to new name
+     * \return renamed object or group member name
+     */
+    static std::string RenamedNode(const std::string &nodeName, const std::map<std::string, std::string> &renamed);
+
+    /**
+     * \brief Get the IPv4 addresses of the nodes, as assigned by the generated code.
+     *
+     *  The link i is the subnet 10.0.i.0/24 and its net devices get the host
+     *  numbers from 1 in their install order: the access point first for a
+     *  wifi link, then the members (access points excepted), each for its
+     *  number of machines. A group gives the range of its machines.
+     *
+     * \param addresses for each node, the link indexes and addresses (output)
+     */
+    void GetAddresses(std::map<std::string, std::vector<std::pair<size_t, std::string> > > &addresses);
+
     /**
      * \brief Generate ns-3 C++ code.
      * 
@@ -240,6 +315,217 @@ class Generator
      */
     void GenerateCodePython(std::string fileName = "");
 
+    /**
+     * \brief Generate ns-3 C++ and python code in a single traversal.
+     *
+     *  The objects are described once and the description is rendered in both
+     *  languages, the files are the same as GenerateCodeCpp and
+     *  GenerateCodePython ones.
+     *
+     * \param cppFileName C++ file name
+     * \param pythonFileName python file name
+     */
+    void GenerateCode(const std::string &cppFileName, const std::string &pythonFileName);
+
+    /**
+     * \brief Enable/disable the self-profiling harness in generated code.
+     *
+     * When enabled, each setup block of the generated main is timed,
+     * the simulation progress is printed periodically and a JSON
+     * performance summary is written at the end of the run.
+     *
+     * \param state profiling state
+     */
+    void SetProfiling(const bool &state);
+
+    /**
+     * \brief Get the self-profiling state.
+     * \return profiling state
+     */
+    bool GetProfiling() const;
+
+    /**
+     * \brief Set the event scheduler used by the generated simulation.
+     *
+     * Known schedulers are "Map", "Heap", "List", "Calendar" and "PriorityQueue".
+     * An empty name keeps the ns-3 default scheduler.
+     *
+     * \param scheduler scheduler name
+     */
+    void SetScheduler(const std::string &scheduler);
+
+    /**
+     * \brief Get the event scheduler used by the generated simulation.
+     * \return scheduler name (empty for the ns-3 default)
+     */
+    std::string GetScheduler() const;
+
+    /**
+     * \brief Get the list of the known event schedulers.
+     * \return scheduler names
+     */
+    static std::vector<std::string> GetSchedulers();
+
+    /**
+     * \brief Enable/disable the command line parameters of the generated code.
+     *
+     * When enabled, the data rates, delays, application times and attributes
+     * and the terminal group sizes are generated as CommandLine parameters
+     * with the current values as defaults, so one compiled scenario can be
+     * run for a whole parameter sweep.
+     *
+     * \param state parameterized state
+     */
+    void SetParameterized(const bool &state);
+
+    /**
+     * \brief Get the command line parameters state.
+     * \return parameterized state
+     */
+    bool GetParameterized() const;
+
+    /**
+     * \brief Set the compression of the generated code files.
+     *
+     *  The C++, python and Makefile outputs are written compressed by blocks
+     *  (see CompressedFile) and get the codec extension: "scenario.cc" is
+     *  written as "scenario.cc.gz" with "gzip". The data file of the
+     *  data-driven backend stays plain, the driver reads it as is.
+     *
+     * \param codec codec name (empty for plain files)
+     */
+    void SetCompression(const std::string &codec);
+
+    /**
+     * \brief Get the compression of the generated code files.
+     * \return codec name (empty for plain files)
+     */
+    std::string GetCompression() const;
+
+    /**
+     * \brief Get the name of a generated file, with the extension of the compression codec.
+     * \param fileName file name given to the generation
+     * \return written file name
+     */
+    std::string OutputFileName(const std::string &fileName) const;
+
+    /**
+     * \brief Set the fragment cache of the C++ and python generation.
+     *
+     *  The code of the nodes, links and applications is looked up in an
+     *  on-disk cache (see FragmentCache) shared by the generator runs, only
+     *  the objects of the missing entries are generated. The objects are
+     *  cached by runs, cut where the hash of an object signature says so: an
+     *  added, removed or changed object only misses the run it belongs to.
+     *
+     * \param directory cache directory (empty to disable the cache)
+     */
+    void SetFragmentCache(const std::string &directory);
+
+    /**
+     * \brief Get the fragment cache.
+     * \return fragment cache (NULL if disabled)
+     */
+    FragmentCache* GetFragmentCache();
+
+    /**
+     * \brief Enable/disable the build cache helper of the generated C++ code.
+     *
+     *  Every generated C++ file ends with its structure hash, the hash of the
+     *  code without the default values of the command line parameters (see
+     *  BuildCache). When enabled, the C++, data-driven and sharded generations
+     *  also write "<file>-build.sh", which reuses the program compiled for the
+     *  same hash and runs it with the parameter values of the scenario.
+     *
+     * \param state build cache helper state
+     */
+    void SetBuildCache(const bool &state);
+
+    /**
+     * \brief Get the build cache helper state.
+     * \return build cache helper state
+     */
+    bool GetBuildCache() const;
+
+    /**
+     * \brief Get the structure hash of the last generated C++ code.
+     * \return structure hash (empty if no C++ code is generated)
+     */
+    std::string GetStructureHash() const;
+
+    /**
+     * \brief Add a pass run on the program before it is rendered.
+     *
+     *  The passes are run in the order they are added, on the C++, python and
+     *  sharded code (see Pass::GetPasses). The fragment cache is not used when
+     *  there is a pass and the data-driven backend is not transformed.
+     *
+     * \param name pass name
+     */
+    void AddPass(const std::string &name);
+
+    /**
+     * \brief Remove all the passes.
+     */
+    void ClearPasses();
+
+    /**
+     * \brief Get the passes run on the program.
+     * \return pass names, in the run order
+     */
+    std::vector<std::string> GetPasses() const;
+
+    /**
+     * \brief Get the changes made by the passes of the last generation.
+     * \return changes, one line each
+     */
+    std::vector<std::string> GetPassReport() const;
+
+    /**
+     * \brief Generate the data-driven C++ backend.
+     *
+     *  The topology is written into a binary data file (see ScenarioData) next
+     *  to the generated file and the generated file is a fixed driver which
+     *  builds the topology at runtime. The driver compile time does not depend
+     *  on the topology size. The parameterized and profiling states are not
+     *  applied to this backend.
+     *
+     * \param fileName generated driver file name
+     */
+    void GenerateCodeData(const std::string &fileName);
+
+    /**
+     * \brief Generate the C++ code split into several translation units.
+     *
+     *  The unrolled setup code is dispatched into shards builder functions
+     *  (see Sharding). The generated files are the main file, a shared header,
+     *  the shard files and a Makefile, all in the directory of fileName.
+     *
+     * \param fileName main file name
+     * \param shards number of shard files
+     * \return generated file names
+     */
+    std::vector<std::string> GenerateCodeSharded(const std::string &fileName, const size_t &shards);
+
+    /**
+     * \brief Generate one profiled C++ file per known scheduler.
+     *
+     * "dir/scenario.cc" gives "dir/scenario-map.cc", "dir/scenario-heap.cc", ...
+     * Each file writes its own "<file>-profiling.json" summary, so the run
+     * times of the schedulers can be compared for this topology.
+     *
+     * \param fileName base file name
+     * \return generated file names
+     */
+    std::vector<std::string> GenerateSchedulerBenchmarkCpp(const std::string &fileName);
+
+    /**
+     * \brief Generate one profiled python file per known scheduler.
+     * \param fileName base file name
+     * \return generated file names
+     */
+    std::vector<std::string> GenerateSchedulerBenchmarkPython(const std::string &fileName);
+
   private:
     /**
      * \brief Simulation name.
@@ -251,6 +537,228 @@ class Generator
      */
     std::vector<std::string> m_listConfiguration;
 
+    /**
+     * \brief If the self-profiling harness is generated.
+     */
+    bool m_profiling;
+
+    /**
+     * \brief Event scheduler name (empty for the ns-3 default).
+     */
+    std::string m_scheduler;
+
+    /**
+     * \brief If the attributes are generated as command line parameters.
+     */
+    bool m_parameterized;
+
+    /**
+     * \brief Codec of the generated code files (empty for plain files).
+     */
+    std::string m_compression;
+
+    /**
+     * \brief Fragment cache (NULL if disabled).
+     */
+    FragmentCache *m_fragmentCache;
+
+    /**
+     * \brief If the build cache helper is generated.
+     */
+    bool m_buildCache;
+
+    /**
+     * \brief Structure hash of the last generated C++ code.
+     */
+    std::string m_structureHash;
+
+    /**
+     * \brief Structure hash of the C++ code being generated (NULL if none).
+     */
+    BuildCache *m_structure;
+
+    /**
+     * \brief Passes run on the program before it is rendered.
+     */
+    PassManager m_passes;
+
+    /**
+     * \brief Backends of the current generation, one per generated language.
+     */
+    std::vector<Backend*> m_backends;
+
+    /**
+     * \brief Per-object phase code of the current generation, by backend and phase name.
+     */
+    std::vector<std::map<std::string, std::vector<std::string> > > m_fragments;
+
+    /**
+     * \brief Object lists of the fragment cache.
+     */
+    enum FragmentKind
+    {
+      FRAGMENT_NODE = 0,
+      FRAGMENT_LINK = 1,
+      FRAGMENT_APPLICATION = 2
+    };
+
+    /**
+     * \brief Fill the phase code of all the backends.
+     *
+     *  The objects are described once and rendered by each backend. With
+     *  passes, the whole program is described, transformed then rendered.
+     *  Otherwise, with the fragment cache, the runs of objects are loaded from
+     *  the cache and only the missing ones are described and stored.
+     */
+    void LoadFragments();
+
+    /**
+     * \brief Build the program of the scenario.
+     * \param objects if the phase code of the objects is described (it comes from the fragment cache otherwise)
+     * \return program
+     */
+    Program BuildProgram(const bool &objects);
+
+    /**
+     * \brief Get the program sections of an object list.
+     * \param kind object list
+     * \return sections, in the order of DescribeFragments
+     */
+    static std::vector<Program::Section> FragmentSections(const FragmentKind &kind);
+
+    /**
+     * \brief Get the name of an object.
+     * \param kind object list
+     * \param index object index
+     * \return node, link or application name
+     */
+    std::string FragmentOwner(const FragmentKind &kind, const size_t &index);
+
+    /**
+     * \brief Fill the phase code of a run of objects, from the cache or generated.
+     * \param kind object list
+     * \param first first object of the run
+     * \param last object after the run
+     * \param keys keys of the objects of the run (empty without cache)
+     * \param phases phase names of the object list
+     */
+    void LoadFragments(const FragmentKind &kind, const size_t &first, const size_t &last, const std::string &keys,
+        const std::vector<std::string> &phases);
+
+    /**
+     * \brief Get the generation inputs of an object.
+     * \param kind object list
+     * \param index object index
+     * \return signature
+     */
+    std::string FragmentSignature(const FragmentKind &kind, const size_t &index);
+
+    /**
+     * \brief Describe the phase code of an object.
+     * \param kind object list
+     * \param index object index
+     * \return statements of each phase of the object list
+     */
+    std::vector<std::vector<Statement> > DescribeFragments(const FragmentKind &kind, const size_t &index);
+
+    /**
+     * \brief Render statements with each backend.
+     * \param statements statements
+     * \return code of each backend
+     */
+    std::vector<std::vector<std::string> > Render(const std::vector<Statement> &statements);
+
+    /**
+     * \brief Get the code of a phase for each backend.
+     * \param phase phase name
+     * \param declarations statements written before the object code
+     * \return code of each backend
+     */
+    std::vector<std::vector<std::string> > GeneratePhase(const std::string &phase, const std::vector<Statement> &declarations);
+
+    /**
+     * \brief Apply a parameterized state on all nodes, links and applications.
+     * \param state parameterized state
+     */
+    void UpdateParameterized(const bool &state);
+
+    /**
+     * \brief Get the parameterized state of the nodes, links and applications.
+     * \return states, nodes first then links and applications
+     */
+    std::vector<bool> GetParameterizedStates();
+
+    /**
+     * \brief Restore the states given by GetParameterizedStates.
+     * \param states states, nodes first then links and applications
+     */
+    void SetParameterizedStates(const std::vector<bool> &states);
+
+    /**
+     * \brief Write the scenario data file and its driver (see GenerateCodeData).
+     * \param fileName driver file name
+     */
+    void WriteCodeData(const std::string &fileName);
+
+    /**
+     * \brief Find the link which gives the receiver address of an application.
+     * \param application application
+     * \param nodeNumber number of the fixed size nodes before the receiver (output)
+     * \param nodeGroups size variables of the parameterized groups before the receiver (output)
+     * \return link index, or the number of links if the receiver is not connected
+     */
+    size_t FindReceiver(Application *application, size_t &nodeNumber, std::vector<std::string> &nodeGroups);
+
+    /**
+     * \brief Find a node container from a node or a group member name.
+     *
+     * "term_0" gives the term_0 index and NONE, "NodeContainer(term_0.Get(3))"
+     * gives the term_0 index and 3.
+     *
+     * \param nodeName node or group member name
+     * \param nodeIndex node index (output, NONE if not found)
+     * \param subIndex machine index into the container (output, NONE for the whole container)
+     */
+    void FindDataNode(const std::string &nodeName, uint32_t &nodeIndex, uint32_t &subIndex);
+
+    /**
+     * \brief Build the expression of a node index into a net device container.
+     * \param nodeNumber number of the fixed size nodes before the node
+     * \param nodeGroups size variables of the parameterized groups before the node
+     * \return index expression
+     */
+    static std::string IndexValue(const size_t &nodeNumber, const std::vector<std::string> &nodeGroups);
+
+    /**
+     * \brief Get the node container of an application node.
+     *
+     *  "NodeContainer(nodesGroup_0.Get(2))" gives "nodesGroup_0".
+     *
+     * \param nodeName node or group member name
+     * \return node container name
+     */
+    static std::string ContainerName(const std::string &nodeName);
+
+    /**
+     * \brief Find a free name for a renamed object.
+     *
+     *  "term_0" gives "term_N", N the first number which makes a name not in
+     *  used. The new name is added to used.
+     *
+     * \param name colliding name
+     * \param used names already taken
+     * \return new name
+     */
+    static std::string FreeName(const std::string &name, std::set<std::string> &used);
+
+    /**
+     * \brief Build the file name of a scheduler benchmark variant.
+     * \param fileName base file name
+     * \param scheduler scheduler name
+     * \return variant file name
+     */
+    static std::string SchedulerFileName(const std::string &fileName, const std::string &scheduler);
+
     /**
      * \brief Number attribute of term node created.
      */
@@ -366,172 +874,175 @@ class Generator
     std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate vars C++ code.
-     * 
-     * This function return a string wich contain all C++ vars.
-     * \return vars code
-     */
-    std::vector<std::string> GenerateVarsCpp();
-
-    /**
-     * \brief Generate command line C++ code.
-     * \return commend line code
-     */
-    std::vector<std::string> GenerateCmdLineCpp();
-
-    /**
-     * \brief Generate config C++ code.
-     * \return config code
-     */
-    std::vector<std::string> GenerateConfigCpp();
-
-    /**
-     * \brief Generate node declaration C++ code.
-     * \return declaration code
-     */
-    std::vector<std::string> GenerateNodeCpp();
-
-    /**
-     * \brief Generate link C++ code.
-     * \return link code
-     */
-    std::vector<std::string> GenerateNetworkHardwareCpp();
-
-    /**
-     * \brief Generate net device C++ code.
-     * \return net device code
+     * \brief Describe the configuration (user one and real time simulator).
+     * \return config statements
      */
-    std::vector<std::string> GenerateNetDeviceCpp();
+    std::vector<Statement> DescribeConfig();
 
     /**
-     * \brief Generate ip stack declaration.
-     * \return IP stack code
+     * \brief Describe the scheduler selection.
+     * \return scheduler statements
      */
-    std::vector<std::string> GenerateIpStackCpp();
+    std::vector<Statement> DescribeScheduler();
 
     /**
-     * \brief Generate ip assign C++ code.
-     * \return IP assign code
+     * \brief Describe the ip assign of a link.
+     * \param index link index
+     * \return IP assign statements
      */
-    std::vector<std::string> GenerateIpAssignCpp();
+    std::vector<Statement> DescribeIpAssign(const size_t &index);
 
     /**
-     * \brief Generate tap bridge C++ code.
-     * \return tab bridge code
+     * \brief Describe the routes.
+     * \return route statements
      */
-    std::vector<std::string> GenerateTapBridgeCpp();
+    std::vector<Statement> DescribeRoute();
 
     /**
-     * \brief Generate route C++ code.
-     * \return route code
+     * \brief Describe an application with its receiver address.
+     * \param index application index
+     * \return application statements
      */
-    std::vector<std::string> GenerateRouteCpp();
+    std::vector<Statement> DescribeApplication(const size_t &index);
 
     /**
-     * \brief Generate application C++ code.
-     * \return application code
+     * \brief Describe the stop of the simulation after the last application.
+     * \return stop statements
      */
-    std::vector<std::string> GenerateApplicationCpp();
+    std::vector<Statement> DescribeStop();
 
     /**
-     * \brief Generate trace C++ code.
-     * \return trace code
+     * \brief Describe the run of the simulation.
+     * \return run statements
      */
-    std::vector<std::string> GenerateTraceCpp();
+    std::vector<Statement> DescribeRun();
 
     //
-    // Python code generation operation part
+    // Code writing part, for the backends of the current generation.
     //
 
     /**
-     * \brief Generate vars python code.
-     * 
-     * This function return a string wich contain all python vars.
-     * 
-     * \return vars code
+     * \brief Generate ns-3 code with several backends.
+     * \param backends backends, one per language
+     * \param fileNames output file name of each backend
      */
-    std::vector<std::string> GenerateVarsPython();
+    void GenerateCode(const std::vector<Backend*> &backends, const std::vector<std::string> &fileNames);
 
     /**
-     * \brief Generate command line python code.
-     * \return commend line code
+     * \brief Write a line into the file of a backend.
+     * \param backend backend index
+     * \param line line
      */
-    std::vector<std::string> GenerateCmdLinePython();
+    void Write(const size_t &backend, const std::string &line);
 
     /**
-     * \brief Generate config python code.
-     * \return config code
+     * \brief Write lines of the main function into the file of a backend.
+     * \param backend backend index
+     * \param lines lines, indented by the backend
      */
-    std::vector<std::string> GenerateConfigPython();
+    void WriteLines(const size_t &backend, const std::vector<std::string> &lines);
 
     /**
-     * \brief Generate node declaration python code.
-     * \return declaration code
+     * \brief Write a comment of the main function into the file of a backend.
+     * \param backend backend index
+     * \param text comment text
      */
-    std::vector<std::string> GenerateNodePython();
+    void WriteComment(const size_t &backend, const std::string &text);
 
     /**
-     * \brief Generate link python code.
-     * \return link code
+     * \brief Write the code which closes a profiled setup phase.
+     * \param backend backend index
+     * \param profiling the profiling harness of the backend
+     * \param phase phase name
      */
-    std::vector<std::string> GenerateNetworkHardwarePython();
+    void WriteProfilingPhase(const size_t &backend, Profiling &profiling, const std::string &phase);
 
     /**
-     * \brief Generate net device python code.
-     * \return net device code
+     * \brief Write a setup phase into the files of all the backends.
+     * \param profilings the profiling harness of each backend
+     * \param comment phase comment
+     * \param code code of each backend
+     * \param phase profiled phase name
      */
-    std::vector<std::string> GenerateNetDevicePython();
+    void WritePhase(const std::vector<Profiling*> &profilings, const std::string &comment, const std::vector<std::vector<std::string> > &code,
+        const std::string &phase);
 
     /**
-     * \brief Generate ip stack declaration.
-     * \return IP stack code
+     * \brief Write the C++ code up to the command line parsing.
+     * \param profiling the profiling harness
+     * \param headers ns-3 headers code
+     * \param vars vars code
+     * \param cmdLine command line code
+     * \param fileName C++ file name
      */
-    std::vector<std::string> GenerateIpStackPython();
+    void WriteMainCpp(Profiling &profiling, const std::vector<std::string> &headers, const std::vector<std::string> &vars,
+        const std::vector<std::string> &cmdLine, const std::string &fileName);
 
     /**
-     * \brief Generate ip assign python code.
-     * \return IP assign code
+     * \brief Write the python code up to the command line parsing.
+     * \param profiling the profiling harness
+     * \param vars vars code
+     * \param cmdLine command line code
      */
-    std::vector<std::string> GenerateIpAssignPython();
+    void WriteMainPython(Profiling &profiling, const std::vector<std::string> &vars, const std::vector<std::string> &cmdLine);
+
+    //
+    // C++ generation operation part.
+    //
 
     /**
-     * \brief Generate tap bridge python code.
-     * \return tab bridge code
-     */
-    std::vector<std::string> GenerateTapBridgePython();
+     * \brief Name of the C++ output file name.
+     */  
+    CompressedFile m_cppFile;
 
     /**
-     * \brief Generate route python code.
-     * \return route code
+     * \brief Write C++ code into the attribute file name.
+     * \param line the new line to add to the attribute file name
      */
-    std::vector<std::string> GenerateRoutePython();
+    void WriteCpp(const std::string &line);
 
     /**
-     * \brief Generate application python code.
-     * \return application code
+     * \brief Write the C++ code which closes a profiled setup phase.
+     *
+     * Nothing is written if the profiling is disabled.
+     *
+     * \param profiling the profiling harness
+     * \param phase phase name
      */
-    std::vector<std::string> GenerateApplicationPython();
+    void WriteProfilingPhaseCpp(Profiling &profiling, const std::string &phase);
 
     /**
-     * \brief Generate trace python code.
-     * \return trace code
+     * \brief Write C++ code (or a Makefile) into a file.
+     * \param fileName file name
+     * \param lines code to write
      */
-    std::vector<std::string> GenerateTracePython();
-
-    //
-    // C++ generation operation part.
-    //
+    void WriteCppFile(const std::string &fileName, const std::vector<std::string> &lines);
 
     /**
-     * \brief Name of the C++ output file name.
-     */  
-    std::ofstream m_cppFile;
+     * \brief Write the calls of the builder functions of a sharded phase.
+     *
+     * Nothing is written if the phase has no code.
+     *
+     * \param sharding the sharded code
+     * \param profiling the profiling harness
+     * \param phase sharded phase name
+     * \param comment phase comment
+     * \param profilingPhase profiled phase name
+     */
+    void WriteShardCallsCpp(Sharding &sharding, Profiling &profiling, const std::string &phase, const std::string &comment,
+        const std::string &profilingPhase);
 
     /**
-     * \brief Write C++ code into the attribute file name.
-     * \param line the new line to add to the attribute file name
+     * \brief Close the structure hash of the generated C++ code.
+     *
+     *  The hash is written at the end of the main file and the build cache
+     *  helper is written if enabled.
+     *
+     * \param headers ns-3 headers code
+     * \param files generated file names
+     * \param makefile true if the files have their own Makefile
      */
-    void WriteCpp(const std::string &line);
+    void WriteStructureHashCpp(const std::vector<std::string> &headers, const std::vector<std::string> &files, const bool &makefile);
 
     //
     // Python generation operation part.
@@ -540,13 +1051,23 @@ class Generator
     /**
      * \brief Name of the python output file name.
      */
-    std::ofstream m_pyFile;
+    CompressedFile m_pyFile;
 
     /**
      * \brief Write python code into the output file name.
      * \param line the line to be writted 
      */
     void WritePython(const std::string &line);
+
+    /**
+     * \brief Write the python code which closes a profiled setup phase.
+     *
+     * Nothing is written if the profiling is disabled.
+     *
+     * \param profiling the profiling harness
+     * \param phase phase name
+     */
+    void WriteProfilingPhasePython(Profiling &profiling, const std::string &phase);
 };
 
 #endif /* GENERATOR_H */
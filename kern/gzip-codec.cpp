@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file gzip-codec.cpp
+ * \brief Gzip (zlib deflate) codec.
+ */
+
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include "gzip-codec.h"
+
+GzipCodec::GzipCodec(const int &level)
+{
+  this->m_level = level;
+}
+
+GzipCodec::~GzipCodec()
+{
+}
+
+std::string GzipCodec::GetName() const
+{
+  return "gzip";
+}
+
+std::string GzipCodec::GetExtension() const
+{
+  return ".gz";
+}
+
+size_t GzipCodec::GetHeaderSize() const
+{
+  return GzipCodec::HEADER_SIZE;
+}
+
+size_t GzipCodec::GetFrameSize(const std::string &header) const
+{
+  /* magic, deflate, FEXTRA, XLEN 8, subfield "NG" of 4 bytes. */
+  static const unsigned char expected[] = {0x1f, 0x8b, 8, 4};
+  if(header.size() < GzipCodec::HEADER_SIZE)
+  {
+    return 0;
+  }
+  for(size_t i = 0; i < sizeof(expected); i++)
+  {
+    if(static_cast<unsigned char>(header[i]) != expected[i])
+    {
+      return 0;
+    }
+  }
+  if(header[10] != 8 || header[11] != 0 || header[12] != 'N' || header[13] != 'G' || header[14] != 4 || header[15] != 0)
+  {
+    return 0;
+  }
+  size_t size = GzipCodec::ReadU32(header, 16);
+  return size >= GzipCodec::HEADER_SIZE + 8 ? size : 0;
+}
+
+size_t GzipCodec::GetMaxFrameSize(const size_t &blockSize) const
+{
+  /* the zlib bound covers the raw deflate stream written by Compress. */
+  return GzipCodec::HEADER_SIZE + compressBound(blockSize) + 8;
+}
+
+std::string GzipCodec::Compress(const std::string &block) const
+{
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  /* raw deflate, the gzip header and trailer are written here. */
+  if(deflateInit2(&stream, this->m_level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    throw std::runtime_error("Compress failed! (deflate init).");
+  }
+
+  std::string frame(GzipCodec::HEADER_SIZE + deflateBound(&stream, block.size()) + 8, '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(block.data()));
+  stream.avail_in = block.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&frame[GzipCodec::HEADER_SIZE]);
+  stream.avail_out = frame.size() - GzipCodec::HEADER_SIZE - 8;
+  int ret = deflate(&stream, Z_FINISH);
+  size_t compressed = stream.total_out;
+  deflateEnd(&stream);
+  if(ret != Z_STREAM_END)
+  {
+    throw std::runtime_error("Compress failed! (deflate).");
+  }
+  frame.resize(GzipCodec::HEADER_SIZE + compressed);
+
+  static const unsigned char header[] = {0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 8, 0, 'N', 'G', 4, 0};
+  frame.replace(0, sizeof(header), reinterpret_cast<const char*>(header), sizeof(header));
+  std::string size;
+  GzipCodec::WriteU32(size, frame.size() + 8);
+  frame.replace(16, 4, size);
+
+  GzipCodec::WriteU32(frame, crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(block.data()), block.size()));
+  GzipCodec::WriteU32(frame, block.size());
+  return frame;
+}
+
+std::string GzipCodec::Decompress(const std::string &frame, const size_t &maxBlockSize) const
+{
+  size_t frameSize = this->GetFrameSize(frame);
+  if(frameSize == 0 || frameSize != frame.size())
+  {
+    throw std::logic_error("Decompress failed! (bad gzip member).");
+  }
+  /* the size trailer comes from the file, it is checked before the allocation. */
+  size_t blockSize = GzipCodec::ReadU32(frame, frame.size() - 4);
+  if(blockSize > maxBlockSize)
+  {
+    throw std::logic_error("Decompress failed! (gzip member too large).");
+  }
+
+  std::string block(blockSize, '\0');
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(frame.data() + GzipCodec::HEADER_SIZE));
+  stream.avail_in = frame.size() - GzipCodec::HEADER_SIZE - 8;
+  if(inflateInit2(&stream, -15) != Z_OK)
+  {
+    throw std::runtime_error("Decompress failed! (inflate init).");
+  }
+  /* a zero size output buffer is not accepted, give one byte more. */
+  block.push_back('\0');
+  stream.next_out = reinterpret_cast<Bytef*>(&block[0]);
+  stream.avail_out = block.size();
+  int ret = inflate(&stream, Z_FINISH);
+  size_t decompressed = stream.total_out;
+  inflateEnd(&stream);
+  block.resize(block.size() - 1);
+  if(ret != Z_STREAM_END || decompressed != block.size())
+  {
+    throw std::logic_error("Decompress failed! (corrupted gzip member).");
+  }
+  if(crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(block.data()), block.size()) != GzipCodec::ReadU32(frame, frame.size() - 8))
+  {
+    throw std::logic_error("Decompress failed! (bad gzip checksum).");
+  }
+  return block;
+}
+
+size_t GzipCodec::ReadU32(const std::string &data, const size_t &offset)
+{
+  size_t value = 0;
+  for(size_t i = 0; i < 4; i++)
+  {
+    value |= static_cast<size_t>(static_cast<unsigned char>(data[offset + i])) << (8 * i);
+  }
+  return value;
+}
+
+void GzipCodec::WriteU32(std::string &data, const size_t &value)
+{
+  for(size_t i = 0; i < 4; i++)
+  {
+    data.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
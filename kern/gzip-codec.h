@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file gzip-codec.h
+ * \brief Gzip (zlib deflate) codec.
+ */
+
+#ifndef GZIP_CODEC_H
+#define GZIP_CODEC_H
+
+#include "codec.h"
+
+/**
+ * \ingroup generator
+ * \brief Gzip (zlib deflate) codec.
+ *
+ *  Each frame is a complete gzip member, so a compressed file is a valid gzip
+ *  file and gunzip or zcat read it. As in BGZF, the member header carries an
+ *  extra field ("NG", 4 bytes) with the member size, which gives the frame
+ *  boundaries without inflating.
+ */
+class GzipCodec : public Codec
+{
+  public:
+    /**
+     * \brief Size of a member header (with the extra field).
+     */
+    static const size_t HEADER_SIZE = 20;
+
+    /**
+     * \brief Constructor.
+     * \param level zlib compression level (1 fastest, 9 smallest)
+     */
+    GzipCodec(const int &level = 6);
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~GzipCodec();
+
+    /**
+     * \brief Get the codec name.
+     * \return "gzip"
+     */
+    virtual std::string GetName() const;
+
+    /**
+     * \brief Get the file name extension of the codec.
+     * \return ".gz"
+     */
+    virtual std::string GetExtension() const;
+
+    /**
+     * \brief Get the size of a member header.
+     * \return header size (in bytes)
+     */
+    virtual size_t GetHeaderSize() const;
+
+    /**
+     * \brief Get the size of a member from its header.
+     * \param header member header
+     * \return member size (in bytes), 0 if it is not a member written by this codec
+     */
+    virtual size_t GetFrameSize(const std::string &header) const;
+
+    /**
+     * \brief Get the largest member the codec writes for a block.
+     * \param blockSize block size (in bytes)
+     * \return member size bound (in bytes)
+     */
+    virtual size_t GetMaxFrameSize(const size_t &blockSize) const;
+
+    /**
+     * \brief Compress a block into a gzip member.
+     * \param block block to compress
+     * \return gzip member
+     */
+    virtual std::string Compress(const std::string &block) const;
+
+    /**
+     * \brief Decompress a gzip member.
+     * \param frame gzip member
+     * \param maxBlockSize largest block size accepted
+     * \return block
+     */
+    virtual std::string Decompress(const std::string &frame, const size_t &maxBlockSize) const;
+
+  private:
+    /**
+     * \brief Compression level.
+     */
+    int m_level;
+
+    /**
+     * \brief Read a little endian 32 bits integer.
+     * \param data data
+     * \param offset offset of the integer
+     * \return integer
+     */
+    static size_t ReadU32(const std::string &data, const size_t &offset);
+
+    /**
+     * \brief Append a little endian 32 bits integer.
+     * \param data data
+     * \param value integer
+     */
+    static void WriteU32(std::string &data, const size_t &value);
+};
+
+#endif /* GZIP_CODEC_H */
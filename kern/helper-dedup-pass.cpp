@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file helper-dedup-pass.cpp
+ * \brief Merge of the link helpers which have the same configuration.
+ */
+
+#include <map>
+
+#include "helper-dedup-pass.h"
+#include "utils.h"
+
+HelperDedupPass::~HelperDedupPass()
+{
+}
+
+std::string HelperDedupPass::GetName() const
+{
+  return "helper-dedup";
+}
+
+void HelperDedupPass::Run(Program &program, std::vector<std::string> &report)
+{
+  std::map<std::string, std::string> helpers;
+  std::vector<std::pair<std::string, std::string> > merged;
+  std::vector<Program::Block> &blocks = program.GetBlocks(Program::LINKS);
+  size_t kept = 0;
+  for(size_t i = 0; i < blocks.size(); i++)
+  {
+    std::string name = "";
+    std::string key = HelperDedupPass::Configuration(blocks.at(i).statements, name);
+    std::map<std::string, std::string>::const_iterator helper = helpers.find(key);
+    if(key != "" && helper != helpers.end())
+    {
+      merged.push_back(std::make_pair(name, helper->second));
+      continue;
+    }
+    if(key != "")
+    {
+      helpers[key] = name;
+    }
+    if(kept != i)
+    {
+      blocks.at(kept) = blocks.at(i);
+    }
+    kept++;
+  }
+  blocks.resize(kept);
+
+  for(size_t i = 0; i < merged.size(); i++)
+  {
+    program.Rename(merged.at(i).first, merged.at(i).second);
+    report.push_back(merged.at(i).first + " merged into " + merged.at(i).second);
+  }
+}
+
+std::string HelperDedupPass::Configuration(const std::vector<Statement> &statements, std::string &name)
+{
+  if(statements.size() == 0 || (statements.at(0).GetKind() != Statement::DECLARE && statements.at(0).GetKind() != Statement::CONSTRUCT))
+  {
+    return "";
+  }
+
+  /* "Type name (args);" then "name.Method (args);" only. */
+  name = statements.at(0).GetName();
+  std::string key = statements.at(0).GetType() + "\n";
+  if(!HelperDedupPass::ValueKey(statements.at(0).GetExpression(), key))
+  {
+    return "";
+  }
+  for(size_t i = 1; i < statements.size(); i++)
+  {
+    const Expression &call = statements.at(i).GetExpression();
+    if(statements.at(i).GetKind() != Statement::EVALUATE || call.GetKind() != Expression::METHOD || call.GetName() != name)
+    {
+      return "";
+    }
+    key += "\n" + call.GetMethod();
+    for(size_t j = 0; j < call.GetArgs().size(); j++)
+    {
+      if(!HelperDedupPass::ValueKey(call.GetArgs().at(j), key))
+      {
+        return "";
+      }
+    }
+  }
+  return key;
+}
+
+bool HelperDedupPass::ValueKey(const Expression &expression, std::string &key)
+{
+  if(expression.GetKind() == Expression::METHOD || expression.GetKind() == Expression::STATIC)
+  {
+    return false;
+  }
+  /* the kind and the name length keep the keys of different values apart. */
+  key += "(" + utils::integerToString(expression.GetKind()) + " " + utils::integerToString(expression.GetName().size()) + " " + expression.GetName();
+  for(size_t i = 0; i < expression.GetArgs().size(); i++)
+  {
+    if(!HelperDedupPass::ValueKey(expression.GetArgs().at(i), key))
+    {
+      return false;
+    }
+  }
+  key += ")";
+  return true;
+}
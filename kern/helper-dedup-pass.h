@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file helper-dedup-pass.h
+ * \brief Merge of the link helpers which have the same configuration.
+ */
+
+#ifndef HELPER_DEDUP_PASS_H
+#define HELPER_DEDUP_PASS_H
+
+#include <string>
+#include <vector>
+
+#include "pass.h"
+
+/**
+ * \ingroup generator
+ * \brief Merge of the link helpers which have the same configuration.
+ *
+ *  The links of a scenario often share their data rate and delay, each one
+ *  still declares and configures its own helper. A link helper which is
+ *  configured like a previous one is removed and the previous helper is used
+ *  in its place. Installing twice with a helper gives two channels, the
+ *  simulation is the same.
+ *
+ *  Only the helpers which are declared then configured by calls with plain
+ *  values (no method call in the arguments) are merged: a wifi channel
+ *  created for a link is never shared.
+ */
+class HelperDedupPass : public Pass
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~HelperDedupPass();
+
+    /**
+     * \brief Get the pass name.
+     * \return "helper-dedup"
+     */
+    virtual std::string GetName() const;
+
+    /**
+     * \brief Merge the link helpers of a program.
+     * \param program program to transform
+     * \param report merged helpers (output)
+     */
+    virtual void Run(Program &program, std::vector<std::string> &report);
+
+  private:
+    /**
+     * \brief Get the configuration of a helper block.
+     * \param statements block statements
+     * \param name helper name (output)
+     * \return configuration key, empty if the block can not be merged
+     */
+    static std::string Configuration(const std::vector<Statement> &statements, std::string &name);
+
+    /**
+     * \brief Get the key of a plain value.
+     * \param expression value
+     * \param key key to complete (output)
+     * \return false if the value calls a method
+     */
+    static bool ValueKey(const Expression &expression, std::string &key);
+};
+
+#endif /* HELPER_DEDUP_PASS_H */
@@ -47,86 +47,34 @@ std::vector<std::string> Hub::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Hub::GenerateNetworkHardwareCpp()
+std::vector<Statement> Hub::DescribeNetworkHardware()
 {
-  std::vector<std::string> generatedLink;
-  generatedLink.push_back("CsmaHelper csma_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\",  TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
+  std::vector<Statement> generatedLink;
+  generatedLink.push_back(Statement::Declare("CsmaHelper", "csma_" + this->GetNetworkHardwareName()));
+  std::vector<Statement> attributes = this->DescribeDataRateDelay("csma_" + this->GetNetworkHardwareName(), "SetChannelAttribute");
+  generatedLink.insert(generatedLink.end(), attributes.begin(), attributes.end());
 
   return generatedLink;
 }
 
-std::vector<std::string> Hub::GenerateNetDeviceCpp()
+std::vector<Statement> Hub::DescribeNetDevice()
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
+  std::vector<Statement> ndc = this->GroupAsNodeContainer();
+  ndc.push_back(Statement::Define("NetDeviceContainer", this->GetNdcName(),
+        Expression::Method("csma_" + this->GetNetworkHardwareName(), "Install").Arg(Expression::Name(this->GetAllNodeContainer()))));
 
   return ndc;
 }
 
-std::vector<std::string> Hub::GenerateTraceCpp()
+std::vector<Statement> Hub::DescribeTrace()
 {
-  std::vector<std::string> trace;
+  std::vector<Statement> trace;
 
   if(this->GetTrace())
   {
-    if(this->GetPromisc())
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", true);");
-    }
-    else
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", false);");
-    }
-  }
-
-  return trace;
-}
-
-std::vector<std::string> Hub::GenerateNetworkHardwarePython()
-{
-  std::vector<std::string> ret;
-  
-  ret.push_back("csma_" + this->GetNetworkHardwareName() + " = ns3.CsmaHelper()");
-  ret.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute(\"DataRate\", ns3.DataRateValue(ns3.DataRate(" + this->GetDataRate() + ")))");
-  ret.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute(\"Delay\",  ns3.TimeValue(ns3.MilliSeconds(" + this->GetNetworkHardwareDelay() + ")))");
-  return ret;
-}
-
-std::vector<std::string> Hub::GenerateNetDevicePython()
-{
-  std::vector<std::string> ret;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerPython();
-  
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ret.push_back(allNodes.at(i));
+    trace.push_back(Statement::Call("csma_" + this->GetNetworkHardwareName(), "EnablePcapAll")
+        .Arg(Expression::String("csma_" + this->GetNetworkHardwareName())).Arg(Expression::Boolean(this->GetPromisc())));
   }
-  ret.push_back(this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install(" + this->GetAllNodeContainer() + ")");
-
-  return ret;
-}
 
-std::vector<std::string> Hub::GenerateTracePython()
-{
-  std::vector<std::string> trace;
-  
-  if(this->GetTrace())
-  {
-    if(this->GetPromisc())
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll(\"csma_" + this->GetNetworkHardwareName() + "\", true)");
-    }
-    else
-    {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll(\"csma_" + this->GetNetworkHardwareName() + "\", false)");
-    }
-  }
   return trace;
 }
@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file journal.cpp
+ * \brief Append-only edit journal.
+ */
+
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "journal.h"
+
+Journal::Journal()
+{
+  this->m_file = NULL;
+  this->m_records = 0;
+}
+
+Journal::~Journal()
+{
+  this->Close();
+}
+
+void Journal::Open(const std::string &fileName)
+{
+  this->Close();
+
+  // a torn last line is cut, the next record must start on its own line.
+  size_t length = 0;
+  std::vector<std::vector<std::string> > records = Journal::Read(fileName, length);
+  std::ifstream in(fileName.c_str(), std::ios::binary | std::ios::ate);
+  if(in.is_open() && static_cast<size_t>(in.tellg()) > length)
+  {
+    std::string content(length, '\0');
+    in.seekg(0);
+    in.read(&content[0], length);
+    in.close();
+    Journal::Replace(fileName, content);
+  }
+
+  this->m_records = records.size();
+  this->m_file = fopen(fileName.c_str(), "ab");
+  if(!this->m_file)
+  {
+    throw std::runtime_error("Open journal failed! (" + fileName + ") can not be opened.");
+  }
+  this->m_fileName = fileName;
+}
+
+void Journal::Close()
+{
+  if(this->m_file)
+  {
+    fclose(this->m_file);
+    this->m_file = NULL;
+  }
+}
+
+void Journal::Append(const std::vector<std::string> &record)
+{
+  if(!this->m_file)
+  {
+    throw std::logic_error("Append failed! (journal not opened).");
+  }
+  std::string line = Journal::Encode(record);
+  if(fwrite(line.data(), 1, line.size(), this->m_file) != line.size() || !Journal::Sync(this->m_file))
+  {
+    throw std::runtime_error("Append failed! (" + this->m_fileName + ").");
+  }
+  this->m_records++;
+}
+
+void Journal::Reset(const std::vector<std::string> &record)
+{
+  if(!this->m_file)
+  {
+    throw std::logic_error("Reset failed! (journal not opened).");
+  }
+  this->Close();
+  Journal::Replace(this->m_fileName, Journal::Encode(record));
+  this->m_file = fopen(this->m_fileName.c_str(), "ab");
+  if(!this->m_file)
+  {
+    throw std::runtime_error("Reset failed! (" + this->m_fileName + ") can not be opened.");
+  }
+  this->m_records = 1;
+}
+
+size_t Journal::GetNRecords() const
+{
+  return this->m_records;
+}
+
+std::vector<std::vector<std::string> > Journal::Read(const std::string &fileName)
+{
+  size_t length = 0;
+  return Journal::Read(fileName, length);
+}
+
+std::vector<std::vector<std::string> > Journal::Read(const std::string &fileName, size_t &length)
+{
+  std::vector<std::vector<std::string> > records;
+  std::ifstream in(fileName.c_str(), std::ios::binary);
+  std::string line;
+  length = 0;
+  while(std::getline(in, line))
+  {
+    // a line without its newline was torn by a crash.
+    if(in.eof())
+    {
+      break;
+    }
+    records.push_back(Journal::Decode(line));
+    length += line.size() + 1;
+  }
+  return records;
+}
+
+void Journal::Replace(const std::string &fileName, const std::string &content)
+{
+  std::string tmp = fileName + ".tmp";
+  FILE *file = fopen(tmp.c_str(), "wb");
+  if(!file)
+  {
+    throw std::runtime_error("Write journal failed! (" + tmp + ") can not be opened.");
+  }
+  bool written = fwrite(content.data(), 1, content.size(), file) == content.size() && Journal::Sync(file);
+  fclose(file);
+  if(!written)
+  {
+    throw std::runtime_error("Write journal failed! (" + tmp + ").");
+  }
+#ifdef _WIN32
+  /* the rename does not replace an existing file. */
+  remove(fileName.c_str());
+#endif
+  if(rename(tmp.c_str(), fileName.c_str()) != 0)
+  {
+    throw std::runtime_error("Write journal failed! (" + fileName + ") can not be replaced.");
+  }
+}
+
+bool Journal::Sync(FILE *file)
+{
+  if(fflush(file) != 0)
+  {
+    return false;
+  }
+#if defined(_WIN32)
+  return _commit(_fileno(file)) == 0;
+#elif defined(__linux__)
+  /* the data only, the file metadata (times) is not needed to read it back. */
+  return fdatasync(fileno(file)) == 0;
+#else
+  return fsync(fileno(file)) == 0;
+#endif
+}
+
+std::string Journal::Encode(const std::vector<std::string> &record)
+{
+  std::string line;
+  for(size_t i = 0; i < record.size(); i++)
+  {
+    if(i > 0)
+    {
+      line += '\t';
+    }
+    const std::string &field = record.at(i);
+    for(size_t j = 0; j < field.size(); j++)
+    {
+      switch(field[j])
+      {
+        case '\\':
+          line += "\\\\";
+          break;
+        case '\t':
+          line += "\\t";
+          break;
+        case '\n':
+          line += "\\n";
+          break;
+        default:
+          line += field[j];
+          break;
+      }
+    }
+  }
+  return line + '\n';
+}
+
+std::vector<std::string> Journal::Decode(const std::string &line)
+{
+  std::vector<std::string> record(1);
+  for(size_t i = 0; i < line.size(); i++)
+  {
+    if(line[i] == '\t')
+    {
+      record.push_back("");
+    }
+    else if(line[i] == '\\' && i + 1 < line.size())
+    {
+      i++;
+      record.back() += (line[i] == 't') ? '\t' : (line[i] == 'n') ? '\n' : line[i];
+    }
+    else
+    {
+      record.back() += line[i];
+    }
+  }
+  return record;
+}
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file journal.h
+ * \brief Append-only edit journal.
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Append-only edit journal.
+ *
+ *  A record is a list of string fields, written as one text line with tab
+ *  separated fields (the backslash, tab and newline characters are escaped).
+ *  Each appended record is flushed and synced to the disk, so the cost of an
+ *  edit does not depend on the project size and a crash loses at most the
+ *  record being written. A torn last line is ignored when the journal is read.
+ *
+ *  Reset replaces the whole journal by a single record through a temporary
+ *  file and a rename, so the journal is never seen half rewritten.
+ */
+class Journal
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    Journal();
+
+    /**
+     * \brief Destructor.
+     */
+    ~Journal();
+
+    /**
+     * \brief Open a journal to append records, it is created if missing.
+     * \param fileName journal file name
+     */
+    void Open(const std::string &fileName);
+
+    /**
+     * \brief Close the journal.
+     */
+    void Close();
+
+    /**
+     * \brief Append a record and sync it to the disk.
+     * \param record record fields
+     */
+    void Append(const std::vector<std::string> &record);
+
+    /**
+     * \brief Replace the content of the journal by a single record.
+     * \param record record fields
+     */
+    void Reset(const std::vector<std::string> &record);
+
+    /**
+     * \brief Get the number of records of the opened journal.
+     * \return number of records
+     */
+    size_t GetNRecords() const;
+
+    /**
+     * \brief Read the complete records of a journal.
+     * \param fileName journal file name
+     * \return records (empty if the journal does not exist)
+     */
+    static std::vector<std::vector<std::string> > Read(const std::string &fileName);
+
+  private:
+    /**
+     * \brief Journal file name.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief Journal file (NULL if closed).
+     */
+    FILE *m_file;
+
+    /**
+     * \brief Number of records.
+     */
+    size_t m_records;
+
+    /**
+     * \brief Read the complete records of a journal.
+     * \param fileName journal file name
+     * \param length length of the complete records (output, in bytes)
+     * \return records
+     */
+    static std::vector<std::vector<std::string> > Read(const std::string &fileName, size_t &length);
+
+    /**
+     * \brief Replace the content of a file through a synced temporary file.
+     * \param fileName file name
+     * \param content new content
+     */
+    static void Replace(const std::string &fileName, const std::string &content);
+
+    /**
+     * \brief Flush a file and sync its data to the disk.
+     * \param file file to sync
+     * \return true on success
+     */
+    static bool Sync(FILE *file);
+
+    /**
+     * \brief Encode a record as a journal line.
+     * \param record record fields
+     * \return line, with its newline
+     */
+    static std::string Encode(const std::vector<std::string> &record);
+
+    /**
+     * \brief Decode a journal line.
+     * \param line line, without its newline
+     * \return record fields
+     */
+    static std::vector<std::string> Decode(const std::string &line);
+};
+
+#endif /* JOURNAL_H */
@@ -27,10 +27,21 @@
 
 #include "network-hardware.h"
 #include "generator.h"
+#include <algorithm>
 #include <stdexcept>
 
 #include "utils.h"
 
+/**
+ * \brief Check if an installed node is a router.
+ * \param node node name
+ * \return true if the node is a router
+ */
+static bool IsRouter(const std::string &node)
+{
+  return node.find("router_") == 0;
+}
+
 NetworkHardware::NetworkHardware(const std::string &type, const size_t &indice)
 {
   this->m_type = type;
@@ -40,6 +51,7 @@ NetworkHardware::NetworkHardware(const std::string &type, const size_t &indice)
 
   this->m_enableTrace = false;
   this->m_tracePromisc = false;
+  this->m_parameterized = false;
 }
 
 NetworkHardware::~NetworkHardware()
@@ -76,7 +88,7 @@ std::string NetworkHardware::GetNdcName()
   return this->m_ndcName;
 }
 
-std::vector<std::string> NetworkHardware::GetInstalledNodes()
+const std::vector<std::string>& NetworkHardware::GetInstalledNodes() const
 {
   return this->m_nodes;
 }
@@ -86,6 +98,11 @@ std::string NetworkHardware::GetInstalledNode(const size_t &i)
   return this->m_nodes.at(i);
 }
 
+void NetworkHardware::SetInstalledNode(const size_t &i, const std::string &node)
+{
+  this->m_nodes.at(i) = node;
+}
+
 void NetworkHardware::removeInstalledNode(const size_t &nb)
 {
   try
@@ -99,6 +116,21 @@ void NetworkHardware::removeInstalledNode(const size_t &nb)
   }
 }
 
+size_t NetworkHardware::RemoveInstalledNodes(const std::set<std::string> &names)
+{
+  size_t kept = 0;
+  for(size_t i = 0; i < this->m_nodes.size(); i++)
+  {
+    if(names.find(this->m_nodes.at(i)) == names.end())
+    {
+      this->m_nodes.at(kept++) = this->m_nodes.at(i);
+    }
+  }
+  size_t removed = this->m_nodes.size() - kept;
+  this->m_nodes.resize(kept);
+  return removed;
+}
+
 void NetworkHardware::SetNetworkHardwareName(const std::string &linkName)
 {
   this->m_networkHardwareName = linkName;
@@ -121,25 +153,14 @@ void NetworkHardware::SetNdcName(const std::string &ndcName)
 
 void NetworkHardware::Install(const std::string &node)
 {
-  this->m_nodes.push_back(node);
-  std::vector<std::string> trans;
-  std::vector<std::string> transWhitoutRouter;
-  for(size_t i = 0; i <  this->m_nodes.size(); i++)
-  {
-    if((this->m_nodes.at(i)).find("router_") == 0)
-    {
-      trans.push_back(this->m_nodes.at(i));
-    }
-    else
-    {
-      transWhitoutRouter.push_back(this->m_nodes.at(i));
-    }
-  }
-  for(size_t i = 0; i <  transWhitoutRouter.size(); i++)
+  /* the routers are kept first, in install order: the list is always
+   * partitioned, a router goes at the end of the router part. */
+  if(!IsRouter(node))
   {
-    trans.push_back(transWhitoutRouter.at(i));
+    this->m_nodes.push_back(node);
+    return;
   }
-  this->m_nodes = trans;
+  this->m_nodes.insert(std::partition_point(this->m_nodes.begin(), this->m_nodes.end(), IsRouter), node);
 }
 
 std::string NetworkHardware::GetAllNodeContainer()
@@ -152,36 +173,21 @@ void NetworkHardware::SetAllNodeContainer(const std::string &allNodeContainer)
   this->m_allNodeContainer = allNodeContainer;
 }
 
-std::vector<std::string> NetworkHardware::GroupAsNodeContainerCpp()
+std::vector<Statement> NetworkHardware::GroupAsNodeContainer()
 {
-  std::vector<std::string> res;
-  res.push_back("NodeContainer " + this->m_allNodeContainer + ";");
+  std::vector<Statement> res;
+  res.push_back(Statement::Declare("NodeContainer", this->m_allNodeContainer));
   for(size_t i = 0; i <  this->m_nodes.size(); i++)
   {
     if((this->m_nodes.at(i)).find("ap_") != 0)
     {
-      res.push_back(this->m_allNodeContainer + ".Add (" + this->m_nodes.at(i) + ");");
+      res.push_back(Statement::Call(this->m_allNodeContainer, "Add").Arg(Expression::Name(this->m_nodes.at(i))));
     }
   }
 
   return res;
 }
 
-std::vector<std::string> NetworkHardware::GroupAsNodeContainerPython()
-{
-  std::vector<std::string> res;
-
-  res.push_back(this->m_allNodeContainer + " = ns3.NodeContainer()");
-  for(size_t i = 0; i <  this->m_nodes.size(); i++)
-  {
-    if((this->m_nodes.at(i)).find("ap_") != 0)
-    {
-      res.push_back(this->m_allNodeContainer + ".Add (" + this->m_nodes.at(i) + ")");
-    }
-  }
-  return res;
-}
-
 void NetworkHardware::SetTrace(const bool &state)
 {
   this->m_enableTrace = state;
@@ -202,57 +208,104 @@ bool NetworkHardware::GetPromisc()
   return this->m_tracePromisc;
 }
 
-std::vector<std::string> NetworkHardware::GenerateTapBridgeCpp()
+std::vector<Statement> NetworkHardware::DescribeTapBridge()
 {
-  std::vector<std::string> res;
+  std::vector<Statement> res;
   return res;
 }
 
-std::vector<std::string> NetworkHardware::GenerateVarsCpp()
+std::vector<Statement> NetworkHardware::DescribeVars()
 {
-  std::vector<std::string> res;
-  return res;
+  return this->DescribeParameterVars();
 }
 
-std::vector<std::string> NetworkHardware::GenerateCmdLineCpp()
+std::vector<Statement> NetworkHardware::DescribeCmdLine()
 {
-  std::vector<std::string> res;
-  return res;
+  return this->DescribeParameterCmdLine();
 }
 
-std::vector<std::string> NetworkHardware::GenerateTraceCpp()
+std::vector<Statement> NetworkHardware::DescribeTrace()
 {
-  std::vector<std::string> res;
+  std::vector<Statement> res;
   return res;
 }
 
-/* XXX to move elsewhere */
-std::vector<std::string> NetworkHardware::GenerateTapBridgePython()
+std::string NetworkHardware::GetLinkType()
 {
-  std::vector<std::string> res;
-  return res;
+  return this->m_type;
 }
 
-std::vector<std::string> NetworkHardware::GenerateVarsPython()
+void NetworkHardware::SetParameterized(const bool &state)
 {
-  std::vector<std::string> res;
-  return res;
+  this->m_parameterized = state;
 }
 
-std::vector<std::string> NetworkHardware::GenerateCmdLinePython()
+bool NetworkHardware::GetParameterized()
 {
-  std::vector<std::string> res;
-  return res;
+  return this->m_parameterized;
 }
 
-std::vector<std::string> NetworkHardware::GenerateTracePython()
+std::string NetworkHardware::GetSignature()
 {
-  std::vector<std::string> res;
-  return res;
+  std::string signature = this->m_type + "\n" + utils::integerToString(this->m_indice) + "\n" + this->m_networkHardwareName + "\n" +
+    this->m_dataRate + "\n" + this->m_networkHardwareDelay + "\n" + this->m_ndcName + "\n" + this->m_allNodeContainer + "\n" +
+    (this->m_enableTrace ? "1" : "0") + (this->m_tracePromisc ? "1" : "0") + (this->m_parameterized ? "1" : "0") + "\n" +
+    utils::integerToString(this->m_nodes.size()) + "\n";
+  for(size_t i = 0; i < this->m_nodes.size(); i++)
+  {
+    signature += this->m_nodes.at(i) + "\n";
+  }
+  return signature;
 }
 
-std::string NetworkHardware::GetLinkType()
+std::string NetworkHardware::GetDataRateValue()
 {
-  return this->m_type;
+  if(this->m_parameterized)
+  {
+    return "dataRate_" + this->m_networkHardwareName;
+  }
+  return this->m_dataRate;
 }
 
+std::string NetworkHardware::GetNetworkHardwareDelayValue()
+{
+  if(this->m_parameterized)
+  {
+    return "delay_" + this->m_networkHardwareName;
+  }
+  return this->m_networkHardwareDelay;
+}
+
+std::vector<Statement> NetworkHardware::DescribeParameterVars()
+{
+  std::vector<Statement> vars;
+  if(this->m_parameterized)
+  {
+    vars.push_back(Statement::Define("uint64_t", "dataRate_" + this->m_networkHardwareName, Expression::Name(this->m_dataRate)));
+    vars.push_back(Statement::Define("uint32_t", "delay_" + this->m_networkHardwareName, Expression::Name(this->m_networkHardwareDelay)));
+  }
+  return vars;
+}
+
+std::vector<Statement> NetworkHardware::DescribeParameterCmdLine()
+{
+  std::vector<Statement> cmdLine;
+  if(this->m_parameterized)
+  {
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("dataRate_" + this->m_networkHardwareName))
+        .Arg(Expression::String("Data rate of " + this->m_networkHardwareName + " (bps)")).Arg(Expression::Name("dataRate_" + this->m_networkHardwareName)));
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("delay_" + this->m_networkHardwareName))
+        .Arg(Expression::String("Delay of " + this->m_networkHardwareName + " (ms)")).Arg(Expression::Name("delay_" + this->m_networkHardwareName)));
+  }
+  return cmdLine;
+}
+
+std::vector<Statement> NetworkHardware::DescribeDataRateDelay(const std::string &helper, const std::string &dataRate)
+{
+  std::vector<Statement> attributes;
+  attributes.push_back(Statement::Call(helper, dataRate).Arg(Expression::String("DataRate"))
+      .Arg(Expression::Function("DataRateValue").Arg(Expression::Convert("DataRate", Expression::Name(this->GetDataRateValue())))));
+  attributes.push_back(Statement::Call(helper, "SetChannelAttribute").Arg(Expression::String("Delay"))
+      .Arg(Expression::Function("TimeValue").Arg(Expression::Function("MilliSeconds").Arg(Expression::Name(this->GetNetworkHardwareDelayValue())))));
+  return attributes;
+}
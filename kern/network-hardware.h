@@ -29,9 +29,12 @@
 #define NETWORKHARDWARE_H
 
 #include <iostream>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "statement.h"
+
 /**
  * \ingroup generator
  * \brief This is the link class.
@@ -56,20 +59,17 @@
  *    ~LinkImpl();
  *
  *    virtual std::vector<std::string> GenerateHeader();
- *    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
- *    virtual std::vector<std::string> GenerateNetdeviceCpp();
- *    virtual std::vector<std::string> GenerateNetworkHardwarePython();
- *    virtual std::vector<std::string> GenerateNetdevicePython();
+ *    virtual std::vector<Statement> DescribeNetworkHardware();
+ *    virtual std::vector<Statement> DescribeNetDevice();
  *    # and if you need
- *    virtual std::vector<std::string> GenerateTraceCpp();
- *    virtual std::vector<std::string> GenerateTapBridgeCpp();
- *    virtual std::vector<std::string> GenerateVarsCpp();
- *    virtual std::vector<std::string> GenerateCmdLineCpp();
- *    virtual std::vector<std::string> GenerateTracePython();
- *    virtual std::vector<std::string> GenerateTapBridgePython();
- *    virtual std::vector<std::string> GenerateVarsPython();
- *    virtual std::vector<std::string> GenerateCmdLinePython();
+ *    virtual std::vector<Statement> DescribeTrace();
+ *    virtual std::vector<Statement> DescribeTapBridge();
+ *    virtual std::vector<Statement> DescribeVars();
+ *    virtual std::vector<Statement> DescribeCmdLine();
  *  }
+ *
+ *  The code is described once (see Statement), the Generator renders it in
+ *  C++ and in python.
  */
 class NetworkHardware
 {
@@ -119,6 +119,11 @@ class NetworkHardware
      */
     bool m_tracePromisc;
 
+    /**
+     * \brief If the attributes are lifted into command line parameters.
+     */
+    bool m_parameterized;
+
     /**
      * \brief Node name which are connected to the link.
      */
@@ -144,80 +149,42 @@ class NetworkHardware
     virtual std::vector<std::string> GenerateHeader() = 0;
 
     /**
-     * \brief Generate link C++ code.
+     * \brief Describe the link code.
      * \return link code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp() = 0;
+    virtual std::vector<Statement> DescribeNetworkHardware() = 0;
 
     /**
-     * \brief Generate net device container C++ code.
+     * \brief Describe the net device container code.
      *
      * The net device container contain all nodes installed by the link.
      * \return net device container code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp() = 0;
+    virtual std::vector<Statement> DescribeNetDevice() = 0;
 
     /**
-     * \brief Generate tap bridge C++ code.
+     * \brief Describe the tap bridge code.
      * \return tap bridge code
      */
-    virtual std::vector<std::string> GenerateTapBridgeCpp();
+    virtual std::vector<Statement> DescribeTapBridge();
 
     /**
-     * \brief Generate vars C++ code.
+     * \brief Describe the vars code.
      * \return vars code
      */
-    virtual std::vector<std::string> GenerateVarsCpp();
+    virtual std::vector<Statement> DescribeVars();
 
     /**
-     * \brief Generate cmd line C++ code.
+     * \brief Describe the cmd line code.
      * \return cmd line code
      */
-    virtual std::vector<std::string> GenerateCmdLineCpp();
+    virtual std::vector<Statement> DescribeCmdLine();
 
     /**
-     * \brief Generate trace line C++ code.
-     * \return trace line code
-     */
-    virtual std::vector<std::string> GenerateTraceCpp();
-
-    /**
-     * \brief Generate link python code.
-     * \return link code
-     */
-    virtual std::vector<std::string> GenerateNetworkHardwarePython() = 0;
-
-    /**
-     * \brief Generate net device container python code.
-     *
-     * The net device container contain all nodes installed by the link.
-     * \return net device container code
-     */
-    virtual std::vector<std::string> GenerateNetDevicePython() = 0;
-
-    /**
-     * \brief Generate tap bridge python code.
-     * \return tap bridge code
+     * \brief Describe the trace code.
+     * \return trace code
      */
-    virtual std::vector<std::string> GenerateTapBridgePython();
-
-    /**
-     * \brief Generate vars python code.
-     * \return vars code
-     */
-    virtual std::vector<std::string> GenerateVarsPython();
-
-    /**
-     * \brief Generate cmd line python code.
-     * \return cmd line code
-     */
-    virtual std::vector<std::string> GenerateCmdLinePython();
-
-    /**
-     * \brief Generate trace line python code.
-     * \return trace line code
-     */
-    virtual std::vector<std::string> GenerateTracePython();
+    virtual std::vector<Statement> DescribeTrace();
 
     /**
      * \brief Get link number.
@@ -259,7 +226,7 @@ class NetworkHardware
      * \brief Get attached nodes list.
      * \return node list
      */
-    std::vector<std::string> GetInstalledNodes();
+    const std::vector<std::string>& GetInstalledNodes() const;
 
     /**
      * \brief Get n node.
@@ -267,12 +234,30 @@ class NetworkHardware
      */
     std::string GetInstalledNode(const size_t &i);
 
+    /**
+     * \brief Set n node.
+     *
+     *  The new name must keep the kind of the node (router or not), the
+     *  routers stay first.
+     *
+     * \param i index of the node
+     * \param node new node name
+     */
+    void SetInstalledNode(const size_t &i, const std::string &node);
+
     /**
      * \brief Remove installed selected node.
      * \param nb remove node index
      */
     void removeInstalledNode(const size_t &nb);
 
+    /**
+     * \brief Remove installed nodes.
+     * \param names names of the nodes to remove
+     * \return number of nodes removed
+     */
+    size_t RemoveInstalledNodes(const std::set<std::string> &names);
+
     /**
      * \brief Set link rate.
      * \param linkName new link name
@@ -299,21 +284,19 @@ class NetworkHardware
 
     /**
      * \brief Install node on link.
+     *
+     *  The routers are kept before the other nodes, the install costs a
+     *  binary search, not a rebuild of the list.
+     *
      * \param node new node to add
      */
     void Install(const std::string &node);
 
     /**
      * \brief Group all link installed nodes.
-     * \return all nodes
-     */
-    std::vector<std::string> GroupAsNodeContainerCpp();
-
-    /**
-     * \brief Group all link installed nodes.
-     * \return all nodes
+     * \return all nodes code
      */
-    std::vector<std::string> GroupAsNodeContainerPython();
+    std::vector<Statement> GroupAsNodeContainer();
 
     /**
      * \brief Get all node container name.
@@ -356,6 +339,65 @@ class NetworkHardware
      * \return link type
      */
     std::string GetLinkType();
+
+    /**
+     * \brief Enable/disable the command line parameters.
+     *
+     * When enabled, the data rate and the delay are generated as
+     * variables which can be changed from the command line.
+     *
+     * \param state parameterized state
+     */
+    void SetParameterized(const bool &state);
+
+    /**
+     * \brief Get the command line parameters state.
+     * \return parameterized state
+     */
+    bool GetParameterized();
+
+    /**
+     * \brief Get the inputs of the code generation of the link.
+     *
+     *  Two links with the same signature generate the same code, it keys
+     *  the fragment cache (see FragmentCache).
+     *
+     * \return signature (one field per line)
+     */
+    virtual std::string GetSignature();
+
+    /**
+     * \brief Get the data rate expression used into the generated code.
+     * \return data rate value or the data rate variable name
+     */
+    std::string GetDataRateValue();
+
+    /**
+     * \brief Get the delay expression (in ms) used into the generated code.
+     * \return delay value or the delay variable name
+     */
+    std::string GetNetworkHardwareDelayValue();
+
+  protected:
+    /**
+     * \brief Describe the data rate and delay vars code.
+     * \return vars code
+     */
+    std::vector<Statement> DescribeParameterVars();
+
+    /**
+     * \brief Describe the data rate and delay cmd line code.
+     * \return cmd line code
+     */
+    std::vector<Statement> DescribeParameterCmdLine();
+
+    /**
+     * \brief Describe the data rate and delay attributes of a helper.
+     * \param helper helper name
+     * \param dataRate method which sets the data rate ("SetChannelAttribute", "SetDeviceAttribute")
+     * \return attributes code
+     */
+    std::vector<Statement> DescribeDataRateDelay(const std::string &helper, const std::string &dataRate);
 };
 
 #endif /* NETWORKHARDWARE_H */
@@ -38,6 +38,7 @@ Node::Node(const size_t &indice, const std::string &type, const std::string &nam
   this->m_ipInterfaceName = std::string("iface_" + this->m_nodeName);
   this->m_nsc = std::string("");	
   this->m_machinesNumber = machinesNumber;
+  this->m_parameterized = false;
 }
 
 Node::~Node()
@@ -106,51 +107,81 @@ std::vector<std::string> Node::GenerateHeader()
   return headers; 
 }
 
-std::vector<std::string> Node::GenerateNodeCpp()
+std::vector<Statement> Node::DescribeNode()
 {
-  std::vector<std::string> nodes;
-  nodes.push_back("NodeContainer " + this->m_nodeName + ";");
-  nodes.push_back(this->m_nodeName + ".Create (" + utils::integerToString(this->m_machinesNumber) + ");");
+  std::vector<Statement> nodes;
+  nodes.push_back(Statement::Declare("NodeContainer", this->m_nodeName));
+  nodes.push_back(Statement::Call(this->m_nodeName, "Create").Arg(Expression::Name(this->GetMachinesNumberValue())));
 
   return nodes; 
 }
 
-std::vector<std::string> Node::GenerateIpStackCpp()
+std::vector<Statement> Node::DescribeIpStack()
 {
-  std::vector<std::string> stack;
+  std::vector<Statement> stack;
   
   if(this->m_nsc != "")
   {
-    stack.push_back("internetStackH.SetTcp (\"ns3::NscTcpL4Protocol\",\"Library\",StringValue(nscStack));");
+    stack.push_back(Statement::Call("internetStackH", "SetTcp").Arg(Expression::String("ns3::NscTcpL4Protocol"))
+        .Arg(Expression::String("Library")).Arg(Expression::Function("StringValue").Arg(Expression::Name("nscStack"))));
   }
-  stack.push_back("internetStackH.Install (" + this->m_nodeName + ");");
+  stack.push_back(Statement::Call("internetStackH", "Install").Arg(Expression::Name(this->m_nodeName)));
 
   return stack; 
 }
 
-std::vector<std::string> Node::GenerateNodePython()
+std::string Node::GetNodeType()
 {
-  std::vector<std::string> nodes;
-  
-  nodes.push_back(this->m_nodeName + " = ns3.NodeContainer()");
-  nodes.push_back(this->m_nodeName + ".Create (" + utils::integerToString(this->m_machinesNumber) + ")");
-  return nodes; 
+  return this->m_type;
 }
 
-std::vector<std::string> Node::GenerateIpStackPython()
+void Node::SetParameterized(const bool &state)
 {
-  std::vector<std::string> stack;
-  
-  if(this->m_nsc != "")
+  this->m_parameterized = state;
+}
+
+bool Node::GetParameterized()
+{
+  return this->m_parameterized;
+}
+
+std::string Node::GetSignature()
+{
+  return this->m_type + "\n" + utils::integerToString(this->m_indice) + "\n" + this->m_nodeName + "\n" + this->m_ipInterfaceName + "\n" +
+    this->m_nsc + "\n" + utils::integerToString(this->m_machinesNumber) + "\n" + (this->m_parameterized ? "1" : "0") + "\n";
+}
+
+bool Node::HasMachinesNumberParameter()
+{
+  return this->m_parameterized && this->m_type == "Pc-group";
+}
+
+std::string Node::GetMachinesNumberValue()
+{
+  if(this->HasMachinesNumberParameter())
   {
-    stack.push_back("internetStackH.SetTcp (\"ns3::NscTcpL4Protocol\",\"Library\",StringValue(nscStack))");
+    return "nNodes_" + this->m_nodeName;
   }
-  stack.push_back("internetStackH.Install (" + this->m_nodeName + ")");
+  return utils::integerToString(this->m_machinesNumber);
+}
 
-  return stack; 
+std::vector<Statement> Node::DescribeVars()
+{
+  std::vector<Statement> vars;
+  if(this->HasMachinesNumberParameter())
+  {
+    vars.push_back(Statement::Define("uint32_t", "nNodes_" + this->m_nodeName, Expression::Name(utils::integerToString(this->m_machinesNumber))));
+  }
+  return vars;
 }
 
-std::string Node::GetNodeType()
+std::vector<Statement> Node::DescribeCmdLine()
 {
-  return this->m_type;
+  std::vector<Statement> cmdLine;
+  if(this->HasMachinesNumberParameter())
+  {
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("nNodes_" + this->m_nodeName))
+        .Arg(Expression::String("Number of nodes of " + this->m_nodeName)).Arg(Expression::Name("nNodes_" + this->m_nodeName)));
+  }
+  return cmdLine;
 }
@@ -32,6 +32,8 @@
 #include <string>
 #include <vector>
 
+#include "statement.h"
+
 /**
  * \ingroup generator
  * \brief Node base class.
@@ -82,6 +84,11 @@ class Node
      */
     std::string m_type;
 
+    /**
+     * \brief If the group size is lifted into a command line parameter.
+     */
+    bool m_parameterized;
+
   public:
     /**
      * \brief Constructor.
@@ -105,32 +112,31 @@ class Node
     std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate node C++ code.
+     * \brief Describe node code.
      * This function return a vector which contain the declaration and instanciation of the node
      * \return node code
      */
-    std::vector<std::string> GenerateNodeCpp();
+    std::vector<Statement> DescribeNode();
 
     /**
-     * \brief Generate IP stack C++ code.
-     * This function return a vector which contain the c++ code from the Ipv4 stack declaration and instanciation
+     * \brief Describe IP stack code.
+     * This function return a vector which contain the code from the Ipv4 stack declaration and instanciation
      * \return IP stack code.
      */
-    std::vector<std::string> GenerateIpStackCpp();
+    std::vector<Statement> DescribeIpStack();
 
     /**
-     * \brief Generate node python code.
-     * This function return a vector which contain the declaration and instanciation of the node
-     * \return node code
+     * \brief Describe vars code.
+     * Only a terminal group has a parameter: its machines number.
+     * \return vars code
      */
-    std::vector<std::string> GenerateNodePython();
+    std::vector<Statement> DescribeVars();
 
     /**
-     * \brief Generate IP stack python code.
-     * This function return a vector which contain the c++ code from the Ipv4 stack declaration and instanciation
-     * \return IP stack code.
+     * \brief Describe cmd line code.
+     * \return cmd line code
      */
-    std::vector<std::string> GenerateIpStackPython();
+    std::vector<Statement> DescribeCmdLine();
 
     /**
      * \brief Set node name.
@@ -207,6 +213,40 @@ class Node
      * \return type the node type
      */
     std::string GetNodeType();
+
+    /**
+     * \brief Enable/disable the command line parameters.
+     * \param state parameterized state
+     */
+    void SetParameterized(const bool &state);
+
+    /**
+     * \brief Get the command line parameters state.
+     * \return parameterized state
+     */
+    bool GetParameterized();
+
+    /**
+     * \brief Get the inputs of the code generation of the node.
+     *
+     *  Two nodes with the same signature generate the same code, it keys
+     *  the fragment cache (see FragmentCache).
+     *
+     * \return signature (one field per line)
+     */
+    std::string GetSignature();
+
+    /**
+     * \brief Get if the machines number is generated as a parameter.
+     * \return true if the node is a parameterized terminal group
+     */
+    bool HasMachinesNumberParameter();
+
+    /**
+     * \brief Get the machines number expression used into the generated code.
+     * \return machines number or the machines number variable name
+     */
+    std::string GetMachinesNumberValue();
 };
 
 #endif /* NODE_H */
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file pass-manager.cpp
+ * \brief Ordered list of the passes run on a program.
+ */
+
+#include <algorithm>
+
+#include "pass-manager.h"
+
+PassManager::PassManager()
+{
+}
+
+PassManager::~PassManager()
+{
+  this->Clear();
+}
+
+void PassManager::Add(const std::string &name)
+{
+  for(size_t i = 0; i < this->m_passes.size(); i++)
+  {
+    if(this->m_passes.at(i)->GetName() == name)
+    {
+      return;
+    }
+  }
+  Pass *pass = Pass::Create(name);
+
+  /* the helper of a removed link may be shared after a merge: the removals
+   * run before the rewrites. */
+  std::vector<std::string> order = Pass::GetPasses();
+  size_t rank = std::find(order.begin(), order.end(), name) - order.begin();
+  std::vector<Pass*>::iterator it = this->m_passes.begin();
+  while(it != this->m_passes.end() && static_cast<size_t>(std::find(order.begin(), order.end(), (*it)->GetName()) - order.begin()) < rank)
+  {
+    it++;
+  }
+  this->m_passes.insert(it, pass);
+}
+
+void PassManager::Clear()
+{
+  for(size_t i = 0; i < this->m_passes.size(); i++)
+  {
+    delete this->m_passes.at(i);
+  }
+  this->m_passes.clear();
+  this->m_report.clear();
+}
+
+std::vector<std::string> PassManager::GetPasses() const
+{
+  std::vector<std::string> passes;
+  for(size_t i = 0; i < this->m_passes.size(); i++)
+  {
+    passes.push_back(this->m_passes.at(i)->GetName());
+  }
+  return passes;
+}
+
+bool PassManager::IsEmpty() const
+{
+  return this->m_passes.size() == 0;
+}
+
+void PassManager::Run(Program &program)
+{
+  this->m_report.clear();
+  for(size_t i = 0; i < this->m_passes.size(); i++)
+  {
+    std::vector<std::string> report;
+    this->m_passes.at(i)->Run(program, report);
+    for(size_t j = 0; j < report.size(); j++)
+    {
+      this->m_report.push_back(this->m_passes.at(i)->GetName() + ": " + report.at(j));
+    }
+  }
+}
+
+const std::vector<std::string>& PassManager::GetReport() const
+{
+  return this->m_report;
+}
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file pass-manager.h
+ * \brief Ordered list of the passes run on a program.
+ */
+
+#ifndef PASS_MANAGER_H
+#define PASS_MANAGER_H
+
+#include <string>
+#include <vector>
+
+#include "pass.h"
+
+/**
+ * \ingroup generator
+ * \brief Ordered list of the passes run on a program.
+ *
+ *  The passes are run in the order of Pass::GetPasses, whatever the order
+ *  they are added in, and the report of the last run gives the changes of each pass, prefixed by the pass name:
+ *    "helper-dedup: csma_hub_1 merged into csma_hub_0"
+ */
+class PassManager
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    PassManager();
+
+    /**
+     * \brief Destructor.
+     */
+    ~PassManager();
+
+    /**
+     * \brief Add a pass at its place in the run order.
+     *
+     *  A pass which is already in the list is not added twice.
+     *
+     * \param name pass name
+     */
+    void Add(const std::string &name);
+
+    /**
+     * \brief Remove all the passes.
+     */
+    void Clear();
+
+    /**
+     * \brief Get the names of the passes, in the run order.
+     * \return pass names
+     */
+    std::vector<std::string> GetPasses() const;
+
+    /**
+     * \brief Check if there is no pass.
+     * \return true if there is no pass
+     */
+    bool IsEmpty() const;
+
+    /**
+     * \brief Run all the passes on a program.
+     * \param program program to transform
+     */
+    void Run(Program &program);
+
+    /**
+     * \brief Get the report of the last run.
+     * \return changes made, one line each
+     */
+    const std::vector<std::string>& GetReport() const;
+
+  private:
+    /**
+     * \brief Passes, in the run order.
+     */
+    std::vector<Pass*> m_passes;
+
+    /**
+     * \brief Report of the last run.
+     */
+    std::vector<std::string> m_report;
+};
+
+#endif /* PASS_MANAGER_H */
@@ -0,0 +1,53 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file pass.cpp
+ * \brief Transformation of the program before it is rendered.
+ */
+
+#include <stdexcept>
+
+#include "pass.h"
+#include "dead-object-pass.h"
+#include "helper-dedup-pass.h"
+
+Pass::~Pass()
+{
+}
+
+Pass* Pass::Create(const std::string &name)
+{
+  if(name == "dead-objects")
+  {
+    return new DeadObjectPass();
+  }
+  if(name == "helper-dedup")
+  {
+    return new HelperDedupPass();
+  }
+  throw std::logic_error("Pass failed! (" + name + ") unknown pass.");
+}
+
+std::vector<std::string> Pass::GetPasses()
+{
+  std::vector<std::string> passes;
+  passes.push_back("dead-objects");
+  passes.push_back("helper-dedup");
+  return passes;
+}
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file pass.h
+ * \brief Transformation of the program before it is rendered.
+ */
+
+#ifndef PASS_H
+#define PASS_H
+
+#include <string>
+#include <vector>
+
+#include "program.h"
+
+/**
+ * \ingroup generator
+ * \brief Transformation of the program before it is rendered.
+ *
+ *  A pass rewrites the Program of a scenario (removes, merges or rewrites
+ *  blocks) and reports what it changed. The passes are known by their name,
+ *  a new pass is a subclass added to Create and GetPasses. The passes which
+ *  remove objects come first in GetPasses, a later pass does not rewrite code
+ *  that is then removed.
+ */
+class Pass
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~Pass();
+
+    /**
+     * \brief Get the pass name.
+     * \return pass name
+     */
+    virtual std::string GetName() const = 0;
+
+    /**
+     * \brief Transform a program.
+     * \param program program to transform
+     * \param report changes made, one line each (output)
+     */
+    virtual void Run(Program &program, std::vector<std::string> &report) = 0;
+
+    /**
+     * \brief Create a pass from its name.
+     * \param name pass name
+     * \return pass (to be deleted by the caller)
+     */
+    static Pass* Create(const std::string &name);
+
+    /**
+     * \brief Get the available pass names, in their run order.
+     * \return pass names
+     */
+    static std::vector<std::string> GetPasses();
+};
+
+#endif /* PASS_H */
@@ -49,53 +49,40 @@ std::vector<std::string> Ping::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Ping::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+std::vector<Statement> Ping::DescribeApplication(const std::string &netDeviceContainer, const std::string &numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
+  std::vector<Statement> apps;
+  std::vector<Statement> startStop;
+  std::string dst = "dst_" + this->GetAppName();
+  std::string container = "apps_" + this->GetAppName();
+
+  apps.push_back(Statement::Define("InetSocketAddress", dst, Expression::Function("InetSocketAddress")
+        .Arg(Expression::Method("iface_" + netDeviceContainer, "GetAddress").Arg(Expression::Name(numberIntoNetDevice)))));
+  apps.push_back(Statement::Define("OnOffHelper", "onoff_" + this->GetAppName(), Expression::Function("OnOffHelper")
+        .Arg(Expression::String("ns3::Ipv4RawSocketFactory")).Arg(Expression::Name(dst))));
+  apps.push_back(Statement::Call("onoff_" + this->GetAppName(), "SetAttribute").Arg(Expression::String("OnTime"))
+      .Arg(Expression::Function("StringValue").Arg(Expression::String("ns3::ConstantRandomVariable[Constant=1]"))));
+  apps.push_back(Statement::Call("onoff_" + this->GetAppName(), "SetAttribute").Arg(Expression::String("OffTime"))
+      .Arg(Expression::Function("StringValue").Arg(Expression::String("ns3::ConstantRandomVariable[Constant=0]"))));
+
+  apps.push_back(Statement::Define("ApplicationContainer", container, Expression::Method("onoff_" + this->GetAppName(), "Install")
+        .Arg(Expression::Method(this->GetSenderNode(), "Get").Arg(Expression::Name("0")))));
+  startStop = this->DescribeStartStop(container, "1", "1");
+  apps.insert(apps.end(), startStop.begin(), startStop.end());
+
+  apps.push_back(Statement::Define("PacketSinkHelper", "sink_" + this->GetAppName(), Expression::Function("PacketSinkHelper")
+        .Arg(Expression::String("ns3::Ipv4RawSocketFactory")).Arg(Expression::Name(dst))));
+  apps.push_back(Statement::Assign(container, Expression::Method("sink_" + this->GetAppName(), "Install")
+        .Arg(Expression::Method(this->GetReceiverNode(), "Get").Arg(Expression::Name("0")))));
+  startStop = this->DescribeStartStop(container, "0", "2");
+  apps.insert(apps.end(), startStop.begin(), startStop.end());
+
+  apps.push_back(Statement::Define("V4PingHelper", "ping_" + this->GetAppName(), Expression::Function("V4PingHelper")
+        .Arg(Expression::Method("iface_" + netDeviceContainer, "GetAddress").Arg(Expression::Name(numberIntoNetDevice)))));
+  apps.push_back(Statement::Assign(container, Expression::Method("ping_" + this->GetAppName(), "Install")
+        .Arg(Expression::Method(this->GetSenderNode(), "Get").Arg(Expression::Name("0")))));
+  startStop = this->DescribeStartStop(container, "2", "0");
+  apps.insert(apps.end(), startStop.begin(), startStop.end());
 
-  apps.push_back("InetSocketAddress dst_" + this->GetAppName() + " = InetSocketAddress (iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "));");
-  apps.push_back("OnOffHelper onoff_" + this->GetAppName() + " = OnOffHelper (\"ns3::Ipv4RawSocketFactory\", dst_" + this->GetAppName() + ");");
-  apps.push_back("onoff_" + this->GetAppName() + ".SetAttribute (\"OnTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"));");
-  apps.push_back("onoff_" + this->GetAppName() + ".SetAttribute (\"OffTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"));");
-
-  apps.push_back("ApplicationContainer apps_" + this->GetAppName() + " = onoff_" + this->GetAppName() + ".Install(" + this->GetSenderNode() + ".Get(0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".1));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".1));");
-
-  apps.push_back("PacketSinkHelper sink_" + this->GetAppName() + " = PacketSinkHelper (\"ns3::Ipv4RawSocketFactory\", dst_" + this->GetAppName() + ");");
-  apps.push_back("apps_" + this->GetAppName() + " = sink_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ".Get(0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".2));");
-
-  apps.push_back("V4PingHelper ping_" + this->GetAppName() + " = V4PingHelper(iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "));");
-  apps.push_back("apps_" + this->GetAppName() + " = ping_" + this->GetAppName() + ".Install(" + this->GetSenderNode() + ".Get(0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".2));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  return apps;
-}
-
-std::vector<std::string> Ping::GenerateApplicationPython(std::string netDeviceContainer, size_t numberIntoNetDevice)
-{
-  std::vector<std::string> apps;
-
-  apps.push_back("dst_" + this->GetAppName() + " = ns3.InetSocketAddress(iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "))");
-  apps.push_back("onoff_" + this->GetAppName() + " = ns3.OnOffHelper(\"ns3::Ipv4RawSocketFactory\", dst_" + this->GetAppName() + ")");
-  apps.push_back("onoff_" + this->GetAppName() + ".SetAttribute(\"OnTime\", ns3.StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"))");
-  apps.push_back("onoff_" + this->GetAppName() + ".SetAttribute(\"OffTime\", ns3.StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"))");
-
-  apps.push_back("apps_" + this->GetAppName() + " = onoff_" + this->GetAppName() + ".Install(" + this->GetSenderNode() + ".Get(0))");
-  apps.push_back("apps_" + this->GetAppName() + ".Start(ns3.Seconds (" + this->GetStartTime() + ".1))");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop(ns3.Seconds (" + this->GetEndTime() + ".1))");
-
-  apps.push_back("sink_" + this->GetAppName() + " = ns3.PacketSinkHelper(\"ns3::Ipv4RawSocketFactory\", dst_" + this->GetAppName() + ")");
-  apps.push_back("apps_" + this->GetAppName() + " = sink_" + this->GetAppName() + ".Install(" + this->GetReceiverNode() + ".Get(0))");
-  apps.push_back("apps_" + this->GetAppName() + ".Start(ns3.Seconds(" + this->GetStartTime() + ".0))");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop(ns3.Seconds(" + this->GetEndTime() + ".2))");
-
-  apps.push_back("ping_" + this->GetAppName() + " = ns3.V4PingHelper(iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "))");
-  apps.push_back("apps_" + this->GetAppName() + " = ping_" + this->GetAppName() + ".Install(" + this->GetSenderNode() + ".Get(0))");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (ns3.Seconds(" + this->GetStartTime() + ".2))");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (ns3.Seconds(" + this->GetEndTime() + ".0))");
   return apps;
 }
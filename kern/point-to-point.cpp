@@ -47,74 +47,33 @@ std::vector<std::string> PointToPoint::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> PointToPoint::GenerateNetworkHardwareCpp()
+std::vector<Statement> PointToPoint::DescribeNetworkHardware()
 {
-  std::vector<std::string> generatedLink;
-  generatedLink.push_back("PointToPointHelper p2p_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("p2p_" + this->GetNetworkHardwareName() + ".SetDeviceAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("p2p_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\", TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
+  std::vector<Statement> generatedLink;
+  generatedLink.push_back(Statement::Declare("PointToPointHelper", "p2p_" + this->GetNetworkHardwareName()));
+  std::vector<Statement> attributes = this->DescribeDataRateDelay("p2p_" + this->GetNetworkHardwareName(), "SetDeviceAttribute");
+  generatedLink.insert(generatedLink.end(), attributes.begin(), attributes.end());
 
   return generatedLink;
 }
 
-std::vector<std::string> PointToPoint::GenerateNetDeviceCpp()
+std::vector<Statement> PointToPoint::DescribeNetDevice()
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = p2p_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
+  std::vector<Statement> ndc = this->GroupAsNodeContainer();
+  ndc.push_back(Statement::Define("NetDeviceContainer", this->GetNdcName(),
+        Expression::Method("p2p_" + this->GetNetworkHardwareName(), "Install").Arg(Expression::Name(this->GetAllNodeContainer()))));
 
   return ndc;
 }
 
-std::vector<std::string> PointToPoint::GenerateTraceCpp()
+std::vector<Statement> PointToPoint::DescribeTrace()
 {
-  std::vector<std::string> trace;
+  std::vector<Statement> trace;
 
   if(this->GetTrace())
   {
-    trace.push_back("PointToPointHelper::EnablePcapAll (\"" + this->GetNetworkHardwareName() + "\");");
-  }
-
-  return trace;
-}
-
-std::vector<std::string> PointToPoint::GenerateNetworkHardwarePython()
-{
-  std::vector<std::string> generatedLink;
-  
-  generatedLink.push_back("p2p_" + this->GetNetworkHardwareName() + " = ns3.PointToPointHelper()");
-  generatedLink.push_back("p2p_" + this->GetNetworkHardwareName() + ".SetDeviceAttribute(\"DataRate\", ns3.DataRateValue(ns3.DataRate(" + this->GetDataRate() + ")))");
-  generatedLink.push_back("p2p_" + this->GetNetworkHardwareName() + ".SetChannelAttribute(\"Delay\", ns3.TimeValue(ns3.MilliSeconds(" + this->GetNetworkHardwareDelay() + ")))");
-  return generatedLink;
-}
-
-std::vector<std::string> PointToPoint::GenerateNetDevicePython()
-{
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerPython();
-  
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
+    trace.push_back(Statement::Evaluate(Expression::Static("PointToPointHelper", "EnablePcapAll").Arg(Expression::String(this->GetNetworkHardwareName()))));
   }
-  
-  ndc.push_back(this->GetNdcName() + " = p2p_" + this->GetNetworkHardwareName() + ".Install(" + this->GetAllNodeContainer() + ")");
-
-  return ndc;
-}
 
-std::vector<std::string> PointToPoint::GenerateTracePython()
-{
-  std::vector<std::string> trace;
-  
-  if(this->GetTrace())
-  {
-    trace.push_back("PointToPointHelper.EnablePcapAll(\"" + this->GetNetworkHardwareName() + "\")");
-  }
-  
   return trace;
 }
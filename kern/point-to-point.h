@@ -70,40 +70,22 @@ class PointToPoint : public NetworkHardware
     virtual std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate link C++ code.
+     * \brief Describe link code.
      * \return link code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual std::vector<Statement> DescribeNetworkHardware();
 
     /**
-     * \brief Generate net device container C++ code.
+     * \brief Describe net device container code.
      * \return net device container code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual std::vector<Statement> DescribeNetDevice();
 
     /**
-     * \brief Generate trace line C++ code.
+     * \brief Describe trace line code.
      * \return trace line code
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
-    
-    /**
-     * \brief Generate link python code.
-     * \return link code
-     */
-    virtual std::vector<std::string> GenerateNetworkHardwarePython();
-
-    /**
-     * \brief Generate net device container python code.
-     * \return net device container code
-     */
-    virtual std::vector<std::string> GenerateNetDevicePython();
-
-    /**
-     * \brief Generate trace line python code.
-     * \return trace line code
-     */
-    virtual std::vector<std::string> GenerateTracePython();
+    virtual std::vector<Statement> DescribeTrace();
 };
 
 #endif /* POINT_TO_POINT_H */
@@ -0,0 +1,353 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file profiling.cpp
+ * \brief Self-profiling harness of the generated scripts.
+ */
+
+#include "profiling.h"
+
+Profiling::Profiling(const std::string &scenarioName, const std::string &outputName)
+{
+  this->m_scenarioName = scenarioName;
+  this->m_outputName = outputName;
+  this->m_scheduler = "";
+}
+
+Profiling::~Profiling()
+{
+}
+
+std::string Profiling::GetOutputName()
+{
+  return this->m_outputName;
+}
+
+void Profiling::SetScheduler(const std::string &scheduler)
+{
+  this->m_scheduler = scheduler;
+}
+
+std::string Profiling::GetScheduler()
+{
+  return this->m_scheduler;
+}
+
+std::string Profiling::OutputNameFromFile(const std::string &fileName)
+{
+  std::string base = fileName;
+  std::string::size_type pos = base.find_last_of("/\\");
+  if(pos != std::string::npos)
+  {
+    base = base.substr(pos + 1);
+  }
+  pos = base.find_last_of('.');
+  if(pos != std::string::npos && pos != 0)
+  {
+    base = base.substr(0, pos);
+  }
+  if(base == "")
+  {
+    base = "scenario";
+  }
+  return base + "-profiling.json";
+}
+
+std::string Profiling::Escape(const std::string &str)
+{
+  std::string res;
+  for(size_t i = 0; i < str.size(); i++)
+  {
+    if(str.at(i) == '"' || str.at(i) == '\\')
+    {
+      res += '\\';
+    }
+    res += str.at(i);
+  }
+  return res;
+}
+
+std::string Profiling::EscapeJson(const std::string &str)
+{
+  static const char hex[] = "0123456789abcdef";
+  std::string res;
+  for(size_t i = 0; i < str.size(); i++)
+  {
+    unsigned char c = static_cast<unsigned char>(str.at(i));
+    if(c == '"' || c == '\\')
+    {
+      res += '\\';
+      res += str.at(i);
+    }
+    else if(c == '\n')
+    {
+      res += "\\n";
+    }
+    else if(c == '\t')
+    {
+      res += "\\t";
+    }
+    else if(c < 0x20)
+    {
+      res += "\\u00";
+      res += hex[c >> 4];
+      res += hex[c & 0xf];
+    }
+    else
+    {
+      res += str.at(i);
+    }
+  }
+  return res;
+}
+
+std::vector<std::string> Profiling::GenerateHeader()
+{
+  std::vector<std::string> headers;
+  headers.push_back("#include <chrono>");
+  headers.push_back("#include <fstream>");
+  headers.push_back("#include <iostream>");
+  headers.push_back("#include <string>");
+  headers.push_back("#include <utility>");
+  headers.push_back("#include <vector>");
+  headers.push_back("#include <sys/resource.h>");
+  headers.push_back("#include <unistd.h>");
+
+  return headers;
+}
+
+std::vector<std::string> Profiling::GenerateHelpersCpp()
+{
+  std::vector<std::string> helpers;
+
+  helpers.push_back("/* Self-profiling. */");
+  helpers.push_back("static std::chrono::steady_clock::time_point profilingMark = std::chrono::steady_clock::now ();");
+  helpers.push_back("static std::chrono::steady_clock::time_point profilingProgressMark = profilingMark;");
+  helpers.push_back("static uint64_t profilingProgressEvents = 0;");
+  helpers.push_back("static std::vector<std::pair<std::string, double> > profilingPhases;");
+  helpers.push_back("");
+  helpers.push_back("static double ProfilingSince (const std::chrono::steady_clock::time_point &mark)");
+  helpers.push_back("{");
+  helpers.push_back("  return std::chrono::duration<double> (std::chrono::steady_clock::now () - mark).count ();");
+  helpers.push_back("}");
+  helpers.push_back("");
+  helpers.push_back("static void ProfilingPhase (const std::string &phase)");
+  helpers.push_back("{");
+  helpers.push_back("  profilingPhases.push_back (std::make_pair (phase, ProfilingSince (profilingMark)));");
+  helpers.push_back(R"(  std::cout << "[profiling] " << phase << ": " << profilingPhases.back ().second << " s" << std::endl;)");
+  helpers.push_back("  profilingMark = std::chrono::steady_clock::now ();");
+  helpers.push_back("}");
+  helpers.push_back("");
+  helpers.push_back("static long ProfilingRss ()");
+  helpers.push_back("{");
+  helpers.push_back("  long size = 0;");
+  helpers.push_back("  long resident = 0;");
+  helpers.push_back(R"(  std::ifstream statm ("/proc/self/statm");)");
+  helpers.push_back("  if (!(statm >> size >> resident))");
+  helpers.push_back("    {");
+  helpers.push_back("      return 0;");
+  helpers.push_back("    }");
+  helpers.push_back("  return resident * (sysconf (_SC_PAGESIZE) / 1024);");
+  helpers.push_back("}");
+  helpers.push_back("");
+  helpers.push_back("static long ProfilingPeakRss ()");
+  helpers.push_back("{");
+  helpers.push_back("  struct rusage usage;");
+  helpers.push_back("  getrusage (RUSAGE_SELF, &usage);");
+  helpers.push_back("  return usage.ru_maxrss;");
+  helpers.push_back("}");
+  helpers.push_back("");
+  helpers.push_back("static void ProfilingProgress (Time interval)");
+  helpers.push_back("{");
+  helpers.push_back("  double wall = ProfilingSince (profilingProgressMark);");
+  helpers.push_back("  uint64_t events = Simulator::GetEventCount ();");
+  helpers.push_back("  double rate = wall > 0 ? (events - profilingProgressEvents) / wall : 0;");
+  helpers.push_back(R"(  std::cout << "[profiling] simulated " << Simulator::Now ().GetSeconds () << " s, " << rate << " events/s, rss " << ProfilingRss () << " kB" << std::endl;)");
+  helpers.push_back("  profilingProgressMark = std::chrono::steady_clock::now ();");
+  helpers.push_back("  profilingProgressEvents = events;");
+  helpers.push_back("  Simulator::Schedule (interval, &ProfilingProgress, interval);");
+  helpers.push_back("}");
+  helpers.push_back("");
+  helpers.push_back("static void ProfilingSummary (const std::string &fileName, const std::string &scenario, const std::string &scheduler, double runTime, uint64_t events, double simulated)");
+  helpers.push_back("{");
+  helpers.push_back("  std::ofstream out (fileName.c_str ());");
+  helpers.push_back(R"(  out << "{" << std::endl;)");
+  helpers.push_back(R"(  out << "  \"scenario\": \"" << scenario << "\"," << std::endl;)");
+  helpers.push_back(R"(  out << "  \"scheduler\": \"" << scheduler << "\"," << std::endl;)");
+  helpers.push_back(R"(  out << "  \"phases\": {" << std::endl;)");
+  helpers.push_back("  for (size_t i = 0; i < profilingPhases.size (); i++)");
+  helpers.push_back("    {");
+  helpers.push_back(R"(      out << "    \"" << profilingPhases[i].first << "\": " << profilingPhases[i].second;)");
+  helpers.push_back(R"(      out << (i + 1 < profilingPhases.size () ? "," : "") << std::endl;)");
+  helpers.push_back("    }");
+  helpers.push_back(R"(  out << "  }," << std::endl;)");
+  helpers.push_back(R"(  out << "  \"runSeconds\": " << runTime << "," << std::endl;)");
+  helpers.push_back(R"(  out << "  \"events\": " << events << "," << std::endl;)");
+  helpers.push_back(R"(  out << "  \"eventsPerSecond\": " << (runTime > 0 ? events / runTime : 0) << "," << std::endl;)");
+  helpers.push_back(R"(  out << "  \"simulatedSeconds\": " << simulated << "," << std::endl;)");
+  helpers.push_back(R"(  out << "  \"peakRssKb\": " << ProfilingPeakRss () << std::endl;)");
+  helpers.push_back(R"(  out << "}" << std::endl;)");
+  helpers.push_back(R"(  std::cout << "[profiling] summary written to " << fileName << std::endl;)");
+  helpers.push_back("}");
+
+  return helpers;
+}
+
+std::vector<std::string> Profiling::GenerateVarsCpp()
+{
+  std::vector<std::string> vars;
+  vars.push_back("double profilingInterval = 1.0;");
+  vars.push_back("std::string profilingOutput = \"" + Profiling::Escape(this->m_outputName) + "\";");
+  return vars;
+}
+
+std::vector<std::string> Profiling::GenerateCmdLineCpp()
+{
+  std::vector<std::string> cmdLine;
+  cmdLine.push_back("cmd.AddValue (\"profilingInterval\", \"Simulated seconds between two progress reports\", profilingInterval);");
+  cmdLine.push_back("cmd.AddValue (\"profilingOutput\", \"Performance summary file\", profilingOutput);");
+  return cmdLine;
+}
+
+std::vector<std::string> Profiling::GeneratePhaseCpp(const std::string &phase)
+{
+  std::vector<std::string> res;
+  res.push_back("ProfilingPhase (\"" + Profiling::Escape(phase) + "\");");
+  return res;
+}
+
+std::vector<std::string> Profiling::GenerateRunCpp()
+{
+  std::vector<std::string> run;
+  run.push_back("profilingProgressMark = std::chrono::steady_clock::now ();");
+  run.push_back("Simulator::Schedule (Seconds (profilingInterval), &ProfilingProgress, Seconds (profilingInterval));");
+  run.push_back("std::chrono::steady_clock::time_point profilingRunStart = std::chrono::steady_clock::now ();");
+  run.push_back("Simulator::Run ();");
+  run.push_back("double profilingRunTime = ProfilingSince (profilingRunStart);");
+  run.push_back("uint64_t profilingEvents = Simulator::GetEventCount ();");
+  run.push_back("double profilingSimulated = Simulator::Now ().GetSeconds ();");
+  run.push_back("ProfilingPhase (\"run\");");
+  run.push_back("Simulator::Destroy ();");
+  run.push_back("ProfilingPhase (\"destroy\");");
+  /* the summary helper writes the names into the JSON file as they are. */
+  run.push_back("ProfilingSummary (profilingOutput, \"" + Profiling::Escape(Profiling::EscapeJson(this->m_scenarioName)) + "\", \""
+      + Profiling::Escape(Profiling::EscapeJson(this->SchedulerLabel())) + "\", profilingRunTime, profilingEvents, profilingSimulated);");
+  return run;
+}
+
+std::vector<std::string> Profiling::GenerateHelpersPython()
+{
+  std::vector<std::string> helpers;
+
+  helpers.push_back("import collections");
+  helpers.push_back("import json");
+  helpers.push_back("import resource");
+  helpers.push_back("import time");
+  helpers.push_back("");
+  helpers.push_back("# Self-profiling.");
+  helpers.push_back("profilingState = {'mark': time.time(), 'progressMark': time.time(), 'progressEvents': 0, 'phases': []}");
+  helpers.push_back("");
+  helpers.push_back("def ProfilingPhase(phase):");
+  helpers.push_back("    now = time.time()");
+  helpers.push_back("    profilingState['phases'].append((phase, now - profilingState['mark']))");
+  helpers.push_back("    print(\"[profiling] %s: %f s\" % (phase, now - profilingState['mark']))");
+  helpers.push_back("    profilingState['mark'] = now");
+  helpers.push_back("");
+  helpers.push_back("def ProfilingRss():");
+  helpers.push_back("    try:");
+  helpers.push_back("        with open('/proc/self/statm') as statm:");
+  helpers.push_back("            return int(statm.read().split()[1]) * resource.getpagesize() // 1024");
+  helpers.push_back("    except (IOError, IndexError, ValueError):");
+  helpers.push_back("        return 0");
+  helpers.push_back("");
+  helpers.push_back("def ProfilingProgress(interval):");
+  helpers.push_back("    now = time.time()");
+  helpers.push_back("    events = ns3.Simulator.GetEventCount()");
+  helpers.push_back("    wall = now - profilingState['progressMark']");
+  helpers.push_back("    rate = (events - profilingState['progressEvents']) / wall if wall > 0 else 0");
+  helpers.push_back("    print(\"[profiling] simulated %f s, %f events/s, rss %d kB\" % (ns3.Simulator.Now().GetSeconds(), rate, ProfilingRss()))");
+  helpers.push_back("    profilingState['progressMark'] = now");
+  helpers.push_back("    profilingState['progressEvents'] = events");
+  helpers.push_back("    ns3.Simulator.Schedule(ns3.Seconds(interval), ProfilingProgress, interval)");
+  helpers.push_back("");
+  helpers.push_back("def ProfilingSummary(fileName, scenario, scheduler, runTime, events, simulated):");
+  helpers.push_back("    summary = collections.OrderedDict()");
+  helpers.push_back("    summary['scenario'] = scenario");
+  helpers.push_back("    summary['scheduler'] = scheduler");
+  helpers.push_back("    summary['phases'] = collections.OrderedDict(profilingState['phases'])");
+  helpers.push_back("    summary['runSeconds'] = runTime");
+  helpers.push_back("    summary['events'] = events");
+  helpers.push_back("    summary['eventsPerSecond'] = events / runTime if runTime > 0 else 0");
+  helpers.push_back("    summary['simulatedSeconds'] = simulated");
+  helpers.push_back("    summary['peakRssKb'] = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss");
+  helpers.push_back("    with open(fileName, 'w') as out:");
+  helpers.push_back("        json.dump(summary, out, indent=2)");
+  helpers.push_back("    print(\"[profiling] summary written to %s\" % fileName)");
+
+  return helpers;
+}
+
+std::vector<std::string> Profiling::GenerateVarsPython()
+{
+  std::vector<std::string> vars;
+  vars.push_back("profilingInterval = 1.0");
+  vars.push_back("profilingOutput = \"" + Profiling::Escape(this->m_outputName) + "\"");
+  return vars;
+}
+
+std::vector<std::string> Profiling::GenerateCmdLinePython()
+{
+  std::vector<std::string> cmdLine;
+  cmdLine.push_back("cmd.AddValue(\"profilingInterval\", \"Simulated seconds between two progress reports\", profilingInterval)");
+  cmdLine.push_back("cmd.AddValue(\"profilingOutput\", \"Performance summary file\", profilingOutput)");
+  return cmdLine;
+}
+
+std::vector<std::string> Profiling::GeneratePhasePython(const std::string &phase)
+{
+  std::vector<std::string> res;
+  res.push_back("ProfilingPhase(\"" + Profiling::Escape(phase) + "\")");
+  return res;
+}
+
+std::vector<std::string> Profiling::GenerateRunPython()
+{
+  std::vector<std::string> run;
+  run.push_back("profilingState['progressMark'] = time.time()");
+  run.push_back("ns3.Simulator.Schedule(ns3.Seconds(profilingInterval), ProfilingProgress, profilingInterval)");
+  run.push_back("profilingRunStart = time.time()");
+  run.push_back("ns3.Simulator.Run()");
+  run.push_back("profilingRunTime = time.time() - profilingRunStart");
+  run.push_back("profilingEvents = ns3.Simulator.GetEventCount()");
+  run.push_back("profilingSimulated = ns3.Simulator.Now().GetSeconds()");
+  run.push_back("ProfilingPhase(\"run\")");
+  run.push_back("ns3.Simulator.Destroy()");
+  run.push_back("ProfilingPhase(\"destroy\")");
+  run.push_back("ProfilingSummary(profilingOutput, \"" + Profiling::Escape(this->m_scenarioName) + "\", \"" + Profiling::Escape(this->SchedulerLabel()) + "\", profilingRunTime, profilingEvents, profilingSimulated)");
+  return run;
+}
+
+std::string Profiling::SchedulerLabel()
+{
+  if(this->m_scheduler == "")
+  {
+    return "Default";
+  }
+  return this->m_scheduler;
+}
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file profiling.h
+ * \brief Self-profiling harness of the generated scripts.
+ */
+
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Self-profiling harness of the generated scripts.
+ *
+ *  The profiling class generates the code which times the generated simulation.
+ *  When it is enabled on the Generator, the setup blocks (nodes, links, IP stack,
+ *  routes, applications, ...) are wrapped by wall-clock timers, the simulated-time
+ *  progress, the events per second and the resident memory are printed periodically
+ *  and a JSON summary is written at the end of the simulation.
+ *
+ *  Usage:
+ *    - enable it with Generator::SetProfiling(true),
+ *    - run the generated script,
+ *    - read the "<script>-profiling.json" file written next to the pcap outputs.
+ */
+class Profiling
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param scenarioName scenario name written into the summary
+     * \param outputName default summary file name
+     */
+    Profiling(const std::string &scenarioName, const std::string &outputName);
+
+    /**
+     * \brief Destructor.
+     */
+    ~Profiling();
+
+    /**
+     * \brief Generate the headers code.
+     * \return headers code
+     */
+    std::vector<std::string> GenerateHeader();
+
+    /**
+     * \brief Generate the helpers C++ code (placed before main).
+     * \return helpers code
+     */
+    std::vector<std::string> GenerateHelpersCpp();
+
+    /**
+     * \brief Generate vars C++ code.
+     * \return vars code
+     */
+    std::vector<std::string> GenerateVarsCpp();
+
+    /**
+     * \brief Generate cmd line C++ code.
+     * \return cmd line code
+     */
+    std::vector<std::string> GenerateCmdLineCpp();
+
+    /**
+     * \brief Generate the C++ code which closes a setup phase.
+     * \param phase phase name
+     * \return phase code
+     */
+    std::vector<std::string> GeneratePhaseCpp(const std::string &phase);
+
+    /**
+     * \brief Generate the C++ code which runs and measures the simulation.
+     * \return run code
+     */
+    std::vector<std::string> GenerateRunCpp();
+
+    /**
+     * \brief Generate the helpers python code (placed before main).
+     * \return helpers code
+     */
+    std::vector<std::string> GenerateHelpersPython();
+
+    /**
+     * \brief Generate vars python code.
+     * \return vars code
+     */
+    std::vector<std::string> GenerateVarsPython();
+
+    /**
+     * \brief Generate cmd line python code.
+     * \return cmd line code
+     */
+    std::vector<std::string> GenerateCmdLinePython();
+
+    /**
+     * \brief Generate the python code which closes a setup phase.
+     * \param phase phase name
+     * \return phase code
+     */
+    std::vector<std::string> GeneratePhasePython(const std::string &phase);
+
+    /**
+     * \brief Generate the python code which runs and measures the simulation.
+     * \return run code
+     */
+    std::vector<std::string> GenerateRunPython();
+
+    /**
+     * \brief Get the default summary file name.
+     * \return summary file name
+     */
+    std::string GetOutputName();
+
+    /**
+     * \brief Set the scheduler name written into the summary.
+     * \param scheduler scheduler name (empty for the ns-3 default)
+     */
+    void SetScheduler(const std::string &scheduler);
+
+    /**
+     * \brief Get the scheduler name written into the summary.
+     * \return scheduler name
+     */
+    std::string GetScheduler();
+
+    /**
+     * \brief Build the default summary file name from a generated file name.
+     *
+     * "dir/scenario.cc" gives "scenario-profiling.json".
+     *
+     * \param fileName generated file name (may be empty)
+     * \return summary file name
+     */
+    static std::string OutputNameFromFile(const std::string &fileName);
+
+    /**
+     * \brief Escape a string to be written into a generated string literal.
+     * \param str string to escape
+     * \return escaped string
+     */
+    static std::string Escape(const std::string &str);
+
+    /**
+     * \brief Escape a string to be written into a JSON string.
+     * \param str string to escape
+     * \return escaped string
+     */
+    static std::string EscapeJson(const std::string &str);
+
+  private:
+    /**
+     * \brief Scenario name.
+     */
+    std::string m_scenarioName;
+
+    /**
+     * \brief Default summary file name.
+     */
+    std::string m_outputName;
+
+    /**
+     * \brief Scheduler name.
+     */
+    std::string m_scheduler;
+
+    /**
+     * \brief Get the scheduler label written into the summary.
+     * \return scheduler name, or "Default" if none is set
+     */
+    std::string SchedulerLabel();
+};
+
+#endif /* PROFILING_H */
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file program.cpp
+ * \brief Intermediate representation of the generated scenario.
+ */
+
+#include <stdexcept>
+
+#include "program.h"
+
+Program::Program() : m_sections(SECTIONS), m_objects(OBJECT_KINDS)
+{
+}
+
+Program::~Program()
+{
+}
+
+void Program::Add(const Section &section, const ObjectKind &kind, const std::string &owner, const std::vector<Statement> &statements)
+{
+  if(statements.size() == 0)
+  {
+    return;
+  }
+  Block block;
+  block.kind = kind;
+  block.owner = owner;
+  block.statements = statements;
+  this->GetBlocks(section).push_back(block);
+}
+
+std::vector<Program::Block>& Program::GetBlocks(const Section &section)
+{
+  if(section >= SECTIONS)
+  {
+    throw std::out_of_range("Get blocks failed! (unknown section).");
+  }
+  return this->m_sections.at(section);
+}
+
+const std::vector<Program::Block>& Program::GetBlocks(const Section &section) const
+{
+  if(section >= SECTIONS)
+  {
+    throw std::out_of_range("Get blocks failed! (unknown section).");
+  }
+  return this->m_sections.at(section);
+}
+
+std::vector<Statement> Program::GetStatements(const Section &section) const
+{
+  std::vector<Statement> statements;
+  const std::vector<Block> &blocks = this->GetBlocks(section);
+  for(size_t i = 0; i < blocks.size(); i++)
+  {
+    statements.insert(statements.end(), blocks.at(i).statements.begin(), blocks.at(i).statements.end());
+  }
+  return statements;
+}
+
+size_t Program::Remove(const ObjectKind &kind, const std::string &owner)
+{
+  size_t removed = 0;
+  for(size_t i = 0; i < this->m_sections.size(); i++)
+  {
+    std::vector<Block> &blocks = this->m_sections.at(i);
+    size_t kept = 0;
+    for(size_t j = 0; j < blocks.size(); j++)
+    {
+      if(blocks.at(j).kind == kind && blocks.at(j).owner == owner)
+      {
+        removed++;
+        continue;
+      }
+      if(kept != j)
+      {
+        blocks.at(kept) = blocks.at(j);
+      }
+      kept++;
+    }
+    blocks.resize(kept);
+  }
+
+  std::vector<Object> &objects = this->m_objects.at(kind);
+  for(size_t i = 0; i < objects.size(); i++)
+  {
+    if(objects.at(i).name == owner)
+    {
+      objects.erase(objects.begin() + i);
+      break;
+    }
+  }
+  return removed;
+}
+
+void Program::AddObject(const ObjectKind &kind, const std::string &name, const std::vector<std::string> &members,
+    const std::vector<std::string> &uses, const bool &external)
+{
+  if(kind >= OBJECT_KINDS)
+  {
+    throw std::out_of_range("Add object failed! (unknown object kind).");
+  }
+  Object object;
+  object.name = name;
+  object.members = members;
+  object.uses = uses;
+  object.external = external;
+  this->m_objects.at(kind).push_back(object);
+}
+
+const std::vector<Program::Object>& Program::GetObjects(const ObjectKind &kind) const
+{
+  if(kind >= OBJECT_KINDS)
+  {
+    throw std::out_of_range("Get objects failed! (unknown object kind).");
+  }
+  return this->m_objects.at(kind);
+}
+
+void Program::Rename(const std::string &from, const std::string &to)
+{
+  for(size_t i = 0; i < this->m_sections.size(); i++)
+  {
+    std::vector<Block> &blocks = this->m_sections.at(i);
+    for(size_t j = 0; j < blocks.size(); j++)
+    {
+      for(size_t k = 0; k < blocks.at(j).statements.size(); k++)
+      {
+        blocks.at(j).statements.at(k).Rename(from, to);
+      }
+    }
+  }
+}
+
+std::string Program::GetSectionName(const Section &section)
+{
+  switch(section)
+  {
+    case VARS:
+      return "vars";
+    case CMD_LINE:
+      return "cmdLine";
+    case NODES:
+      return "nodes";
+    case LINKS:
+      return "links";
+    case NET_DEVICES:
+      return "netDevices";
+    case IP_STACK:
+      return "ipStack";
+    case IP_ASSIGN:
+      return "ipAssign";
+    case TAP_BRIDGE:
+      return "tapBridge";
+    case APPLICATIONS:
+      return "applications";
+    case TRACES:
+      return "traces";
+    default:
+      throw std::out_of_range("Get section name failed! (unknown section).");
+  }
+}
@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file program.h
+ * \brief Intermediate representation of the generated scenario.
+ */
+
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <string>
+#include <vector>
+
+#include "statement.h"
+
+/**
+ * \ingroup generator
+ * \brief Intermediate representation of the generated scenario.
+ *
+ *  The program is the code description of the whole scenario, between the
+ *  Generator model and the backends. Its sections are the kinds of code of a
+ *  scenario (declarations, helper configurations, installs, address
+ *  assignments, application schedules, ...) and each section is a list of
+ *  blocks, one per object, in the order of the generated code. The objects
+ *  themselves are listed with the objects they depend on, a pass can follow
+ *  which link or application uses a node.
+ *
+ *  The passes of a PassManager transform the program before it is rendered,
+ *  an optimisation written as a pass applies to every backend.
+ */
+class Program
+{
+  public:
+    /**
+     * \brief Sections of the program, in the order of the generated code.
+     */
+    enum Section
+    {
+      VARS = 0,         /*!< scenario variables */
+      CMD_LINE,         /*!< command line options */
+      NODES,            /*!< node declarations */
+      LINKS,            /*!< link helper configurations */
+      NET_DEVICES,      /*!< net device installs */
+      IP_STACK,         /*!< IP stack installs */
+      IP_ASSIGN,        /*!< address assignments */
+      TAP_BRIDGE,       /*!< tap bridge installs */
+      APPLICATIONS,     /*!< application installs and schedules */
+      TRACES,           /*!< pcap traces */
+      SECTIONS          /*!< number of sections */
+    };
+
+    /**
+     * \brief Kinds of the scenario objects.
+     */
+    enum ObjectKind
+    {
+      OBJECT_NODE = 0,      /*!< node or node group */
+      OBJECT_LINK,          /*!< link */
+      OBJECT_APPLICATION,   /*!< application */
+      OBJECT_KINDS          /*!< number of object kinds */
+    };
+
+    /**
+     * \brief Code of an object in a section.
+     */
+    struct Block
+    {
+      /**
+       * \brief Kind of the object, a node and a link can share a name (emu_0).
+       */
+      ObjectKind kind;
+
+      /**
+       * \brief Name of the object (node, link or application name).
+       */
+      std::string owner;
+
+      /**
+       * \brief Statements of the object.
+       */
+      std::vector<Statement> statements;
+    };
+
+    /**
+     * \brief Scenario object and the objects its code depends on.
+     */
+    struct Object
+    {
+      /**
+       * \brief Name of the object, owner of its blocks.
+       */
+      std::string name;
+
+      /**
+       * \brief Endpoints of the object (nodes of a link, sender and receiver of an application).
+       */
+      std::vector<std::string> members;
+
+      /**
+       * \brief Other objects used by the code of the object (bridge node, receiver link).
+       */
+      std::vector<std::string> uses;
+
+      /**
+       * \brief If the link joins its node to the host (emu, tap), one member is enough.
+       */
+      bool external;
+    };
+
+    /**
+     * \brief Constructor.
+     */
+    Program();
+
+    /**
+     * \brief Destructor.
+     */
+    ~Program();
+
+    /**
+     * \brief Add the code of an object at the end of a section.
+     *
+     *  Nothing is added if there is no statement.
+     *
+     * \param section section
+     * \param kind object kind
+     * \param owner object name
+     * \param statements object statements
+     */
+    void Add(const Section &section, const ObjectKind &kind, const std::string &owner, const std::vector<Statement> &statements);
+
+    /**
+     * \brief Get the blocks of a section.
+     * \param section section
+     * \return blocks
+     */
+    std::vector<Block>& GetBlocks(const Section &section);
+
+    /**
+     * \brief Get the blocks of a section.
+     * \param section section
+     * \return blocks
+     */
+    const std::vector<Block>& GetBlocks(const Section &section) const;
+
+    /**
+     * \brief Get the statements of a section.
+     * \param section section
+     * \return statements of all the blocks
+     */
+    std::vector<Statement> GetStatements(const Section &section) const;
+
+    /**
+     * \brief Remove an object and all its code.
+     * \param kind object kind
+     * \param owner object name
+     * \return number of removed blocks
+     */
+    size_t Remove(const ObjectKind &kind, const std::string &owner);
+
+    /**
+     * \brief Add a scenario object.
+     * \param kind object kind
+     * \param name object name
+     * \param members object endpoints
+     * \param uses other objects used by the object
+     * \param external if the link joins its node to the host
+     */
+    void AddObject(const ObjectKind &kind, const std::string &name, const std::vector<std::string> &members,
+        const std::vector<std::string> &uses, const bool &external = false);
+
+    /**
+     * \brief Get the scenario objects of a kind.
+     * \param kind object kind
+     * \return objects, in the order they are added
+     */
+    const std::vector<Object>& GetObjects(const ObjectKind &kind) const;
+
+    /**
+     * \brief Rename a variable in all the sections.
+     * \param from variable name
+     * \param to new variable name
+     */
+    void Rename(const std::string &from, const std::string &to);
+
+    /**
+     * \brief Get the phase name of a section ("nodes", "ipAssign", ...).
+     * \param section section
+     * \return phase name
+     */
+    static std::string GetSectionName(const Section &section);
+
+  private:
+    /**
+     * \brief Blocks of each section.
+     */
+    std::vector<std::vector<Block> > m_sections;
+
+    /**
+     * \brief Objects of each kind.
+     */
+    std::vector<std::vector<Object> > m_objects;
+};
+
+#endif /* PROGRAM_H */
@@ -0,0 +1,572 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file project-file.cpp
+ * \brief Binary project file.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "project-file.h"
+#include "compressed-file.h"
+#include "utils.h"
+
+/**
+ * \brief Project file format version.
+ */
+static const uint32_t VERSION = 1;
+
+/**
+ * \brief Header size (magic, version, flags, scheduler and 7 counts).
+ */
+static const size_t HEADER_SIZE = 44;
+
+/**
+ * \brief Number of the node columns.
+ */
+static const size_t NODE_COLUMNS = 6;
+
+/**
+ * \brief Number of the link columns (without the member offsets).
+ */
+static const size_t LINK_COLUMNS = 6;
+
+/**
+ * \brief Number of the application columns.
+ */
+static const size_t APP_COLUMNS = 10;
+
+/**
+ * \brief Number of the line columns.
+ */
+static const size_t LINE_COLUMNS = 3;
+
+/**
+ * \brief Header flag of the parameterized state.
+ */
+static const uint32_t FLAG_PARAMETERIZED = 1;
+
+/**
+ * \brief Link flag of the hidden state.
+ */
+static const uint32_t FLAG_HIDDEN = 1;
+
+/**
+ * \brief Link flag of the trace state.
+ */
+static const uint32_t FLAG_TRACE = 2;
+
+/**
+ * \brief Link flag of the promiscuous trace state.
+ */
+static const uint32_t FLAG_PROMISC = 4;
+
+ProjectFile::ProjectFile()
+{
+  this->m_flags = 0;
+  this->m_nodeColumns.resize(NODE_COLUMNS);
+  this->m_linkColumns.resize(LINK_COLUMNS);
+  this->m_linkMembers.push_back(0);
+  this->m_appColumns.resize(APP_COLUMNS);
+  this->m_lineColumns.resize(LINE_COLUMNS);
+  this->m_data = NULL;
+  this->m_size = 0;
+
+  /* the string 0 is the empty string. */
+  this->AddString("");
+  this->m_scheduler = 0;
+}
+
+ProjectFile::~ProjectFile()
+{
+  this->Close();
+}
+
+void ProjectFile::SetScheduler(const std::string &scheduler)
+{
+  this->CheckWritable();
+  this->m_scheduler = this->AddString(scheduler);
+}
+
+void ProjectFile::SetParameterized(const bool &state)
+{
+  this->CheckWritable();
+  this->m_flags = state ? (this->m_flags | FLAG_PARAMETERIZED) : (this->m_flags & ~FLAG_PARAMETERIZED);
+}
+
+void ProjectFile::AddNode(const Node &node)
+{
+  this->CheckWritable();
+  this->m_nodeColumns.at(0).push_back(this->AddString(node.type));
+  this->m_nodeColumns.at(1).push_back(this->AddString(node.name));
+  this->m_nodeColumns.at(2).push_back(this->AddString(node.nsc));
+  this->m_nodeColumns.at(3).push_back(node.number);
+  this->m_nodeColumns.at(4).push_back(node.x);
+  this->m_nodeColumns.at(5).push_back(node.y);
+}
+
+void ProjectFile::AddLink(const Link &link)
+{
+  this->CheckWritable();
+  uint32_t flags = (link.hidden ? FLAG_HIDDEN : 0) | (link.trace ? FLAG_TRACE : 0) | (link.promisc ? FLAG_PROMISC : 0);
+  this->m_linkColumns.at(0).push_back(flags);
+  this->m_linkColumns.at(1).push_back(this->AddString(link.type));
+  this->m_linkColumns.at(2).push_back(this->AddString(link.name));
+  this->m_linkColumns.at(3).push_back(this->AddString(link.dataRate));
+  this->m_linkColumns.at(4).push_back(this->AddString(link.delay));
+  this->m_linkColumns.at(5).push_back(this->AddString(link.special));
+  for(size_t i = 0; i < link.members.size(); i++)
+  {
+    this->m_memberName.push_back(this->AddString(link.members.at(i)));
+  }
+  this->m_linkMembers.push_back(this->m_memberName.size());
+}
+
+void ProjectFile::AddApplication(const Application &application)
+{
+  this->CheckWritable();
+  this->m_appColumns.at(0).push_back(this->AddString(application.type));
+  this->m_appColumns.at(1).push_back(this->AddString(application.name));
+  this->m_appColumns.at(2).push_back(this->AddString(application.sender));
+  this->m_appColumns.at(3).push_back(this->AddString(application.receiver));
+  this->m_appColumns.at(4).push_back(this->AddString(application.startTime));
+  this->m_appColumns.at(5).push_back(this->AddString(application.endTime));
+  this->m_appColumns.at(6).push_back(application.port);
+  this->m_appColumns.at(7).push_back(application.packetSize);
+  this->m_appColumns.at(8).push_back(application.maxPacketCount);
+  this->m_appColumns.at(9).push_back(this->AddString(application.packetIntervalTime));
+}
+
+void ProjectFile::AddLine(const Line &line)
+{
+  this->CheckWritable();
+  this->m_lineColumns.at(0).push_back(this->AddString(line.first));
+  this->m_lineColumns.at(1).push_back(this->AddString(line.second));
+  this->m_lineColumns.at(2).push_back(this->AddString(line.type));
+}
+
+void ProjectFile::Write(const std::string &fileName, const std::string &codec)
+{
+  if(codec == "")
+  {
+    std::ofstream out(fileName.c_str(), std::ios::binary);
+    if(!out.is_open())
+    {
+      throw std::runtime_error("Write project failed! (" + fileName + ") can not be opened.");
+    }
+    this->WriteTo(out, fileName);
+    return;
+  }
+
+  /* the columns are built in memory, then compressed by blocks. */
+  std::ostringstream out;
+  this->WriteTo(out, fileName);
+  CompressedFile file;
+  file.Create(fileName, codec);
+  file.Write(out.str());
+  file.Close();
+}
+
+void ProjectFile::WriteTo(std::ostream &out, const std::string &fileName)
+{
+  std::vector<uint32_t> offsets;
+  size_t bytes = 0;
+  offsets.push_back(0);
+  for(size_t i = 0; i < this->m_strings.size(); i++)
+  {
+    bytes += this->m_strings.at(i).size();
+    if(bytes > 0xffffffff)
+    {
+      throw std::runtime_error("Write project failed! (" + fileName + ") string table too large.");
+    }
+    offsets.push_back(bytes);
+  }
+
+  /* header */
+  out.write("NS3P", 4);
+  ProjectFile::WriteU32(out, VERSION);
+  ProjectFile::WriteU32(out, this->m_flags);
+  ProjectFile::WriteU32(out, this->m_scheduler);
+  ProjectFile::WriteU32(out, this->m_strings.size());
+  ProjectFile::WriteU32(out, bytes);
+  ProjectFile::WriteU32(out, this->m_nodeColumns.at(0).size());
+  ProjectFile::WriteU32(out, this->m_linkColumns.at(0).size());
+  ProjectFile::WriteU32(out, this->m_memberName.size());
+  ProjectFile::WriteU32(out, this->m_appColumns.at(0).size());
+  ProjectFile::WriteU32(out, this->m_lineColumns.at(0).size());
+
+  /* string table, padded so the columns stay aligned */
+  ProjectFile::WriteColumn(out, offsets);
+  for(size_t i = 0; i < this->m_strings.size(); i++)
+  {
+    out.write(this->m_strings.at(i).data(), this->m_strings.at(i).size());
+  }
+  out.write("\0\0\0", (4 - bytes % 4) % 4);
+
+  /* node, link, member, application and line tables */
+  for(size_t i = 0; i < NODE_COLUMNS; i++)
+  {
+    ProjectFile::WriteColumn(out, this->m_nodeColumns.at(i));
+  }
+  for(size_t i = 0; i < LINK_COLUMNS; i++)
+  {
+    ProjectFile::WriteColumn(out, this->m_linkColumns.at(i));
+  }
+  ProjectFile::WriteColumn(out, this->m_linkMembers);
+  ProjectFile::WriteColumn(out, this->m_memberName);
+  for(size_t i = 0; i < APP_COLUMNS; i++)
+  {
+    ProjectFile::WriteColumn(out, this->m_appColumns.at(i));
+  }
+  for(size_t i = 0; i < LINE_COLUMNS; i++)
+  {
+    ProjectFile::WriteColumn(out, this->m_lineColumns.at(i));
+  }
+
+  if(!out.good())
+  {
+    throw std::runtime_error("Write project failed! (" + fileName + ").");
+  }
+}
+
+void ProjectFile::Open(const std::string &fileName)
+{
+  this->Close();
+
+  if(CompressedFile::IsCompressed(fileName))
+  {
+    /* a compressed project can not be mapped, it is decompressed in memory. */
+    std::string content = CompressedFile::ReadFile(fileName);
+    this->m_buffer.assign(content.begin(), content.end());
+    this->m_size = this->m_buffer.size();
+    this->m_data = this->m_size > 0 ? &this->m_buffer[0] : NULL;
+  }
+  else
+  {
+    this->Map(fileName);
+  }
+
+  if(this->m_size < HEADER_SIZE || std::memcmp(this->m_data, "NS3P", 4) != 0)
+  {
+    this->Close();
+    throw std::logic_error("Open project failed! (" + fileName + ") is not a project file.");
+  }
+  if(this->ReadU32(4) != VERSION)
+  {
+    this->Close();
+    throw std::logic_error("Open project failed! (" + fileName + ") unknown version.");
+  }
+
+  this->m_counts.clear();
+  for(size_t i = 0; i < 7; i++)
+  {
+    this->m_counts.push_back(this->ReadU32(16 + 4 * i));
+  }
+  size_t strings = this->m_counts.at(0), bytes = this->m_counts.at(1);
+  size_t links = this->m_counts.at(3);
+
+  this->m_offsets.clear();
+  size_t offset = HEADER_SIZE;
+  this->m_offsets.push_back(offset);
+  offset += 4 * (strings + 1);
+  this->m_offsets.push_back(offset);
+  offset += bytes + (4 - bytes % 4) % 4;
+  this->m_offsets.push_back(offset);
+  offset += 4 * NODE_COLUMNS * this->m_counts.at(2);
+  this->m_offsets.push_back(offset);
+  offset += 4 * LINK_COLUMNS * links;
+  this->m_offsets.push_back(offset);
+  offset += 4 * (links + 1);
+  this->m_offsets.push_back(offset);
+  offset += 4 * this->m_counts.at(4);
+  this->m_offsets.push_back(offset);
+  offset += 4 * APP_COLUMNS * this->m_counts.at(5);
+  this->m_offsets.push_back(offset);
+  offset += 4 * LINE_COLUMNS * this->m_counts.at(6);
+
+  if(strings == 0 || offset != this->m_size)
+  {
+    this->Close();
+    throw std::logic_error("Open project failed! (" + fileName + ") truncated or corrupted.");
+  }
+}
+
+void ProjectFile::Map(const std::string &fileName)
+{
+#ifdef _WIN32
+  std::ifstream in(fileName.c_str(), std::ios::binary);
+  if(!in.is_open())
+  {
+    throw std::runtime_error("Open project failed! (" + fileName + ") can not be opened.");
+  }
+  this->m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  this->m_size = this->m_buffer.size();
+  this->m_data = this->m_size > 0 ? &this->m_buffer[0] : NULL;
+#else
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    throw std::runtime_error("Open project failed! (" + fileName + ") can not be opened.");
+  }
+  struct stat st;
+  if(fstat(fd, &st) != 0)
+  {
+    close(fd);
+    throw std::runtime_error("Open project failed! (" + fileName + ") can not be read.");
+  }
+  this->m_size = st.st_size;
+  if(this->m_size > 0)
+  {
+    void *map = mmap(NULL, this->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(map == MAP_FAILED)
+    {
+      close(fd);
+      this->m_size = 0;
+      throw std::runtime_error("Open project failed! (" + fileName + ") can not be mapped.");
+    }
+    this->m_data = static_cast<const unsigned char*>(map);
+  }
+  close(fd);
+#endif
+}
+
+void ProjectFile::Close()
+{
+#ifndef _WIN32
+  if(this->m_data && this->m_buffer.empty())
+  {
+    munmap(const_cast<unsigned char*>(this->m_data), this->m_size);
+  }
+#endif
+  this->m_buffer.clear();
+  this->m_data = NULL;
+  this->m_size = 0;
+  this->m_counts.clear();
+  this->m_offsets.clear();
+}
+
+std::string ProjectFile::GetScheduler() const
+{
+  this->CheckReadable(0, 1);
+  return this->ReadString(this->ReadU32(12));
+}
+
+bool ProjectFile::GetParameterized() const
+{
+  this->CheckReadable(0, 1);
+  return (this->ReadU32(8) & FLAG_PARAMETERIZED) != 0;
+}
+
+size_t ProjectFile::GetNNodes() const
+{
+  return this->m_data ? this->m_counts.at(2) : 0;
+}
+
+size_t ProjectFile::GetNLinks() const
+{
+  return this->m_data ? this->m_counts.at(3) : 0;
+}
+
+size_t ProjectFile::GetNApplications() const
+{
+  return this->m_data ? this->m_counts.at(5) : 0;
+}
+
+size_t ProjectFile::GetNLines() const
+{
+  return this->m_data ? this->m_counts.at(6) : 0;
+}
+
+ProjectFile::Node ProjectFile::GetNode(const size_t &index) const
+{
+  this->CheckReadable(index, this->GetNNodes());
+  size_t table = this->m_offsets.at(2), rows = this->GetNNodes();
+  Node node;
+  node.type = this->ReadString(this->ReadColumn(table, 0, rows, index));
+  node.name = this->ReadString(this->ReadColumn(table, 1, rows, index));
+  node.nsc = this->ReadString(this->ReadColumn(table, 2, rows, index));
+  node.number = this->ReadColumn(table, 3, rows, index);
+  node.x = this->ReadColumn(table, 4, rows, index);
+  node.y = this->ReadColumn(table, 5, rows, index);
+  return node;
+}
+
+ProjectFile::Link ProjectFile::GetLink(const size_t &index) const
+{
+  this->CheckReadable(index, this->GetNLinks());
+  size_t table = this->m_offsets.at(3), rows = this->GetNLinks();
+  Link link;
+  uint32_t flags = this->ReadColumn(table, 0, rows, index);
+  link.hidden = (flags & FLAG_HIDDEN) != 0;
+  link.trace = (flags & FLAG_TRACE) != 0;
+  link.promisc = (flags & FLAG_PROMISC) != 0;
+  link.type = this->ReadString(this->ReadColumn(table, 1, rows, index));
+  link.name = this->ReadString(this->ReadColumn(table, 2, rows, index));
+  link.dataRate = this->ReadString(this->ReadColumn(table, 3, rows, index));
+  link.delay = this->ReadString(this->ReadColumn(table, 4, rows, index));
+  link.special = this->ReadString(this->ReadColumn(table, 5, rows, index));
+
+  uint32_t begin = this->ReadU32(this->m_offsets.at(4) + 4 * index);
+  uint32_t end = this->ReadU32(this->m_offsets.at(4) + 4 * (index + 1));
+  if(begin > end || end > this->m_counts.at(4))
+  {
+    throw std::out_of_range("Read project failed! (link " + utils::integerToString(index) + " members).");
+  }
+  for(uint32_t i = begin; i < end; i++)
+  {
+    link.members.push_back(this->ReadString(this->ReadU32(this->m_offsets.at(5) + 4 * i)));
+  }
+  return link;
+}
+
+ProjectFile::Application ProjectFile::GetApplication(const size_t &index) const
+{
+  this->CheckReadable(index, this->GetNApplications());
+  size_t table = this->m_offsets.at(6), rows = this->GetNApplications();
+  Application application;
+  application.type = this->ReadString(this->ReadColumn(table, 0, rows, index));
+  application.name = this->ReadString(this->ReadColumn(table, 1, rows, index));
+  application.sender = this->ReadString(this->ReadColumn(table, 2, rows, index));
+  application.receiver = this->ReadString(this->ReadColumn(table, 3, rows, index));
+  application.startTime = this->ReadString(this->ReadColumn(table, 4, rows, index));
+  application.endTime = this->ReadString(this->ReadColumn(table, 5, rows, index));
+  application.port = this->ReadColumn(table, 6, rows, index);
+  application.packetSize = this->ReadColumn(table, 7, rows, index);
+  application.maxPacketCount = this->ReadColumn(table, 8, rows, index);
+  application.packetIntervalTime = this->ReadString(this->ReadColumn(table, 9, rows, index));
+  return application;
+}
+
+ProjectFile::Line ProjectFile::GetLine(const size_t &index) const
+{
+  this->CheckReadable(index, this->GetNLines());
+  size_t table = this->m_offsets.at(7), rows = this->GetNLines();
+  Line line;
+  line.first = this->ReadString(this->ReadColumn(table, 0, rows, index));
+  line.second = this->ReadString(this->ReadColumn(table, 1, rows, index));
+  line.type = this->ReadString(this->ReadColumn(table, 2, rows, index));
+  return line;
+}
+
+bool ProjectFile::IsProjectFile(const std::string &fileName)
+{
+  // the magic is checked after the decompression of a compressed project.
+  try
+  {
+    CompressedFile file;
+    file.Open(fileName);
+    char magic[4];
+    return file.Read(magic, 4) == 4 && std::memcmp(magic, "NS3P", 4) == 0;
+  }
+  catch(const std::exception &)
+  {
+    return false;
+  }
+}
+
+uint32_t ProjectFile::AddString(const std::string &str)
+{
+  std::map<std::string, uint32_t>::const_iterator it = this->m_stringIndex.find(str);
+  if(it != this->m_stringIndex.end())
+  {
+    return it->second;
+  }
+  uint32_t index = this->m_strings.size();
+  this->m_strings.push_back(str);
+  this->m_stringIndex[str] = index;
+  return index;
+}
+
+void ProjectFile::CheckWritable() const
+{
+  if(this->m_data)
+  {
+    throw std::logic_error("Add failed! (project file opened for reading).");
+  }
+}
+
+void ProjectFile::CheckReadable(const size_t &index, const size_t &count) const
+{
+  if(!this->m_data)
+  {
+    throw std::logic_error("Read project failed! (no project file opened).");
+  }
+  if(index >= count)
+  {
+    throw std::out_of_range("Read project failed! (index " + utils::integerToString(index) + " out of range).");
+  }
+}
+
+uint32_t ProjectFile::ReadU32(const size_t &offset) const
+{
+  const unsigned char *b = this->m_data + offset;
+  return b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<uint32_t>(b[3]) << 24);
+}
+
+uint32_t ProjectFile::ReadColumn(const size_t &table, const size_t &column, const size_t &rows, const size_t &index) const
+{
+  return this->ReadU32(table + 4 * (column * rows + index));
+}
+
+std::string ProjectFile::ReadString(const uint32_t &index) const
+{
+  if(index >= this->m_counts.at(0))
+  {
+    throw std::out_of_range("Read project failed! (string " + utils::integerToString(index) + " out of range).");
+  }
+  uint32_t begin = this->ReadU32(this->m_offsets.at(0) + 4 * index);
+  uint32_t end = this->ReadU32(this->m_offsets.at(0) + 4 * (index + 1));
+  if(begin > end || end > this->m_counts.at(1))
+  {
+    throw std::out_of_range("Read project failed! (string " + utils::integerToString(index) + " corrupted).");
+  }
+  const char *bytes = reinterpret_cast<const char*>(this->m_data + this->m_offsets.at(1));
+  return std::string(bytes + begin, end - begin);
+}
+
+void ProjectFile::WriteColumn(std::ostream &out, const std::vector<uint32_t> &column)
+{
+  for(size_t i = 0; i < column.size(); i++)
+  {
+    ProjectFile::WriteU32(out, column.at(i));
+  }
+}
+
+void ProjectFile::WriteU32(std::ostream &out, const uint32_t &value)
+{
+  char bytes[4];
+  for(size_t i = 0; i < 4; i++)
+  {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  out.write(bytes, 4);
+}
@@ -0,0 +1,517 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file project-file.h
+ * \brief Binary project file.
+ */
+
+#ifndef PROJECT_FILE_H
+#define PROJECT_FILE_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * \ingroup generator
+ * \brief Binary project file.
+ *
+ *  The binary project holds the same records as the xml save file (nodes with
+ *  their canvas position, links with their members, applications, canvas
+ *  lines and simulation settings), so a project converts between both formats
+ *  without loss. The tables are stored as fixed size columns and the file is
+ *  mapped in memory when opened: opening does not depend on the project size
+ *  and a record is only decoded when it is read.
+ *
+ *  File layout (all integers are 32 bits little endian):
+ *    - header: magic "NS3P", version, flags, scheduler, then the number of
+ *      strings, string bytes, nodes, links, members, applications and lines
+ *    - string table: offsets (count + 1 entries), then the bytes padded to 4
+ *    - node table: type, name, nsc, machines number, x and y columns
+ *    - link table: flags, type, name, data rate, delay, special and member
+ *      offset (count + 1 entries) columns
+ *    - member table: node name column (the link members in CSR form)
+ *    - application table: type, name, sender, receiver, start, end, port,
+ *      packet size, max packets and interval columns
+ *    - line table: first, second and type columns
+ *
+ *  Strings are referenced by their index into the string table, the index 0
+ *  is always the empty string.
+ */
+class ProjectFile
+{
+  public:
+    /**
+     * \brief Node record.
+     */
+    struct Node
+    {
+      /**
+       * \brief Node type ("Pc", "Router", ...).
+       */
+      std::string type;
+
+      /**
+       * \brief Node name.
+       */
+      std::string name;
+
+      /**
+       * \brief Nsc library.
+       */
+      std::string nsc;
+
+      /**
+       * \brief Number of machines.
+       */
+      size_t number;
+
+      /**
+       * \brief Canvas position.
+       */
+      size_t x;
+
+      /**
+       * \brief Canvas position.
+       */
+      size_t y;
+    };
+
+    /**
+     * \brief Link record.
+     */
+    struct Link
+    {
+      /**
+       * \brief Hidden on the canvas.
+       */
+      bool hidden;
+
+      /**
+       * \brief Link type ("Hub", "PointToPoint", ...).
+       */
+      std::string type;
+
+      /**
+       * \brief Link name.
+       */
+      std::string name;
+
+      /**
+       * \brief Data rate.
+       */
+      std::string dataRate;
+
+      /**
+       * \brief Delay.
+       */
+      std::string delay;
+
+      /**
+       * \brief Trace state.
+       */
+      bool trace;
+
+      /**
+       * \brief Promiscuous trace state.
+       */
+      bool promisc;
+
+      /**
+       * \brief Link special setting (ap mobility, emu/tap iface or "x-y" hub position).
+       */
+      std::string special;
+
+      /**
+       * \brief Installed node names.
+       */
+      std::vector<std::string> members;
+    };
+
+    /**
+     * \brief Application record.
+     */
+    struct Application
+    {
+      /**
+       * \brief Application type ("Ping", "UdpEcho", ...).
+       */
+      std::string type;
+
+      /**
+       * \brief Application name.
+       */
+      std::string name;
+
+      /**
+       * \brief Sender node.
+       */
+      std::string sender;
+
+      /**
+       * \brief Receiver node.
+       */
+      std::string receiver;
+
+      /**
+       * \brief Start time.
+       */
+      std::string startTime;
+
+      /**
+       * \brief End time.
+       */
+      std::string endTime;
+
+      /**
+       * \brief Port (0 if not used).
+       */
+      size_t port;
+
+      /**
+       * \brief Packet size (0 if not used).
+       */
+      size_t packetSize;
+
+      /**
+       * \brief Max packets (0 if not used).
+       */
+      size_t maxPacketCount;
+
+      /**
+       * \brief Packet interval (empty if not used).
+       */
+      std::string packetIntervalTime;
+    };
+
+    /**
+     * \brief Canvas line record.
+     */
+    struct Line
+    {
+      /**
+       * \brief First object.
+       */
+      std::string first;
+
+      /**
+       * \brief Second object.
+       */
+      std::string second;
+
+      /**
+       * \brief Link type.
+       */
+      std::string type;
+    };
+
+    /**
+     * \brief Constructor.
+     */
+    ProjectFile();
+
+    /**
+     * \brief Destructor.
+     */
+    ~ProjectFile();
+
+    /**
+     * \brief Set the event scheduler.
+     * \param scheduler scheduler name (empty for the ns-3 default)
+     */
+    void SetScheduler(const std::string &scheduler);
+
+    /**
+     * \brief Set the command line parameters state.
+     * \param state parameterized state
+     */
+    void SetParameterized(const bool &state);
+
+    /**
+     * \brief Add a node.
+     * \param node node record
+     */
+    void AddNode(const Node &node);
+
+    /**
+     * \brief Add a link.
+     * \param link link record
+     */
+    void AddLink(const Link &link);
+
+    /**
+     * \brief Add an application.
+     * \param application application record
+     */
+    void AddApplication(const Application &application);
+
+    /**
+     * \brief Add a canvas line.
+     * \param line line record
+     */
+    void AddLine(const Line &line);
+
+    /**
+     * \brief Write the added records into a project file.
+     * \param fileName project file name
+     * \param codec codec name of a compressed project (empty for a plain one)
+     */
+    void Write(const std::string &fileName, const std::string &codec = "");
+
+    /**
+     * \brief Open a project file for reading.
+     *
+     *  The file is mapped in memory and only its header is checked, the
+     *  records are decoded by the getters. A compressed project (see
+     *  CompressedFile) is decompressed in memory instead.
+     *
+     * \param fileName project file name
+     */
+    void Open(const std::string &fileName);
+
+    /**
+     * \brief Close the opened project file.
+     */
+    void Close();
+
+    /**
+     * \brief Get the event scheduler of the opened file.
+     * \return scheduler name
+     */
+    std::string GetScheduler() const;
+
+    /**
+     * \brief Get the command line parameters state of the opened file.
+     * \return parameterized state
+     */
+    bool GetParameterized() const;
+
+    /**
+     * \brief Get the number of nodes of the opened file.
+     * \return number of nodes
+     */
+    size_t GetNNodes() const;
+
+    /**
+     * \brief Get the number of links of the opened file.
+     * \return number of links
+     */
+    size_t GetNLinks() const;
+
+    /**
+     * \brief Get the number of applications of the opened file.
+     * \return number of applications
+     */
+    size_t GetNApplications() const;
+
+    /**
+     * \brief Get the number of canvas lines of the opened file.
+     * \return number of lines
+     */
+    size_t GetNLines() const;
+
+    /**
+     * \brief Read a node of the opened file.
+     * \param index node index
+     * \return node record
+     */
+    Node GetNode(const size_t &index) const;
+
+    /**
+     * \brief Read a link of the opened file.
+     * \param index link index
+     * \return link record
+     */
+    Link GetLink(const size_t &index) const;
+
+    /**
+     * \brief Read an application of the opened file.
+     * \param index application index
+     * \return application record
+     */
+    Application GetApplication(const size_t &index) const;
+
+    /**
+     * \brief Read a canvas line of the opened file.
+     * \param index line index
+     * \return line record
+     */
+    Line GetLine(const size_t &index) const;
+
+    /**
+     * \brief Check if a file is a binary project file.
+     * \param fileName file name
+     * \return true if the file starts with the project magic
+     */
+    static bool IsProjectFile(const std::string &fileName);
+
+  private:
+    /**
+     * \brief Header flags.
+     */
+    uint32_t m_flags;
+
+    /**
+     * \brief Scheduler string index.
+     */
+    uint32_t m_scheduler;
+
+    /**
+     * \brief String table.
+     */
+    std::vector<std::string> m_strings;
+
+    /**
+     * \brief String table index.
+     */
+    std::map<std::string, uint32_t> m_stringIndex;
+
+    /**
+     * \brief Node columns (type, name, nsc, machines number, x, y).
+     */
+    std::vector<std::vector<uint32_t> > m_nodeColumns;
+
+    /**
+     * \brief Link columns (flags, type, name, data rate, delay, special).
+     */
+    std::vector<std::vector<uint32_t> > m_linkColumns;
+
+    /**
+     * \brief Link first member column (one more entry than links).
+     */
+    std::vector<uint32_t> m_linkMembers;
+
+    /**
+     * \brief Member node name column.
+     */
+    std::vector<uint32_t> m_memberName;
+
+    /**
+     * \brief Application columns (type, name, sender, receiver, start, end,
+     * port, packet size, max packets, interval).
+     */
+    std::vector<std::vector<uint32_t> > m_appColumns;
+
+    /**
+     * \brief Line columns (first, second, type).
+     */
+    std::vector<std::vector<uint32_t> > m_lineColumns;
+
+    /**
+     * \brief Opened file content (NULL if no file is opened).
+     */
+    const unsigned char *m_data;
+
+    /**
+     * \brief Opened file size (in bytes).
+     */
+    size_t m_size;
+
+    /**
+     * \brief Opened file content when it can not be mapped.
+     */
+    std::vector<unsigned char> m_buffer;
+
+    /**
+     * \brief Header counts of the opened file (strings, string bytes, nodes,
+     * links, members, applications, lines).
+     */
+    std::vector<size_t> m_counts;
+
+    /**
+     * \brief Offsets of the tables into the opened file (string offsets,
+     * string bytes, nodes, links, link members, members, applications, lines).
+     */
+    std::vector<size_t> m_offsets;
+
+    /**
+     * \brief Add a string into the string table.
+     * \param str string to add
+     * \return string index (a string is stored only once)
+     */
+    uint32_t AddString(const std::string &str);
+
+    /**
+     * \brief Check that no file is opened before adding a record.
+     */
+    void CheckWritable() const;
+
+    /**
+     * \brief Check that a file is opened and a record index is valid.
+     * \param index record index
+     * \param count number of records of the table
+     */
+    void CheckReadable(const size_t &index, const size_t &count) const;
+
+    /**
+     * \brief Read a 32 bits integer of the opened file.
+     * \param offset byte offset
+     * \return value
+     */
+    uint32_t ReadU32(const size_t &offset) const;
+
+    /**
+     * \brief Read a column entry of the opened file.
+     * \param table table offset
+     * \param column column number into the table
+     * \param rows number of rows of the table
+     * \param index row index
+     * \return value
+     */
+    uint32_t ReadColumn(const size_t &table, const size_t &column, const size_t &rows, const size_t &index) const;
+
+    /**
+     * \brief Read a string of the opened file.
+     * \param index string index
+     * \return string
+     */
+    std::string ReadString(const uint32_t &index) const;
+
+    /**
+     * \brief Write the added records into a stream.
+     * \param out output stream
+     * \param fileName project file name (for the errors)
+     */
+    void WriteTo(std::ostream &out, const std::string &fileName);
+
+    /**
+     * \brief Map a plain project file in memory.
+     * \param fileName project file name
+     */
+    void Map(const std::string &fileName);
+
+    /**
+     * \brief Write a 32 bits column.
+     * \param out output stream
+     * \param column column to write
+     */
+    static void WriteColumn(std::ostream &out, const std::vector<uint32_t> &column);
+
+    /**
+     * \brief Write a 32 bits integer.
+     * \param out output stream
+     * \param value value to write
+     */
+    static void WriteU32(std::ostream &out, const uint32_t &value);
+};
+
+#endif /* PROJECT_FILE_H */
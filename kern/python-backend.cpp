@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file python-backend.cpp
+ * \brief Python backend.
+ */
+
+#include "python-backend.h"
+
+PythonBackend::~PythonBackend()
+{
+}
+
+std::string PythonBackend::GetName() const
+{
+  return "python";
+}
+
+std::string PythonBackend::GetIndent() const
+{
+  return "    ";
+}
+
+std::string PythonBackend::RenderExpression(const Expression &expression) const
+{
+  const std::string &name = expression.GetName();
+  switch(expression.GetKind())
+  {
+    case Expression::STRING:
+      return "\"" + name + "\"";
+    case Expression::BOOLEAN:
+      return name == "true" ? "True" : "False";
+    case Expression::REAL:
+      /* an integer number would be an int. */
+      if(name != "" && name.find_first_not_of("-0123456789") == std::string::npos)
+      {
+        return name + ".0";
+      }
+      return name;
+    case Expression::FUNCTION:
+    case Expression::CONVERT:
+      return "ns3." + name + "(" + this->RenderArgs(expression.GetArgs()) + ")";
+    case Expression::STATIC:
+      return "ns3." + name + "." + expression.GetMethod() + "(" + this->RenderArgs(expression.GetArgs()) + ")";
+    case Expression::METHOD:
+      return name + "." + expression.GetMethod() + "(" + this->RenderArgs(expression.GetArgs()) + ")";
+    case Expression::MAX:
+      if(expression.GetArgs().size() == 1)
+      {
+        return this->RenderExpression(expression.GetArgs().at(0));
+      }
+      return "max(" + this->RenderArgs(expression.GetArgs()) + ")";
+    default:
+      return name;
+  }
+}
+
+std::vector<std::string> PythonBackend::RenderStatement(const Statement &statement) const
+{
+  std::vector<std::string> lines;
+  switch(statement.GetKind())
+  {
+    case Statement::DECLARE:
+    case Statement::CONSTRUCT:
+    case Statement::DEFINE:
+    case Statement::ASSIGN:
+      lines.push_back(statement.GetName() + " = " + this->RenderExpression(statement.GetExpression()));
+      break;
+    case Statement::EVALUATE:
+      lines.push_back(this->RenderExpression(statement.GetExpression()));
+      break;
+    case Statement::LOOP:
+      lines.push_back("for " + statement.GetName() + " in range(" + this->RenderExpression(statement.GetExpression()) + "):");
+      this->RenderBody(statement.GetBody(), lines);
+      break;
+    case Statement::COMMENT:
+      lines.push_back("# " + statement.GetName());
+      break;
+    case Statement::VERBATIM:
+      lines.push_back(statement.GetName());
+      break;
+  }
+  return lines;
+}
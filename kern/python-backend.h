@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file python-backend.h
+ * \brief Python backend.
+ */
+
+#ifndef PYTHON_BACKEND_H
+#define PYTHON_BACKEND_H
+
+#include "backend.h"
+
+/**
+ * \ingroup generator
+ * \brief Python backend.
+ *
+ *  The ns-3 names are prefixed by the "ns3" module, the conversions of the
+ *  values are explicit and a variable is assigned instead of declared.
+ */
+class PythonBackend : public Backend
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~PythonBackend();
+
+    /**
+     * \brief Get the language name.
+     * \return "python"
+     */
+    virtual std::string GetName() const;
+
+    /**
+     * \brief Get the indentation of a block level.
+     * \return indentation
+     */
+    virtual std::string GetIndent() const;
+
+    /**
+     * \brief Render an expression.
+     * \param expression expression
+     * \return code
+     */
+    virtual std::string RenderExpression(const Expression &expression) const;
+
+    /**
+     * \brief Render a statement.
+     * \param statement statement
+     * \return code lines
+     */
+    virtual std::vector<std::string> RenderStatement(const Statement &statement) const;
+};
+
+#endif /* PYTHON_BACKEND_H */
@@ -0,0 +1,635 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file scenario-data.cpp
+ * \brief Columnar topology data file and its fixed ns-3 driver.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "scenario-data.h"
+#include "profiling.h"
+#include "utils.h"
+
+/**
+ * \brief Number of the 32 bits application columns.
+ */
+static const size_t APP_COLUMNS = 13;
+
+/**
+ * \brief Fixed driver code, "@TOPOLOGY@" is replaced by the default data file name
+ * and "@APP_COLUMNS@" by the number of application columns.
+ */
+static const char *DRIVER = R"DRIVER(#include "ns3/core-module.h"
+#include "ns3/global-route-manager.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/bridge-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/emu-module.h"
+#include "ns3/tap-bridge-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/v4ping-helper.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/* Data file reader (see scenario-data.h of the generator for the layout). */
+static std::ifstream topologyFile;
+
+static uint32_t ReadU32 ()
+{
+  unsigned char b[4];
+  if (!topologyFile.read (reinterpret_cast<char *> (b), 4))
+    {
+      NS_FATAL_ERROR ("Truncated topology file");
+    }
+  return b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<uint32_t> (b[3]) << 24);
+}
+
+static uint64_t ReadU64 ()
+{
+  uint64_t low = ReadU32 ();
+  uint64_t high = ReadU32 ();
+  return low | (high << 32);
+}
+
+static std::vector<uint32_t> ReadColumn (uint32_t n)
+{
+  std::vector<uint32_t> column (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      column[i] = ReadU32 ();
+    }
+  return column;
+}
+
+static const uint32_t NONE = 0xffffffff;
+
+int main(int argc, char *argv[])
+{
+  std::string topology = "@TOPOLOGY@";
+
+  CommandLine cmd;
+  cmd.AddValue ("topology", "Topology data file", topology);
+  cmd.Parse (argc, argv);
+
+  /* Read the topology. */
+  topologyFile.open (topology.c_str (), std::ios::binary);
+  char magic[4];
+  if (!topologyFile.read (magic, 4) || std::memcmp (magic, "NS3T", 4) != 0 || ReadU32 () != 1)
+    {
+      NS_FATAL_ERROR ("Bad topology file " << topology);
+    }
+  uint32_t flags = ReadU32 ();
+  uint32_t stopTime = ReadU32 ();
+  uint32_t scheduler = ReadU32 ();
+
+  std::vector<std::string> strings (ReadU32 ());
+  for (size_t i = 0; i < strings.size (); i++)
+    {
+      strings[i].resize (ReadU32 ());
+      if (strings[i].size () > 0)
+        {
+          topologyFile.read (&strings[i][0], strings[i].size ());
+        }
+    }
+
+  uint32_t nNodes = ReadU32 ();
+  std::vector<uint32_t> nodeName = ReadColumn (nNodes);
+  std::vector<uint32_t> nodeMachines = ReadColumn (nNodes);
+  std::vector<uint32_t> nodeNsc = ReadColumn (nNodes);
+  std::vector<uint32_t> nodeFlags = ReadColumn (nNodes);
+
+  uint32_t nLinks = ReadU32 ();
+  std::vector<uint32_t> linkKind = ReadColumn (nLinks);
+  std::vector<uint32_t> linkName = ReadColumn (nLinks);
+  std::vector<uint64_t> linkDataRate (nLinks);
+  for (uint32_t i = 0; i < nLinks; i++)
+    {
+      linkDataRate[i] = ReadU64 ();
+    }
+  std::vector<uint32_t> linkDelay = ReadColumn (nLinks);
+  std::vector<uint32_t> linkFlags = ReadColumn (nLinks);
+  std::vector<uint32_t> linkNode = ReadColumn (nLinks);
+  std::vector<uint32_t> linkIface = ReadColumn (nLinks);
+  std::vector<uint32_t> linkMembers = ReadColumn (nLinks + 1);
+
+  uint32_t nMembers = ReadU32 ();
+  std::vector<uint32_t> memberNode = ReadColumn (nMembers);
+  std::vector<uint32_t> memberSub = ReadColumn (nMembers);
+
+  uint32_t nApps = ReadU32 ();
+  std::vector<std::vector<uint32_t> > app (@APP_COLUMNS@);
+  for (size_t i = 0; i < app.size (); i++)
+    {
+      app[i] = ReadColumn (nApps);
+    }
+  std::vector<double> appInterval (nApps);
+  for (uint32_t i = 0; i < nApps; i++)
+    {
+      uint64_t bits = ReadU64 ();
+      std::memcpy (&appInterval[i], &bits, sizeof (double));
+    }
+  topologyFile.close ();
+
+  /* Configuration. */
+  if (flags & 1)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::RealtimeSimulatorImpl"));
+      GlobalValue::Bind ("ChecksumEnabled", BooleanValue (true));
+    }
+  if (strings[scheduler] != "")
+    {
+      ObjectFactory schedulerFactory;
+      schedulerFactory.SetTypeId ("ns3::" + strings[scheduler] + "Scheduler");
+      Simulator::SetScheduler (schedulerFactory);
+    }
+
+  /* Build nodes. */
+  std::vector<NodeContainer> nodes (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      nodes[i].Create (nodeMachines[i]);
+    }
+
+  /* Build links and net device containers. */
+  std::vector<NetDeviceContainer> ndc (nLinks);
+  std::vector<CsmaHelper> csma (nLinks);
+  std::vector<YansWifiPhyHelper> wifiPhy (nLinks);
+  for (uint32_t i = 0; i < nLinks; i++)
+    {
+      NodeContainer all;
+      for (uint32_t m = linkMembers[i]; m < linkMembers[i + 1]; m++)
+        {
+          if (memberSub[m] == NONE)
+            {
+              all.Add (nodes[memberNode[m]]);
+            }
+          else
+            {
+              all.Add (nodes[memberNode[m]].Get (memberSub[m]));
+            }
+        }
+      switch (linkKind[i])
+        {
+        case 0: /* Hub */
+        case 5: /* Tap */
+          csma[i].SetChannelAttribute ("DataRate", DataRateValue (DataRate (linkDataRate[i])));
+          csma[i].SetChannelAttribute ("Delay", TimeValue (MilliSeconds (linkDelay[i])));
+          ndc[i] = csma[i].Install (all);
+          break;
+        case 1: /* PointToPoint */
+          {
+            PointToPointHelper p2p;
+            p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (linkDataRate[i])));
+            p2p.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (linkDelay[i])));
+            ndc[i] = p2p.Install (all);
+          }
+          break;
+        case 2: /* Bridge */
+          {
+            csma[i].SetChannelAttribute ("DataRate", DataRateValue (DataRate (linkDataRate[i])));
+            csma[i].SetChannelAttribute ("Delay", TimeValue (MilliSeconds (linkDelay[i])));
+            NetDeviceContainer bridgeDevices;
+            for (uint32_t n = 0; n < all.GetN (); n++)
+              {
+                NetDeviceContainer link = csma[i].Install (NodeContainer (all.Get (n), nodes[linkNode[i]]));
+                ndc[i].Add (link.Get (0));
+                bridgeDevices.Add (link.Get (1));
+              }
+            BridgeHelper bridge;
+            bridge.Install (nodes[linkNode[i]].Get (0), bridgeDevices);
+          }
+          break;
+        case 3: /* Ap */
+          {
+            YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+            wifiPhy[i] = YansWifiPhyHelper::Default ();
+            wifiPhy[i].SetChannel (wifiChannel.Create ());
+            Ssid ssid = Ssid (strings[linkIface[i]]);
+            WifiHelper wifi = WifiHelper::Default ();
+            NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+            wifi.SetRemoteStationManager ("ns3::ArfWifiManager");
+            wifiMac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconGeneration", BooleanValue (true),
+               "BeaconInterval", TimeValue (Seconds (2.5)));
+            ndc[i].Add (wifi.Install (wifiPhy[i], wifiMac, nodes[linkNode[i]]));
+            wifiMac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+            ndc[i].Add (wifi.Install (wifiPhy[i], wifiMac, all));
+            MobilityHelper mobility;
+            mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+            mobility.Install (nodes[linkNode[i]]);
+            if (linkFlags[i] & 4)
+              {
+                mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel","Bounds", RectangleValue (Rectangle (-50, 50, -50, 50)));
+              }
+            mobility.Install (all);
+          }
+          break;
+        case 4: /* Emu */
+          {
+            EmuHelper emu;
+            emu.SetAttribute ("DeviceName", StringValue (strings[linkIface[i]]));
+            ndc[i] = emu.Install (all);
+          }
+          break;
+        default:
+          NS_FATAL_ERROR ("Unknown link kind " << linkKind[i]);
+        }
+    }
+
+  /* Install the IP stack. */
+  InternetStackHelper internetStackH;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      if (nodeFlags[i] & 1)
+        {
+          continue;
+        }
+      if (strings[nodeNsc[i]] != "")
+        {
+          internetStackH.SetTcp ("ns3::NscTcpL4Protocol","Library",StringValue(strings[nodeNsc[i]]));
+        }
+      internetStackH.Install (nodes[i]);
+    }
+
+  /* IP assign, the link i has the subnet 10.0.i.0 as in the unrolled code. */
+  Ipv4AddressHelper ipv4;
+  std::vector<Ipv4InterfaceContainer> iface (nLinks);
+  for (uint32_t i = 0; i < nLinks; i++)
+    {
+      std::ostringstream base;
+      base << "10.0." << i << ".0";
+      ipv4.SetBase (Ipv4Address (base.str ().c_str ()), Ipv4Mask ("255.255.255.0"));
+      iface[i] = ipv4.Assign (ndc[i]);
+    }
+
+  /* Tap bridge. */
+  for (uint32_t i = 0; i < nLinks; i++)
+    {
+      if (linkKind[i] == 5)
+        {
+          TapBridgeHelper tapBridge (iface[i].GetAddress (1));
+          tapBridge.SetAttribute ("Mode", StringValue ("ConfigureLocal"));
+          tapBridge.SetAttribute ("DeviceName", StringValue (strings[linkIface[i]]));
+          tapBridge.Install (nodes[linkNode[i]].Get (0), ndc[i].Get (0));
+        }
+    }
+
+  /* Generate Route. */
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  /* Generate Application. */
+  for (uint32_t i = 0; i < nApps; i++)
+    {
+      uint32_t kind = app[0][i];
+      NodeContainer sender = app[3][i] == NONE ? nodes[app[2][i]] : NodeContainer (nodes[app[2][i]].Get (app[3][i]));
+      NodeContainer receiver = app[5][i] == NONE ? nodes[app[4][i]] : NodeContainer (nodes[app[4][i]].Get (app[5][i]));
+      double start = app[8][i];
+      double end = app[9][i];
+      if (app[6][i] == NONE)
+        {
+          std::cerr << "Application " << strings[app[1][i]] << " has no receiver address, skipped." << std::endl;
+          continue;
+        }
+      Ipv4Address dst = iface[app[6][i]].GetAddress (app[7][i]);
+      ApplicationContainer apps;
+      if (kind == 0) /* Ping */
+        {
+          OnOffHelper onoff = OnOffHelper ("ns3::Ipv4RawSocketFactory", InetSocketAddress (dst));
+          onoff.SetAttribute ("OnTime", StringValue ("ns3::ConstantRandomVariable[Constant=1]"));
+          onoff.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0]"));
+          apps = onoff.Install (sender.Get (0));
+          apps.Start (Seconds (start + 0.1));
+          apps.Stop (Seconds (end + 0.1));
+          PacketSinkHelper sink = PacketSinkHelper ("ns3::Ipv4RawSocketFactory", InetSocketAddress (dst));
+          apps = sink.Install (receiver.Get (0));
+          apps.Start (Seconds (start));
+          apps.Stop (Seconds (end + 0.2));
+          V4PingHelper ping = V4PingHelper (dst);
+          apps = ping.Install (sender.Get (0));
+          apps.Start (Seconds (start + 0.2));
+          apps.Stop (Seconds (end));
+        }
+      else if (kind == 1) /* UdpEcho */
+        {
+          UdpEchoServerHelper server (app[10][i]);
+          apps = server.Install (receiver.Get (0));
+          apps.Start (Seconds (start));
+          apps.Stop (Seconds (end));
+          UdpEchoClientHelper client (dst, app[10][i]);
+          client.SetAttribute ("MaxPackets", UintegerValue (app[12][i]));
+          client.SetAttribute ("Interval", TimeValue (Seconds (appInterval[i])));
+          client.SetAttribute ("PacketSize", UintegerValue (app[11][i]));
+          apps = client.Install (sender.Get (0));
+          apps.Start (Seconds (start + 0.1));
+          apps.Stop (Seconds (end));
+        }
+      else if (kind == 2) /* TcpLargeTransfer */
+        {
+          PacketSinkHelper sinkHelper ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), app[10][i]));
+          apps = sinkHelper.Install (receiver);
+          apps.Start (Seconds (start));
+          apps.Stop (Seconds (end));
+          OnOffHelper clientHelper ("ns3::TcpSocketFactory", Address ());
+          clientHelper.SetAttribute ("OnTime", StringValue ("ns3::ConstantRandomVariable[Constant=1]"));
+          clientHelper.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0]"));
+          clientHelper.SetAttribute ("Remote", AddressValue (InetSocketAddress (dst, app[10][i])));
+          apps = clientHelper.Install (sender);
+          apps.Start (Seconds (start));
+          apps.Stop (Seconds (end));
+        }
+    }
+
+  /* Simulation. */
+  /* Pcap output. */
+  for (uint32_t i = 0; i < nLinks; i++)
+    {
+      if (!(linkFlags[i] & 1))
+        {
+          continue;
+        }
+      bool promisc = linkFlags[i] & 2;
+      std::string name = strings[linkName[i]];
+      if (linkKind[i] == 0 || linkKind[i] == 2 || linkKind[i] == 5)
+        {
+          csma[i].EnablePcapAll ("csma_" + name, promisc);
+        }
+      else if (linkKind[i] == 1)
+        {
+          PointToPointHelper::EnablePcapAll (name);
+        }
+      else if (linkKind[i] == 3)
+        {
+          wifiPhy[i].EnablePcap (name, ndc[i].Get (0));
+        }
+      else if (linkKind[i] == 4)
+        {
+          EmuHelper::EnablePcap ("Emu-" + name, strings[linkIface[i]], promisc);
+        }
+    }
+  /* Stop the simulation after x seconds. */
+  Simulator::Stop (Seconds (stopTime));
+  /* Start and clean simulation. */
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+)DRIVER";
+
+ScenarioData::ScenarioData()
+{
+  this->m_flags = 0;
+  this->m_stopTime = 0;
+  this->m_scheduler = this->AddString("");
+  this->m_linkMembers.push_back(0);
+  this->m_appColumns.resize(APP_COLUMNS);
+}
+
+ScenarioData::~ScenarioData()
+{
+}
+
+void ScenarioData::SetFlags(const uint32_t &flags)
+{
+  this->m_flags = flags;
+}
+
+void ScenarioData::SetStopTime(const uint32_t &stopTime)
+{
+  this->m_stopTime = stopTime;
+}
+
+void ScenarioData::SetScheduler(const std::string &scheduler)
+{
+  this->m_scheduler = this->AddString(scheduler);
+}
+
+uint32_t ScenarioData::AddString(const std::string &str)
+{
+  std::map<std::string, uint32_t>::iterator it = this->m_stringIndex.find(str);
+  if(it != this->m_stringIndex.end())
+  {
+    return it->second;
+  }
+  uint32_t index = this->m_strings.size();
+  this->m_strings.push_back(str);
+  this->m_stringIndex[str] = index;
+  return index;
+}
+
+uint32_t ScenarioData::AddNode(const std::string &name, const uint32_t &machinesNumber, const std::string &nsc, const uint32_t &flags)
+{
+  this->m_nodeName.push_back(this->AddString(name));
+  this->m_nodeMachines.push_back(machinesNumber);
+  this->m_nodeNsc.push_back(this->AddString(nsc));
+  this->m_nodeFlags.push_back(flags);
+  return this->m_nodeName.size() - 1;
+}
+
+uint32_t ScenarioData::AddLink(const uint32_t &kind, const std::string &name, const uint64_t &dataRate, const uint32_t &delay,
+    const uint32_t &flags, const uint32_t &node, const std::string &iface)
+{
+  this->m_linkKind.push_back(kind);
+  this->m_linkName.push_back(this->AddString(name));
+  this->m_linkDataRate.push_back(dataRate);
+  this->m_linkDelay.push_back(delay);
+  this->m_linkFlags.push_back(flags);
+  this->m_linkNode.push_back(node);
+  this->m_linkIface.push_back(this->AddString(iface));
+  this->m_linkMembers.push_back(this->m_memberNode.size());
+  return this->m_linkKind.size() - 1;
+}
+
+void ScenarioData::AddMember(const uint32_t &node, const uint32_t &sub)
+{
+  if(this->m_linkKind.size() == 0)
+  {
+    throw std::logic_error("Add member failed! (no link).");
+  }
+  this->m_memberNode.push_back(node);
+  this->m_memberSub.push_back(sub);
+  this->m_linkMembers.back() = this->m_memberNode.size();
+}
+
+uint32_t ScenarioData::AddApplication(const uint32_t &kind, const std::string &name, const uint32_t &sender, const uint32_t &senderSub,
+    const uint32_t &receiver, const uint32_t &receiverSub, const uint32_t &receiverLink, const uint32_t &receiverIndex,
+    const uint32_t &startTime, const uint32_t &endTime, const uint32_t &port, const uint32_t &packetSize,
+    const uint32_t &maxPackets, const double &interval)
+{
+  const uint32_t values[APP_COLUMNS] = {kind, this->AddString(name), sender, senderSub, receiver, receiverSub,
+    receiverLink, receiverIndex, startTime, endTime, port, packetSize, maxPackets};
+  for(size_t i = 0; i < APP_COLUMNS; i++)
+  {
+    this->m_appColumns.at(i).push_back(values[i]);
+  }
+  this->m_appInterval.push_back(interval);
+  return this->m_appInterval.size() - 1;
+}
+
+size_t ScenarioData::GetNNodes() const
+{
+  return this->m_nodeName.size();
+}
+
+size_t ScenarioData::GetNLinks() const
+{
+  return this->m_linkKind.size();
+}
+
+size_t ScenarioData::GetNApplications() const
+{
+  return this->m_appInterval.size();
+}
+
+void ScenarioData::Write(const std::string &fileName)
+{
+  std::ofstream out(fileName.c_str(), std::ios::binary);
+  if(!out.is_open())
+  {
+    throw std::runtime_error("Write topology failed! (" + fileName + ") can not be opened.");
+  }
+
+  /* header */
+  out.write("NS3T", 4);
+  ScenarioData::WriteU32(out, 1);
+  ScenarioData::WriteU32(out, this->m_flags);
+  ScenarioData::WriteU32(out, this->m_stopTime);
+  ScenarioData::WriteU32(out, this->m_scheduler);
+
+  /* string table */
+  ScenarioData::WriteU32(out, this->m_strings.size());
+  for(size_t i = 0; i < this->m_strings.size(); i++)
+  {
+    ScenarioData::WriteU32(out, this->m_strings.at(i).size());
+    out.write(this->m_strings.at(i).data(), this->m_strings.at(i).size());
+  }
+
+  /* node table */
+  ScenarioData::WriteU32(out, this->m_nodeName.size());
+  ScenarioData::WriteColumn(out, this->m_nodeName);
+  ScenarioData::WriteColumn(out, this->m_nodeMachines);
+  ScenarioData::WriteColumn(out, this->m_nodeNsc);
+  ScenarioData::WriteColumn(out, this->m_nodeFlags);
+
+  /* link table */
+  ScenarioData::WriteU32(out, this->m_linkKind.size());
+  ScenarioData::WriteColumn(out, this->m_linkKind);
+  ScenarioData::WriteColumn(out, this->m_linkName);
+  for(size_t i = 0; i < this->m_linkDataRate.size(); i++)
+  {
+    ScenarioData::WriteU64(out, this->m_linkDataRate.at(i));
+  }
+  ScenarioData::WriteColumn(out, this->m_linkDelay);
+  ScenarioData::WriteColumn(out, this->m_linkFlags);
+  ScenarioData::WriteColumn(out, this->m_linkNode);
+  ScenarioData::WriteColumn(out, this->m_linkIface);
+  ScenarioData::WriteColumn(out, this->m_linkMembers);
+
+  /* member table */
+  ScenarioData::WriteU32(out, this->m_memberNode.size());
+  ScenarioData::WriteColumn(out, this->m_memberNode);
+  ScenarioData::WriteColumn(out, this->m_memberSub);
+
+  /* application table */
+  ScenarioData::WriteU32(out, this->m_appInterval.size());
+  for(size_t i = 0; i < APP_COLUMNS; i++)
+  {
+    ScenarioData::WriteColumn(out, this->m_appColumns.at(i));
+  }
+  for(size_t i = 0; i < this->m_appInterval.size(); i++)
+  {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &this->m_appInterval.at(i), sizeof(double));
+    ScenarioData::WriteU64(out, bits);
+  }
+
+  if(!out.good())
+  {
+    throw std::runtime_error("Write topology failed! (" + fileName + ").");
+  }
+}
+
+std::vector<std::string> ScenarioData::GenerateDriverCpp(const std::string &dataFileName)
+{
+  std::vector<std::string> driver;
+  std::string code = DRIVER;
+  std::string::size_type pos = code.find("@TOPOLOGY@");
+  code.replace(pos, std::string("@TOPOLOGY@").size(), Profiling::Escape(dataFileName));
+  pos = code.find("@APP_COLUMNS@");
+  code.replace(pos, std::string("@APP_COLUMNS@").size(), utils::integerToString(APP_COLUMNS));
+
+  std::string::size_type begin = 0;
+  std::string::size_type end = code.find('\n');
+  while(end != std::string::npos)
+  {
+    driver.push_back(code.substr(begin, end - begin));
+    begin = end + 1;
+    end = code.find('\n', begin);
+  }
+  return driver;
+}
+
+std::string ScenarioData::DataFileName(const std::string &fileName)
+{
+  std::string::size_type slash = fileName.find_last_of("/\\");
+  std::string::size_type dot = fileName.find_last_of('.');
+  if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return fileName + ".topo";
+  }
+  return fileName.substr(0, dot) + ".topo";
+}
+
+void ScenarioData::WriteColumn(std::ostream &out, const std::vector<uint32_t> &column)
+{
+  for(size_t i = 0; i < column.size(); i++)
+  {
+    ScenarioData::WriteU32(out, column.at(i));
+  }
+}
+
+void ScenarioData::WriteU32(std::ostream &out, const uint32_t &value)
+{
+  char bytes[4];
+  for(size_t i = 0; i < 4; i++)
+  {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  out.write(bytes, 4);
+}
+
+void ScenarioData::WriteU64(std::ostream &out, const uint64_t &value)
+{
+  ScenarioData::WriteU32(out, static_cast<uint32_t>(value & 0xffffffff));
+  ScenarioData::WriteU32(out, static_cast<uint32_t>(value >> 32));
+}
@@ -0,0 +1,360 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file scenario-data.h
+ * \brief Columnar topology data file and its fixed ns-3 driver.
+ */
+
+#ifndef SCENARIO_DATA_H
+#define SCENARIO_DATA_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * \ingroup generator
+ * \brief Columnar topology data file and its fixed ns-3 driver.
+ *
+ *  Instead of one unrolled statement per object, the data-driven backend
+ *  writes the whole topology into a compact binary file and emits a small
+ *  driver which is the same for every scenario. The driver reads the file
+ *  at runtime and builds the ns-3 objects in loops, so its compile time does
+ *  not depend on the topology size.
+ *
+ *  File layout (all integers are little endian):
+ *    - header: magic "NS3T", version, flags, stop time, scheduler
+ *    - string table: count, then (length, bytes) for each string
+ *    - node table: count, then the name, machines number, nsc and flags columns
+ *    - link table: count, then the kind, name, data rate, delay, flags, node,
+ *      iface and member offset (count + 1 entries) columns
+ *    - member table: count, then the node and sub index columns
+ *    - application table: count, then the kind, name, sender, sender sub,
+ *      receiver, receiver sub, receiver link, receiver index, start, end,
+ *      port, packet size, max packets and interval columns
+ *
+ *  Strings, nodes and links are referenced by their index into their table.
+ *  The index 0 of the string table is always the empty string.
+ */
+class ScenarioData
+{
+  public:
+    /**
+     * \brief Value of a missing node, link or sub index.
+     */
+    static const uint32_t NONE = 0xffffffff;
+
+    /**
+     * \brief Link kinds.
+     */
+    enum LinkKind
+    {
+      LINK_HUB = 0,
+      LINK_POINT_TO_POINT = 1,
+      LINK_BRIDGE = 2,
+      LINK_AP = 3,
+      LINK_EMU = 4,
+      LINK_TAP = 5
+    };
+
+    /**
+     * \brief Application kinds.
+     */
+    enum ApplicationKind
+    {
+      APPLICATION_PING = 0,
+      APPLICATION_UDP_ECHO = 1,
+      APPLICATION_TCP_LARGE_TRANSFER = 2
+    };
+
+    /**
+     * \brief Flags of the header, the nodes and the links.
+     */
+    enum Flags
+    {
+      FLAG_REALTIME = 1,
+      FLAG_NO_STACK = 1,
+      FLAG_TRACE = 1,
+      FLAG_PROMISC = 2,
+      FLAG_MOBILITY = 4
+    };
+
+    /**
+     * \brief Constructor.
+     */
+    ScenarioData();
+
+    /**
+     * \brief Destructor.
+     */
+    ~ScenarioData();
+
+    /**
+     * \brief Set the header flags.
+     * \param flags header flags
+     */
+    void SetFlags(const uint32_t &flags);
+
+    /**
+     * \brief Set the simulation stop time.
+     * \param stopTime stop time (in s)
+     */
+    void SetStopTime(const uint32_t &stopTime);
+
+    /**
+     * \brief Set the event scheduler.
+     * \param scheduler scheduler name (empty for the ns-3 default)
+     */
+    void SetScheduler(const std::string &scheduler);
+
+    /**
+     * \brief Add a string into the string table.
+     * \param str string to add
+     * \return string index (a string is stored only once)
+     */
+    uint32_t AddString(const std::string &str);
+
+    /**
+     * \brief Add a node.
+     * \param name node container name
+     * \param machinesNumber number of machines of the container
+     * \param nsc nsc library (empty if not used)
+     * \param flags node flags
+     * \return node index
+     */
+    uint32_t AddNode(const std::string &name, const uint32_t &machinesNumber, const std::string &nsc, const uint32_t &flags);
+
+    /**
+     * \brief Add a link.
+     * \param kind link kind
+     * \param name link name
+     * \param dataRate data rate (in bps)
+     * \param delay delay (in ms)
+     * \param flags link flags
+     * \param node bridge, ap, emu or tap node index (NONE if not used)
+     * \param iface ssid or interface name (empty if not used)
+     * \return link index
+     */
+    uint32_t AddLink(const uint32_t &kind, const std::string &name, const uint64_t &dataRate, const uint32_t &delay,
+        const uint32_t &flags, const uint32_t &node, const std::string &iface);
+
+    /**
+     * \brief Add a member to the last added link.
+     * \param node node index
+     * \param sub machine index into the node container (NONE for the whole container)
+     */
+    void AddMember(const uint32_t &node, const uint32_t &sub);
+
+    /**
+     * \brief Add an application.
+     * \param kind application kind
+     * \param name application name
+     * \param sender sender node index
+     * \param senderSub sender machine index (NONE for the whole container)
+     * \param receiver receiver node index
+     * \param receiverSub receiver machine index (NONE for the whole container)
+     * \param receiverLink link index of the receiver address (NONE if not connected)
+     * \param receiverIndex receiver index into the link net devices
+     * \param startTime start time (in s)
+     * \param endTime end time (in s)
+     * \param port port (0 if not used)
+     * \param packetSize packet size (0 if not used)
+     * \param maxPackets max packets (0 if not used)
+     * \param interval packet interval (in s)
+     * \return application index
+     */
+    uint32_t AddApplication(const uint32_t &kind, const std::string &name, const uint32_t &sender, const uint32_t &senderSub,
+        const uint32_t &receiver, const uint32_t &receiverSub, const uint32_t &receiverLink, const uint32_t &receiverIndex,
+        const uint32_t &startTime, const uint32_t &endTime, const uint32_t &port, const uint32_t &packetSize,
+        const uint32_t &maxPackets, const double &interval);
+
+    /**
+     * \brief Get the number of nodes.
+     * \return number of nodes
+     */
+    size_t GetNNodes() const;
+
+    /**
+     * \brief Get the number of links.
+     * \return number of links
+     */
+    size_t GetNLinks() const;
+
+    /**
+     * \brief Get the number of applications.
+     * \return number of applications
+     */
+    size_t GetNApplications() const;
+
+    /**
+     * \brief Write the data file.
+     * \param fileName data file name
+     */
+    void Write(const std::string &fileName);
+
+    /**
+     * \brief Generate the fixed C++ driver.
+     * \param dataFileName default data file name read by the driver
+     * \return driver code
+     */
+    static std::vector<std::string> GenerateDriverCpp(const std::string &dataFileName);
+
+    /**
+     * \brief Build the data file name from a generated file name.
+     *
+     * "dir/scenario.cc" gives "dir/scenario.topo".
+     *
+     * \param fileName generated file name
+     * \return data file name
+     */
+    static std::string DataFileName(const std::string &fileName);
+
+  private:
+    /**
+     * \brief Header flags.
+     */
+    uint32_t m_flags;
+
+    /**
+     * \brief Stop time.
+     */
+    uint32_t m_stopTime;
+
+    /**
+     * \brief Scheduler string index.
+     */
+    uint32_t m_scheduler;
+
+    /**
+     * \brief String table.
+     */
+    std::vector<std::string> m_strings;
+
+    /**
+     * \brief String table index.
+     */
+    std::map<std::string, uint32_t> m_stringIndex;
+
+    /**
+     * \brief Node name column.
+     */
+    std::vector<uint32_t> m_nodeName;
+
+    /**
+     * \brief Node machines number column.
+     */
+    std::vector<uint32_t> m_nodeMachines;
+
+    /**
+     * \brief Node nsc column.
+     */
+    std::vector<uint32_t> m_nodeNsc;
+
+    /**
+     * \brief Node flags column.
+     */
+    std::vector<uint32_t> m_nodeFlags;
+
+    /**
+     * \brief Link kind column.
+     */
+    std::vector<uint32_t> m_linkKind;
+
+    /**
+     * \brief Link name column.
+     */
+    std::vector<uint32_t> m_linkName;
+
+    /**
+     * \brief Link data rate column.
+     */
+    std::vector<uint64_t> m_linkDataRate;
+
+    /**
+     * \brief Link delay column.
+     */
+    std::vector<uint32_t> m_linkDelay;
+
+    /**
+     * \brief Link flags column.
+     */
+    std::vector<uint32_t> m_linkFlags;
+
+    /**
+     * \brief Link node column.
+     */
+    std::vector<uint32_t> m_linkNode;
+
+    /**
+     * \brief Link iface column.
+     */
+    std::vector<uint32_t> m_linkIface;
+
+    /**
+     * \brief Link first member column (one more entry than links).
+     */
+    std::vector<uint32_t> m_linkMembers;
+
+    /**
+     * \brief Member node column.
+     */
+    std::vector<uint32_t> m_memberNode;
+
+    /**
+     * \brief Member sub index column.
+     */
+    std::vector<uint32_t> m_memberSub;
+
+    /**
+     * \brief Application columns (kind, name, sender, sender sub, receiver, receiver sub,
+     * receiver link, receiver index, start, end, port, packet size, max packets).
+     */
+    std::vector<std::vector<uint32_t> > m_appColumns;
+
+    /**
+     * \brief Application interval column.
+     */
+    std::vector<double> m_appInterval;
+
+    /**
+     * \brief Write a 32 bits column.
+     * \param out output stream
+     * \param column column to write
+     */
+    static void WriteColumn(std::ostream &out, const std::vector<uint32_t> &column);
+
+    /**
+     * \brief Write a 32 bits integer.
+     * \param out output stream
+     * \param value value to write
+     */
+    static void WriteU32(std::ostream &out, const uint32_t &value);
+
+    /**
+     * \brief Write a 64 bits integer.
+     * \param out output stream
+     * \param value value to write
+     */
+    static void WriteU64(std::ostream &out, const uint64_t &value);
+};
+
+#endif /* SCENARIO_DATA_H */
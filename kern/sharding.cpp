@@ -0,0 +1,369 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file sharding.cpp
+ * \brief Split of the generated C++ code into several translation units.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#include "sharding.h"
+#include "utils.h"
+
+Sharding::Sharding(const std::string &fileName, const size_t &shards)
+{
+  if(shards == 0)
+  {
+    throw std::logic_error("Sharding failed! (no shard).");
+  }
+  this->m_fileName = fileName;
+  this->m_shards = shards;
+}
+
+Sharding::~Sharding()
+{
+}
+
+std::vector<std::string> Sharding::AddVars(const std::vector<std::string> &vars)
+{
+  std::vector<std::string> others;
+  std::string type, name, value;
+  for(size_t i = 0; i < vars.size(); i++)
+  {
+    if(Sharding::SplitDeclaration(vars.at(i), type, name, value))
+    {
+      this->AddGlobal(type, name, value);
+    }
+    else
+    {
+      others.push_back(vars.at(i));
+    }
+  }
+  return others;
+}
+
+void Sharding::AddBlock(const std::string &phase, const size_t &index, const size_t &count, const std::vector<std::string> &code)
+{
+  if(this->m_blocks.find(phase) == this->m_blocks.end())
+  {
+    this->m_phases.push_back(phase);
+    this->m_blocks[phase].resize(this->m_shards);
+  }
+  std::vector<std::string> &block = this->m_blocks[phase].at(index * this->m_shards / count);
+
+  int depth = 0;
+  std::string type, name, value;
+  for(size_t i = 0; i < code.size(); i++)
+  {
+    const std::string &line = code.at(i);
+    if(depth == 0 && Sharding::SplitDeclaration(line, type, name, value) && Sharding::IsHoistable(type))
+    {
+      this->AddGlobal(type, name, "");
+      if(value != "")
+      {
+        block.push_back(name + " = " + value + ";");
+      }
+      continue;
+    }
+    block.push_back(line);
+
+    /* follow the blocks (the generated strings have no brace). */
+    depth += std::count(line.begin(), line.end(), '{');
+    depth -= std::count(line.begin(), line.end(), '}');
+  }
+}
+
+std::vector<std::string> Sharding::GenerateHeaderCpp(const std::vector<std::string> &headers)
+{
+  std::vector<std::string> code;
+  std::string guard = Sharding::BaseName(this->GetHeaderName());
+  for(size_t i = 0; i < guard.size(); i++)
+  {
+    guard[i] = isalnum(guard[i]) ? toupper(guard[i]) : '_';
+  }
+
+  code.push_back("#ifndef " + guard);
+  code.push_back("#define " + guard);
+  code.push_back("");
+  for(size_t i = 0; i < headers.size(); i++)
+  {
+    code.push_back(headers.at(i));
+  }
+  code.push_back("");
+  code.push_back("using namespace ns3;");
+  code.push_back("");
+  for(size_t i = 0; i < this->m_globals.size(); i++)
+  {
+    code.push_back("extern " + this->m_globals.at(i) + ";");
+  }
+  code.push_back("");
+  for(size_t i = 0; i < this->m_phases.size(); i++)
+  {
+    for(size_t j = 0; j < this->m_shards; j++)
+    {
+      if(this->m_blocks[this->m_phases.at(i)].at(j).size() > 0)
+      {
+        code.push_back("void " + Sharding::FunctionName(this->m_phases.at(i), j) + " ();");
+      }
+    }
+  }
+  code.push_back("");
+  code.push_back("#endif /* " + guard + " */");
+
+  return code;
+}
+
+std::vector<std::string> Sharding::GenerateGlobalsCpp()
+{
+  return this->m_definitions;
+}
+
+std::vector<std::string> Sharding::GenerateCallsCpp(const std::string &phase)
+{
+  std::vector<std::string> calls;
+  if(this->m_blocks.find(phase) == this->m_blocks.end())
+  {
+    return calls;
+  }
+  for(size_t i = 0; i < this->m_shards; i++)
+  {
+    if(this->m_blocks[phase].at(i).size() > 0)
+    {
+      calls.push_back(Sharding::FunctionName(phase, i) + " ();");
+    }
+  }
+  return calls;
+}
+
+std::vector<std::string> Sharding::GenerateShardCpp(const size_t &shard)
+{
+  std::vector<std::string> code;
+  code.push_back("#include \"" + Sharding::BaseName(this->GetHeaderName()) + "\"");
+  for(size_t i = 0; i < this->m_phases.size(); i++)
+  {
+    const std::vector<std::string> &block = this->m_blocks[this->m_phases.at(i)].at(shard);
+    if(block.size() == 0)
+    {
+      continue;
+    }
+    code.push_back("");
+    code.push_back("void " + Sharding::FunctionName(this->m_phases.at(i), shard) + " ()");
+    code.push_back("{");
+    for(size_t j = 0; j < block.size(); j++)
+    {
+      code.push_back("  " + block.at(j));
+    }
+    code.push_back("}");
+  }
+  return code;
+}
+
+std::vector<std::string> Sharding::GenerateMakefile(const std::vector<std::string> &headers)
+{
+  std::vector<std::string> makefile;
+  std::string program = Sharding::BaseName(this->m_fileName);
+  program = program.substr(0, program.find_last_of('.'));
+
+  std::string objs = program + ".o";
+  for(size_t i = 0; i < this->m_shards; i++)
+  {
+    std::string shard = Sharding::BaseName(this->GetShardName(i));
+    objs += " " + shard.substr(0, shard.find_last_of('.')) + ".o";
+  }
+
+  makefile.push_back("# Build of the " + program + " simulation, use make -jN to compile the shards in parallel.");
+  makefile.push_back("# The ns-3 pkg-config names depend on the ns-3 version and build profile.");
+  makefile.push_back("NS3_PKG_PREFIX ?= libns3-dev-");
+  makefile.push_back("NS3_PKG_SUFFIX ?= -debug");
+  makefile.push_back("NS3_MODULES = " + Sharding::GetModules(headers));
+  makefile.push_back("NS3_PKGS = $(foreach module,$(NS3_MODULES),$(NS3_PKG_PREFIX)$(module)$(NS3_PKG_SUFFIX))");
+  makefile.push_back("");
+  makefile.push_back("CXXFLAGS += $(shell pkg-config --cflags $(NS3_PKGS))");
+  makefile.push_back("LDLIBS += $(shell pkg-config --libs $(NS3_PKGS))");
+  makefile.push_back("");
+  makefile.push_back("PROGRAM = " + program);
+  makefile.push_back("OBJS = " + objs);
+  makefile.push_back("");
+  makefile.push_back("all: $(PROGRAM)");
+  makefile.push_back("");
+  makefile.push_back("$(PROGRAM): $(OBJS)");
+  makefile.push_back("\t$(CXX) $(LDFLAGS) -o $@ $(OBJS) $(LDLIBS)");
+  makefile.push_back("");
+  makefile.push_back("%.o: %.cc " + Sharding::BaseName(this->GetHeaderName()));
+  makefile.push_back("\t$(CXX) $(CXXFLAGS) -c -o $@ $<");
+  makefile.push_back("");
+  makefile.push_back("clean:");
+  makefile.push_back("\trm -f $(PROGRAM) $(OBJS)");
+  makefile.push_back("");
+  makefile.push_back(".PHONY: all clean");
+
+  return makefile;
+}
+
+std::string Sharding::GetModules(const std::vector<std::string> &headers)
+{
+  /* "#include "ns3/csma-module.h"" gives the csma module. */
+  std::string modules = "";
+  for(size_t i = 0; i < headers.size(); i++)
+  {
+    std::string::size_type begin = headers.at(i).find("\"ns3/");
+    std::string::size_type end = headers.at(i).find("-module.h\"");
+    if(begin != std::string::npos && end != std::string::npos)
+    {
+      modules += (modules != "" ? " " : "") + headers.at(i).substr(begin + 5, end - begin - 5);
+    }
+  }
+  return modules;
+}
+
+size_t Sharding::GetShards() const
+{
+  return this->m_shards;
+}
+
+std::string Sharding::GetHeaderName() const
+{
+  std::string::size_type slash = this->m_fileName.find_last_of("/\\");
+  std::string::size_type dot = this->m_fileName.find_last_of('.');
+  if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return this->m_fileName + ".h";
+  }
+  return this->m_fileName.substr(0, dot) + ".h";
+}
+
+std::string Sharding::GetShardName(const size_t &shard) const
+{
+  std::string suffix = "-" + utils::integerToString(shard);
+  std::string::size_type slash = this->m_fileName.find_last_of("/\\");
+  std::string::size_type dot = this->m_fileName.find_last_of('.');
+  if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return this->m_fileName + suffix;
+  }
+  return this->m_fileName.substr(0, dot) + suffix + this->m_fileName.substr(dot);
+}
+
+std::string Sharding::GetMakefileName() const
+{
+  std::string::size_type slash = this->m_fileName.find_last_of("/\\");
+  if(slash == std::string::npos)
+  {
+    return "Makefile";
+  }
+  return this->m_fileName.substr(0, slash + 1) + "Makefile";
+}
+
+void Sharding::AddGlobal(const std::string &type, const std::string &name, const std::string &value)
+{
+  std::string definition = type + " " + name + (value != "" ? " = " + value : "") + ";";
+  if(std::find(this->m_definitions.begin(), this->m_definitions.end(), definition) != this->m_definitions.end())
+  {
+    return;
+  }
+  this->m_globals.push_back(type + " " + name);
+  this->m_definitions.push_back(definition);
+}
+
+std::string Sharding::FunctionName(const std::string &phase, const size_t &shard)
+{
+  return "Build" + phase + "_" + utils::integerToString(shard);
+}
+
+std::string Sharding::BaseName(const std::string &fileName)
+{
+  std::string::size_type slash = fileName.find_last_of("/\\");
+  if(slash == std::string::npos)
+  {
+    return fileName;
+  }
+  return fileName.substr(slash + 1);
+}
+
+bool Sharding::SplitDeclaration(const std::string &line, std::string &type, std::string &name, std::string &value)
+{
+  std::string::size_type begin = line.find_first_not_of(' ');
+  std::string::size_type end = line.find_last_not_of(' ');
+  if(begin == std::string::npos || line.at(end) != ';')
+  {
+    return false;
+  }
+  std::string decl = line.substr(begin, end - begin);
+
+  /* type */
+  std::string::size_type pos = 0;
+  while(pos < decl.size() && (isalnum(decl[pos]) || decl[pos] == '_' || decl[pos] == ':'))
+  {
+    pos++;
+  }
+  if(pos == 0 || pos >= decl.size() || decl[pos] != ' ')
+  {
+    return false;
+  }
+  type = decl.substr(0, pos);
+
+  /* name */
+  pos = decl.find_first_not_of(' ', pos);
+  if(pos == std::string::npos || !(isalpha(decl[pos]) || decl[pos] == '_'))
+  {
+    return false;
+  }
+  std::string::size_type nameBegin = pos;
+  while(pos < decl.size() && (isalnum(decl[pos]) || decl[pos] == '_'))
+  {
+    pos++;
+  }
+  name = decl.substr(nameBegin, pos - nameBegin);
+
+  /* value */
+  pos = decl.find_first_not_of(' ', pos);
+  if(pos == std::string::npos)
+  {
+    value = "";
+    return true;
+  }
+  if(decl[pos] == '=')
+  {
+    value = decl.substr(decl.find_first_not_of(' ', pos + 1));
+    return true;
+  }
+  if(decl[pos] == '(')
+  {
+    value = type + " " + decl.substr(pos);
+    return true;
+  }
+  return false;
+}
+
+bool Sharding::IsHoistable(const std::string &type)
+{
+  /* default constructible containers and helpers shared between the phases. */
+  static const char *hoistable[] = {"NodeContainer", "NetDeviceContainer", "Ipv4InterfaceContainer", "ApplicationContainer",
+    "CsmaHelper", "PointToPointHelper", "YansWifiPhyHelper", "EmuHelper", "InternetStackHelper", "Ipv4AddressHelper"};
+  for(size_t i = 0; i < sizeof(hoistable) / sizeof(hoistable[0]); i++)
+  {
+    if(type == hoistable[i])
+    {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file sharding.h
+ * \brief Split of the generated C++ code into several translation units.
+ */
+
+#ifndef SHARDING_H
+#define SHARDING_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Split of the generated C++ code into several translation units.
+ *
+ *  The unrolled code of each setup phase (nodes, links, net devices, ...) is
+ *  given object by object and dispatched into N shard files, where it becomes
+ *  the body of a builder function "Build<Phase>_<shard> ()". The main file
+ *  calls the builder functions phase after phase and a generated Makefile
+ *  compiles the shards separately, so "make -jN" uses N cores.
+ *
+ *  The objects shared between the phases are hoisted out of the functions:
+ *    - the declarations of the ns-3 containers and helpers are turned into
+ *      globals defined in the main file, the initialisation stays in place,
+ *    - the scenario variables (the command line parameters) are defined with
+ *      their value in the main file.
+ *  Both are declared "extern" in a generated header included by all files.
+ *  The other declarations (application helpers, ...) stay local to the builder
+ *  function of their object.
+ */
+class Sharding
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param fileName main file name
+     * \param shards number of shard files
+     */
+    Sharding(const std::string &fileName, const size_t &shards);
+
+    /**
+     * \brief Destructor.
+     */
+    ~Sharding();
+
+    /**
+     * \brief Add the scenario variables.
+     * \param vars vars code
+     * \return the lines which are not a variable definition
+     */
+    std::vector<std::string> AddVars(const std::vector<std::string> &vars);
+
+    /**
+     * \brief Add the code of an object to a phase.
+     *
+     *  The objects of a phase are dispatched in contiguous ranges, the object
+     *  index out of count objects goes into the shard index * shards / count.
+     *
+     * \param phase phase name
+     * \param index object index into the phase
+     * \param count number of objects of the phase
+     * \param code object code
+     */
+    void AddBlock(const std::string &phase, const size_t &index, const size_t &count, const std::vector<std::string> &code);
+
+    /**
+     * \brief Generate the shared header.
+     * \param headers ns-3 headers code
+     * \return header code
+     */
+    std::vector<std::string> GenerateHeaderCpp(const std::vector<std::string> &headers);
+
+    /**
+     * \brief Generate the global definitions of the main file.
+     * \return definitions code
+     */
+    std::vector<std::string> GenerateGlobalsCpp();
+
+    /**
+     * \brief Generate the calls of the builder functions of a phase.
+     * \param phase phase name
+     * \return calls code
+     */
+    std::vector<std::string> GenerateCallsCpp(const std::string &phase);
+
+    /**
+     * \brief Generate a shard file.
+     * \param shard shard number
+     * \return shard code
+     */
+    std::vector<std::string> GenerateShardCpp(const size_t &shard);
+
+    /**
+     * \brief Generate the Makefile.
+     * \param headers ns-3 headers code (gives the pkg-config modules)
+     * \return Makefile content
+     */
+    std::vector<std::string> GenerateMakefile(const std::vector<std::string> &headers);
+
+    /**
+     * \brief Get the pkg-config modules of the ns-3 headers.
+     * \param headers ns-3 headers code
+     * \return module names separated by a space
+     */
+    static std::string GetModules(const std::vector<std::string> &headers);
+
+    /**
+     * \brief Get the number of shard files.
+     * \return number of shard files
+     */
+    size_t GetShards() const;
+
+    /**
+     * \brief Get the shared header file name.
+     * \return header file name
+     */
+    std::string GetHeaderName() const;
+
+    /**
+     * \brief Get a shard file name.
+     *
+     * "dir/scenario.cc" gives "dir/scenario-2.cc" for the shard 2.
+     *
+     * \param shard shard number
+     * \return shard file name
+     */
+    std::string GetShardName(const size_t &shard) const;
+
+    /**
+     * \brief Get the Makefile name.
+     * \return Makefile name
+     */
+    std::string GetMakefileName() const;
+
+  private:
+    /**
+     * \brief Main file name.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief Number of shard files.
+     */
+    size_t m_shards;
+
+    /**
+     * \brief Phase names, in the order they are added.
+     */
+    std::vector<std::string> m_phases;
+
+    /**
+     * \brief Code of each phase, one entry per shard.
+     */
+    std::map<std::string, std::vector<std::vector<std::string> > > m_blocks;
+
+    /**
+     * \brief Global declarations ("Type name").
+     */
+    std::vector<std::string> m_globals;
+
+    /**
+     * \brief Global definitions (with their value for the variables).
+     */
+    std::vector<std::string> m_definitions;
+
+    /**
+     * \brief Add a global.
+     * \param type global type
+     * \param name global name
+     * \param value global value (empty for the default constructor)
+     */
+    void AddGlobal(const std::string &type, const std::string &name, const std::string &value);
+
+    /**
+     * \brief Get the builder function name of a phase.
+     * \param phase phase name
+     * \param shard shard number
+     * \return function name
+     */
+    static std::string FunctionName(const std::string &phase, const size_t &shard);
+
+    /**
+     * \brief Remove the directory of a file name.
+     * \param fileName file name
+     * \return base name
+     */
+    static std::string BaseName(const std::string &fileName);
+
+    /**
+     * \brief Split a single-line declaration.
+     *
+     *  "Type name;", "Type name = value;" and "Type name (args);" are
+     *  recognised, value is "Type (args)" for the last one.
+     *
+     * \param line code line
+     * \param type declaration type (output)
+     * \param name declaration name (output)
+     * \param value declaration value (output, empty if none)
+     * \return true if the line is a declaration
+     */
+    static bool SplitDeclaration(const std::string &line, std::string &type, std::string &name, std::string &value);
+
+    /**
+     * \brief Check if a type can be hoisted as a default constructed global.
+     * \param type declaration type
+     * \return true if the type can be hoisted
+     */
+    static bool IsHoistable(const std::string &type);
+};
+
+#endif /* SHARDING_H */
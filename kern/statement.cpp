@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file statement.cpp
+ * \brief Language independent description of the generated ns-3 code.
+ */
+
+#include "statement.h"
+
+Expression::Expression(const Kind &kind, const std::string &name, const std::string &method)
+{
+  this->m_kind = kind;
+  this->m_name = name;
+  this->m_method = method;
+}
+
+Expression Expression::Name(const std::string &name)
+{
+  return Expression(NAME, name, "");
+}
+
+Expression Expression::String(const std::string &text)
+{
+  return Expression(STRING, text, "");
+}
+
+Expression Expression::Boolean(const bool &value)
+{
+  return Expression(BOOLEAN, value ? "true" : "false", "");
+}
+
+Expression Expression::Real(const std::string &number)
+{
+  return Expression(REAL, number, "");
+}
+
+Expression Expression::Function(const std::string &name)
+{
+  return Expression(FUNCTION, name, "");
+}
+
+Expression Expression::Convert(const std::string &type, const Expression &value)
+{
+  return Expression(CONVERT, type, "").Arg(value);
+}
+
+Expression Expression::Static(const std::string &type, const std::string &method)
+{
+  return Expression(STATIC, type, method);
+}
+
+Expression Expression::Method(const std::string &object, const std::string &method)
+{
+  return Expression(METHOD, object, method);
+}
+
+Expression Expression::Max()
+{
+  return Expression(MAX, "", "");
+}
+
+Expression& Expression::Arg(const Expression &arg)
+{
+  this->m_args.push_back(arg);
+  return *this;
+}
+
+Expression::Kind Expression::GetKind() const
+{
+  return this->m_kind;
+}
+
+const std::string& Expression::GetName() const
+{
+  return this->m_name;
+}
+
+const std::string& Expression::GetMethod() const
+{
+  return this->m_method;
+}
+
+const std::vector<Expression>& Expression::GetArgs() const
+{
+  return this->m_args;
+}
+
+void Expression::Rename(const std::string &from, const std::string &to)
+{
+  /* the type of a function or a static call is not a variable. */
+  if((this->m_kind == NAME || this->m_kind == METHOD) && this->m_name == from)
+  {
+    this->m_name = to;
+  }
+  for(size_t i = 0; i < this->m_args.size(); i++)
+  {
+    this->m_args.at(i).Rename(from, to);
+  }
+}
+
+Statement::Statement(const Kind &kind, const std::string &type, const std::string &name, const Expression &expression) : m_expression(expression)
+{
+  this->m_kind = kind;
+  this->m_type = type;
+  this->m_name = name;
+}
+
+Statement Statement::Declare(const std::string &type, const std::string &name)
+{
+  return Statement(DECLARE, type, name, Expression::Function(type));
+}
+
+Statement Statement::Define(const std::string &type, const std::string &name, const Expression &value)
+{
+  return Statement(DEFINE, type, name, value);
+}
+
+Statement Statement::Construct(const std::string &type, const std::string &name)
+{
+  return Statement(CONSTRUCT, type, name, Expression::Function(type));
+}
+
+Statement Statement::Assign(const std::string &name, const Expression &value)
+{
+  return Statement(ASSIGN, "", name, value);
+}
+
+Statement Statement::Evaluate(const Expression &expression)
+{
+  return Statement(EVALUATE, "", "", expression);
+}
+
+Statement Statement::Call(const std::string &object, const std::string &method)
+{
+  return Statement(EVALUATE, "", "", Expression::Method(object, method));
+}
+
+Statement Statement::Loop(const std::string &variable, const std::string &count)
+{
+  return Statement(LOOP, "", variable, Expression::Name(count));
+}
+
+Statement Statement::Comment(const std::string &text)
+{
+  return Statement(COMMENT, "", text, Expression::Name(""));
+}
+
+Statement Statement::Verbatim(const std::string &code)
+{
+  return Statement(VERBATIM, "", code, Expression::Name(""));
+}
+
+Statement& Statement::Arg(const Expression &arg)
+{
+  this->m_expression.Arg(arg);
+  return *this;
+}
+
+Statement& Statement::Add(const Statement &statement)
+{
+  this->m_body.push_back(statement);
+  return *this;
+}
+
+Statement::Kind Statement::GetKind() const
+{
+  return this->m_kind;
+}
+
+const std::string& Statement::GetType() const
+{
+  return this->m_type;
+}
+
+const std::string& Statement::GetName() const
+{
+  return this->m_name;
+}
+
+const Expression& Statement::GetExpression() const
+{
+  return this->m_expression;
+}
+
+const std::vector<Statement>& Statement::GetBody() const
+{
+  return this->m_body;
+}
+
+void Statement::Rename(const std::string &from, const std::string &to)
+{
+  if(this->m_kind != COMMENT && this->m_kind != VERBATIM && this->m_name == from)
+  {
+    this->m_name = to;
+  }
+  this->m_expression.Rename(from, to);
+  for(size_t i = 0; i < this->m_body.size(); i++)
+  {
+    this->m_body.at(i).Rename(from, to);
+  }
+}
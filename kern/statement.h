@@ -0,0 +1,381 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file statement.h
+ * \brief Language independent description of the generated ns-3 code.
+ */
+
+#ifndef STATEMENT_H
+#define STATEMENT_H
+
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Expression of the generated code.
+ *
+ *  An expression names the ns-3 objects it uses (types, helpers, methods,
+ *  values) and a Backend gives its syntax: "DataRateValue (rate)" in C++ is
+ *  "ns3.DataRateValue(ns3.DataRate(rate))" in python.
+ *
+ *  The arguments of a call are added with Arg:
+ *    Expression::Method("p2p", "Install").Arg(Expression::Name("all"))
+ */
+class Expression
+{
+  public:
+    /**
+     * \brief Expression kinds.
+     */
+    enum Kind
+    {
+      NAME,     /*!< variable, number or code written as is */
+      STRING,   /*!< string literal */
+      BOOLEAN,  /*!< boolean literal */
+      REAL,     /*!< floating point literal */
+      FUNCTION, /*!< ns-3 constructor or function call */
+      CONVERT,  /*!< implicit ns-3 conversion of a value */
+      STATIC,   /*!< static method call of an ns-3 class */
+      METHOD,   /*!< method call of a variable */
+      MAX       /*!< largest of the arguments */
+    };
+
+    /**
+     * \brief Variable, number or code which is the same in every language.
+     * \param name text
+     * \return expression
+     */
+    static Expression Name(const std::string &name);
+
+    /**
+     * \brief String literal.
+     * \param text string content (without quotes)
+     * \return expression
+     */
+    static Expression String(const std::string &text);
+
+    /**
+     * \brief Boolean literal.
+     * \param value boolean value
+     * \return expression
+     */
+    static Expression Boolean(const bool &value);
+
+    /**
+     * \brief Floating point literal, "5" is "5.0" in python.
+     * \param number number
+     * \return expression
+     */
+    static Expression Real(const std::string &number);
+
+    /**
+     * \brief Call of an ns-3 constructor or function ("Seconds", "NodeContainer", ...).
+     * \param name constructor or function name
+     * \return expression
+     */
+    static Expression Function(const std::string &name);
+
+    /**
+     * \brief Value given where an ns-3 type is expected.
+     *
+     *  The conversion is implicit in C++ and explicit in python: a data rate
+     *  number is a DataRate.
+     *
+     * \param type ns-3 type
+     * \param value converted value
+     * \return expression
+     */
+    static Expression Convert(const std::string &type, const Expression &value);
+
+    /**
+     * \brief Call of a static method of an ns-3 class.
+     * \param type class name
+     * \param method method name
+     * \return expression
+     */
+    static Expression Static(const std::string &type, const std::string &method);
+
+    /**
+     * \brief Call of a method of a variable.
+     * \param object variable name
+     * \param method method name
+     * \return expression
+     */
+    static Expression Method(const std::string &object, const std::string &method);
+
+    /**
+     * \brief Largest of the arguments added by Arg (numbers of the same type).
+     * \return expression
+     */
+    static Expression Max();
+
+    /**
+     * \brief Add an argument to a call.
+     * \param arg argument
+     * \return this expression
+     */
+    Expression& Arg(const Expression &arg);
+
+    /**
+     * \brief Get the expression kind.
+     * \return kind
+     */
+    Kind GetKind() const;
+
+    /**
+     * \brief Get the text, function, type or variable name.
+     * \return name
+     */
+    const std::string& GetName() const;
+
+    /**
+     * \brief Get the method name of a call.
+     * \return method name
+     */
+    const std::string& GetMethod() const;
+
+    /**
+     * \brief Get the arguments of a call (the converted value of a conversion).
+     * \return arguments
+     */
+    const std::vector<Expression>& GetArgs() const;
+
+    /**
+     * \brief Rename a variable in the expression and its arguments.
+     * \param from variable name
+     * \param to new variable name
+     */
+    void Rename(const std::string &from, const std::string &to);
+
+  private:
+    /**
+     * \brief Constructor.
+     * \param kind expression kind
+     * \param name text, function, type or variable name
+     * \param method method name
+     */
+    Expression(const Kind &kind, const std::string &name, const std::string &method);
+
+    /**
+     * \brief Expression kind.
+     */
+    Kind m_kind;
+
+    /**
+     * \brief Text, function, type or variable name.
+     */
+    std::string m_name;
+
+    /**
+     * \brief Method name.
+     */
+    std::string m_method;
+
+    /**
+     * \brief Arguments.
+     */
+    std::vector<Expression> m_args;
+};
+
+/**
+ * \ingroup generator
+ * \brief Statement of the generated code.
+ *
+ *  The objects describe their ns-3 construction (helpers, attributes,
+ *  installs) as a list of statements, once, and each Backend renders it in its
+ *  language. The statements are written without indentation, a Backend
+ *  indents the body of a loop.
+ */
+class Statement
+{
+  public:
+    /**
+     * \brief Statement kinds.
+     */
+    enum Kind
+    {
+      DECLARE,   /*!< default constructed variable */
+      DEFINE,    /*!< variable initialised with an expression */
+      CONSTRUCT, /*!< variable constructed with arguments */
+      ASSIGN,    /*!< assignment of an existing variable */
+      EVALUATE,  /*!< expression evaluated for its effect (a call) */
+      LOOP,      /*!< loop of a counter from 0 */
+      COMMENT,   /*!< comment */
+      VERBATIM   /*!< code written as is */
+    };
+
+    /**
+     * \brief Default constructed variable: "Type name;".
+     * \param type ns-3 type
+     * \param name variable name
+     * \return statement
+     */
+    static Statement Declare(const std::string &type, const std::string &name);
+
+    /**
+     * \brief Variable initialised with an expression: "Type name = value;".
+     * \param type variable type (an ns-3 or a C++ type)
+     * \param name variable name
+     * \param value initial value
+     * \return statement
+     */
+    static Statement Define(const std::string &type, const std::string &name, const Expression &value);
+
+    /**
+     * \brief Variable constructed with the arguments added by Arg: "Type name (args);".
+     * \param type ns-3 type
+     * \param name variable name
+     * \return statement
+     */
+    static Statement Construct(const std::string &type, const std::string &name);
+
+    /**
+     * \brief Assignment of an existing variable.
+     * \param name variable name
+     * \param value new value
+     * \return statement
+     */
+    static Statement Assign(const std::string &name, const Expression &value);
+
+    /**
+     * \brief Expression evaluated for its effect.
+     * \param expression expression (a call)
+     * \return statement
+     */
+    static Statement Evaluate(const Expression &expression);
+
+    /**
+     * \brief Method call of a variable, with the arguments added by Arg.
+     * \param object variable name
+     * \param method method name
+     * \return statement
+     */
+    static Statement Call(const std::string &object, const std::string &method);
+
+    /**
+     * \brief Loop of a counter from 0 to count - 1, with the body added by Add.
+     * \param variable counter name
+     * \param count number of iterations
+     * \return statement
+     */
+    static Statement Loop(const std::string &variable, const std::string &count);
+
+    /**
+     * \brief Comment.
+     * \param text comment text
+     * \return statement
+     */
+    static Statement Comment(const std::string &text);
+
+    /**
+     * \brief Code which is written as is in every language (user configuration).
+     * \param code code line
+     * \return statement
+     */
+    static Statement Verbatim(const std::string &code);
+
+    /**
+     * \brief Add an argument to a construction or a call.
+     * \param arg argument
+     * \return this statement
+     */
+    Statement& Arg(const Expression &arg);
+
+    /**
+     * \brief Add a statement to the body of a loop.
+     * \param statement statement
+     * \return this statement
+     */
+    Statement& Add(const Statement &statement);
+
+    /**
+     * \brief Get the statement kind.
+     * \return kind
+     */
+    Kind GetKind() const;
+
+    /**
+     * \brief Get the variable type.
+     * \return type
+     */
+    const std::string& GetType() const;
+
+    /**
+     * \brief Get the variable or counter name, the comment or the code.
+     * \return name
+     */
+    const std::string& GetName() const;
+
+    /**
+     * \brief Get the value, the evaluated expression, the constructor call or the loop count.
+     * \return expression
+     */
+    const Expression& GetExpression() const;
+
+    /**
+     * \brief Get the body of a loop.
+     * \return body
+     */
+    const std::vector<Statement>& GetBody() const;
+
+    /**
+     * \brief Rename a variable in the statement, its expression and its body.
+     * \param from variable name
+     * \param to new variable name
+     */
+    void Rename(const std::string &from, const std::string &to);
+
+  private:
+    /**
+     * \brief Constructor.
+     * \param kind statement kind
+     * \param type variable type
+     * \param name variable or counter name, comment or code
+     * \param expression value
+     */
+    Statement(const Kind &kind, const std::string &type, const std::string &name, const Expression &expression);
+
+    /**
+     * \brief Statement kind.
+     */
+    Kind m_kind;
+
+    /**
+     * \brief Variable type.
+     */
+    std::string m_type;
+
+    /**
+     * \brief Variable or counter name, comment or code.
+     */
+    std::string m_name;
+
+    /**
+     * \brief Value, evaluated expression, constructor call or loop count.
+     */
+    Expression m_expression;
+
+    /**
+     * \brief Body of a loop.
+     */
+    std::vector<Statement> m_body;
+};
+
+#endif /* STATEMENT_H */
@@ -41,27 +41,32 @@ Tap::~Tap()
 {
 }
 
-std::vector<std::string> Tap::GenerateNetDeviceCpp()
+std::string Tap::GetSignature()
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
+  return NetworkHardware::GetSignature() + this->m_tapNode + "\n" + this->m_ifaceName + "\n";
+}
+
+std::vector<Statement> Tap::DescribeNetDevice()
+{
+  std::vector<Statement> ndc = this->GroupAsNodeContainer();
+  ndc.push_back(Statement::Define("NetDeviceContainer", this->GetNdcName(),
+        Expression::Method("csma_" + this->GetNetworkHardwareName(), "Install").Arg(Expression::Name(this->GetAllNodeContainer()))));
 
   return ndc;
 }
 
-std::vector<std::string> Tap::GenerateTapBridgeCpp()
+std::vector<Statement> Tap::DescribeTapBridge()
 {
-  std::vector<std::string> tapBridge;
+  std::vector<Statement> tapBridge;
+  std::string helper = "tapBridge_" + this->GetNetworkHardwareName();
 
-  tapBridge.push_back("TapBridgeHelper tapBridge_" + this->GetNetworkHardwareName() + " (iface_" + this->GetNdcName() + ".GetAddress(1));");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".SetAttribute (\"Mode\", StringValue (mode_" + this->GetNetworkHardwareName() + "));");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".SetAttribute (\"DeviceName\", StringValue (tapName_" + this->GetNetworkHardwareName() + "));");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".Install (" + this->m_tapNode + ".Get(0), " + this->GetNdcName() + ".Get(0));");
+  tapBridge.push_back(Statement::Construct("TapBridgeHelper", helper).Arg(Expression::Method("iface_" + this->GetNdcName(), "GetAddress").Arg(Expression::Name("1"))));
+  tapBridge.push_back(Statement::Call(helper, "SetAttribute").Arg(Expression::String("Mode"))
+      .Arg(Expression::Function("StringValue").Arg(Expression::Name("mode_" + this->GetNetworkHardwareName()))));
+  tapBridge.push_back(Statement::Call(helper, "SetAttribute").Arg(Expression::String("DeviceName"))
+      .Arg(Expression::Function("StringValue").Arg(Expression::Name("tapName_" + this->GetNetworkHardwareName()))));
+  tapBridge.push_back(Statement::Call(helper, "Install").Arg(Expression::Method(this->m_tapNode, "Get").Arg(Expression::Name("0")))
+      .Arg(Expression::Method(this->GetNdcName(), "Get").Arg(Expression::Name("0"))));
 
   return tapBridge;
 }
@@ -86,11 +91,11 @@ void Tap::SetIfaceName(const std::string &ifaceName)
   this->m_ifaceName = ifaceName;
 }
 
-std::vector<std::string> Tap::GenerateVarsCpp()
+std::vector<Statement> Tap::DescribeVars()
 {
-  std::vector<std::string> vars;
-  vars.push_back("std::string mode_" + this->GetNetworkHardwareName() + " = \"ConfigureLocal\";");
-  vars.push_back("std::string tapName_" + this->GetNetworkHardwareName() + " = \"" + this->m_ifaceName + "\";");
+  std::vector<Statement> vars = this->DescribeParameterVars();
+  vars.push_back(Statement::Define("std::string", "mode_" + this->GetNetworkHardwareName(), Expression::String("ConfigureLocal")));
+  vars.push_back(Statement::Define("std::string", "tapName_" + this->GetNetworkHardwareName(), Expression::String(this->m_ifaceName)));
   return vars;
 }
 
@@ -104,72 +109,22 @@ std::vector<std::string> Tap::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Tap::GenerateNetworkHardwareCpp()
+std::vector<Statement> Tap::DescribeNetworkHardware()
 {
-  std::vector<std::string> generatedLink;
-  generatedLink.push_back("CsmaHelper csma_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\", TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
+  std::vector<Statement> generatedLink;
+  generatedLink.push_back(Statement::Declare("CsmaHelper", "csma_" + this->GetNetworkHardwareName()));
+  std::vector<Statement> attributes = this->DescribeDataRateDelay("csma_" + this->GetNetworkHardwareName(), "SetChannelAttribute");
+  generatedLink.insert(generatedLink.end(), attributes.begin(), attributes.end());
 
   return generatedLink;
 }
 
-std::vector<std::string> Tap::GenerateCmdLineCpp()
-{
-  std::vector<std::string> cmdLine;
-  cmdLine.push_back("cmd.AddValue (\"mode_" + this->GetNetworkHardwareName() + "\", \"Mode Setting of TapBridge\", mode_" + this->GetNetworkHardwareName() + ");");
-  cmdLine.push_back("cmd.AddValue (\"tapName_" + this->GetNetworkHardwareName() + "\", \"Name of the OS tap device\", tapName_" + this->GetNetworkHardwareName() + ");");
-  return cmdLine;
-}
-
-std::vector<std::string> Tap::GenerateVarsPython()
-{
-  std::vector<std::string> vars;
-  vars.push_back("mode_" + this->GetNetworkHardwareName() + " = \"ConfigureLocal\"");
-  vars.push_back("tapName_" + this->GetNetworkHardwareName() + " = \"" + this->m_ifaceName + "\"");
-  return vars;
-}
-
-std::vector<std::string> Tap::GenerateCmdLinePython()
+std::vector<Statement> Tap::DescribeCmdLine()
 {
-  std::vector<std::string> cmdLine;
-  cmdLine.push_back("cmd.AddValue(\"mode_" + this->GetNetworkHardwareName() + "\", \"Mode Setting of TapBridge\", mode_" + this->GetNetworkHardwareName() + ")");
-  cmdLine.push_back("cmd.AddValue(\"tapName_" + this->GetNetworkHardwareName() + "\", \"Name of the OS tap device\", tapName_" + this->GetNetworkHardwareName() + ")");
+  std::vector<Statement> cmdLine = this->DescribeParameterCmdLine();
+  cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("mode_" + this->GetNetworkHardwareName()))
+      .Arg(Expression::String("Mode Setting of TapBridge")).Arg(Expression::Name("mode_" + this->GetNetworkHardwareName())));
+  cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("tapName_" + this->GetNetworkHardwareName()))
+      .Arg(Expression::String("Name of the OS tap device")).Arg(Expression::Name("tapName_" + this->GetNetworkHardwareName())));
   return cmdLine;
 }
-
-std::vector<std::string> Tap::GenerateNetworkHardwarePython()
-{
-  std::vector<std::string> generatedLink;
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + " = ns3.CsmaHelper()");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute(\"DataRate\", ns3.DataRateValue(ns3.DataRate(" + this->GetDataRate() + ")));");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute(\"Delay\", ns3.TimeValue(ns3.MilliSeconds(" + this->GetNetworkHardwareDelay() + ")));");
-
-  return generatedLink;
-}
-
-std::vector<std::string> Tap::GenerateNetDevicePython()
-{
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back(this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install(" + this->GetAllNodeContainer() + ");");
-
-  return ndc;
-}
-
-std::vector<std::string> Tap::GenerateTapBridgePython()
-{ 
-  std::vector<std::string> tapBridge;
-  
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + " = ns3.TapBridgeHelper(iface_" + this->GetNdcName() + ".GetAddress(1))");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".SetAttribute(\"Mode\", ns3.StringValue (mode_" + this->GetNetworkHardwareName() + "))");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".SetAttribute(\"DeviceName\", ns3.StringValue (tapName_" + this->GetNetworkHardwareName() + "))");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".Install(" + this->m_tapNode + ".Get(0), " + this->GetNdcName() + ".Get(0))");
-  
-  return tapBridge;
-} 
@@ -87,6 +87,12 @@ class Tap : public NetworkHardware
      */
     virtual ~Tap();
 
+    /**
+     * \brief Get the inputs of the code generation of the tap link.
+     * \return signature (one field per line)
+     */
+    virtual std::string GetSignature();
+
     /**
      * \brief Get tap node name.
      * \return tap name
@@ -118,64 +124,34 @@ class Tap : public NetworkHardware
     virtual std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate link C++ code.
+     * \brief Describe link code.
      * \return link code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual std::vector<Statement> DescribeNetworkHardware();
 
     /**
-     * \brief Generate net device container C++ code.
+     * \brief Describe net device container code.
      * \return net device container code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
-
-    /**
-     * \brief Function re-writted from link main class.
-     * \return tap bridge code
-     */
-    std::vector<std::string> GenerateTapBridgeCpp();
-
-    /**
-     * \brief Function re-writted from link main class.
-     * \return vars code
-     */
-    std::vector<std::string> GenerateVarsCpp();
+    virtual std::vector<Statement> DescribeNetDevice();
 
-    /**
-     * \brief Function re-wrotted from link main class.
-     * \return cmd line code
-     */
-    std::vector<std::string> GenerateCmdLineCpp();
-    
     /**
      * \brief Function re-writted from link main class.
      * \return tap bridge code
      */
-    std::vector<std::string> GenerateTapBridgePython();
+    std::vector<Statement> DescribeTapBridge();
 
     /**
      * \brief Function re-writted from link main class.
      * \return vars code
      */
-    std::vector<std::string> GenerateVarsPython();
+    std::vector<Statement> DescribeVars();
 
     /**
      * \brief Function re-wrotted from link main class.
      * \return cmd line code
      */
-    std::vector<std::string> GenerateCmdLinePython();
-    
-    /**
-     * \brief Generate link python code.
-     * \return link code
-     */
-    virtual std::vector<std::string> GenerateNetworkHardwarePython();
-
-    /**
-     * \brief Generate net device container python code.
-     * \return net device container code
-     */
-    virtual std::vector<std::string> GenerateNetDevicePython();
+    std::vector<Statement> DescribeCmdLine();
 };
 
 #endif /* TAP_H */
@@ -40,6 +40,11 @@ TcpLargeTransfer::~TcpLargeTransfer()
 {
 }
 
+std::string TcpLargeTransfer::GetSignature()
+{
+  return Application::GetSignature() + utils::integerToString(this->m_port) + "\n";
+}
+
 std::vector<std::string> TcpLargeTransfer::GenerateHeader()
 {
   std::vector<std::string> headers;
@@ -58,53 +63,62 @@ void TcpLargeTransfer::SetPort(const size_t &port)
   this->m_port = port;
 }
 
-std::vector<std::string> TcpLargeTransfer::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+std::vector<Statement> TcpLargeTransfer::DescribeApplication(const std::string &netDeviceContainer, const std::string &numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
-
-  apps.push_back("uint16_t port_" + this->GetAppName() + " = " + utils::integerToString(this->m_port) + ";");
-  apps.push_back("Address sinkLocalAddress_" + this->GetAppName() + " (InetSocketAddress (Ipv4Address::GetAny (), port_" + this->GetAppName() + "));");
-  apps.push_back("PacketSinkHelper sinkHelper_" + this->GetAppName() + " (\"ns3::TcpSocketFactory\", sinkLocalAddress_" + this->GetAppName() + ");");
-  apps.push_back("ApplicationContainer sinkApp_" + this->GetAppName() + " = sinkHelper_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ");");
-  apps.push_back("sinkApp_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("sinkApp_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  apps.push_back("OnOffHelper clientHelper_" + this->GetAppName() + " (\"ns3::TcpSocketFactory\", Address ());");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute (\"OnTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"));");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute (\"OffTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"));");
-
-  apps.push_back("ApplicationContainer clientApps_" + this->GetAppName() + ";");
-  apps.push_back("AddressValue remoteAddress_" + this->GetAppName() + " (InetSocketAddress (iface_" + netDeviceContainer + ".GetAddress (" + utils::integerToString(numberIntoNetDevice) + "), port_" + this->GetAppName() + "));");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute (\"Remote\", remoteAddress_" + this->GetAppName() + ");");
-  apps.push_back("clientApps_" + this->GetAppName() + ".Add (clientHelper_" + this->GetAppName() + ".Install (" + this->GetSenderNode() + "));");
-
-  apps.push_back("clientApps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("clientApps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
+  std::vector<Statement> apps;
+  std::vector<Statement> startStop;
+  std::string clientHelper = "clientHelper_" + this->GetAppName();
+
+  if(!this->GetParameterized())
+  {
+    apps.push_back(Statement::Define("uint16_t", "port_" + this->GetAppName(), Expression::Name(utils::integerToString(this->m_port))));
+  }
+  apps.push_back(Statement::Construct("Address", "sinkLocalAddress_" + this->GetAppName()).Arg(Expression::Function("InetSocketAddress")
+        .Arg(Expression::Static("Ipv4Address", "GetAny")).Arg(Expression::Name("port_" + this->GetAppName()))));
+  apps.push_back(Statement::Construct("PacketSinkHelper", "sinkHelper_" + this->GetAppName()).Arg(Expression::String("ns3::TcpSocketFactory"))
+      .Arg(Expression::Name("sinkLocalAddress_" + this->GetAppName())));
+  apps.push_back(Statement::Define("ApplicationContainer", "sinkApp_" + this->GetAppName(), Expression::Method("sinkHelper_" + this->GetAppName(), "Install")
+        .Arg(Expression::Name(this->GetReceiverNode()))));
+  startStop = this->DescribeStartStop("sinkApp_" + this->GetAppName(), "0", "0");
+  apps.insert(apps.end(), startStop.begin(), startStop.end());
+
+  apps.push_back(Statement::Construct("OnOffHelper", clientHelper).Arg(Expression::String("ns3::TcpSocketFactory")).Arg(Expression::Function("Address")));
+  apps.push_back(Statement::Call(clientHelper, "SetAttribute").Arg(Expression::String("OnTime"))
+      .Arg(Expression::Function("StringValue").Arg(Expression::String("ns3::ConstantRandomVariable[Constant=1]"))));
+  apps.push_back(Statement::Call(clientHelper, "SetAttribute").Arg(Expression::String("OffTime"))
+      .Arg(Expression::Function("StringValue").Arg(Expression::String("ns3::ConstantRandomVariable[Constant=0]"))));
+
+  apps.push_back(Statement::Declare("ApplicationContainer", "clientApps_" + this->GetAppName()));
+  apps.push_back(Statement::Construct("AddressValue", "remoteAddress_" + this->GetAppName()).Arg(Expression::Function("InetSocketAddress")
+        .Arg(Expression::Method("iface_" + netDeviceContainer, "GetAddress").Arg(Expression::Name(numberIntoNetDevice)))
+        .Arg(Expression::Name("port_" + this->GetAppName()))));
+  apps.push_back(Statement::Call(clientHelper, "SetAttribute").Arg(Expression::String("Remote")).Arg(Expression::Name("remoteAddress_" + this->GetAppName())));
+  apps.push_back(Statement::Call("clientApps_" + this->GetAppName(), "Add").Arg(Expression::Method(clientHelper, "Install")
+        .Arg(Expression::Name(this->GetSenderNode()))));
+
+  startStop = this->DescribeStartStop("clientApps_" + this->GetAppName(), "0", "0");
+  apps.insert(apps.end(), startStop.begin(), startStop.end());
 
   return apps;
 }
 
-std::vector<std::string> TcpLargeTransfer::GenerateApplicationPython(std::string netDeviceContainer, size_t numberIntoNetDevice)
+std::vector<Statement> TcpLargeTransfer::DescribeVars()
 {
-  std::vector<std::string> apps;
-
-  apps.push_back("port_" + this->GetAppName() + " = " + utils::integerToString(this->m_port));
-  apps.push_back("sinkLocalAddress_" + this->GetAppName() + " = ns3.Address(ns3.InetSocketAddress(ns3.Ipv4Address.GetAny(), port_" + this->GetAppName() + "))");
-  apps.push_back("sinkHelper_" + this->GetAppName() + " = ns3.PacketSinkHelper(\"ns3::TcpSocketFactory\", sinkLocalAddress_" + this->GetAppName() + ")");
-  apps.push_back("sinkApp_" + this->GetAppName() + " = sinkHelper_" + this->GetAppName() + ".Install(" + this->GetReceiverNode() + ")");
-  apps.push_back("sinkApp_" + this->GetAppName() + ".Start(ns3.Seconds(" + this->GetStartTime() + ".0))");
-  apps.push_back("sinkApp_" + this->GetAppName() + ".Stop(ns3.Seconds(" + this->GetEndTime() + ".0))");
-
-  apps.push_back("clientHelper_" + this->GetAppName() + " = ns3.OnOffHelper(\"ns3::TcpSocketFactory\", ns3.Address())");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute(\"OnTime\", ns3.StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"))");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute(\"OffTime\", ns3.StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"))");
-
-  apps.push_back("clientApps_" + this->GetAppName() + " = ns3.ApplicationContainer()");
-  apps.push_back("remoteAddress_" + this->GetAppName() + " = ns3.AddressValue(ns3.InetSocketAddress(iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "), port_" + this->GetAppName() + "))");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute(\"Remote\", remoteAddress_" + this->GetAppName() + ")");
-  apps.push_back("clientApps_" + this->GetAppName() + ".Add(clientHelper_" + this->GetAppName() + ".Install(" + this->GetSenderNode() + "))");
-
-  apps.push_back("clientApps_" + this->GetAppName() + ".Start(ns3.Seconds(" + this->GetStartTime() + ".0))");
-  apps.push_back("clientApps_" + this->GetAppName() + ".Stop(ns3.Seconds(" + this->GetEndTime() + ".0))");
-  return apps;
+  std::vector<Statement> vars = Application::DescribeVars();
+  if(this->GetParameterized())
+  {
+    vars.push_back(Statement::Define("uint16_t", "port_" + this->GetAppName(), Expression::Name(utils::integerToString(this->m_port))));
+  }
+  return vars;
+}
+
+std::vector<Statement> TcpLargeTransfer::DescribeCmdLine()
+{
+  std::vector<Statement> cmdLine = Application::DescribeCmdLine();
+  if(this->GetParameterized())
+  {
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("port_" + this->GetAppName()))
+        .Arg(Expression::String("Port of " + this->GetAppName())).Arg(Expression::Name("port_" + this->GetAppName())));
+  }
+  return cmdLine;
 }
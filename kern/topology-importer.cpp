@@ -0,0 +1,1167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-importer.cpp
+ * \brief Streaming importer of GraphML, BRITE, Rocketfuel and Inet topologies.
+ */
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "topology-importer.h"
+#include "codec.h"
+#include "generator.h"
+
+/**
+ * \brief Size of the read buffer.
+ */
+static const size_t BUFFER_SIZE = 1024 * 1024;
+
+/**
+ * \brief Number of records between two progress reports.
+ */
+static const size_t PROGRESS_RECORDS = 4096;
+
+/**
+ * \brief Number of nodes per row of the grid of the nodes without position.
+ */
+static const size_t GRID_COLUMNS = 100;
+
+TopologyImporter::Sink::~Sink()
+{
+}
+
+void TopologyImporter::Sink::Reserve(const size_t &/*nodes*/, const size_t &/*links*/)
+{
+}
+
+void TopologyImporter::Sink::AddLine(const ProjectFile::Line &/*line*/)
+{
+}
+
+bool TopologyImporter::Sink::Advance(const size_t &/*done*/, const size_t &/*total*/)
+{
+  return true;
+}
+
+TopologyImporter::GeneratorSink::GeneratorSink(Generator *gen)
+{
+  this->m_gen = gen;
+}
+
+void TopologyImporter::GeneratorSink::Reserve(const size_t &nodes, const size_t &links)
+{
+  this->m_gen->Reserve(this->m_gen->GetNNodes() + nodes, this->m_gen->GetNNetworkHardwares() + links);
+}
+
+std::string TopologyImporter::GeneratorSink::AddNode(const ProjectFile::Node &node)
+{
+  this->m_gen->AddNode(node.type, node.number);
+  Node *equi = this->m_gen->GetNode(this->m_gen->GetNNodes() - 1);
+  if(node.name != "")
+  {
+    equi->SetNodeName(node.name);
+  }
+  equi->SetNsc(node.nsc);
+  return equi->GetNodeName();
+}
+
+std::string TopologyImporter::GeneratorSink::AddLink(const ProjectFile::Link &link)
+{
+  if(link.type != "Hub" && link.type != "PointToPoint")
+  {
+    throw std::logic_error("Import failed! (" + link.type + ") unknow.");
+  }
+  this->m_gen->AddNetworkHardware(link.type);
+  NetworkHardware *hardware = this->m_gen->GetNetworkHardware(this->m_gen->GetNNetworkHardwares() - 1);
+  if(link.name != "")
+  {
+    hardware->SetNetworkHardwareName(link.name);
+  }
+  if(link.dataRate != "")
+  {
+    hardware->SetDataRate(link.dataRate);
+  }
+  if(link.delay != "")
+  {
+    hardware->SetNetworkHardwareDelay(link.delay);
+  }
+  hardware->SetTrace(link.trace);
+  hardware->SetPromisc(link.promisc);
+  for(size_t i = 0; i < link.members.size(); i++)
+  {
+    hardware->Install(link.members.at(i));
+  }
+  if(!link.hidden)
+  {
+    this->m_hubs[hardware->GetNetworkHardwareName()] = hardware;
+  }
+  return hardware->GetNetworkHardwareName();
+}
+
+void TopologyImporter::GeneratorSink::Install(const std::string &link, const std::string &node)
+{
+  std::map<std::string, NetworkHardware*>::iterator it = this->m_hubs.find(link);
+  if(it == this->m_hubs.end())
+  {
+    throw std::logic_error("Import failed! (" + link + ") not found.");
+  }
+  it->second->Install(node);
+}
+
+TopologyImporter::TopologyImporter(Sink *sink)
+{
+  this->m_sink = sink;
+  this->m_size = 0;
+  this->m_pos = 0;
+  this->m_end = 0;
+  this->m_line = 0;
+  this->m_records = 0;
+}
+
+TopologyImporter::~TopologyImporter()
+{
+}
+
+bool TopologyImporter::Import(const std::string &fileName, const std::string &format)
+{
+  this->m_fileName = fileName;
+  this->m_file.Open(fileName);
+  std::ifstream file(fileName.c_str(), std::ios::binary | std::ios::ate);
+  std::streamoff size = file.tellg();
+  this->m_size = size < 0 ? 0 : static_cast<size_t>(size);
+
+  this->m_buffer.resize(BUFFER_SIZE);
+  this->m_pos = 0;
+  this->m_end = 0;
+  this->m_line = 0;
+  this->m_records = 0;
+  this->m_nodes.clear();
+
+  std::string type = format != "" ? format : TopologyImporter::Detect(fileName);
+  if(type == "")
+  {
+    type = this->Sniff();
+  }
+
+  bool completed = false;
+  if(type == "graphml")
+  {
+    completed = this->ImportGraphml();
+  }
+  else if(type == "brite")
+  {
+    completed = this->ImportBrite();
+  }
+  else if(type == "rocketfuel")
+  {
+    completed = this->ImportRocketfuel();
+  }
+  else if(type == "inet")
+  {
+    completed = this->ImportInet();
+  }
+  else
+  {
+    throw std::logic_error("Import failed! (" + type + ") unknow.");
+  }
+
+  if(completed)
+  {
+    completed = this->m_sink->Advance(this->m_size, this->m_size);
+  }
+  this->m_file.Close();
+  this->m_nodes.clear();
+  return completed;
+}
+
+std::vector<std::string> TopologyImporter::GetFormats()
+{
+  std::vector<std::string> formats;
+  formats.push_back("graphml");
+  formats.push_back("brite");
+  formats.push_back("rocketfuel");
+  formats.push_back("inet");
+  return formats;
+}
+
+std::string TopologyImporter::Detect(const std::string &fileName)
+{
+  /* "topo.graphml.gz" is a compressed "topo.graphml". */
+  std::string name = fileName;
+  std::string codec = Codec::FromFileName(name);
+  if(codec != "")
+  {
+    Codec *c = Codec::Create(codec);
+    name = name.substr(0, name.size() - c->GetExtension().size());
+    delete c;
+  }
+
+  std::string::size_type slash = name.find_last_of("/\\");
+  std::string::size_type dot = name.find_last_of('.');
+  if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return "";
+  }
+  std::string extension = TopologyImporter::Normalize(name.substr(dot + 1));
+  if(extension == "graphml")
+  {
+    return "graphml";
+  }
+  if(extension == "brite")
+  {
+    return "brite";
+  }
+  if(extension == "cch")
+  {
+    return "rocketfuel";
+  }
+  if(extension == "inet")
+  {
+    return "inet";
+  }
+  return "";
+}
+
+bool TopologyImporter::ImportGraphml()
+{
+  /* key id to attribute name, and the default values of the attributes. */
+  std::map<std::string, std::string> keys;
+  std::map<std::string, std::string> nodeDefaults;
+  std::map<std::string, std::string> edgeDefaults;
+  std::string keyId = "";
+  std::string keyFor = "";
+
+  /* the open nodes (a node can hold a nested graph) and the open edge. */
+  std::vector<std::pair<std::string, std::map<std::string, std::string> > > nodes;
+  std::map<std::string, std::string> edge;
+  std::string source = "";
+  std::string target = "";
+  bool inEdge = false;
+
+  /* the open data element, its text is kept if it has no child element. */
+  std::string dataKey = "";
+  bool inData = false;
+
+  std::string name;
+  std::string text;
+  std::map<std::string, std::string> attributes;
+  bool closing = false;
+  bool empty = false;
+  this->m_line = 1;
+  while(this->ReadTag(name, attributes, closing, empty, text))
+  {
+    if(closing)
+    {
+      if(name == "data" && inData)
+      {
+        std::string value = text;
+        std::string::size_type begin = value.find_first_not_of(" \t\r\n");
+        std::string::size_type end = value.find_last_not_of(" \t\r\n");
+        value = begin == std::string::npos ? "" : value.substr(begin, end - begin + 1);
+        std::map<std::string, std::string>::const_iterator key = keys.find(dataKey);
+        std::string attribute = key != keys.end() ? key->second : TopologyImporter::Normalize(dataKey);
+        if(inEdge)
+        {
+          edge[attribute] = value;
+        }
+        else if(nodes.size() > 0)
+        {
+          nodes.back().second[attribute] = value;
+        }
+      }
+      else if(name == "default" && keyId != "")
+      {
+        std::string attribute = keys[keyId];
+        std::string value = TopologyImporter::Normalize(text) == "" ? "" : text;
+        if(keyFor == "node" || keyFor == "all")
+        {
+          nodeDefaults[attribute] = value;
+        }
+        if(keyFor == "edge" || keyFor == "all")
+        {
+          edgeDefaults[attribute] = value;
+        }
+      }
+      else if(name == "key")
+      {
+        keyId = "";
+      }
+      else if(name == "node" && nodes.size() > 0)
+      {
+        empty = true;
+      }
+      else if(name == "edge" && inEdge)
+      {
+        empty = true;
+      }
+      inData = false;
+      if(!empty)
+      {
+        continue;
+      }
+    }
+    else
+    {
+      inData = false;
+      if(name == "key")
+      {
+        keyId = attributes["id"];
+        keyFor = attributes.find("for") != attributes.end() ? attributes["for"] : "all";
+        keys[keyId] = TopologyImporter::Normalize(attributes.find("attr.name") != attributes.end() ? attributes["attr.name"] : keyId);
+        if(empty)
+        {
+          keyId = "";
+        }
+        continue;
+      }
+      else if(name == "node")
+      {
+        nodes.push_back(std::make_pair(attributes["id"], nodeDefaults));
+      }
+      else if(name == "edge")
+      {
+        source = attributes["source"];
+        target = attributes["target"];
+        if(source == "" || target == "")
+        {
+          this->Fail("edge without source or target");
+        }
+        edge = edgeDefaults;
+        inEdge = true;
+      }
+      else if(name == "data")
+      {
+        dataKey = attributes["key"];
+        inData = !empty;
+        continue;
+      }
+      else if(name == "Geometry" && nodes.size() > 0 && !inEdge)
+      {
+        /* yEd keeps the node position into its graphics data. */
+        std::map<std::string, std::string> &data = nodes.back().second;
+        if(data.find("x") == data.end() && data.find("y") == data.end())
+        {
+          data["x"] = attributes["x"];
+          data["y"] = attributes["y"];
+        }
+        continue;
+      }
+      else
+      {
+        continue;
+      }
+      if(!empty)
+      {
+        continue;
+      }
+    }
+
+    /* end of a node or an edge (closing or empty element tag). */
+    if(name == "node")
+    {
+      const std::string &id = nodes.back().first;
+      std::map<std::string, std::string> &data = nodes.back().second;
+      std::unordered_map<std::string, Entry>::const_iterator known = this->m_nodes.find(id);
+      if(known != this->m_nodes.end() && known->second.forward)
+      {
+        /* the router added for the edge can not become another node. */
+        this->Fail("node " + id + " defined after an edge using it");
+      }
+      std::string type = TopologyImporter::Normalize(data["type"]);
+      double hosts = 1;
+      TopologyImporter::ToNumber(data["hosts"], hosts);
+      double x = -1;
+      double y = -1;
+      double longitude = 0;
+      double latitude = 0;
+      if(!TopologyImporter::ToNumber(data["x"], x) || !TopologyImporter::ToNumber(data["y"], y))
+      {
+        x = -1;
+        y = -1;
+        if(TopologyImporter::ToNumber(data["longitude"], longitude) && TopologyImporter::ToNumber(data["latitude"], latitude))
+        {
+          x = (longitude + 180) * 10;
+          y = (90 - latitude) * 10;
+        }
+      }
+
+      if(type == "host" || type == "pc" || type == "server" || type == "terminal")
+      {
+        size_t number = hosts > 1 ? static_cast<size_t>(hosts) : 1;
+        this->AddNode(id, number > 1 ? "Pc-group" : "Pc", number, x, y);
+      }
+      else if(type == "hub" || type == "switch")
+      {
+        this->AddNode(id, "Hub", 1, x, y);
+      }
+      else
+      {
+        this->AddNode(id, "Router", 1, x, y);
+      }
+      nodes.pop_back();
+    }
+    else
+    {
+      std::string dataRate = "";
+      const char *bandwidths[] = {"bandwidth", "capacity", "linkspeedraw", "datarate"};
+      for(size_t i = 0; i < sizeof(bandwidths) / sizeof(bandwidths[0]) && dataRate == ""; i++)
+      {
+        dataRate = TopologyImporter::DataRate(edge[bandwidths[i]], 1);
+      }
+      std::string delay = TopologyImporter::Delay(edge["latency"]);
+      if(delay == "")
+      {
+        delay = TopologyImporter::Delay(edge["delay"]);
+      }
+      this->AddEdge(source, target, dataRate, delay);
+      inEdge = false;
+    }
+    if(!this->Continue())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TopologyImporter::ImportBrite()
+{
+  std::string line;
+  std::string section = "";
+  while(this->ReadLine(line))
+  {
+    std::vector<std::string> fields = TopologyImporter::Split(line);
+    if(fields.size() == 0)
+    {
+      continue;
+    }
+
+    /* "Topology: ( 10 Nodes, 9 Edges )" */
+    double nodes = 0;
+    double links = 0;
+    if(fields.at(0) == "Topology:")
+    {
+      if(fields.size() >= 5 && TopologyImporter::ToNumber(fields.at(2), nodes) && TopologyImporter::ToNumber(fields.at(4), links))
+      {
+        this->m_sink->Reserve(static_cast<size_t>(nodes), static_cast<size_t>(links));
+      }
+      continue;
+    }
+    if(fields.at(0).find("Nodes:") == 0 || fields.at(0).find("Edges:") == 0)
+    {
+      section = fields.at(0).substr(0, 5);
+      continue;
+    }
+
+    /* node: id x y indegree outdegree as type */
+    double x = 0;
+    double y = 0;
+    if(section == "Nodes")
+    {
+      if(fields.size() < 3 || !TopologyImporter::ToNumber(fields.at(1), x) || !TopologyImporter::ToNumber(fields.at(2), y))
+      {
+        this->Fail("bad node");
+      }
+      this->AddNode(fields.at(0), "Router", 1, x, y);
+    }
+    /* edge: id from to length delay bandwidth asfrom asto type */
+    else if(section == "Edges")
+    {
+      if(fields.size() < 6)
+      {
+        this->Fail("bad edge");
+      }
+      this->AddEdge(fields.at(1), fields.at(2), TopologyImporter::DataRate(fields.at(5), 1000000), TopologyImporter::Delay(fields.at(4)));
+    }
+    else
+    {
+      continue;
+    }
+    if(!this->Continue())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TopologyImporter::ImportRocketfuel()
+{
+  std::string line;
+  while(this->ReadLine(line))
+  {
+    std::vector<std::string> fields = TopologyImporter::Split(line);
+    if(fields.size() == 0 || fields.at(0).at(0) == '#')
+    {
+      continue;
+    }
+
+    /* "uid @loc [+] [bb] (degree) [&ext] -> <nuid-1> ... {-euid} ... =name rn" */
+    const std::string &uid = fields.at(0);
+    double id = 0;
+    if(!TopologyImporter::ToNumber(uid, id))
+    {
+      this->Fail("bad router id");
+    }
+    if(id < 0)
+    {
+      continue;
+    }
+    this->GetNode(uid);
+    for(size_t i = 1; i < fields.size(); i++)
+    {
+      const std::string &field = fields.at(i);
+      double neighbour = 0;
+      if(field.size() > 2 && field.at(0) == '<' && field.at(field.size() - 1) == '>' &&
+          TopologyImporter::ToNumber(field.substr(1, field.size() - 2), neighbour) && neighbour >= 0 && id < neighbour)
+      {
+        /* both ends list the link, it is added by the lower uid. */
+        this->AddEdge(uid, field.substr(1, field.size() - 2), "", "");
+      }
+    }
+    if(!this->Continue())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TopologyImporter::ImportInet()
+{
+  std::string line;
+  double nodes = -1;
+  double links = -1;
+  size_t nodesRead = 0;
+  while(this->ReadLine(line))
+  {
+    std::vector<std::string> fields = TopologyImporter::Split(line);
+    if(fields.size() == 0)
+    {
+      continue;
+    }
+
+    /* "nodes links" */
+    if(nodes < 0)
+    {
+      if(fields.size() < 2 || !TopologyImporter::ToNumber(fields.at(0), nodes) || !TopologyImporter::ToNumber(fields.at(1), links))
+      {
+        this->Fail("bad header");
+      }
+      this->m_sink->Reserve(static_cast<size_t>(nodes), static_cast<size_t>(links));
+      continue;
+    }
+
+    /* "id x y" then "from to weight" */
+    if(nodesRead < nodes)
+    {
+      double x = 0;
+      double y = 0;
+      if(fields.size() < 3 || !TopologyImporter::ToNumber(fields.at(1), x) || !TopologyImporter::ToNumber(fields.at(2), y))
+      {
+        this->Fail("bad node");
+      }
+      this->AddNode(fields.at(0), "Router", 1, x, y);
+      nodesRead++;
+    }
+    else
+    {
+      if(fields.size() < 2)
+      {
+        this->Fail("bad link");
+      }
+      this->AddEdge(fields.at(0), fields.at(1), "", "");
+    }
+    if(!this->Continue())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+const TopologyImporter::Entry& TopologyImporter::AddNode(const std::string &id, const std::string &type, const size_t &number, const double &x, const double &y)
+{
+  /* a node already used by an edge keeps its first definition. */
+  std::unordered_map<std::string, Entry>::const_iterator it = this->m_nodes.find(id);
+  if(it != this->m_nodes.end())
+  {
+    return it->second;
+  }
+
+  size_t index = this->m_nodes.size();
+  size_t posX = 20 + (index % GRID_COLUMNS) * 80;
+  size_t posY = 20 + (index / GRID_COLUMNS) * 80;
+  if(x >= 0 && y >= 0)
+  {
+    posX = static_cast<size_t>(x);
+    posY = static_cast<size_t>(y);
+  }
+
+  Entry entry;
+  entry.forward = false;
+  entry.x = posX;
+  entry.y = posY;
+  if(type == "Hub")
+  {
+    ProjectFile::Link link;
+    link.hidden = false;
+    link.type = type;
+    link.name = "";
+    link.dataRate = "";
+    link.delay = "";
+    link.trace = false;
+    link.promisc = false;
+    std::ostringstream special;
+    special << posX << "-" << posY;
+    link.special = special.str();
+    entry.name = this->m_sink->AddLink(link);
+    entry.hub = true;
+  }
+  else
+  {
+    ProjectFile::Node node;
+    node.type = type;
+    node.name = "";
+    node.nsc = "";
+    node.number = number;
+    node.x = posX;
+    node.y = posY;
+    entry.name = this->m_sink->AddNode(node);
+    entry.hub = false;
+  }
+  return this->m_nodes[id] = entry;
+}
+
+const TopologyImporter::Entry& TopologyImporter::GetNode(const std::string &id)
+{
+  std::unordered_map<std::string, Entry>::const_iterator it = this->m_nodes.find(id);
+  if(it != this->m_nodes.end())
+  {
+    return it->second;
+  }
+  this->AddNode(id, "Router", 1, -1, -1);
+  Entry &entry = this->m_nodes[id];
+  entry.forward = true;
+  return entry;
+}
+
+void TopologyImporter::AddEdge(const std::string &source, const std::string &target, const std::string &dataRate, const std::string &delay)
+{
+  if(source == target)
+  {
+    return;
+  }
+  /* the entries stay valid when the table grows. */
+  const Entry &first = this->GetNode(source);
+  const Entry &second = this->GetNode(target);
+
+  ProjectFile::Line line;
+  if(first.hub && second.hub)
+  {
+    /* a hub can not be a hub member, a router joins both hubs. */
+    ProjectFile::Node node;
+    node.type = "Router";
+    node.name = "";
+    node.nsc = "";
+    node.number = 1;
+    node.x = (first.x + second.x) / 2;
+    node.y = (first.y + second.y) / 2;
+    std::string router = this->m_sink->AddNode(node);
+    this->m_sink->Install(first.name, router);
+    this->m_sink->Install(second.name, router);
+    line.first = router;
+    line.second = first.name;
+    line.type = "WiredLink";
+    this->m_sink->AddLine(line);
+    line.second = second.name;
+  }
+  else if(first.hub || second.hub)
+  {
+    const Entry &hub = first.hub ? first : second;
+    const Entry &node = first.hub ? second : first;
+    this->m_sink->Install(hub.name, node.name);
+    line.first = node.name;
+    line.second = hub.name;
+    line.type = "WiredLink";
+  }
+  else
+  {
+    ProjectFile::Link link;
+    link.hidden = true;
+    link.type = "PointToPoint";
+    link.name = "";
+    link.dataRate = dataRate;
+    link.delay = delay;
+    link.trace = false;
+    link.promisc = false;
+    link.special = "";
+    link.members.push_back(first.name);
+    link.members.push_back(second.name);
+    this->m_sink->AddLink(link);
+    line.first = first.name;
+    line.second = second.name;
+    line.type = "P2pLink";
+  }
+  this->m_sink->AddLine(line);
+}
+
+std::string TopologyImporter::Sniff()
+{
+  if(this->m_pos == this->m_end && !this->Fill())
+  {
+    throw std::logic_error("Import failed! (" + this->m_fileName + ") empty file.");
+  }
+
+  /* the first line of the buffer, it is not consumed. */
+  const char *begin = &this->m_buffer[this->m_pos];
+  const char *end = begin + (this->m_end - this->m_pos);
+  while(begin < end && isspace(static_cast<unsigned char>(*begin)))
+  {
+    begin++;
+  }
+  const char *newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
+  std::string line(begin, newline ? newline : end);
+
+  if(line.size() > 0 && line.at(0) == '<')
+  {
+    return "graphml";
+  }
+  if(line.find("Topology:") == 0)
+  {
+    return "brite";
+  }
+  std::vector<std::string> fields = TopologyImporter::Split(line);
+  double number = 0;
+  if(fields.size() == 2 && TopologyImporter::ToNumber(fields.at(0), number) && TopologyImporter::ToNumber(fields.at(1), number))
+  {
+    return "inet";
+  }
+  return "rocketfuel";
+}
+
+bool TopologyImporter::Continue()
+{
+  this->m_records++;
+  if(this->m_records % PROGRESS_RECORDS != 0)
+  {
+    return true;
+  }
+  return this->m_sink->Advance(this->m_file.GetFilePosition(), this->m_size);
+}
+
+bool TopologyImporter::Fill()
+{
+  this->m_pos = 0;
+  this->m_end = this->m_file.Read(&this->m_buffer[0], this->m_buffer.size());
+  return this->m_end > 0;
+}
+
+bool TopologyImporter::ReadLine(std::string &line)
+{
+  line.clear();
+  bool read = false;
+  while(this->m_pos < this->m_end || this->Fill())
+  {
+    const char *begin = &this->m_buffer[this->m_pos];
+    size_t size = this->m_end - this->m_pos;
+    const char *newline = static_cast<const char*>(memchr(begin, '\n', size));
+    read = true;
+    if(newline)
+    {
+      line.append(begin, newline - begin);
+      this->m_pos += newline - begin + 1;
+      break;
+    }
+    line.append(begin, size);
+    this->m_pos = this->m_end;
+  }
+  if(!read)
+  {
+    return false;
+  }
+  if(line.size() > 0 && line.at(line.size() - 1) == '\r')
+  {
+    line.erase(line.size() - 1);
+  }
+  this->m_line++;
+  return true;
+}
+
+bool TopologyImporter::ReadChar(char &c)
+{
+  if(this->m_pos == this->m_end && !this->Fill())
+  {
+    return false;
+  }
+  c = this->m_buffer[this->m_pos++];
+  if(c == '\n')
+  {
+    this->m_line++;
+  }
+  return true;
+}
+
+bool TopologyImporter::ReadTag(std::string &name, std::map<std::string, std::string> &attributes, bool &closing, bool &empty, std::string &text)
+{
+  name = "";
+  attributes.clear();
+  closing = false;
+  empty = false;
+  text = "";
+
+  std::string raw = "";
+  char c = 0;
+  while(true)
+  {
+    if(!this->ReadChar(c))
+    {
+      return false;
+    }
+    if(c != '<')
+    {
+      raw += c;
+      continue;
+    }
+    text += TopologyImporter::DecodeXml(raw);
+    raw = "";
+
+    if(!this->ReadChar(c))
+    {
+      this->Fail("unexpected end of file");
+    }
+
+    /* processing instruction, comment, CDATA section or DOCTYPE. */
+    if(c == '?' || c == '!')
+    {
+      std::string markup(1, c);
+      std::string terminator = c == '?' ? "?>" : ">";
+      int depth = 0;
+      while(true)
+      {
+        if(!this->ReadChar(c))
+        {
+          this->Fail("unexpected end of file");
+        }
+        markup += c;
+        if(markup == "!--")
+        {
+          terminator = "-->";
+        }
+        else if(markup == "![CDATA[")
+        {
+          terminator = "]]>";
+        }
+        if(terminator == ">")
+        {
+          /* the DOCTYPE internal subset holds ">" between brackets. */
+          depth += c == '[' ? 1 : c == ']' ? -1 : 0;
+          if(c == '>' && depth <= 0)
+          {
+            break;
+          }
+        }
+        else if(markup.size() >= terminator.size() + 1 &&
+            markup.compare(markup.size() - terminator.size(), terminator.size(), terminator) == 0)
+        {
+          break;
+        }
+      }
+      if(terminator == "]]>")
+      {
+        text += markup.substr(8, markup.size() - 11);
+      }
+      continue;
+    }
+
+    /* element tag, ">" can appear into the quoted attribute values. */
+    std::string tag(1, c);
+    char quote = 0;
+    while(true)
+    {
+      if(!this->ReadChar(c))
+      {
+        this->Fail("unexpected end of file");
+      }
+      if(quote == 0 && c == '>')
+      {
+        break;
+      }
+      if(quote == 0 && (c == '"' || c == '\''))
+      {
+        quote = c;
+      }
+      else if(c == quote)
+      {
+        quote = 0;
+      }
+      tag += c;
+    }
+
+    size_t pos = 0;
+    if(tag.at(0) == '/')
+    {
+      closing = true;
+      pos = 1;
+    }
+    if(tag.at(tag.size() - 1) == '/')
+    {
+      empty = true;
+      tag.erase(tag.size() - 1);
+    }
+    size_t begin = pos;
+    while(pos < tag.size() && !isspace(static_cast<unsigned char>(tag.at(pos))))
+    {
+      pos++;
+    }
+    name = tag.substr(begin, pos - begin);
+    std::string::size_type colon = name.find(':');
+    if(colon != std::string::npos)
+    {
+      name = name.substr(colon + 1);
+    }
+
+    /* attributes: name = "value" */
+    while(true)
+    {
+      pos = tag.find_first_not_of(" \t\r\n", pos);
+      if(pos == std::string::npos)
+      {
+        break;
+      }
+      std::string::size_type equal = tag.find('=', pos);
+      if(equal == std::string::npos)
+      {
+        this->Fail("bad attribute in " + name);
+      }
+      std::string attribute = tag.substr(pos, equal - pos);
+      attribute = attribute.substr(0, attribute.find_last_not_of(" \t\r\n") + 1);
+      std::string::size_type open = tag.find_first_of("\"'", equal);
+      if(open == std::string::npos)
+      {
+        this->Fail("bad attribute in " + name);
+      }
+      std::string::size_type close = tag.find(tag.at(open), open + 1);
+      if(close == std::string::npos)
+      {
+        this->Fail("bad attribute in " + name);
+      }
+      attributes[attribute] = TopologyImporter::DecodeXml(tag.substr(open + 1, close - open - 1));
+      pos = close + 1;
+    }
+    return true;
+  }
+}
+
+void TopologyImporter::Fail(const std::string &message) const
+{
+  std::ostringstream line;
+  line << this->m_line;
+  throw std::logic_error("Import failed! (" + this->m_fileName + ":" + line.str() + ": " + message + ").");
+}
+
+std::string TopologyImporter::DataRate(const std::string &value, const double &scale)
+{
+  double number = 0;
+  if(!TopologyImporter::ToNumber(value, number) || number <= 0)
+  {
+    return "";
+  }
+
+  /* the unit follows the number. */
+  const char *begin = value.c_str();
+  char *end = NULL;
+  strtod(begin, &end);
+  std::string unit = TopologyImporter::Normalize(value.substr(end - begin));
+  double factor = scale;
+  if(unit == "bps" || unit == "b/s" || unit == "bit/s")
+  {
+    factor = 1;
+  }
+  else if(unit == "kbps" || unit == "kb/s" || unit == "kbit/s" || unit == "k")
+  {
+    factor = 1e3;
+  }
+  else if(unit == "mbps" || unit == "mb/s" || unit == "mbit/s" || unit == "m")
+  {
+    factor = 1e6;
+  }
+  else if(unit == "gbps" || unit == "gb/s" || unit == "gbit/s" || unit == "g")
+  {
+    factor = 1e9;
+  }
+  else if(unit != "")
+  {
+    return "";
+  }
+
+  std::ostringstream dataRate;
+  dataRate << std::fixed << std::setprecision(0) << floor(number * factor + 0.5);
+  return dataRate.str();
+}
+
+std::string TopologyImporter::Delay(const std::string &value)
+{
+  double number = 0;
+  if(!TopologyImporter::ToNumber(value, number) || number < 0)
+  {
+    return "";
+  }
+
+  const char *begin = value.c_str();
+  char *end = NULL;
+  strtod(begin, &end);
+  std::string unit = TopologyImporter::Normalize(value.substr(end - begin));
+  double factor = 1;
+  if(unit == "s")
+  {
+    factor = 1e3;
+  }
+  else if(unit == "us")
+  {
+    factor = 1e-3;
+  }
+  else if(unit == "ns")
+  {
+    factor = 1e-6;
+  }
+  else if(unit != "" && unit != "ms")
+  {
+    return "";
+  }
+
+  std::ostringstream delay;
+  delay << std::fixed << std::setprecision(0) << floor(number * factor + 0.5);
+  return delay.str();
+}
+
+std::string TopologyImporter::DecodeXml(const std::string &text)
+{
+  if(text.find('&') == std::string::npos)
+  {
+    return text;
+  }
+  std::string decoded = "";
+  size_t pos = 0;
+  while(pos < text.size())
+  {
+    std::string::size_type amp = text.find('&', pos);
+    std::string::size_type semicolon = amp == std::string::npos ? std::string::npos : text.find(';', amp);
+    if(semicolon == std::string::npos)
+    {
+      decoded += text.substr(pos);
+      break;
+    }
+    decoded += text.substr(pos, amp - pos);
+    std::string entity = text.substr(amp + 1, semicolon - amp - 1);
+    if(entity == "lt")
+    {
+      decoded += '<';
+    }
+    else if(entity == "gt")
+    {
+      decoded += '>';
+    }
+    else if(entity == "amp")
+    {
+      decoded += '&';
+    }
+    else if(entity == "quot")
+    {
+      decoded += '"';
+    }
+    else if(entity == "apos")
+    {
+      decoded += '\'';
+    }
+    else if(entity.size() > 1 && entity.at(0) == '#')
+    {
+      /* the character references out of ascii are kept as is. */
+      long code = entity.at(1) == 'x' ? strtol(entity.c_str() + 2, NULL, 16) : strtol(entity.c_str() + 1, NULL, 10);
+      if(code > 0 && code < 128)
+      {
+        decoded += static_cast<char>(code);
+      }
+      else
+      {
+        decoded += "&" + entity + ";";
+      }
+    }
+    else
+    {
+      decoded += "&" + entity + ";";
+    }
+    pos = semicolon + 1;
+  }
+  return decoded;
+}
+
+bool TopologyImporter::ToNumber(const std::string &value, double &number)
+{
+  const char *begin = value.c_str();
+  char *end = NULL;
+  double result = strtod(begin, &end);
+  if(end == begin)
+  {
+    return false;
+  }
+  number = result;
+  return true;
+}
+
+std::string TopologyImporter::Normalize(const std::string &value)
+{
+  std::string::size_type begin = value.find_first_not_of(" \t\r\n");
+  if(begin == std::string::npos)
+  {
+    return "";
+  }
+  std::string::size_type end = value.find_last_not_of(" \t\r\n");
+  std::string normalized = value.substr(begin, end - begin + 1);
+  for(size_t i = 0; i < normalized.size(); i++)
+  {
+    normalized[i] = tolower(static_cast<unsigned char>(normalized[i]));
+  }
+  return normalized;
+}
+
+std::vector<std::string> TopologyImporter::Split(const std::string &line)
+{
+  std::vector<std::string> fields;
+  size_t pos = 0;
+  while(true)
+  {
+    pos = line.find_first_not_of(" \t\r", pos);
+    if(pos == std::string::npos)
+    {
+      break;
+    }
+    std::string::size_type end = line.find_first_of(" \t\r", pos);
+    fields.push_back(line.substr(pos, end == std::string::npos ? std::string::npos : end - pos));
+    pos = end;
+  }
+  return fields;
+}
@@ -0,0 +1,442 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-importer.h
+ * \brief Streaming importer of GraphML, BRITE, Rocketfuel and Inet topologies.
+ */
+
+#ifndef TOPOLOGY_IMPORTER_H
+#define TOPOLOGY_IMPORTER_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "compressed-file.h"
+#include "project-file.h"
+
+class Generator;
+class NetworkHardware;
+
+/**
+ * \ingroup generator
+ * \brief Streaming importer of GraphML, BRITE, Rocketfuel and Inet topologies.
+ *
+ *  The file is read once, through a fixed size buffer, and each node or edge
+ *  is given to a sink as soon as it is parsed: only the table from the file
+ *  node ids to the generator names is kept, the edges are never stored. The
+ *  file can be compressed (see CompressedFile).
+ *
+ *  Mapping:
+ *    - a node is a "Router", a GraphML node typed "host" or "pc" is a "Pc"
+ *      (a "Pc-group" when it has more than one host) and a node typed "hub"
+ *      or "switch" is a "Hub" link,
+ *    - an edge is a hidden "PointToPoint" link between its nodes, an edge to
+ *      a hub installs the node on the hub, an edge between two hubs is a
+ *      "Router" installed on both,
+ *    - the edge bandwidth gives the data rate (in bps) and the latency gives
+ *      the delay (in ms), the link defaults are kept otherwise,
+ *    - the file coordinates give the canvas positions (GraphML x/y or
+ *      Longitude/Latitude, BRITE and Inet x y), else the nodes are put on a grid.
+ *
+ *  Supported formats:
+ *    - "graphml": the key, node, edge and data elements (and the yEd node
+ *      geometry), the other elements are skipped. A node must be defined
+ *      before the edges which use it (an edge to an undefined node adds a
+ *      router, a later definition of it is an error). A unit-less bandwidth
+ *      is in bps, a unit-less latency in ms.
+ *    - "brite": the "Nodes:" and "Edges:" sections of a BRITE output, the
+ *      edge delay is in ms and its bandwidth in Mbps.
+ *    - "rocketfuel": a Rocketfuel ".cch" router map, the "<uid>" neighbours
+ *      of each router (each link is listed by both ends, it is kept once),
+ *      the external routers (negative uid) are skipped.
+ *    - "inet": an Inet output, "nodes links", the node lines "id x y", the
+ *      link lines "from to weight" (the weight is not a latency, it is skipped).
+ */
+class TopologyImporter
+{
+  public:
+    /**
+     * \brief Receiver of the imported objects.
+     */
+    class Sink
+    {
+      public:
+        /**
+         * \brief Destructor.
+         */
+        virtual ~Sink();
+
+        /**
+         * \brief Announce the number of objects, when the file gives it.
+         * \param nodes number of nodes
+         * \param links number of links
+         */
+        virtual void Reserve(const size_t &nodes, const size_t &links);
+
+        /**
+         * \brief Add a node.
+         * \param node node record (the name is empty, the sink names it)
+         * \return node name
+         */
+        virtual std::string AddNode(const ProjectFile::Node &node) = 0;
+
+        /**
+         * \brief Add a link.
+         * \param link link record (the name is empty, the sink names it)
+         * \return link name
+         */
+        virtual std::string AddLink(const ProjectFile::Link &link) = 0;
+
+        /**
+         * \brief Install a node on a link added before.
+         * \param link link name
+         * \param node node name
+         */
+        virtual void Install(const std::string &link, const std::string &node) = 0;
+
+        /**
+         * \brief Add a canvas line.
+         * \param line line record
+         */
+        virtual void AddLine(const ProjectFile::Line &line);
+
+        /**
+         * \brief Progress of the import.
+         * \param done part of the file already read
+         * \param total whole file
+         * \return false to cancel the import
+         */
+        virtual bool Advance(const size_t &done, const size_t &total);
+    };
+
+    /**
+     * \brief Sink which adds the objects to a generator, without canvas.
+     */
+    class GeneratorSink : public Sink
+    {
+      public:
+        /**
+         * \brief Constructor.
+         * \param gen the generator
+         */
+        GeneratorSink(Generator *gen);
+
+        /**
+         * \brief Reserve the generator lists.
+         * \param nodes number of nodes
+         * \param links number of links
+         */
+        virtual void Reserve(const size_t &nodes, const size_t &links);
+
+        /**
+         * \brief Add a node to the generator.
+         * \param node node record
+         * \return node name
+         */
+        virtual std::string AddNode(const ProjectFile::Node &node);
+
+        /**
+         * \brief Add a link to the generator.
+         * \param link link record
+         * \return link name
+         */
+        virtual std::string AddLink(const ProjectFile::Link &link);
+
+        /**
+         * \brief Install a node on a link.
+         * \param link link name
+         * \param node node name
+         */
+        virtual void Install(const std::string &link, const std::string &node);
+
+      private:
+        /**
+         * \brief The generator.
+         */
+        Generator *m_gen;
+
+        /**
+         * \brief Links which get members later (the hubs).
+         */
+        std::map<std::string, NetworkHardware*> m_hubs;
+    };
+
+    /**
+     * \brief Constructor.
+     * \param sink receiver of the imported objects
+     */
+    TopologyImporter(Sink *sink);
+
+    /**
+     * \brief Destructor.
+     */
+    ~TopologyImporter();
+
+    /**
+     * \brief Import a topology file.
+     * \param fileName file name
+     * \param format format name (empty to detect it, from the extension or else the first line)
+     * \return false if the import was canceled by the sink
+     */
+    bool Import(const std::string &fileName, const std::string &format = "");
+
+    /**
+     * \brief Get the known formats.
+     * \return format names
+     */
+    static std::vector<std::string> GetFormats();
+
+    /**
+     * \brief Find the format of a file from its extension.
+     *
+     *  ".graphml", ".brite", ".cch" and ".inet", also followed by a codec
+     *  extension ("topo.graphml.gz").
+     *
+     * \param fileName file name
+     * \return format name (empty if unknown)
+     */
+    static std::string Detect(const std::string &fileName);
+
+  private:
+    /**
+     * \brief Imported node.
+     */
+    struct Entry
+    {
+      /**
+       * \brief Generator name.
+       */
+      std::string name;
+
+      /**
+       * \brief If the node is a hub link.
+       */
+      bool hub;
+      /**
+       * \brief If the node was added by an edge, before its definition.
+       */
+      bool forward;
+      /**
+       * \brief Canvas position.
+       */
+      size_t x;
+      /**
+       * \brief Canvas position.
+       */
+      size_t y;
+    };
+
+    /**
+     * \brief Receiver of the imported objects.
+     */
+    Sink *m_sink;
+
+    /**
+     * \brief Imported file.
+     */
+    CompressedFile m_file;
+
+    /**
+     * \brief File name.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief File size (in bytes, compressed).
+     */
+    size_t m_size;
+
+    /**
+     * \brief Read buffer.
+     */
+    std::vector<char> m_buffer;
+
+    /**
+     * \brief Next character into the buffer.
+     */
+    size_t m_pos;
+
+    /**
+     * \brief End of the data into the buffer.
+     */
+    size_t m_end;
+
+    /**
+     * \brief Current line (for the errors).
+     */
+    size_t m_line;
+
+    /**
+     * \brief Number of records since the last progress.
+     */
+    size_t m_records;
+
+    /**
+     * \brief File node ids to imported nodes.
+     */
+    std::unordered_map<std::string, Entry> m_nodes;
+
+    /**
+     * \brief Import a GraphML file.
+     * \return false if canceled
+     */
+    bool ImportGraphml();
+
+    /**
+     * \brief Import a BRITE file.
+     * \return false if canceled
+     */
+    bool ImportBrite();
+
+    /**
+     * \brief Import a Rocketfuel file.
+     * \return false if canceled
+     */
+    bool ImportRocketfuel();
+
+    /**
+     * \brief Import an Inet file.
+     * \return false if canceled
+     */
+    bool ImportInet();
+
+    /**
+     * \brief Add a node.
+     * \param id file node id
+     * \param type "Router", "Pc", "Pc-group" or "Hub"
+     * \param number number of machines
+     * \param x canvas position (-1 for the grid)
+     * \param y canvas position (-1 for the grid)
+     * \return imported node
+     */
+    const Entry& AddNode(const std::string &id, const std::string &type, const size_t &number, const double &x, const double &y);
+
+    /**
+     * \brief Get a node, a router is added for an unknown id.
+     * \param id file node id
+     * \return imported node
+     */
+    const Entry& GetNode(const std::string &id);
+
+    /**
+     * \brief Add an edge.
+     * \param source source node id
+     * \param target target node id
+     * \param dataRate data rate (in bps, empty for the default)
+     * \param delay delay (in ms, empty for the default)
+     */
+    void AddEdge(const std::string &source, const std::string &target, const std::string &dataRate, const std::string &delay);
+
+    /**
+     * \brief Find the format from the first line, without consuming it.
+     * \return format name
+     */
+    std::string Sniff();
+
+    /**
+     * \brief Count a record and report the progress.
+     * \return false if the import is canceled
+     */
+    bool Continue();
+
+    /**
+     * \brief Read a line.
+     * \param line line, without the end of line (output)
+     * \return false at the end of the file
+     */
+    bool ReadLine(std::string &line);
+
+    /**
+     * \brief Read the next part of the file into the buffer.
+     * \return false at the end of the file
+     */
+    bool Fill();
+
+    /**
+     * \brief Read a character.
+     * \param c character (output)
+     * \return false at the end of the file
+     */
+    bool ReadChar(char &c);
+
+    /**
+     * \brief Read the next xml tag.
+     * \param name tag name, without namespace prefix (output)
+     * \param attributes tag attributes (output)
+     * \param closing true for a closing tag (output)
+     * \param empty true for an empty element tag (output)
+     * \param text character data before the tag (output)
+     * \return false at the end of the file
+     */
+    bool ReadTag(std::string &name, std::map<std::string, std::string> &attributes, bool &closing, bool &empty, std::string &text);
+
+    /**
+     * \brief Throw an import error at the current line.
+     * \param message error message
+     */
+    void Fail(const std::string &message) const;
+
+    /**
+     * \brief Convert a bandwidth into a data rate.
+     * \param value number with an optional unit ("bps", "kbps", "Mbps", "Gbps")
+     * \param scale value of the unit-less number (in bps)
+     * \return data rate (in bps, empty if the value is not a number)
+     */
+    static std::string DataRate(const std::string &value, const double &scale);
+
+    /**
+     * \brief Convert a latency into a delay.
+     * \param value number with an optional unit ("s", "ms", "us", "ns")
+     * \return delay (in ms, empty if the value is not a number)
+     */
+    static std::string Delay(const std::string &value);
+
+    /**
+     * \brief Decode the xml entities.
+     * \param text xml text
+     * \return decoded text
+     */
+    static std::string DecodeXml(const std::string &text);
+
+    /**
+     * \brief Parse a number.
+     * \param value text
+     * \param number number (output)
+     * \return false if the text does not start with a number
+     */
+    static bool ToNumber(const std::string &value, double &number);
+
+    /**
+     * \brief Lower case and trim a text.
+     * \param value text
+     * \return lower case text, without the surrounding spaces
+     */
+    static std::string Normalize(const std::string &value);
+
+    /**
+     * \brief Split a line on blanks.
+     * \param line line
+     * \return fields
+     */
+    static std::vector<std::string> Split(const std::string &line);
+};
+
+#endif /* TOPOLOGY_IMPORTER_H */
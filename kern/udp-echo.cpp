@@ -44,6 +44,12 @@ UdpEcho::~UdpEcho()
 {
 }
 
+std::string UdpEcho::GetSignature()
+{
+  return Application::GetSignature() + utils::integerToString(this->m_port) + "\n" + utils::integerToString(this->m_packetSize) + "\n" +
+    utils::integerToString(this->m_maxPacketCount) + "\n" + this->m_packetIntervalTime + "\n";
+}
+
 size_t UdpEcho::GetPort()
 {
   return this->m_port;
@@ -92,44 +98,68 @@ std::vector<std::string> UdpEcho::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> UdpEcho::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+std::vector<Statement> UdpEcho::DescribeApplication(const std::string &netDeviceContainer, const std::string &numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
-
-  apps.push_back("uint16_t port_" + this->GetAppName() + " = " + utils::integerToString(this->m_port) + ";"); 
-  apps.push_back("UdpEchoServerHelper server_" + this->GetAppName() + " (port_" + this->GetAppName() + ");");
-  apps.push_back("ApplicationContainer apps_" + this->GetAppName() + " = server_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ".Get(0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  apps.push_back("Time interPacketInterval_" + this->GetAppName() + " = Seconds (" + this->m_packetIntervalTime + ");");
-  apps.push_back("UdpEchoClientHelper client_" + this->GetAppName() + " (iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "), " + utils::integerToString(this->m_port) + ");");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"MaxPackets\", UintegerValue (" + utils::integerToString(this->m_maxPacketCount) + "));");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"Interval\", TimeValue (interPacketInterval_" + this->GetAppName() + "));");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"PacketSize\", UintegerValue (" + utils::integerToString(this->m_packetSize) + "));");
-  apps.push_back("apps_" + this->GetAppName() + " = client_" + this->GetAppName() + ".Install (" + this->GetSenderNode() + ".Get (0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".1));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
+  std::vector<Statement> apps;
+  std::vector<Statement> startStop;
+  std::string client = "client_" + this->GetAppName();
+  std::string container = "apps_" + this->GetAppName();
+
+  if(!this->GetParameterized())
+  {
+    apps.push_back(Statement::Define("uint16_t", "port_" + this->GetAppName(), Expression::Name(utils::integerToString(this->m_port))));
+  }
+  apps.push_back(Statement::Construct("UdpEchoServerHelper", "server_" + this->GetAppName()).Arg(Expression::Name("port_" + this->GetAppName())));
+  apps.push_back(Statement::Define("ApplicationContainer", container, Expression::Method("server_" + this->GetAppName(), "Install")
+        .Arg(Expression::Method(this->GetReceiverNode(), "Get").Arg(Expression::Name("0")))));
+  startStop = this->DescribeStartStop(container, "0", "0");
+  apps.insert(apps.end(), startStop.begin(), startStop.end());
+
+  apps.push_back(Statement::Define("Time", "interPacketInterval_" + this->GetAppName(), Expression::Function("Seconds")
+        .Arg(Expression::Name(this->GetParameterValue("interval", this->m_packetIntervalTime)))));
+  apps.push_back(Statement::Construct("UdpEchoClientHelper", client)
+      .Arg(Expression::Method("iface_" + netDeviceContainer, "GetAddress").Arg(Expression::Name(numberIntoNetDevice)))
+      .Arg(Expression::Name(this->GetParameterValue("port", utils::integerToString(this->m_port)))));
+  apps.push_back(Statement::Call(client, "SetAttribute").Arg(Expression::String("MaxPackets"))
+      .Arg(Expression::Function("UintegerValue").Arg(Expression::Name(this->GetParameterValue("maxPackets", utils::integerToString(this->m_maxPacketCount))))));
+  apps.push_back(Statement::Call(client, "SetAttribute").Arg(Expression::String("Interval"))
+      .Arg(Expression::Function("TimeValue").Arg(Expression::Name("interPacketInterval_" + this->GetAppName()))));
+  apps.push_back(Statement::Call(client, "SetAttribute").Arg(Expression::String("PacketSize"))
+      .Arg(Expression::Function("UintegerValue").Arg(Expression::Name(this->GetParameterValue("packetSize", utils::integerToString(this->m_packetSize))))));
+  apps.push_back(Statement::Assign(container, Expression::Method(client, "Install")
+        .Arg(Expression::Method(this->GetSenderNode(), "Get").Arg(Expression::Name("0")))));
+  startStop = this->DescribeStartStop(container, "1", "0");
+  apps.insert(apps.end(), startStop.begin(), startStop.end());
 
   return apps;
 }
 
-std::vector<std::string> UdpEcho::GenerateApplicationPython(std::string netDeviceContainer, size_t numberIntoNetDevice)
+std::vector<Statement> UdpEcho::DescribeVars()
 {
-  std::vector<std::string> apps;
-  apps.push_back("port_" + this->GetAppName() + " = " + utils::integerToString(this->m_port));
-  apps.push_back("server_" + this->GetAppName() + " = ns3.UdpEchoServerHelper(port_" + this->GetAppName() + ")");
-  apps.push_back("apps_" + this->GetAppName() + " = server_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ".Get(0))");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (ns3.Seconds (" + this->GetStartTime() + ".0))");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (ns3.Seconds (" + this->GetEndTime() + ".0))");
-
-  apps.push_back("interPacketInterval_" + this->GetAppName() + " = ns3.Seconds (" + this->m_packetIntervalTime + ")");
-  apps.push_back("client_" + this->GetAppName() + " = ns3.UdpEchoClientHelper(iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "), " + utils::integerToString(this->m_port) + ")");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"MaxPackets\", ns3.UintegerValue (" + utils::integerToString(this->m_maxPacketCount) + "))");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"Interval\", ns3.TimeValue (interPacketInterval_" + this->GetAppName() + "))");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"PacketSize\", ns3.UintegerValue (" + utils::integerToString(this->m_packetSize) + "))");
-  apps.push_back("apps_" + this->GetAppName() + " = client_" + this->GetAppName() + ".Install (" + this->GetSenderNode() + ".Get (0))");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (ns3.Seconds (" + this->GetStartTime() + ".1))");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (ns3.Seconds (" + this->GetEndTime() + ".0))");
-  return apps;
+  std::vector<Statement> vars = Application::DescribeVars();
+  if(this->GetParameterized())
+  {
+    vars.push_back(Statement::Define("uint16_t", "port_" + this->GetAppName(), Expression::Name(utils::integerToString(this->m_port))));
+    vars.push_back(Statement::Define("uint32_t", "packetSize_" + this->GetAppName(), Expression::Name(utils::integerToString(this->m_packetSize))));
+    vars.push_back(Statement::Define("uint32_t", "maxPackets_" + this->GetAppName(), Expression::Name(utils::integerToString(this->m_maxPacketCount))));
+    vars.push_back(Statement::Define("double", "interval_" + this->GetAppName(), Expression::Real(this->m_packetIntervalTime)));
+  }
+  return vars;
+}
+
+std::vector<Statement> UdpEcho::DescribeCmdLine()
+{
+  std::vector<Statement> cmdLine = Application::DescribeCmdLine();
+  if(this->GetParameterized())
+  {
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("port_" + this->GetAppName()))
+        .Arg(Expression::String("Port of " + this->GetAppName())).Arg(Expression::Name("port_" + this->GetAppName())));
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("packetSize_" + this->GetAppName()))
+        .Arg(Expression::String("Packet size of " + this->GetAppName() + " (bytes)")).Arg(Expression::Name("packetSize_" + this->GetAppName())));
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("maxPackets_" + this->GetAppName()))
+        .Arg(Expression::String("Max packets of " + this->GetAppName())).Arg(Expression::Name("maxPackets_" + this->GetAppName())));
+    cmdLine.push_back(Statement::Call("cmd", "AddValue").Arg(Expression::String("interval_" + this->GetAppName()))
+        .Arg(Expression::String("Packet interval of " + this->GetAppName() + " (s)")).Arg(Expression::Name("interval_" + this->GetAppName())));
+  }
+  return cmdLine;
 }
@@ -88,6 +88,12 @@ class UdpEcho : public Application
      */
     ~UdpEcho();
 
+    /**
+     * \brief Get the inputs of the code generation of the application.
+     * \return signature (one field per line)
+     */
+    virtual std::string GetSignature();
+
     /**
      * \brief Generate headers code.
      * \return headers code
@@ -95,20 +101,24 @@ class UdpEcho : public Application
     virtual std::vector<std::string> GenerateHeader();
 
     /**
-     * \brief Generate application C++ code.
+     * \brief Describe application code.
      * \param netDeviceContainer net device container
      * \param numberIntoNetDevice number into net device
      * \return application code
      */
-    virtual std::vector<std::string> GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice);
+    virtual std::vector<Statement> DescribeApplication(const std::string &netDeviceContainer, const std::string &numberIntoNetDevice);
 
     /**
-     * \brief Generate application python code.
-     * \param netDeviceContainer net device container
-     * \param numberIntoNetDevice number of the sender node into the net device container
-     * \return the ns3 application code
+     * \brief Describe vars code.
+     * \return vars code
+     */
+    virtual std::vector<Statement> DescribeVars();
+
+    /**
+     * \brief Describe cmd line code.
+     * \return cmd line code
      */
-    virtual std::vector<std::string> GenerateApplicationPython(std::string netDeviceContainer, size_t numberIntoNetDevice);
+    virtual std::vector<Statement> DescribeCmdLine();
 
     /**
      * \brief Get port.
@@ -157,6 +157,7 @@ int main(int argc, char *argv[])
   MainWindow* win = new MainWindow(std::string("Simulation generator for ns-3"));
   win->setWindowTitle("Generator");
   win->show();
+  win->RecoverAutosave();
     
   app.exec();
 	
@@ -4,15 +4,23 @@ DEPENDPATH += . gui kern test kern/examples
 INCLUDEPATH += . kern gui
 CONFIG += c++14
 QT += widgets
+LIBS += -lz
 
 # Input
 HEADERS += gui/drag-lines.h \
+           gui/drag-link.h \
            gui/drag-object.h \
            gui/drag-widget.h \
            gui/main-window.h \
            gui/gui-utils.h \
+           gui/layout-engine.h \
            gui/application-dialog.h \
            gui/application-pages.h \
+           gui/spatial-grid.h \
+           gui/object-pool.h \
+           gui/xml-loader.h \
+           gui/autosave.h \
+           gui/compressed-device.h \
            kern/ap.h \
            kern/application.h \
            kern/bridge.h \
@@ -22,6 +30,26 @@ HEADERS += gui/drag-lines.h \
            kern/network-hardware.h \
            kern/node.h \
            kern/ping.h \
+           kern/profiling.h \
+           kern/project-file.h \
+           kern/journal.h \
+           kern/codec.h \
+           kern/gzip-codec.h \
+           kern/compressed-file.h \
+           kern/topology-importer.h \
+           kern/fragment-cache.h \
+           kern/build-cache.h \
+           kern/scenario-data.h \
+           kern/sharding.h \
+           kern/statement.h \
+           kern/backend.h \
+           kern/cpp-backend.h \
+           kern/python-backend.h \
+           kern/program.h \
+           kern/pass.h \
+           kern/pass-manager.h \
+           kern/helper-dedup-pass.h \
+           kern/dead-object-pass.h \
            kern/point-to-point.h \
            kern/tap.h \
            kern/tcp-large-transfer.h \
@@ -30,12 +58,18 @@ HEADERS += gui/drag-lines.h \
            kern/array-utils.h
 SOURCES += main.cpp \
            gui/drag-lines.cpp \
+           gui/drag-link.cpp \
            gui/drag-object.cpp \
            gui/drag-widget.cpp \
            gui/main-window.cpp \
            gui/gui-utils.cpp \
+           gui/layout-engine.cpp \
            gui/application-dialog.cpp \
            gui/application-pages.cpp \
+           gui/spatial-grid.cpp \
+           gui/xml-loader.cpp \
+           gui/autosave.cpp \
+           gui/compressed-device.cpp \
            kern/ap.cpp \
            kern/application.cpp \
            kern/bridge.cpp \
@@ -45,6 +79,26 @@ SOURCES += main.cpp \
            kern/network-hardware.cpp \
            kern/node.cpp \
            kern/ping.cpp \
+           kern/profiling.cpp \
+           kern/project-file.cpp \
+           kern/journal.cpp \
+           kern/codec.cpp \
+           kern/gzip-codec.cpp \
+           kern/compressed-file.cpp \
+           kern/topology-importer.cpp \
+           kern/fragment-cache.cpp \
+           kern/build-cache.cpp \
+           kern/scenario-data.cpp \
+           kern/sharding.cpp \
+           kern/statement.cpp \
+           kern/backend.cpp \
+           kern/cpp-backend.cpp \
+           kern/python-backend.cpp \
+           kern/program.cpp \
+           kern/pass.cpp \
+           kern/pass-manager.cpp \
+           kern/helper-dedup-pass.cpp \
+           kern/dead-object-pass.cpp \
            kern/point-to-point.cpp \
            kern/tap.cpp \
            kern/tcp-large-transfer.cpp \
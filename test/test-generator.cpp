@@ -26,8 +26,16 @@
  */
 
 #include <cppunit/extensions/HelperMacros.h>
+#include <cstdio>
+#include <cstdlib>
 #include <stdexcept>
+#include <fstream>
+#include <dirent.h>
+#include <unistd.h>
 #include "../kern/generator.h"
+#include "../kern/topology-importer.h"
+#include "../kern/project-file.h"
+#include "../kern/journal.h"
 
 namespace tests
 {
@@ -43,17 +51,63 @@ namespace tests
     CPPUNIT_TEST(testRemoveNode);
     CPPUNIT_TEST_EXCEPTION(addWrongEquipement, std::exception);
     CPPUNIT_TEST_EXCEPTION(getWrongEquipement, std::out_of_range);
+    CPPUNIT_TEST(testRemoveObjects);
+    CPPUNIT_TEST_EXCEPTION(removeWrongObjects, std::logic_error);
+    CPPUNIT_TEST(testCreateDeleteSession);
+    CPPUNIT_TEST(testMerge);
 
     CPPUNIT_TEST(testAddLink);
     CPPUNIT_TEST(testRemoveLink);
     CPPUNIT_TEST_EXCEPTION(addWrongLink, std::exception);
     CPPUNIT_TEST_EXCEPTION(getWrongLink, std::out_of_range);
 
+    CPPUNIT_TEST(testSetScheduler);
+    CPPUNIT_TEST_EXCEPTION(setWrongScheduler, std::logic_error);
+    CPPUNIT_TEST(testCompression);
+    CPPUNIT_TEST(testCodeData);
+    CPPUNIT_TEST(testProfiling);
+    CPPUNIT_TEST(testProjectFile);
+    CPPUNIT_TEST_EXCEPTION(openTruncatedProject, std::logic_error);
+    CPPUNIT_TEST_EXCEPTION(readCorruptedProject, std::out_of_range);
+    CPPUNIT_TEST(testJournal);
+    CPPUNIT_TEST(testImportTopology);
+    CPPUNIT_TEST(testFragmentCache);
+    CPPUNIT_TEST(testStructureHash);
+    CPPUNIT_TEST(testSinglePass);
+    CPPUNIT_TEST(testHelperDedupPass);
+    CPPUNIT_TEST(testDeadObjectPass);
+    CPPUNIT_TEST_EXCEPTION(addWrongPass, std::logic_error);
+
     CPPUNIT_TEST_SUITE_END();
 
     private:
     Generator *gen;
 
+    /**
+     * \brief Remove a directory and everything in it.
+     * \param directory directory path
+     */
+    void RemoveDirectory(const std::string &directory)
+    {
+      DIR *dir = opendir(directory.c_str());
+      if(dir == NULL)
+      {
+        return;
+      }
+      struct dirent *entry = NULL;
+      while((entry = readdir(dir)) != NULL)
+      {
+        std::string name = entry->d_name;
+        if(name != "." && name != "..")
+        {
+          this->RemoveDirectory(directory + "/" + name);
+          remove((directory + "/" + name).c_str());
+        }
+      }
+      closedir(dir);
+      rmdir(directory.c_str());
+    }
+
     public:
     void setUp()
     {
@@ -108,6 +162,140 @@ namespace tests
       this->gen->GetNode(-1);
     }
 
+    /**
+     * \brief test to remove nodes with their links and applications.
+     */
+    void testRemoveObjects()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Pc");
+      std::string pc0 = this->gen->GetNode(0)->GetNodeName();
+      std::string pc1 = this->gen->GetNode(1)->GetNodeName();
+      std::string pc2 = this->gen->GetNode(2)->GetNodeName();
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(0)->Install(pc0);
+      this->gen->GetNetworkHardware(0)->Install(pc1);
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(1)->Install(pc0);
+      this->gen->GetNetworkHardware(1)->Install(pc1);
+      this->gen->GetNetworkHardware(1)->Install(pc2);
+      this->gen->AddApplication("Ping", pc0, pc1, 1, 2);
+      this->gen->AddApplication("Ping", pc1, pc2, 1, 2);
+
+      std::set<std::string> names;
+      names.insert(pc0);
+      std::set<std::string> keep;
+      this->gen->RemoveObjects(names, keep);
+
+      // the first hub is left with a single node.
+      CPPUNIT_ASSERT(this->gen->GetNNodes() == 2);
+      CPPUNIT_ASSERT(this->gen->GetNNetworkHardwares() == 1);
+      CPPUNIT_ASSERT(this->gen->GetNetworkHardware(0)->GetInstalledNodes().size() == 2);
+      CPPUNIT_ASSERT(this->gen->GetNApplications() == 1);
+    }
+
+    /**
+     * \brief remove an unknown object.
+     */
+    void removeWrongObjects()
+    {
+      this->gen->AddNode("Pc");
+      std::set<std::string> names;
+      names.insert(this->gen->GetNode(0)->GetNodeName());
+      names.insert("unknown");
+      this->gen->RemoveObjects(names, std::set<std::string>());
+    }
+
+    /**
+     * \brief test that a long create/delete session leaves the model as it was.
+     */
+    void testCreateDeleteSession()
+    {
+      // the topology which stays during the session.
+      this->gen->AddNetworkHardware("Hub");
+      for(size_t i = 0; i < 100; i++)
+      {
+        this->gen->AddNode("Pc");
+        this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(i)->GetNodeName());
+      }
+      std::set<std::string> keep;
+      keep.insert(this->gen->GetNetworkHardware(0)->GetNetworkHardwareName());
+
+      // 100k cycles in 10 rounds, each round ends on the initial model.
+      for(size_t r = 0; r < 10; r++)
+      {
+        for(size_t c = 0; c < 10000; c++)
+        {
+          this->gen->AddNode("Pc");
+          std::string name = this->gen->GetNode(this->gen->GetNNodes() - 1)->GetNodeName();
+          this->gen->GetNetworkHardware(0)->Install(name);
+          this->gen->AddApplication("Ping", name, this->gen->GetNode(0)->GetNodeName(), 1, 2);
+
+          std::set<std::string> names;
+          names.insert(name);
+          this->gen->RemoveObjects(names, keep);
+        }
+        CPPUNIT_ASSERT(this->gen->GetNNodes() == 100);
+        CPPUNIT_ASSERT(this->gen->GetNNetworkHardwares() == 1);
+        CPPUNIT_ASSERT(this->gen->GetNetworkHardware(0)->GetInstalledNodes().size() == 100);
+        CPPUNIT_ASSERT(this->gen->GetNApplications() == 0);
+      }
+    }
+
+    /**
+     * \brief test to merge a detached generator.
+     */
+    void testMerge()
+    {
+      this->gen->AddNode("Pc");
+      Generator other("other");
+      other.AddNode("Pc");
+      other.SetScheduler("Calendar");
+      other.GetNode(0)->SetNodeName("loaded_0");
+      std::map<std::string, std::string> renamed;
+      this->gen->Merge(other, renamed);
+      CPPUNIT_ASSERT(this->gen->GetNNodes() == 2 && other.GetNNodes() == 0);
+      CPPUNIT_ASSERT(this->gen->GetNode(1)->GetNodeName() == "loaded_0");
+      CPPUNIT_ASSERT(this->gen->GetScheduler() == "Calendar");
+      CPPUNIT_ASSERT(renamed.empty());
+      /* the name counters follow, the next node does not collide. */
+      this->gen->AddNode("Pc");
+      CPPUNIT_ASSERT(this->gen->GetNode(2)->GetNodeName() != this->gen->GetNode(0)->GetNodeName());
+
+      /* a loaded model names its objects from zero: the same names collide. */
+      Generator loaded("loaded");
+      loaded.AddNode("Pc");
+      loaded.AddNode("Pc");
+      loaded.GetNode(0)->SetNodeName(this->gen->GetNode(0)->GetNodeName());
+      loaded.AddNetworkHardware("Hub");
+      loaded.GetNetworkHardware(0)->Install(loaded.GetNode(0)->GetNodeName());
+      loaded.GetNetworkHardware(0)->Install(loaded.GetNode(1)->GetNodeName());
+      loaded.AddApplication("Ping", loaded.GetNode(0)->GetNodeName(), loaded.GetNode(1)->GetNodeName(), 1, 2);
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->AddApplication("Ping", this->gen->GetNode(0)->GetNodeName(), this->gen->GetNode(2)->GetNodeName(), 1, 2);
+      std::string node = loaded.GetNode(0)->GetNodeName();
+      std::string link = loaded.GetNetworkHardware(0)->GetNetworkHardwareName();
+      std::string app = loaded.GetApplication(0)->GetAppName();
+      CPPUNIT_ASSERT(link == this->gen->GetNetworkHardware(0)->GetNetworkHardwareName());
+      CPPUNIT_ASSERT(app == this->gen->GetApplication(0)->GetAppName());
+
+      this->gen->Merge(loaded, renamed);
+      CPPUNIT_ASSERT(renamed.size() == 3 && renamed.count(node) && renamed.count(link) && renamed.count(app));
+      std::set<std::string> names;
+      for(size_t i = 0; i < this->gen->GetNNodes(); i++)
+      {
+        names.insert(this->gen->GetNode(i)->GetNodeName());
+      }
+      CPPUNIT_ASSERT(names.size() == this->gen->GetNNodes());
+      NetworkHardware *hub = this->gen->GetNetworkHardware(1);
+      CPPUNIT_ASSERT(hub->GetNetworkHardwareName() == renamed[link]);
+      CPPUNIT_ASSERT(hub->GetNdcName() != this->gen->GetNetworkHardware(0)->GetNdcName());
+      CPPUNIT_ASSERT(hub->GetInstalledNode(0) == renamed[node] || hub->GetInstalledNode(1) == renamed[node]);
+      CPPUNIT_ASSERT(this->gen->GetApplication(1)->GetAppName() == renamed[app]);
+      CPPUNIT_ASSERT(this->gen->GetApplication(1)->GetSenderNode() == renamed[node]);
+    }
+
     //
     // Links
     //
@@ -152,6 +340,553 @@ namespace tests
     {
       //this->gen->GetLink(-1);
     }
+
+    //
+    // Scheduler
+    //
+
+    /**
+     * \brief test to set a scheduler.
+     */
+    void testSetScheduler()
+    {
+      this->gen->SetScheduler("Calendar");
+      CPPUNIT_ASSERT(this->gen->GetScheduler() == "Calendar");
+      this->gen->SetScheduler("");
+      CPPUNIT_ASSERT(this->gen->GetScheduler() == "");
+
+      /* a failed benchmark leaves the scheduler and the profiling as they were. */
+      this->gen->AddNode("Pc");
+      this->gen->SetScheduler("Calendar");
+      bool failed = false;
+      try
+      {
+        this->gen->GenerateSchedulerBenchmarkCpp("/nonexistent/test-generator.cc");
+      }
+      catch(const std::exception &)
+      {
+        failed = true;
+      }
+      CPPUNIT_ASSERT(failed);
+      CPPUNIT_ASSERT(this->gen->GetScheduler() == "Calendar" && !this->gen->GetProfiling());
+    }
+
+    /**
+     * \brief test to set a wrong scheduler.
+     */
+    void setWrongScheduler()
+    {
+      this->gen->SetScheduler("Fifo");
+    }
+
+    /**
+     * \brief test to generate compressed code.
+     */
+    void testCompression()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      this->gen->SetCompression("gzip");
+      CPPUNIT_ASSERT(this->gen->OutputFileName("/tmp/test-generator.cc") == "/tmp/test-generator.cc.gz");
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(CompressedFile::IsCompressed("/tmp/test-generator.cc.gz"));
+      CPPUNIT_ASSERT(CompressedFile::ReadFile("/tmp/test-generator.cc.gz") == CompressedFile::ReadFile("/tmp/test-generator.cc"));
+      remove("/tmp/test-generator.cc");
+
+      /* a corrupted frame size is rejected before the frame is read. */
+      std::fstream file("/tmp/test-generator.cc.gz", std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(16);
+      file.write("\xf0\xff\xff\xff", 4);
+      file.close();
+      std::string error;
+      try
+      {
+        CompressedFile::ReadFile("/tmp/test-generator.cc.gz");
+      }
+      catch(const std::logic_error &e)
+      {
+        error = e.what();
+      }
+      CPPUNIT_ASSERT(error.find("oversized frame") != std::string::npos);
+
+      /* a corrupted size trailer is rejected before the block is allocated. */
+      CompressedFile compressed;
+      compressed.Create("/tmp/test-generator.cc.gz", "gzip");
+      compressed.Write("trailer");
+      compressed.Close();
+      file.open("/tmp/test-generator.cc.gz", std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(-4, std::ios::end);
+      file.write("\x00\x00\x00\xc0", 4);
+      file.close();
+      error = "";
+      try
+      {
+        CompressedFile::ReadFile("/tmp/test-generator.cc.gz");
+      }
+      catch(const std::exception &e)
+      {
+        error = e.what();
+      }
+      CPPUNIT_ASSERT(error.find("gzip member too large") != std::string::npos);
+      remove("/tmp/test-generator.cc.gz");
+    }
+
+    /**
+     * \brief test to generate a data-driven scenario.
+     */
+    void testCodeData()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Pc");
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(0)->GetNodeName());
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(1)->GetNodeName());
+      this->gen->GetNode(0)->SetParameterized(true);
+      this->gen->GenerateCodeData("/tmp/test-generator.cc");
+      /* the generation does not change the parameterized objects. */
+      CPPUNIT_ASSERT(this->gen->GetNode(0)->GetParameterized() && !this->gen->GetNode(1)->GetParameterized());
+      std::string code = CompressedFile::ReadFile("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(code.find("NewNetwork") == std::string::npos);
+      CPPUNIT_ASSERT(code.find("base << \"10.0.\" << i << \".0\";") != std::string::npos);
+      remove(ScenarioData::DataFileName("/tmp/test-generator.cc").c_str());
+      remove("/tmp/test-generator.cc");
+    }
+
+    /**
+     * \brief test to generate the profiling code.
+     */
+    void testProfiling()
+    {
+      Generator profiled("scenario\"name");
+      profiled.AddNode("Pc");
+      profiled.SetProfiling(true);
+      profiled.GenerateCodeCpp("/tmp/test-generator.cc");
+      profiled.GenerateCodePython("/tmp/test-generator.py");
+      std::string cpp = CompressedFile::ReadFile("/tmp/test-generator.cc");
+      std::string python = CompressedFile::ReadFile("/tmp/test-generator.py");
+      remove("/tmp/test-generator.cc");
+      remove("/tmp/test-generator.py");
+
+      CPPUNIT_ASSERT(cpp.find("static void ProfilingSummary (") != std::string::npos);
+      CPPUNIT_ASSERT(cpp.find("cmd.AddValue (\"profilingInterval\"") != std::string::npos);
+      CPPUNIT_ASSERT(cpp.find("cmd.AddValue (\"profilingOutput\"") != std::string::npos);
+      /* the scenario name is escaped for the JSON summary, then for the C++ literal. */
+      CPPUNIT_ASSERT(cpp.find("ProfilingSummary (profilingOutput, \"scenario\\\\\\\"name\"") != std::string::npos);
+
+      CPPUNIT_ASSERT(python.find("def ProfilingSummary(") != std::string::npos);
+      CPPUNIT_ASSERT(python.find("cmd.AddValue(\"profilingInterval\"") != std::string::npos);
+      CPPUNIT_ASSERT(python.find("cmd.AddValue(\"profilingOutput\"") != std::string::npos);
+    }
+
+    /**
+     * \brief test to write and read back a binary project file.
+     */
+    void testProjectFile()
+    {
+      ProjectFile project;
+      project.SetScheduler("Calendar");
+      project.SetParameterized(true);
+      ProjectFile::Node node = {"Pc", "term_0", "liblinux2.6.26.so", 3, 10, 20};
+      project.AddNode(node);
+      node.type = "Router";
+      node.name = "router_0";
+      node.nsc = "";
+      project.AddNode(node);
+      ProjectFile::Link link;
+      link.hidden = false;
+      link.type = "Hub";
+      link.name = "hub_0";
+      link.dataRate = "100Mbps";
+      link.delay = "2ms";
+      link.trace = true;
+      link.promisc = false;
+      link.special = "100-200";
+      link.members.push_back("term_0");
+      link.members.push_back("router_0");
+      project.AddLink(link);
+      link.hidden = true;
+      link.type = "PointToPoint";
+      link.name = "p2p_0";
+      link.promisc = true;
+      link.members.pop_back();
+      project.AddLink(link);
+      ProjectFile::Application app = {"UdpEcho", "udpEcho_0", "term_0", "router_0", "1", "5", 9, 1024, 10, "1.0"};
+      project.AddApplication(app);
+      ProjectFile::Line line = {"term_0", "hub_0", "Hub"};
+      project.AddLine(line);
+
+      const char *files[] = {"/tmp/test-generator.ngp", "/tmp/test-generator.ngp.gz"};
+      project.Write(files[0]);
+      project.Write(files[1], "gzip");
+      CPPUNIT_ASSERT(ProjectFile::IsProjectFile(files[0]));
+      CPPUNIT_ASSERT(CompressedFile::IsCompressed(files[1]));
+      for(size_t i = 0; i < 2; i++)
+      {
+        ProjectFile read;
+        read.Open(files[i]);
+        CPPUNIT_ASSERT(read.GetScheduler() == "Calendar" && read.GetParameterized());
+        CPPUNIT_ASSERT(read.GetNNodes() == 2 && read.GetNLinks() == 2);
+        CPPUNIT_ASSERT(read.GetNApplications() == 1 && read.GetNLines() == 1);
+        ProjectFile::Node n = read.GetNode(0);
+        CPPUNIT_ASSERT(n.type == "Pc" && n.name == "term_0" && n.nsc == "liblinux2.6.26.so");
+        CPPUNIT_ASSERT(n.number == 3 && n.x == 10 && n.y == 20);
+        CPPUNIT_ASSERT(read.GetNode(1).name == "router_0" && read.GetNode(1).nsc == "");
+        ProjectFile::Link l = read.GetLink(0);
+        CPPUNIT_ASSERT(l.type == "Hub" && l.name == "hub_0" && l.dataRate == "100Mbps" && l.delay == "2ms");
+        CPPUNIT_ASSERT(!l.hidden && l.trace && !l.promisc && l.special == "100-200");
+        CPPUNIT_ASSERT(l.members.size() == 2 && l.members.at(0) == "term_0" && l.members.at(1) == "router_0");
+        l = read.GetLink(1);
+        CPPUNIT_ASSERT(l.hidden && l.trace && l.promisc && l.members.size() == 1);
+        ProjectFile::Application a = read.GetApplication(0);
+        CPPUNIT_ASSERT(a.type == "UdpEcho" && a.sender == "term_0" && a.receiver == "router_0");
+        CPPUNIT_ASSERT(a.startTime == "1" && a.endTime == "5" && a.packetIntervalTime == "1.0");
+        CPPUNIT_ASSERT(a.port == 9 && a.packetSize == 1024 && a.maxPacketCount == 10);
+        ProjectFile::Line li = read.GetLine(0);
+        CPPUNIT_ASSERT(li.first == "term_0" && li.second == "hub_0" && li.type == "Hub");
+        read.Close();
+        remove(files[i]);
+      }
+    }
+
+    /**
+     * \brief test to open a truncated project file.
+     */
+    void openTruncatedProject()
+    {
+      ProjectFile project;
+      ProjectFile::Node node = {"Pc", "term_0", "", 1, 0, 0};
+      project.AddNode(node);
+      project.Write("/tmp/test-generator.ngp");
+      std::ifstream in("/tmp/test-generator.ngp", std::ios::binary);
+      std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      in.close();
+      std::ofstream out("/tmp/test-generator.ngp", std::ios::binary);
+      out.write(content.data(), content.size() - 4);
+      out.close();
+
+      ProjectFile read;
+      try
+      {
+        read.Open("/tmp/test-generator.ngp");
+      }
+      catch(...)
+      {
+        remove("/tmp/test-generator.ngp");
+        throw;
+      }
+    }
+
+    /**
+     * \brief test to read a project file with a corrupted string offset.
+     */
+    void readCorruptedProject()
+    {
+      ProjectFile project;
+      ProjectFile::Node node = {"Pc", "term_0", "", 1, 0, 0};
+      project.AddNode(node);
+      project.Write("/tmp/test-generator.ngp");
+      std::fstream file("/tmp/test-generator.ngp", std::ios::binary | std::ios::in | std::ios::out);
+      /* end offset of the first string after "", past the string bytes. */
+      file.seekp(44 + 4);
+      file.write("\xff\xff\xff\x7f", 4);
+      file.close();
+
+      ProjectFile read;
+      read.Open("/tmp/test-generator.ngp");
+      remove("/tmp/test-generator.ngp");
+      read.GetNode(0);
+    }
+
+    /**
+     * \brief test to append, recover and reset an edit journal.
+     */
+    void testJournal()
+    {
+      const std::string fileName = "/tmp/test-generator.journal";
+      remove(fileName.c_str());
+      std::vector<std::string> record;
+      record.push_back("move");
+      record.push_back("a\tb");
+      record.push_back("line\nnext");
+      record.push_back("c:\\dir\\t");
+      record.push_back("");
+      std::vector<std::string> other(1, "remove");
+
+      Journal journal;
+      journal.Open(fileName);
+      journal.Append(record);
+      journal.Append(other);
+      CPPUNIT_ASSERT(journal.GetNRecords() == 2);
+      journal.Close();
+      /* the escaped fields keep one record per line. */
+      std::vector<std::vector<std::string> > records = Journal::Read(fileName);
+      CPPUNIT_ASSERT(records.size() == 2 && records.at(0) == record && records.at(1) == other);
+
+      /* a crash in the middle of a record leaves a torn last line. */
+      std::ifstream in(fileName.c_str(), std::ios::binary);
+      std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      in.close();
+      std::ofstream out(fileName.c_str(), std::ios::binary | std::ios::app);
+      out << "move\tter";
+      out.close();
+      CPPUNIT_ASSERT(Journal::Read(fileName).size() == 2);
+      journal.Open(fileName);
+      CPPUNIT_ASSERT(journal.GetNRecords() == 2);
+      journal.Append(other);
+      journal.Close();
+      in.open(fileName.c_str(), std::ios::binary);
+      std::string recovered((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      in.close();
+      CPPUNIT_ASSERT(recovered.size() > content.size() && recovered.compare(0, content.size(), content) == 0);
+      records = Journal::Read(fileName);
+      CPPUNIT_ASSERT(records.size() == 3 && records.at(0) == record && records.at(2) == other);
+
+      journal.Open(fileName);
+      journal.Reset(record);
+      CPPUNIT_ASSERT(journal.GetNRecords() == 1);
+      journal.Close();
+      records = Journal::Read(fileName);
+      CPPUNIT_ASSERT(records.size() == 1 && records.at(0) == record);
+      remove(fileName.c_str());
+    }
+
+    /**
+     * \brief test to import a BRITE topology.
+     */
+    void testImportTopology()
+    {
+      std::ofstream file("/tmp/test-generator.brite");
+      file << "Topology: ( 3 Nodes, 2 Edges )\n\nNodes: ( 3 )\n0 10 20 1 1 -1 RT_NODE\n1 30 40 2 2 -1 RT_NODE\n2 50 60 1 1 -1 RT_NODE\n";
+      file << "\nEdges: ( 2 ):\n0 0 1 20.0 1.5 10.0 -1 -1 E_RT U\n1 1 2 20.0 2.0 100.0 -1 -1 E_RT U\n";
+      file.close();
+
+      TopologyImporter::GeneratorSink sink(this->gen);
+      TopologyImporter importer(&sink);
+      CPPUNIT_ASSERT(importer.Import("/tmp/test-generator.brite"));
+      CPPUNIT_ASSERT(this->gen->GetNNodes() == 3);
+      CPPUNIT_ASSERT(this->gen->GetNNetworkHardwares() == 2);
+      CPPUNIT_ASSERT(this->gen->GetNetworkHardware(0)->GetDataRate() == "10000000");
+      CPPUNIT_ASSERT(this->gen->GetNetworkHardware(1)->GetNetworkHardwareDelay() == "2");
+      CPPUNIT_ASSERT(this->gen->GetNetworkHardware(1)->GetInstalledNode(0) == "router_1");
+      remove("/tmp/test-generator.brite");
+
+      /* two switches joined by an edge: a router is installed on both. */
+      std::ofstream graph("/tmp/test-generator.graphml");
+      graph << "<graphml>\n<key id=\"t\" for=\"node\" attr.name=\"type\"/>\n<graph>\n";
+      graph << "<node id=\"s0\"><data key=\"t\">switch</data></node>\n<node id=\"s1\"><data key=\"t\">switch</data></node>\n";
+      graph << "<node id=\"h0\"><data key=\"t\">host</data></node>\n<node id=\"h1\"><data key=\"t\">host</data></node>\n";
+      graph << "<edge source=\"h0\" target=\"s0\"/>\n<edge source=\"s0\" target=\"s1\"/>\n<edge source=\"s1\" target=\"h1\"/>\n";
+      graph << "</graph>\n</graphml>\n";
+      graph.close();
+      Generator switches("switches");
+      TopologyImporter::GeneratorSink switchSink(&switches);
+      TopologyImporter switchImporter(&switchSink);
+      CPPUNIT_ASSERT(switchImporter.Import("/tmp/test-generator.graphml"));
+      CPPUNIT_ASSERT(switches.GetNNodes() == 3 && switches.GetNNetworkHardwares() == 2);
+      std::string router = switches.GetNode(2)->GetNodeName();
+      CPPUNIT_ASSERT(router.find("router_") == 0);
+      for(size_t i = 0; i < 2; i++)
+      {
+        const std::vector<std::string> &members = switches.GetNetworkHardware(i)->GetInstalledNodes();
+        CPPUNIT_ASSERT(members.size() == 2 && members.at(0) == router);
+      }
+
+      /* a node defined after an edge which uses it is rejected, with its line. */
+      graph.open("/tmp/test-generator.graphml");
+      graph << "<graphml>\n<key id=\"t\" for=\"node\" attr.name=\"type\"/>\n<graph>\n";
+      graph << "<node id=\"h0\"><data key=\"t\">host</data></node>\n<edge source=\"h0\" target=\"h1\"/>\n";
+      graph << "<node id=\"h1\"><data key=\"t\">host</data></node>\n</graph>\n</graphml>\n";
+      graph.close();
+      Generator forward("forward");
+      TopologyImporter::GeneratorSink forwardSink(&forward);
+      TopologyImporter forwardImporter(&forwardSink);
+      std::string error;
+      try
+      {
+        forwardImporter.Import("/tmp/test-generator.graphml");
+      }
+      catch(const std::logic_error &e)
+      {
+        error = e.what();
+      }
+      CPPUNIT_ASSERT(error.find(":6: node h1 defined after an edge using it") != std::string::npos);
+      remove("/tmp/test-generator.graphml");
+    }
+
+    /**
+     * \brief test to generate code from the fragment cache.
+     */
+    void testFragmentCache()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Router");
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(0)->GetNodeName());
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(1)->GetNodeName());
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+
+      /* a fresh directory, so the first pass is cold. */
+      char directory[] = "/tmp/test-generator-cache-XXXXXX";
+      CPPUNIT_ASSERT(mkdtemp(directory) != NULL);
+      this->gen->SetFragmentCache(directory);
+      this->gen->GenerateCodeCpp("/tmp/test-generator-cold.cc");
+      CPPUNIT_ASSERT(this->gen->GetFragmentCache()->GetMisses() > 0);
+      CPPUNIT_ASSERT(this->gen->GetFragmentCache()->GetHits() == 0);
+      this->gen->GenerateCodeCpp("/tmp/test-generator-warm.cc");
+      CPPUNIT_ASSERT(this->gen->GetFragmentCache()->GetHits() > 0);
+      CPPUNIT_ASSERT(CompressedFile::ReadFile("/tmp/test-generator-cold.cc") == CompressedFile::ReadFile("/tmp/test-generator.cc"));
+      CPPUNIT_ASSERT(CompressedFile::ReadFile("/tmp/test-generator-warm.cc") == CompressedFile::ReadFile("/tmp/test-generator.cc"));
+      this->gen->SetFragmentCache("");
+      CPPUNIT_ASSERT(this->gen->GetFragmentCache() == NULL);
+      remove("/tmp/test-generator.cc");
+      remove("/tmp/test-generator-cold.cc");
+      remove("/tmp/test-generator-warm.cc");
+      this->RemoveDirectory(directory);
+    }
+
+    /**
+     * \brief test the structure hash of the parameterized code.
+     */
+    void testStructureHash()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Router");
+      this->gen->AddNetworkHardware("PointToPoint");
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(0)->GetNodeName());
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(1)->GetNodeName());
+      this->gen->AddApplication("Ping", this->gen->GetNode(0)->GetNodeName(), this->gen->GetNode(1)->GetNodeName(), 1, 5);
+      this->gen->SetParameterized(true);
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      std::string hash = this->gen->GetStructureHash();
+      CPPUNIT_ASSERT(hash.size() == 32);
+
+      /* a parameter value does not change the structure. */
+      this->gen->GetNetworkHardware(0)->SetDataRate("1000");
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(this->gen->GetStructureHash() == hash);
+
+      /* neither does an end time, the stop time follows it at run time. */
+      this->gen->GetApplication(0)->SetEndTime(50);
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(this->gen->GetStructureHash() == hash);
+
+      this->gen->SetParameterized(false);
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(this->gen->GetStructureHash() != hash);
+      remove("/tmp/test-generator.cc");
+    }
+
+    /**
+     * \brief test to generate C++ and python code in a single traversal.
+     */
+    void testSinglePass()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Emu");
+      this->gen->AddNetworkHardware("Emu", this->gen->GetNode(1)->GetNodeName(), "eth0");
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(0)->GetNodeName());
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      this->gen->GenerateCodePython("/tmp/test-generator.py");
+      this->gen->GenerateCode("/tmp/test-generator-both.cc", "/tmp/test-generator-both.py");
+      CPPUNIT_ASSERT(CompressedFile::ReadFile("/tmp/test-generator-both.cc") == CompressedFile::ReadFile("/tmp/test-generator.cc"));
+      CPPUNIT_ASSERT(CompressedFile::ReadFile("/tmp/test-generator-both.py") == CompressedFile::ReadFile("/tmp/test-generator.py"));
+
+      /* the real time configuration is written in python syntax. */
+      CPPUNIT_ASSERT(CompressedFile::ReadFile("/tmp/test-generator.py").find("ns3.GlobalValue.Bind(") != std::string::npos);
+      CPPUNIT_ASSERT(CompressedFile::ReadFile("/tmp/test-generator.py").find("GlobalValue::Bind") == std::string::npos);
+      remove("/tmp/test-generator.cc");
+      remove("/tmp/test-generator.py");
+      remove("/tmp/test-generator-both.cc");
+      remove("/tmp/test-generator-both.py");
+    }
+
+    /**
+     * \brief test to merge the link helpers with the same configuration.
+     */
+    void testHelperDedupPass()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Router");
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(0)->GetNodeName());
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(2)->GetNodeName());
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(1)->Install(this->gen->GetNode(1)->GetNodeName());
+      this->gen->GetNetworkHardware(1)->Install(this->gen->GetNode(2)->GetNodeName());
+      this->gen->AddPass("helper-dedup");
+      this->gen->AddPass("helper-dedup");
+      CPPUNIT_ASSERT(this->gen->GetPasses().size() == 1);
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(this->gen->GetPassReport().size() == 1);
+      std::string code = CompressedFile::ReadFile("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(code.find("CsmaHelper csma_hub_1") == std::string::npos);
+      CPPUNIT_ASSERT(code.find("ndc_hub_1 = csma_hub_0.Install (all_hub_1);") != std::string::npos);
+      this->gen->ClearPasses();
+      CPPUNIT_ASSERT(this->gen->GetPasses().size() == 0);
+      remove("/tmp/test-generator.cc");
+    }
+
+    /**
+     * \brief test to remove the objects which take no part in the simulation.
+     */
+    void testDeadObjectPass()
+    {
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Pc");
+      this->gen->AddNode("Pc");
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(0)->GetNodeName());
+      this->gen->GetNetworkHardware(0)->Install(this->gen->GetNode(1)->GetNodeName());
+      this->gen->AddNetworkHardware("Hub");
+      this->gen->GetNetworkHardware(1)->Install(this->gen->GetNode(2)->GetNodeName());
+      this->gen->AddPass("helper-dedup");
+      this->gen->AddPass("dead-objects");
+      CPPUNIT_ASSERT(this->gen->GetPasses().at(0) == "dead-objects");
+      this->gen->GenerateCodeCpp("/tmp/test-generator.cc");
+      std::vector<std::string> report = this->gen->GetPassReport();
+      CPPUNIT_ASSERT(report.size() == 2);
+      CPPUNIT_ASSERT(report.at(0) == "dead-objects: removed link hub_1 (fewer than two members)");
+      CPPUNIT_ASSERT(report.at(1) == "dead-objects: removed node term_2 (no link and no application)");
+      std::string code = CompressedFile::ReadFile("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(code.find("all_hub_1") == std::string::npos);
+      CPPUNIT_ASSERT(code.find("term_2") == std::string::npos);
+      CPPUNIT_ASSERT(code.find("ndc_hub_0 = csma_hub_0.Install (all_hub_0);") != std::string::npos);
+      remove("/tmp/test-generator.cc");
+
+      /* an emu link only needs its node, and a removed link does not take
+       * the code of a node of the same name. */
+      Generator emu("emu");
+      emu.AddNode("Emu");
+      emu.AddNetworkHardware("Emu", emu.GetNode(0)->GetNodeName(), "eth0");
+      emu.AddNode("Pc");
+      emu.AddNode("Pc");
+      emu.AddNetworkHardware("Hub");
+      emu.GetNetworkHardware(1)->Install(emu.GetNode(1)->GetNodeName());
+      emu.GetNetworkHardware(1)->Install(emu.GetNode(2)->GetNodeName());
+      emu.AddNetworkHardware("Hub");
+      emu.GetNetworkHardware(2)->Install(emu.GetNode(1)->GetNodeName());
+      emu.GetNetworkHardware(2)->SetNetworkHardwareName(emu.GetNode(2)->GetNodeName());
+      CPPUNIT_ASSERT(emu.GetNode(0)->GetNodeName() == emu.GetNetworkHardware(0)->GetNetworkHardwareName());
+      emu.AddPass("dead-objects");
+      emu.GenerateCodeCpp("/tmp/test-generator.cc");
+      report = emu.GetPassReport();
+      CPPUNIT_ASSERT(report.size() == 1);
+      CPPUNIT_ASSERT(report.at(0) == "dead-objects: removed link term_1 (fewer than two members)");
+      code = CompressedFile::ReadFile("/tmp/test-generator.cc");
+      CPPUNIT_ASSERT(code.find("EmuHelper") != std::string::npos);
+      CPPUNIT_ASSERT(code.find("NodeContainer emu_0;") != std::string::npos);
+      CPPUNIT_ASSERT(code.find("NodeContainer term_1;") != std::string::npos);
+      remove("/tmp/test-generator.cc");
+    }
+
+    /**
+     * \brief test to add an unknown pass.
+     */
+    void addWrongPass()
+    {
+      this->gen->AddPass("unknown");
+    }
   };
 } 
 
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Strasbourg
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file test-gui.cpp
+ * \brief Unit test for the Qt-free canvas containers and layout
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cmath>
+#include <set>
+#include <thread>
+#include <vector>
+#include "../gui/spatial-grid.h"
+#include "../gui/object-pool.h"
+#include "../gui/layout-engine.h"
+
+namespace tests
+{
+  /**
+   * \brief Canvas object of the session test: grid ids of its icon and link.
+   */
+  struct CanvasObject
+  {
+    /**
+     * \brief Grid id of the icon.
+     */
+    size_t id;
+
+    /**
+     * \brief Grid id of the link.
+     */
+    size_t linkId;
+  };
+
+  /**
+   * \ingroup generator
+   * \brief The canvas containers and layout test class
+   */
+  class TestGui : public CppUnit::TestFixture
+  {
+    CPPUNIT_TEST_SUITE(tests::TestGui);
+
+    CPPUNIT_TEST(testCanvasSession);
+    CPPUNIT_TEST(testTreeLayout);
+    CPPUNIT_TEST(testForceLayout);
+
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    /**
+     * \brief test that a long create/delete session on the canvas leaves no shape and a bounded pool.
+     */
+    void testCanvasSession()
+    {
+      SpatialGrid grid(64);
+      ObjectPool<CanvasObject> pool(16);
+      size_t nextId = 0;
+      std::set<CanvasObject*> allocated;
+
+      // 100k cycles in 10 rounds, each round ends on an empty canvas.
+      for(size_t r = 0; r < 10; r++)
+      {
+        for(size_t c = 0; c < 10000; c++)
+        {
+          // the canvas object comes from the pool, its icon and link are indexed.
+          CanvasObject *object = pool.Take();
+          allocated.insert(object);
+          object->id = nextId++;
+          object->linkId = nextId++;
+          double x = (c % 100) * 40.0;
+          grid.SetRect(object->id, x, 200, x + 32, 232);
+          grid.SetSegment(object->linkId, 16, 16, x + 16, 216);
+
+          grid.Remove(object->linkId);
+          grid.Remove(object->id);
+          pool.Release(object);
+        }
+        CPPUNIT_ASSERT(grid.GetNShapes() == 0);
+        CPPUNIT_ASSERT(pool.GetSize() <= pool.GetCapacity());
+      }
+      // one object at a time: the pool gives back the same one.
+      CPPUNIT_ASSERT(allocated.size() == 1);
+    }
+
+    /**
+     * \brief test the tree layout of a small tree and of a node out of it.
+     */
+    void testTreeLayout()
+    {
+      LayoutEngine engine(10);
+      for(size_t i = 0; i < 6; i++)
+      {
+        engine.AddNode(0, 0);
+      }
+      engine.AddEdge(0, 1);
+      engine.AddEdge(0, 2);
+      engine.AddEdge(1, 3);
+      engine.AddEdge(1, 4);
+      engine.TreeLayout(std::vector<size_t>(1, 0));
+
+      std::vector<double> x;
+      std::vector<double> y;
+      engine.GetPositions(x, y);
+      CPPUNIT_ASSERT(x.size() == 6 && y.size() == 6);
+      // one row by depth, each parent centered over the leaves of its subtree.
+      CPPUNIT_ASSERT(x[0] == 10 && y[0] == 0);
+      CPPUNIT_ASSERT(x[1] == 5 && y[1] == 10);
+      CPPUNIT_ASSERT(x[2] == 20 && y[2] == 10);
+      CPPUNIT_ASSERT(x[3] == 0 && y[3] == 20);
+      CPPUNIT_ASSERT(x[4] == 10 && y[4] == 20);
+      // the node not reached from the root starts a tree on the right.
+      CPPUNIT_ASSERT(x[5] == 30 && y[5] == 0);
+    }
+
+    /**
+     * \brief test that the force iterations bring a small graph to a stable layout without overlap.
+     */
+    void testForceLayout()
+    {
+      LayoutEngine engine(120);
+      engine.SetThreads(1);
+      // all the nodes start stacked at the same position.
+      for(size_t i = 0; i < 8; i++)
+      {
+        engine.AddNode(0, 0);
+      }
+      for(size_t i = 1; i < 5; i++)
+      {
+        engine.AddEdge(0, i);
+      }
+      engine.AddEdge(4, 5);
+      engine.AddEdge(5, 6);
+      engine.AddEdge(6, 7);
+
+      double move = 0;
+      size_t iterations = 0;
+      do
+      {
+        move = engine.Step();
+        iterations++;
+      }
+      while(move >= 0.5 && iterations < 1000);
+      CPPUNIT_ASSERT(move < 0.5);
+      CPPUNIT_ASSERT(engine.Step() < 0.5);
+
+      // Step does not publish, one background iteration does.
+      engine.Start(1);
+      while(engine.IsRunning())
+      {
+        std::this_thread::yield();
+      }
+      engine.Stop();
+      std::vector<double> x;
+      std::vector<double> y;
+      engine.GetPositions(x, y);
+      CPPUNIT_ASSERT(x.size() == 8 && y.size() == 8);
+
+      // no two nodes closer than an icon (32 pixels).
+      for(size_t i = 0; i < x.size(); i++)
+      {
+        for(size_t j = i + 1; j < x.size(); j++)
+        {
+          CPPUNIT_ASSERT(std::sqrt((x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j])) > 32);
+        }
+      }
+    }
+  };
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(tests::TestGui);